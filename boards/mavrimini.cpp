@@ -81,8 +81,9 @@ Mavrimini::Mavrimini(mavrimini_conf_t config):
     serial_2(config.serial_2_config),
     i2c_1(config.i2c_1_config),
     i2c_2(config.i2c_2_config),
+    i2c_2_queue(i2c_2),
     spektrum_satellite(serial_2, dsm_receiver_gpio, dsm_power_gpio),
-    sonar_i2cxl(i2c_2),
+    sonar_i2cxl(i2c_2_queue),
     adc_battery(12.3f),
     battery(adc_battery),
     adc_airspeed(12.0f),
@@ -44,6 +44,7 @@
 
 #include "hal/stm32/gpio_stm32.hpp"
 #include "hal/stm32/i2c_stm32.hpp"
+#include "hal/common/i2c_queue.hpp"
 #include "hal/stm32/pwm_stm32.hpp"
 #include "hal/stm32/serial_stm32.hpp"
 
@@ -147,6 +148,7 @@ public:
     Serial_stm32            serial_2;
     I2c_stm32               i2c_1;
     I2c_stm32               i2c_2;
+    I2c_queue_T<>           i2c_2_queue;            ///< Serializes transfers of the devices on i2c_2, to be updated by the scheduler
     Spektrum_satellite      spektrum_satellite;
     Sonar_i2cxl             sonar_i2cxl;
     Adc_dummy               adc_battery;
@@ -285,6 +287,7 @@ static inline mavrimini_conf_t mavrimini_default_config()
     conf.i2c_2_config.clk_config.alt_fct    = GPIO_STM32_AF_4;
     conf.i2c_2_config.clk_speed             = 100000;
     conf.i2c_2_config.tenbit_config         = false; // 10 bits address is not supported
+    conf.i2c_2_config.async_enabled         = true;
 
     // -------------------------------------------------------------------------
     // PWM config
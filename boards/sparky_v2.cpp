@@ -107,8 +107,8 @@ Sparky_v2::Sparky_v2(conf_t config):
     nss_2_gpio_(config.nss_gpio_config[1]),
     nss_3_gpio_(config.nss_gpio_config[2]),
     state_display_sparky_v2_(led_stat_, led_err_),
-    mpu_9250_(spi_1_, nss_1_gpio_),
-    imu_(mpu_9250_, mpu_9250_, mpu_9250_, config.imu_config)
+    mpu_9250_(spi_1_, nss_1_gpio_, config.mpu_9250_config),
+    imu_(mpu_9250_, mpu_9250_, mpu_9250_, mpu_9250_, config.imu_config)
 {}
 
 
@@ -105,6 +105,7 @@ public:
         gpio_stm32_conf_t           led_rf_gpio_config;         ///< Rf led GPIO configuration
         gpio_stm32_conf_t           nss_gpio_config[3];         ///< Slave Select configuration
         imu_conf_t                  imu_config;                 ///< IMU configuration
+        Mpu_9250::conf_t            mpu_9250_config;            ///< MPU 9250 configuration
         Pwm_stm32::config_t         pwm_config[PWM_COUNT];      ///< PWM configuration
         serial_stm32_conf_t         serial_1_config;            ///< Serial configuration
         Serial_usb_stm32::conf_t    serial_usb_config;          ///< Serial USB configuration
@@ -196,6 +197,11 @@ Sparky_v2::conf_t Sparky_v2::default_config()
     // Imu config
     // -------------------------------------------------------------------------
     conf.imu_config = imu_default_config();
+
+    // Sensor data is read by DMA, one control cycle ahead
+    conf.mpu_9250_config                    = Mpu_9250::mpu_9250_default_config();
+    conf.mpu_9250_config.prefetch_enabled   = true;
+
     // Accelerometer
 
     // Axis and sign
@@ -451,6 +457,8 @@ Sparky_v2::conf_t Sparky_v2::default_config()
     conf.spi_config[0].sck_gpio_config.pull     = GPIO_PULL_UPDOWN_UP;
     conf.spi_config[0].sck_gpio_config.alt_fct  = GPIO_STM32_AF_5;
 
+    conf.spi_config[0].dma_enabled              = true;
+
     // SPI 1 slave select config
     conf.nss_gpio_config[0].port                   = GPIO_STM32_PORT_C;
     conf.nss_gpio_config[0].pin                    = GPIO_STM32_PIN_4;
@@ -481,6 +489,8 @@ Sparky_v2::conf_t Sparky_v2::default_config()
     conf.spi_config[1].sck_gpio_config.pull     = GPIO_PULL_UPDOWN_DOWN;
     conf.spi_config[1].sck_gpio_config.alt_fct  = GPIO_STM32_AF_6;
 
+    conf.spi_config[1].dma_enabled              = false;
+
     // SPI 3 slaves select config
     conf.nss_gpio_config[1].port                   = GPIO_STM32_PORT_A;
     conf.nss_gpio_config[1].pin                    = GPIO_STM32_PIN_15;
@@ -113,7 +113,7 @@ void Mavlink_waypoint_handler::send_home_waypoint()
 {
     local_position_t local_pos = home_waypoint_.local_pos();
     global_position_t global_pos;
-    coord_conventions_local_to_global_position(local_pos, INS::origin(), global_pos);
+    INS::projection().local_to_global(local_pos, global_pos);
 
     float surface_norm[4];
 
@@ -134,6 +134,108 @@ void Mavlink_waypoint_handler::send_home_waypoint()
     mavlink_stream_.send(&msg);
 }
 
+void Mavlink_waypoint_handler::send_mission_request(const mavlink_message_t* msg, uint16_t seq)
+{
+    mavlink_message_t _msg;
+    mavlink_msg_mission_request_pack(mavlink_stream_.sysid(),
+                                     mavlink_stream_.compid(),
+                                     &_msg,
+                                     msg->sysid,
+                                     msg->compid,
+                                     seq);
+    mavlink_stream_.send(&_msg);
+
+    print_util_dbg_print("[Mavlink_waypoint_handler] Asking for waypoint ");
+    print_util_dbg_print_num(seq, 10);
+    print_util_dbg_print("\r\n");
+}
+
+void Mavlink_waypoint_handler::send_mission_ack(const mavlink_message_t* msg, MAV_MISSION_RESULT type)
+{
+    mavlink_message_t _msg;
+    mavlink_msg_mission_ack_pack(mavlink_stream_.sysid(),
+                                 mavlink_stream_.compid(),
+                                 &_msg,
+                                 msg->sysid,
+                                 msg->compid,
+                                 type);
+    mavlink_stream_.send(&_msg);
+}
+
+void Mavlink_waypoint_handler::receive_waypoint(const mavlink_message_t* msg, uint16_t seq, const Waypoint& waypoint)
+{
+    print_util_dbg_print("[Mavlink_waypoint_handler] New waypoint received. expected num :");
+    print_util_dbg_print_num(upload_received_count_, 10);
+    print_util_dbg_print(" receiving num :");
+    print_util_dbg_print_num(seq, 10);
+    print_util_dbg_print("\r\n");
+
+    // Waypoint already received (duplicate due to retransmission)
+    if (seq < upload_received_count_)
+    {
+        return;
+    }
+
+    // Check if this waypoint was requested
+    if (seq >= requested_waypoint_count_ || seq >= upload_next_request_)
+    {
+        send_mission_ack(msg, MAV_MISSION_INVALID_SEQUENCE);
+        return;
+    }
+
+    // Check if we know what the waypoint is
+    if (mission_handler_registry_.get_mission_handler(waypoint) == NULL)
+    {
+        print_util_dbg_print("[Mavlink_waypoint_handler] Waypoint not registered in registry\r\n");
+        send_mission_ack(msg, MAV_MISSION_UNSUPPORTED);
+        return;
+    }
+
+    if (!mission_store_.write(seq, waypoint))
+    {
+        print_util_dbg_print("[Mavlink_waypoint_handler] Failed to store waypoint\r\n");
+        send_mission_ack(msg, MAV_MISSION_ERROR);
+        return;
+    }
+
+    // Mark waypoint as received, then slide the window over received waypoints
+    upload_window_mask_ |= (1UL << (seq - upload_received_count_));
+    while (upload_window_mask_ & 1UL)
+    {
+        upload_window_mask_ >>= 1;
+        upload_received_count_++;
+    }
+
+    if (upload_received_count_ == requested_waypoint_count_)
+    {
+        // The whole list is received, accept mission
+        mission_store_.set_count(requested_waypoint_count_);
+        current_waypoint_index_ = 0;
+
+        send_mission_ack(msg, MAV_MISSION_ACCEPTED);
+
+        print_util_dbg_print("[Mavlink_waypoint_handler] Flight plan received!\n");
+        waypoint_received_time_ms_ = time_keeper_get_ms();
+
+        send_home_waypoint();
+        return;
+    }
+
+    // Waypoints were received after one that is still missing: request the missing one again
+    if (upload_window_mask_ != 0)
+    {
+        send_mission_request(msg, upload_received_count_);
+    }
+
+    // Keep the window full
+    while (upload_next_request_ < requested_waypoint_count_ &&
+           upload_next_request_ < upload_received_count_ + config_.upload_window)
+    {
+        send_mission_request(msg, upload_next_request_);
+        upload_next_request_++;
+    }
+}
+
 void Mavlink_waypoint_handler::request_list_callback(Mavlink_waypoint_handler* waypoint_handler, uint32_t sysid, const mavlink_message_t* msg)
 {
     mavlink_mission_request_list_t packet;
@@ -150,11 +252,11 @@ void Mavlink_waypoint_handler::request_list_callback(Mavlink_waypoint_handler* w
                                        &_msg,
                                        msg->sysid,
                                        msg->compid,
-                                       waypoint_handler->waypoint_count_);
+                                       waypoint_handler->waypoint_count());
         waypoint_handler->mavlink_stream_.send(&_msg);
 
         print_util_dbg_print("[Mavlink_waypoint_handler] Will send ");
-        print_util_dbg_print_num(waypoint_handler->waypoint_count_, 10);
+        print_util_dbg_print_num(waypoint_handler->waypoint_count(), 10);
         print_util_dbg_print(" waypoints\r\n");
     }
 }
@@ -174,7 +276,9 @@ void Mavlink_waypoint_handler::mission_request_callback(Mavlink_waypoint_handler
             && ((uint8_t)packet.target_component == (uint8_t)MAV_COMP_ID_MISSIONPLANNER
             || (uint8_t)packet.target_component == 50)) // target_component = 50 is sent by dronekit
     {
-        if (packet.seq < waypoint_handler->waypoint_count_)
+        Waypoint waypoint;
+        if (packet.seq < waypoint_handler->waypoint_count() &&
+            waypoint_handler->mission_store_.read(packet.seq, waypoint))
         {
             uint8_t is_current = 0;
             if (    packet.seq == waypoint_handler->current_waypoint_index_)       // And we are en route
@@ -182,7 +286,7 @@ void Mavlink_waypoint_handler::mission_request_callback(Mavlink_waypoint_handler
                 is_current = 1;
             }
 
-            waypoint_handler->waypoint_list_[packet.seq].send(waypoint_handler->mavlink_stream_, sysid, msg, packet.seq, is_current);
+            waypoint.send(waypoint_handler->mavlink_stream_, sysid, msg, packet.seq, is_current);
 
             print_util_dbg_print("[Mavlink_waypoint_handler] Sending waypoint ");
             print_util_dbg_print_num(packet.seq, 10);
@@ -215,48 +319,41 @@ void Mavlink_waypoint_handler::mission_count_callback(Mavlink_waypoint_handler*
     if (((uint8_t)packet.target_system == (uint8_t)sysid)
             && ((uint8_t)packet.target_component == (uint8_t)MAV_COMP_ID_MISSIONPLANNER))
     {
-        // Erase current waypoint list
-        waypoint_handler->waypoint_count_ = 0;
-
-        // Save the number of waypoints GCS is about to send
-        if (packet.count > MAX_WAYPOINTS)
-        {
-            packet.count = MAX_WAYPOINTS;
-        }
-        waypoint_handler->requested_waypoint_count_ = packet.count;
-
         print_util_dbg_print("[Mavlink_waypoint_handler] Receiving ");
         print_util_dbg_print_num(packet.count, 10);
         print_util_dbg_print(" new waypoints.");
         print_util_dbg_print("\r\n");
 
-        if (waypoint_handler->requested_waypoint_count_ > 0) // Request first waypoint
+        // Reject lists that do not fit in the store
+        if (packet.count > waypoint_handler->mission_store_.capacity())
         {
-            mavlink_message_t _msg;
-            mavlink_msg_mission_request_pack(sysid,
-                                             waypoint_handler->mavlink_stream_.compid(),
-                                             &_msg,
-                                             msg->sysid,
-                                             msg->compid,
-                                             0);
-            waypoint_handler->mavlink_stream_.send(&_msg);
-
-            print_util_dbg_print("[Mavlink_waypoint_handler] Asking for waypoint ");
-            print_util_dbg_print_num(0, 10);
-            print_util_dbg_print("\r\n");
+            print_util_dbg_print("[Mavlink_waypoint_handler] Not enough space to store the mission\r\n");
+            waypoint_handler->send_mission_ack(msg, MAV_MISSION_NO_SPACE);
+            return;
+        }
+
+        // Erase current waypoint list
+        waypoint_handler->mission_store_.set_count(0);
+        waypoint_handler->current_waypoint_index_ = 0;
+
+        // Save the number of waypoints GCS is about to send
+        waypoint_handler->requested_waypoint_count_ = packet.count;
+        waypoint_handler->upload_received_count_    = 0;
+        waypoint_handler->upload_next_request_      = 0;
+        waypoint_handler->upload_window_mask_       = 0;
+
+        if (waypoint_handler->requested_waypoint_count_ > 0) // Request the first waypoints
+        {
+            while (waypoint_handler->upload_next_request_ < waypoint_handler->requested_waypoint_count_ &&
+                   waypoint_handler->upload_next_request_ < waypoint_handler->config_.upload_window)
+            {
+                waypoint_handler->send_mission_request(msg, waypoint_handler->upload_next_request_);
+                waypoint_handler->upload_next_request_++;
+            }
         }
         else // Acknowledge empty waypoint list
         {
-            MAV_MISSION_RESULT type = MAV_MISSION_ACCEPTED;
-
-            mavlink_message_t _msg;
-            mavlink_msg_mission_ack_pack(waypoint_handler->mavlink_stream_.sysid(),
-                                         waypoint_handler->mavlink_stream_.compid(),
-                                         &_msg,
-                                         msg->sysid,
-                                         msg->compid,
-                                         type);
-            waypoint_handler->mavlink_stream_.send(&_msg);
+            waypoint_handler->send_mission_ack(msg, MAV_MISSION_ACCEPTED);
 
             print_util_dbg_print("[Mavlink_waypoint_handler] Flight plan received!\n");
             waypoint_handler->waypoint_received_time_ms_ = time_keeper_get_ms();
@@ -277,94 +374,23 @@ void Mavlink_waypoint_handler::mission_item_callback(Mavlink_waypoint_handler* w
             && ((uint8_t)packet.target_component == (uint8_t)MAV_COMP_ID_MISSIONPLANNER))
     {
         Waypoint new_waypoint(packet);
+        waypoint_handler->receive_waypoint(msg, packet.seq, new_waypoint);
+    }
+}
 
-        print_util_dbg_print("[Mavlink_waypoint_handler] New waypoint received. requested num :");
-        print_util_dbg_print_num(waypoint_handler->waypoint_count_, 10);
-        print_util_dbg_print(" receiving num :");
-        print_util_dbg_print_num(packet.seq, 10);
-        print_util_dbg_print("\r\n");
+void Mavlink_waypoint_handler::mission_item_int_callback(Mavlink_waypoint_handler* waypoint_handler, uint32_t sysid, const mavlink_message_t* msg)
+{
+    mavlink_mission_item_int_t packet;
 
-        // Check if this is the requested waypoint
-        if (packet.seq == waypoint_handler->waypoint_count_)
-        {
-            // Check if we know what the waypoint is
-            if (waypoint_handler->mission_handler_registry_.get_mission_handler(new_waypoint) != NULL)
-            {
-                print_util_dbg_print("[Mavlink_waypoint_handler] Receiving good waypoint, number ");
-                print_util_dbg_print_num(waypoint_handler->waypoint_count_, 10);
-                print_util_dbg_print(" of ");
-                print_util_dbg_print_num(waypoint_handler->requested_waypoint_count_, 10);
-                print_util_dbg_print("\r\n");
-
-                // Set waypoint and increment
-                waypoint_handler->waypoint_list_[waypoint_handler->waypoint_count_] = new_waypoint;
-                waypoint_handler->waypoint_count_++;
-
-                if (waypoint_handler->waypoint_count_ == waypoint_handler->requested_waypoint_count_ || // If we have finished the list...
-                    waypoint_handler->waypoint_count_ == MAX_WAYPOINTS)                                 // or we have reached max waypoint capacity...
-                {                                                                                       // then accept mission
-                    MAV_MISSION_RESULT type = MAV_MISSION_ACCEPTED;
-
-                    mavlink_message_t _msg;
-                    mavlink_msg_mission_ack_pack(waypoint_handler->mavlink_stream_.sysid(),
-                                                 waypoint_handler->mavlink_stream_.compid(),
-                                                 &_msg,
-                                                 msg->sysid,
-                                                 msg->compid,
-                                                 type);
-                    waypoint_handler->mavlink_stream_.send(&_msg);
-
-                    print_util_dbg_print("[Mavlink_waypoint_handler] Flight plan received!\n");
-                    waypoint_handler->waypoint_received_time_ms_ = time_keeper_get_ms();
-
-                    waypoint_handler->send_home_waypoint();
-                }
-                else
-                {
-                    mavlink_message_t _msg;
-                    mavlink_msg_mission_request_pack(waypoint_handler->mavlink_stream_.sysid(),
-                                                     waypoint_handler->mavlink_stream_.compid(),
-                                                     &_msg,
-                                                     msg->sysid,
-                                                     msg->compid,
-                                                     waypoint_handler->waypoint_count_);
-                    waypoint_handler->mavlink_stream_.send(&_msg);
-
-                    print_util_dbg_print("[Mavlink_waypoint_handler] Asking for waypoint ");
-                    print_util_dbg_print_num(waypoint_handler->waypoint_count_, 10);
-                    print_util_dbg_print("\n");
-                }
-            }
-            else    // No mission handler registered in registry
-            {
-                print_util_dbg_print("[Mavlink_waypoint_handler] Waypoint not registered in registry\r\n");
-                MAV_MISSION_RESULT type = MAV_MISSION_UNSUPPORTED;
-
-                mavlink_message_t _msg;
-                mavlink_msg_mission_ack_pack(waypoint_handler->mavlink_stream_.sysid(),
-                                             waypoint_handler->mavlink_stream_.compid(),
-                                             &_msg,
-                                             msg->sysid,
-                                             msg->compid,
-                                             type);
-                waypoint_handler->mavlink_stream_.send(&_msg);
-            }
+    mavlink_msg_mission_item_int_decode(msg, &packet);
 
-        } //end of if (packet.seq == waypoint_handler->waypoint_count_)
-        else
-        {
-            MAV_MISSION_RESULT type = MAV_MISSION_INVALID_SEQUENCE;
-
-            mavlink_message_t _msg;
-            mavlink_msg_mission_ack_pack(waypoint_handler->mavlink_stream_.sysid(),
-                                         waypoint_handler->mavlink_stream_.compid(),
-                                         &_msg,
-                                         msg->sysid,
-                                         msg->compid,
-                                         type);
-            waypoint_handler->mavlink_stream_.send(&_msg);
-        }
-    } //end of if this message is for this system and subsystem
+    // Check if this message is for this system and subsystem
+    if (((uint8_t)packet.target_system == (uint8_t)sysid)
+            && ((uint8_t)packet.target_component == (uint8_t)MAV_COMP_ID_MISSIONPLANNER))
+    {
+        Waypoint new_waypoint(packet);
+        waypoint_handler->receive_waypoint(msg, packet.seq, new_waypoint);
+    }
 }
 
 void Mavlink_waypoint_handler::mission_clear_all_callback(Mavlink_waypoint_handler* waypoint_handler, uint32_t sysid, const mavlink_message_t* msg)
@@ -377,7 +403,8 @@ void Mavlink_waypoint_handler::mission_clear_all_callback(Mavlink_waypoint_handl
     if (((uint8_t)packet.target_system == (uint8_t)sysid)
             && ((uint8_t)packet.target_component == (uint8_t)MAV_COMP_ID_MISSIONPLANNER))
     {
-        waypoint_handler->waypoint_count_ = 0;
+        waypoint_handler->mission_store_.set_count(0);
+        waypoint_handler->current_waypoint_index_ = 0;
 
         mavlink_message_t _msg;
         mavlink_msg_mission_ack_pack(waypoint_handler->mavlink_stream_.sysid(),
@@ -401,8 +428,9 @@ Mavlink_waypoint_handler::Mavlink_waypoint_handler( const INS& ins,
                                                     Mavlink_message_handler& message_handler,
                                                     const Mavlink_stream& mavlink_stream,
                                                     Mission_handler_registry& mission_handler_registry,
+                                                    Mission_store& mission_store,
                                                     conf_t config):
-    waypoint_count_(0),
+    mission_store_(mission_store),
     current_waypoint_index_(0),
     mavlink_stream_(mavlink_stream),
     ins_(ins),
@@ -410,12 +438,20 @@ Mavlink_waypoint_handler::Mavlink_waypoint_handler( const INS& ins,
     mission_handler_registry_(mission_handler_registry),
     waypoint_received_time_ms_(0),
     requested_waypoint_count_(0),
+    upload_received_count_(0),
+    upload_next_request_(0),
+    upload_window_mask_(0),
     timeout_max_waypoint_(10000),
     config_(config)
 {
-    for (int i = 0; i < MAX_WAYPOINTS; i++)
+    // The window is tracked by a 32 bits mask
+    if (config_.upload_window == 0)
+    {
+        config_.upload_window = 1;
+    }
+    else if (config_.upload_window > MAX_UPLOAD_WINDOW)
     {
-        waypoint_list_[i] = Waypoint();
+        config_.upload_window = MAX_UPLOAD_WINDOW;
     }
 
     home_waypoint_ = Waypoint(  MAV_FRAME_LOCAL_NED,
@@ -434,6 +470,9 @@ bool Mavlink_waypoint_handler::init()
 {
     bool init_success = true;
 
+    // Load stored mission
+    init_success &= mission_store_.init();
+
     // Add message callbacks for waypoint handler messages requests
     init_success &= message_handler_.add_msg_callback(  MAVLINK_MSG_ID_MISSION_ITEM, // 39
                                                         MAVLINK_BASE_STATION_ID,
@@ -471,6 +510,12 @@ bool Mavlink_waypoint_handler::init()
                                                         &mission_ack_callback,
                                                         this );
 
+    init_success &= message_handler_.add_msg_callback(  MAVLINK_MSG_ID_MISSION_ITEM_INT, // 73
+                                                        MAVLINK_BASE_STATION_ID,
+                                                        MAV_COMP_ID_ALL,
+                                                        &mission_item_int_callback,
+                                                        this );
+
     // Add command callbacks for waypoint handler messages requests
     init_success &= message_handler_.add_cmd_callback(  MAV_CMD_DO_SET_HOME, // 179
                                                         MAVLINK_BASE_STATION_ID,
@@ -491,68 +536,51 @@ bool Mavlink_waypoint_handler::init()
 
 const Waypoint& Mavlink_waypoint_handler::current_waypoint() const
 {
-    // If there are no waypoints set, go to home
-    if (waypoint_count_ == 0)
+    // If there are no waypoints set, or if it is not a good index, go to home
+    if (current_waypoint_index_ >= waypoint_count() ||
+        !mission_store_.read(current_waypoint_index_, current_waypoint_))
     {
         return home_waypoint();
     }
 
-    // If it is a good index
-    if (current_waypoint_index_ >= 0 && current_waypoint_index_ < waypoint_count_)
-    {
-        return waypoint_list_[current_waypoint_index_];
-    }
-    else
-    {
-        // For now, set to home
-        return home_waypoint();
-    }
+    return current_waypoint_;
 }
 
 const Waypoint& Mavlink_waypoint_handler::next_waypoint() const
 {
-    // If there are no waypoints set, go to home
-    if (waypoint_count_ == 0)
+    uint16_t count = waypoint_count();
+
+    // If there are no waypoints set, or if it is not a good index, go to home
+    if (current_waypoint_index_ >= count)
     {
         return home_waypoint();
     }
 
-    // If it is a good index
-    if (current_waypoint_index_ >= 0 && current_waypoint_index_ < waypoint_count_)
+    // Check if the next waypoint exists, otherwise set to first
+    uint16_t next_index = current_waypoint_index_ + 1;
+    if (next_index == count)
     {
-        // Check if the next waypoint exists
-        if ((current_waypoint_index_ + 1) != waypoint_count_)
-        {
-            return waypoint_list_[current_waypoint_index_ + 1];
-        }
-        else // No next waypoint, set to first
-        {
-            return waypoint_list_[0];
-        }
+        next_index = 0;
     }
-    else
+
+    if (!mission_store_.read(next_index, next_waypoint_))
     {
-        // For now, set to home
         return home_waypoint();
     }
+
+    return next_waypoint_;
 }
 
 const Waypoint& Mavlink_waypoint_handler::waypoint_from_index(int i) const
 {
-    // If there are no waypoints set, go to home
-    if (waypoint_count_ == 0)
+    // If there are no waypoints set, or if it is not a good index, go to home
+    if (i < 0 || i >= waypoint_count() ||
+        !mission_store_.read(i, indexed_waypoint_))
     {
         return home_waypoint();
     }
 
-    if (i >= 0 && i < waypoint_count_)
-    {
-        return waypoint_list_[i];
-    }
-    else
-    {
-        return home_waypoint();
-    }
+    return indexed_waypoint_;
 }
 
 const Waypoint& Mavlink_waypoint_handler::home_waypoint() const
@@ -563,7 +591,7 @@ const Waypoint& Mavlink_waypoint_handler::home_waypoint() const
 void Mavlink_waypoint_handler::advance_to_next_waypoint()
 {
     // If the current waypoint index is the last waypoint, go to first waypoint
-    if (current_waypoint_index_ == (waypoint_count_-1))
+    if (current_waypoint_index_ == (waypoint_count()-1))
     {
         set_current_waypoint_index(0);
     }
@@ -580,10 +608,14 @@ uint16_t Mavlink_waypoint_handler::current_waypoint_index() const
 
 bool Mavlink_waypoint_handler::set_current_waypoint_index(int index)
 {
-    if (index >= 0 && index < waypoint_count_)
+    if (index >= 0 && index < waypoint_count())
     {
         current_waypoint_index_ = index;
 
+        // Bring the current and next waypoints in memory before they are used by the navigation
+        current_waypoint();
+        next_waypoint();
+
         print_util_dbg_print("[Mavlink_waypoint_handler] Set current waypoint to number");
         print_util_dbg_print_num(index, 10);
         print_util_dbg_print("\r\n");
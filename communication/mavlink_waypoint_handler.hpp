@@ -48,11 +48,10 @@
 #include "communication/mavlink_stream.hpp"
 #include "communication/mavlink_message_handler.hpp"
 #include "mission/mission_handler_registry.hpp"
+#include "mission/mission_store.hpp"
 #include "mission/waypoint.hpp"
 #include "sensing/ins.hpp"
 
-#define MAX_WAYPOINTS 10        ///< The maximal size of the waypoint list
-
 /*
  * N.B.: Reference Frames and MAV_CMD_NAV are defined in "maveric.h"
  */
@@ -61,9 +60,12 @@ class Mavlink_waypoint_handler
 {
 public:
 
+    static const uint16_t MAX_UPLOAD_WINDOW = 32;      ///< Maximum number of waypoints requested in advance during upload
+
     struct conf_t
     {
         float home_altitude;
+        uint16_t upload_window;                         ///< Number of waypoints requested in advance during upload (max MAX_UPLOAD_WINDOW)
     };
 
 
@@ -74,6 +76,7 @@ public:
      * \param   message_handler             The reference to the message handler
      * \param   mavlink_stream              The reference to the MAVLink stream structure
      * \param   mission_handler_registry    The reference to the mission handler registry
+     * \param   mission_store               The reference to the storage of the waypoints
      * \param   config                      The config structure (optional)
      *
      * \return  True if the init succeed, false otherwise
@@ -82,6 +85,7 @@ public:
                                 Mavlink_message_handler& message_handler,
                                 const Mavlink_stream& mavlink_stream,
                                 Mission_handler_registry& mission_handler_registry,
+                                Mission_store& mission_store,
                                 conf_t config = default_config());
 
     bool init();
@@ -91,7 +95,7 @@ public:
      *
      * \return  number of waypoints
      */
-    inline uint16_t waypoint_count() const {return waypoint_count_;};
+    inline uint16_t waypoint_count() const {return mission_store_.count();};
 
     /**
      * \brief   Returns the time that the waypoint list was received
@@ -133,7 +137,9 @@ public:
      * \details If there is no waypoints in the list, creates a hold position
      *          waypoint as the first index in the list and returns it
      *
-     * \return  waypoint_list_[i]
+     * \details The returned reference is valid until the next call to this function
+     *
+     * \return  waypoint i
      */
     const Waypoint& waypoint_from_index(int i) const;
 
@@ -171,10 +177,13 @@ public:
     bool set_current_waypoint_index(int index);
 
 protected:
-    Waypoint waypoint_list_[MAX_WAYPOINTS];                     ///< The array of all waypoints (max MAX_WAYPOINTS)
-    uint16_t waypoint_count_;                                   ///< The total number of waypoints
+    Mission_store& mission_store_;                              ///< The storage of the waypoints
     uint16_t current_waypoint_index_;                           ///< The current waypoint index
 
+    mutable Waypoint current_waypoint_;                         ///< Copy of the current waypoint read from the store
+    mutable Waypoint next_waypoint_;                            ///< Copy of the next waypoint read from the store
+    mutable Waypoint indexed_waypoint_;                         ///< Copy of the last waypoint read by index
+
     Waypoint home_waypoint_;                                    ///< The home waypoint
 
     const Mavlink_stream& mavlink_stream_;                      ///< The reference to MAVLink stream object
@@ -185,6 +194,9 @@ private:
     uint64_t waypoint_received_time_ms_;                        ///< The time that the waypoint list was received
 
     uint16_t requested_waypoint_count_;                         ///< The number of waypoints requested from the GCS
+    uint16_t upload_received_count_;                            ///< Number of waypoints received in sequence since the beginning of the upload
+    uint16_t upload_next_request_;                              ///< Index of the next waypoint to request
+    uint32_t upload_window_mask_;                               ///< Waypoints received ahead of upload_received_count_ (bit i for upload_received_count_ + i)
 
     uint32_t timeout_max_waypoint_;                             ///< The max waiting time for communication
 
@@ -195,6 +207,37 @@ private:
      */
     void send_home_waypoint();
 
+    /**
+     * \brief   Sends a mission request for a waypoint
+     *
+     * \param   msg         The received MAVLink message, used to reply to its sender
+     * \param   seq         Index of the requested waypoint
+     */
+    void send_mission_request(const mavlink_message_t* msg, uint16_t seq);
+
+    /**
+     * \brief   Sends a mission acknowledgement
+     *
+     * \param   msg         The received MAVLink message, used to reply to its sender
+     * \param   type        Result of the mission transfer
+     */
+    void send_mission_ack(const mavlink_message_t* msg, MAV_MISSION_RESULT type);
+
+    /**
+     * \brief   Stores a waypoint received during upload and requests the following ones
+     *
+     * \details Up to upload_window waypoints are requested in advance, so that
+     *          the upload is not limited by the round trip time of the link.
+     *          Waypoints may arrive out of order within the window. While
+     *          waypoints are held after a missing one, the missing one is
+     *          requested again
+     *
+     * \param   msg         The received MAVLink message
+     * \param   seq         Index of the waypoint
+     * \param   waypoint    Received waypoint
+     */
+    void receive_waypoint(const mavlink_message_t* msg, uint16_t seq, const Waypoint& waypoint);
+
     /************************************************
      *      static member functions (callbacks)     *
      ************************************************/
@@ -254,6 +297,15 @@ private:
      */
     static void mission_item_callback(Mavlink_waypoint_handler* waypoint_handler, uint32_t sysid, const mavlink_message_t* msg);
 
+    /**
+     * \brief   Receives a given waypoint with integer coordinates and stores it in the local structure
+     *
+     * \param   waypoint_handler        The pointer to the waypoint handler structure
+     * \param   sysid                   The system ID
+     * \param   msg                     The received MAVLink message structure with the waypoint
+     */
+    static void mission_item_int_callback(Mavlink_waypoint_handler* waypoint_handler, uint32_t sysid, const mavlink_message_t* msg);
+
     /**
      * \brief   Clears the waypoint list
      *
@@ -270,6 +322,7 @@ Mavlink_waypoint_handler::conf_t Mavlink_waypoint_handler::default_config()
     conf_t conf                                                = {};
 
     conf.home_altitude                                         = -10.0f;
+    conf.upload_window                                         = 8;
 
     return conf;
 };
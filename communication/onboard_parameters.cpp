@@ -125,7 +125,9 @@ bool Onboard_parameters::add(uint32_t* val, const char* param_name)
         }
         else
         {
-            print_util_dbg_print("[ONBOARD PARAMETER] Error: Cannot add more param\r\n");
+            print_util_dbg_print("[ONBOARD PARAMETER] Error: Cannot add more param, ");
+            print_util_dbg_print(param_name);
+            print_util_dbg_log_value(" dropped, max count is", max_count(), 10);
 
             add_success &= false;
         }
@@ -172,7 +174,9 @@ bool Onboard_parameters::add(int32_t* val, const char* param_name)
         }
         else
         {
-            print_util_dbg_print("[ONBOARD PARAMETER] Error: Cannot add more param\r\n");
+            print_util_dbg_print("[ONBOARD PARAMETER] Error: Cannot add more param, ");
+            print_util_dbg_print(param_name);
+            print_util_dbg_log_value(" dropped, max count is", max_count(), 10);
 
             add_success &= false;
         }
@@ -219,7 +223,9 @@ bool Onboard_parameters::add(float* val, const char* param_name)
         }
         else
         {
-            print_util_dbg_print("[ONBOARD PARAMETER] Error: Cannot add more param\r\n");
+            print_util_dbg_print("[ONBOARD PARAMETER] Error: Cannot add more param, ");
+            print_util_dbg_print(param_name);
+            print_util_dbg_log_value(" dropped, max count is", max_count(), 10);
 
             add_success &= false;
         }
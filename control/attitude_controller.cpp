@@ -49,7 +49,7 @@
  ******************************************************************************/
 
 #include "control/attitude_controller.hpp"
-#include "hal/common/time_keeper.hpp"
+#include "runtime/cycle_clock.hpp"
 
 //------------------------------------------------------------------------------
 // PUBLIC FUNCTIONS IMPLEMENTATION
@@ -67,6 +67,7 @@ Attitude_controller::Attitude_controller(const args_t& args, const conf_t& confi
     attitude_command_.v[X]  = 0.0f;
     attitude_command_.v[Y]  = 0.0f;
     attitude_command_.v[Z]  = 0.0f;
+    attitude_command_.rate  = std::array<float,3>{{0.0f, 0.0f, 0.0f}};
 
     // set initial rate command
     rate_command_.xyz[X]  = 0.0f;
@@ -74,9 +75,7 @@ Attitude_controller::Attitude_controller(const args_t& args, const conf_t& confi
     rate_command_.xyz[Z]  = 0.0f;
 
     // Init rate gains
-    pid_controller_init(&pid_[ROLL],  &config.pid_config[ROLL]);
-    pid_controller_init(&pid_[PITCH], &config.pid_config[PITCH]);
-    pid_controller_init(&pid_[YAW],   &config.pid_config[YAW]);
+    pid_.init(config.pid_config);
 
     // Init attitude error estimator
     attitude_error_estimator_init(&attitude_error_estimator_, &ahrs_);
@@ -85,7 +84,7 @@ Attitude_controller::Attitude_controller(const args_t& args, const conf_t& confi
 
 bool Attitude_controller::update(void)
 {
-    float now      = time_keeper_get_s();
+    float now      = Cycle_clock::now_s();
     dt_s_          = now - last_update_s_;
     last_update_s_ = now;
 
@@ -100,10 +99,11 @@ bool Attitude_controller::update(void)
     errors[PITCH]   = attitude_error_estimator_.rpy_errors[PITCH];
     errors[YAW]     = attitude_error_estimator_.rpy_errors[YAW];
 
-    // Update PIDs
-    rate_command_.xyz[ROLL]  = pid_controller_update_dt(&pid_[ROLL],  errors[ROLL],  dt_s_);
-    rate_command_.xyz[PITCH] = pid_controller_update_dt(&pid_[PITCH], errors[PITCH], dt_s_);
-    rate_command_.xyz[YAW]   = pid_controller_update_dt(&pid_[YAW],   errors[YAW],   dt_s_);
+    // Update PIDs and add rate feed-forward
+    pid_.update(errors, dt_s_, rate_command_.xyz.data());
+    rate_command_.xyz[ROLL]  += attitude_command_.rate[ROLL];
+    rate_command_.xyz[PITCH] += attitude_command_.rate[PITCH];
+    rate_command_.xyz[YAW]   += attitude_command_.rate[YAW];
 
     return true;
 }
@@ -130,19 +130,7 @@ bool Attitude_controller::get_output(rate_command_t& command) const
 }
 
 
-pid_controller_t& Attitude_controller::get_pid_X(void)
+Pid_controller_T<3>& Attitude_controller::get_pid(void)
 {
-    return pid_[X];
-}
-
-
-pid_controller_t& Attitude_controller::get_pid_Y(void)
-{
-    return pid_[Y];
-}
-
-
-pid_controller_t& Attitude_controller::get_pid_Z(void)
-{
-    return pid_[Z];
+    return pid_;
 }
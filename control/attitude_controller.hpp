@@ -142,11 +142,9 @@ public:
     /**
      * \brief   Gives acces to internal pid_controller
      *
-     * \return  pid     reference to pid controller
+     * \return  pid     reference to the pid controller of the 3 axes
      */
-    pid_controller_t& get_pid_X(void);
-    pid_controller_t& get_pid_Y(void);
-    pid_controller_t& get_pid_Z(void);
+    Pid_controller_T<3>& get_pid(void);
 
 
 protected:
@@ -155,7 +153,7 @@ protected:
     rate_command_t&             rate_command_;               ///< Reference to rate command (output)
 
     attitude_error_estimator_t  attitude_error_estimator_;   ///< Attitude error estimator
-    pid_controller_t            pid_[3];                     ///< Attitude PID controller for roll, pitch and yaw
+    Pid_controller_T<3>         pid_;                        ///< Attitude PID controller for roll, pitch and yaw
     float                       dt_s_;                       ///< The time interval between two updates
     float                       last_update_s_;              ///< The time of the last update in s
 };
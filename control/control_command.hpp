@@ -66,28 +66,86 @@ typedef enum
 
 /**
  * \brief   Velocity command structure
+ *
+ * \details The feed-forward is optional: it is zero when the command is
+ *          default constructed or built from only the velocity and heading
  */
-typedef struct
+struct velocity_command_t
 {
     local_velocity_t xyz;           ///<    Velocity on X, Y and Z axis (NED frame)
     float heading;                  ///<    Heading (can be ignored for fixed wing)
-} velocity_command_t;
+    std::array<float,3> acc;        ///<    Acceleration feed-forward (NED frame, m/s^2)
+
+    velocity_command_t(void):
+        xyz{{0.0f, 0.0f, 0.0f}},
+        heading(0.0f),
+        acc{{0.0f, 0.0f, 0.0f}}
+    {}
+
+    velocity_command_t(const local_velocity_t& xyz, float heading):
+        xyz(xyz),
+        heading(heading),
+        acc{{0.0f, 0.0f, 0.0f}}
+    {}
+};
 
 
 /**
  * \brief   Position command structure
+ *
+ * \details The feed-forward is optional: it is zero when the command is
+ *          default constructed or built from only the position and heading
  */
-typedef struct
+struct position_command_t
 {
     local_position_t xyz;       ///<    Position in NED frame
     float heading;              ///<    Heading (can be ignored for fixed wing)
-} position_command_t;
+    local_velocity_t vel;       ///<    Velocity feed-forward (NED frame, m/s)
+    std::array<float,3> acc;    ///<    Acceleration feed-forward (NED frame, m/s^2)
+
+    position_command_t(void):
+        xyz{{0.0f, 0.0f, 0.0f}},
+        heading(0.0f),
+        vel{{0.0f, 0.0f, 0.0f}},
+        acc{{0.0f, 0.0f, 0.0f}}
+    {}
+
+    position_command_t(const local_position_t& xyz, float heading):
+        xyz(xyz),
+        heading(heading),
+        vel{{0.0f, 0.0f, 0.0f}},
+        acc{{0.0f, 0.0f, 0.0f}}
+    {}
+
+    position_command_t(const local_position_t& xyz, float heading, const local_velocity_t& vel, const std::array<float,3>& acc):
+        xyz(xyz),
+        heading(heading),
+        vel(vel),
+        acc(acc)
+    {}
+};
 
 
 /**
  * \brief   Attitude command structure
+ *
+ * \details The attitude is the quaternion. The rate feed-forward is zero
+ *          when the command is built from a quaternion
  */
-typedef quat_t attitude_command_t;
+struct attitude_command_t: public quat_t
+{
+    std::array<float,3> rate;   ///<    Angular rate feed-forward (body frame, rad/s)
+
+    attitude_command_t(void):
+        quat_t{1.0f, {0.0f, 0.0f, 0.0f}},
+        rate{{0.0f, 0.0f, 0.0f}}
+    {}
+
+    attitude_command_t(const quat_t& quat):
+        quat_t(quat),
+        rate{{0.0f, 0.0f, 0.0f}}
+    {}
+};
 
 
 /**
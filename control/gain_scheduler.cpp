@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file gain_scheduler.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Scheduling of the rate and attitude controller gains over the
+ *          flight envelope
+ *
+ ******************************************************************************/
+
+
+#include "control/gain_scheduler.hpp"
+
+#include <cstring>
+
+extern "C"
+{
+#include "util/maths.h"
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Gain_scheduler::Gain_scheduler(const args_t& args, const conf_t& config):
+    ins_(args.ins),
+    battery_(args.battery),
+    mix_(args.mix),
+    rate_controller_(args.rate_controller),
+    attitude_controller_(args.attitude_controller),
+    rate_factor_(1.0f),
+    attitude_factor_(1.0f)
+{
+    set_config(config);
+}
+
+
+bool Gain_scheduler::set_config(const conf_t& config)
+{
+    bool success = true;
+
+    if (&config != &config_)
+    {
+        config_ = config;
+    }
+    applied_config_ = config_;
+
+    success &= precompute(applied_config_.airspeed, airspeed_);
+    success &= precompute(applied_config_.thrust,   thrust_);
+    success &= precompute(applied_config_.voltage,  voltage_);
+
+    return success;
+}
+
+
+bool Gain_scheduler::update(void)
+{
+    // Tables modified by parameters
+    if (memcmp(&config_, &applied_config_, sizeof(conf_t)) != 0)
+    {
+        set_config(config_);
+    }
+
+    // Scheduling variables
+    std::array<float, 3> velocity = ins_.velocity_lf();
+    float airspeed = maths_fast_sqrt(SQR(velocity[X]) + SQR(velocity[Y]));
+
+    thrust_command_t thrust_command;
+    mix_.get_command(thrust_command);
+    float thrust = - thrust_command.xyz[Z];
+
+    float voltage = battery_.voltage();
+
+    // Product of the factors of each table
+    float rate      = 0.0f;
+    float attitude  = 0.0f;
+    interpolate(airspeed_, airspeed, rate, attitude);
+    rate_factor_     = rate;
+    attitude_factor_ = attitude;
+
+    interpolate(thrust_, thrust, rate, attitude);
+    rate_factor_     *= rate;
+    attitude_factor_ *= attitude;
+
+    interpolate(voltage_, voltage, rate, attitude);
+    rate_factor_     *= rate;
+    attitude_factor_ *= attitude;
+
+    // Apply to controllers
+    Pid_controller_T<3>& rate_pid     = rate_controller_.get_pid();
+    Pid_controller_T<3>& attitude_pid = attitude_controller_.get_pid();
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        rate_pid.gain_scale[i]     = rate_factor_;
+        attitude_pid.gain_scale[i] = attitude_factor_;
+    }
+
+    return true;
+}
+
+
+bool Gain_scheduler::update_task(Gain_scheduler* scheduler)
+{
+    return scheduler->update();
+}
+
+
+float Gain_scheduler::rate_factor(void) const
+{
+    return rate_factor_;
+}
+
+
+float Gain_scheduler::attitude_factor(void) const
+{
+    return attitude_factor_;
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+bool Gain_scheduler::precompute(const table_t& table, interpolation_t& interpolation)
+{
+    bool success = (table.max > table.min);
+
+    interpolation.min      = table.min;
+    interpolation.inv_step = success ? ((TABLE_SIZE - 1) / (table.max - table.min)) : 0.0f;
+
+    for (uint32_t i = 0; i < TABLE_SIZE - 1; ++i)
+    {
+        interpolation.rate[i]           = table.rate[i];
+        interpolation.rate_slope[i]     = table.rate[i + 1] - table.rate[i];
+        interpolation.attitude[i]       = table.attitude[i];
+        interpolation.attitude_slope[i] = table.attitude[i + 1] - table.attitude[i];
+    }
+
+    return success;
+}
+
+
+void Gain_scheduler::interpolate(const interpolation_t& interpolation, float value, float& rate, float& attitude)
+{
+    // Position in the table, in number of cells
+    float position = (value - interpolation.min) * interpolation.inv_step;
+    position = maths_f_min(maths_f_max(position, 0.0f), TABLE_SIZE - 1);
+
+    uint32_t cell = (uint32_t)position;
+    if (cell > TABLE_SIZE - 2)
+    {
+        cell = TABLE_SIZE - 2;
+    }
+    float fraction = position - cell;
+
+    rate     = interpolation.rate[cell]     + fraction * interpolation.rate_slope[cell];
+    attitude = interpolation.attitude[cell] + fraction * interpolation.attitude_slope[cell];
+}
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file gain_scheduler.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Scheduling of the rate and attitude controller gains over the
+ *          flight envelope
+ *
+ * \details Gains are scaled by factors interpolated in tables indexed by
+ *          airspeed, collective thrust and battery voltage. Table points are
+ *          evenly spaced, so the cell is found from the value without search.
+ *          Slopes are precomputed when the configuration is applied, and
+ *          again when a table is modified through its onboard parameters.
+ *
+ ******************************************************************************/
+
+
+#ifndef GAIN_SCHEDULER_HPP_
+#define GAIN_SCHEDULER_HPP_
+
+#include <cstdint>
+#include <cstdbool>
+
+#include "control/rate_controller.hpp"
+#include "control/attitude_controller.hpp"
+#include "control/servos_mix.hpp"
+#include "drivers/battery.hpp"
+#include "sensing/ins.hpp"
+
+
+/**
+ * \brief   Gain scheduler for rate and attitude controllers
+ *
+ * \details The factors of the three tables are multiplied, and the product
+ *          is applied to the gain scale of the PID controllers on all axes.
+ *          The gain parameters are not modified, they remain the tuning at
+ *          factor 1. The airspeed is estimated by the norm of the horizontal
+ *          velocity from the INS.
+ */
+class Gain_scheduler
+{
+public:
+    static const uint32_t TABLE_SIZE = 5;       ///< Number of points per table
+
+    /**
+     * \brief   Table of gain factors on one scheduling variable
+     */
+    struct table_t
+    {
+        float min;                      ///< Value of the scheduling variable at the first point
+        float max;                      ///< Value of the scheduling variable at the last point
+        float rate[TABLE_SIZE];         ///< Factors on rate controller gains, at points evenly spaced from min to max
+        float attitude[TABLE_SIZE];     ///< Factors on attitude controller gains, at points evenly spaced from min to max
+    };
+
+    /**
+     * \brief   Configuration
+     */
+    struct conf_t
+    {
+        table_t airspeed;               ///< Table on airspeed (m/s)
+        table_t thrust;                 ///< Table on collective thrust command (-Z)
+        table_t voltage;                ///< Table on battery voltage (V)
+    };
+
+    /**
+     * \brief   Default configuration, with all factors equal to 1
+     *
+     * \return  Config structure
+     */
+    static inline conf_t default_config(void);
+
+    /**
+     * \brief   Required arguments
+     */
+    struct args_t
+    {
+        const INS&              ins;                ///< Velocity estimation (input)
+        const Battery&          battery;            ///< Battery voltage (input)
+        const Servos_mix&       mix;                ///< Servos mix, gives the thrust command (input)
+        Rate_controller&        rate_controller;    ///< Rate controller (output)
+        Attitude_controller&    attitude_controller;///< Attitude controller (output)
+    };
+
+    /**
+     * \brief   Constructor
+     *
+     * \param   args    Required arguments
+     * \param   config  Configuration
+     */
+    Gain_scheduler(const args_t& args, const conf_t& config = default_config());
+
+    /**
+     * \brief   Applies a new configuration and precomputes the tables
+     *
+     * \param   config  Configuration
+     *
+     * \return  false if a table has max <= min, the table is then flat at its first point
+     */
+    bool set_config(const conf_t& config);
+
+    /**
+     * \brief   Get configuration
+     *
+     * \details Tables modified through this reference are applied at the next update
+     *
+     * \return  Reference to configuration
+     */
+    conf_t& config(void)
+    {
+        return config_;
+    };
+
+    /**
+     * \brief   Main update function
+     *
+     * \return  success
+     */
+    bool update(void);
+
+    /**
+     * \brief   Task function
+     *
+     * \param   scheduler   Pointer to object
+     *
+     * \return  success
+     */
+    static bool update_task(Gain_scheduler* scheduler);
+
+    /**
+     * \brief   Current factor on rate controller gains
+     *
+     * \return  factor
+     */
+    float rate_factor(void) const;
+
+    /**
+     * \brief   Current factor on attitude controller gains
+     *
+     * \return  factor
+     */
+    float attitude_factor(void) const;
+
+private:
+    /**
+     * \brief   Table precomputed for interpolation
+     */
+    struct interpolation_t
+    {
+        float min;                              ///< Value of the scheduling variable at the first point
+        float inv_step;                         ///< Inverse of the spacing between points
+        float rate[TABLE_SIZE - 1];             ///< Rate factors at the start of each cell
+        float rate_slope[TABLE_SIZE - 1];       ///< Change of rate factor over each cell
+        float attitude[TABLE_SIZE - 1];         ///< Attitude factors at the start of each cell
+        float attitude_slope[TABLE_SIZE - 1];   ///< Change of attitude factor over each cell
+    };
+
+    /**
+     * \brief   Precomputes a table
+     *
+     * \param   table           Table from the configuration
+     * \param   interpolation   Precomputed table (output)
+     *
+     * \return  false if max <= min
+     */
+    static bool precompute(const table_t& table, interpolation_t& interpolation);
+
+    /**
+     * \brief   Interpolates a table, values outside the table are clamped
+     *
+     * \param   interpolation   Precomputed table
+     * \param   value           Value of the scheduling variable
+     * \param   rate            Factor on rate controller gains (output)
+     * \param   attitude        Factor on attitude controller gains (output)
+     */
+    static void interpolate(const interpolation_t& interpolation, float value, float& rate, float& attitude);
+
+    const INS&              ins_;                   ///< Velocity estimation (input)
+    const Battery&          battery_;               ///< Battery voltage (input)
+    const Servos_mix&       mix_;                   ///< Servos mix (input)
+    Rate_controller&        rate_controller_;       ///< Rate controller (output)
+    Attitude_controller&    attitude_controller_;   ///< Attitude controller (output)
+
+    conf_t                  config_;                ///< Configuration, tables are exposed as parameters
+    conf_t                  applied_config_;        ///< Configuration used for the precomputed tables
+
+    interpolation_t         airspeed_;              ///< Precomputed table on airspeed
+    interpolation_t         thrust_;                ///< Precomputed table on thrust
+    interpolation_t         voltage_;               ///< Precomputed table on battery voltage
+
+    float                   rate_factor_;           ///< Current factor on rate controller gains
+    float                   attitude_factor_;       ///< Current factor on attitude controller gains
+};
+
+
+Gain_scheduler::conf_t Gain_scheduler::default_config(void)
+{
+    conf_t conf = {};
+
+    conf.airspeed.min = 0.0f;
+    conf.airspeed.max = 20.0f;
+    conf.thrust.min   = 0.0f;
+    conf.thrust.max   = 1.0f;
+    conf.voltage.min  = 10.0f;
+    conf.voltage.max  = 12.6f;
+
+    for (uint32_t i = 0; i < TABLE_SIZE; ++i)
+    {
+        conf.airspeed.rate[i]     = 1.0f;
+        conf.airspeed.attitude[i] = 1.0f;
+        conf.thrust.rate[i]       = 1.0f;
+        conf.thrust.attitude[i]   = 1.0f;
+        conf.voltage.rate[i]      = 1.0f;
+        conf.voltage.attitude[i]  = 1.0f;
+    }
+
+    return conf;
+};
+
+
+#endif /* GAIN_SCHEDULER_HPP_ */
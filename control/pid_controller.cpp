@@ -41,7 +41,7 @@
 
 
 #include "control/pid_controller.hpp"
-#include "hal/common/time_keeper.hpp"
+#include "runtime/cycle_clock.hpp"
 
 extern "C"
 {
@@ -97,6 +97,19 @@ static void pid_controller_init_differenciator(differentiator_t* diff, float gai
 static float pid_controller_differentiate(differentiator_t* diff, float input,  float dt);
 
 
+/**
+ * \brief   Updates the controller with a time sampled by the caller
+ *
+ * \param   controller  Pointer to the PID controller structure
+ * \param   error       Error value
+ * \param   t           Time of the update in seconds
+ * \param   dt          Timestep
+ *
+ * \return  Controller output
+ */
+static float pid_controller_update_at(pid_controller_t* controller, float error, float t, float dt);
+
+
 //------------------------------------------------------------------------------
 // PRIVATE FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
@@ -143,13 +156,52 @@ static float pid_controller_differentiate(differentiator_t* diff, float input, f
 }
 
 
+static float pid_controller_update_at(pid_controller_t* controller, float error, float t, float dt)
+{
+    controller->error         = maths_soft_zone(error, controller->soft_zone_width);
+    controller->dt_s          = dt;
+    controller->last_update_s = t;
+
+    // Compute output with P and D terms (no integration yet)
+    controller->output        = controller->p_gain * controller->error
+                              + pid_controller_differentiate(&controller->differentiator, controller->error, controller->dt_s);
+
+    // do integration only if we are not saturated
+    if (controller->is_saturated == false)
+    {
+        controller->output += pid_controller_integrate(&controller->integrator, controller->error, controller->dt_s);
+    }
+    else
+    {
+        controller->output += controller->integrator.accumulator;
+    }
+
+    if (controller->output < controller->clip_min)
+    {
+        controller->output = controller->clip_min;
+        controller->is_saturated = true;
+    }
+    else if (controller->output > controller->clip_max)
+    {
+        controller->output = controller->clip_max;
+        controller->is_saturated = true;
+    }
+    else
+    {
+        controller->is_saturated = false;
+    }
+
+    return controller->output;
+}
+
+
 //------------------------------------------------------------------------------
 // PUBLIC FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
 
 bool pid_controller_init(pid_controller_t* controller, const pid_controller_conf_t* config)
 {
-    float t = time_keeper_get_s();
+    float t = Cycle_clock::now_s();
 
     controller->p_gain          = config->p_gain;
     controller->clip_min        = config->clip_min;
@@ -189,7 +241,7 @@ bool pid_controller_apply_config(pid_controller_t* controller, const pid_control
 
 void pid_controller_init_pass_through(pid_controller_t* controller)
 {
-    float t = time_keeper_get_s();
+    float t = Cycle_clock::now_s();
 
     controller->dt_s          = 1.0f;
     controller->last_update_s = t;
@@ -218,45 +270,12 @@ void pid_controller_reset_integrator(pid_controller_t* controller)
 
 float pid_controller_update(pid_controller_t* controller, float error)
 {
-    float dt = time_keeper_get_s() - controller->last_update_s;
-    return pid_controller_update_dt(controller, error, dt);
+    float t = Cycle_clock::now_s();
+    return pid_controller_update_at(controller, error, t, t - controller->last_update_s);
 }
 
 
 float pid_controller_update_dt(pid_controller_t* controller, float error, float dt)
 {
-    controller->error         = maths_soft_zone(error, controller->soft_zone_width);;
-    controller->dt_s          = dt;
-    controller->last_update_s = time_keeper_get_s();
-
-    // Compute output with P and D terms (no integration yet)
-    controller->output        = controller->p_gain * controller->error
-                              + pid_controller_differentiate(&controller->differentiator, controller->error, controller->dt_s);
-
-    // do integration only if we are not saturated
-    if (controller->is_saturated == false)
-    {
-        controller->output += pid_controller_integrate(&controller->integrator, controller->error, controller->dt_s);
-    }
-    else
-    {
-        controller->output += controller->integrator.accumulator;
-    }
-
-    if (controller->output < controller->clip_min)
-    {
-        controller->output = controller->clip_min;
-        controller->is_saturated = true;
-    }
-    else if (controller->output > controller->clip_max)
-    {
-        controller->output = controller->clip_max;
-        controller->is_saturated = true;
-    }
-    else
-    {
-        controller->is_saturated = false;
-    }
-
-    return controller->output;
+    return pid_controller_update_at(controller, error, Cycle_clock::now_s(), dt);
 }
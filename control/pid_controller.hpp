@@ -37,6 +37,12 @@
  *
  * \brief PID controller
  *
+ * \details pid_controller_t controls one axis. Pid_controller_T controls N
+ *          axes at once: its state is stored as one array per field, all
+ *          axes share the same time step and the loops over the axes have
+ *          no dependencies between them, so that the compiler can vectorize
+ *          them.
+ *
  ******************************************************************************/
 
 
@@ -47,6 +53,11 @@
 #include <cstdbool>
 #include <math.h>
 
+extern "C"
+{
+#include "util/maths.h"
+}
+
 
 /**
  * \brief Integrator part of PID
@@ -68,6 +79,7 @@ typedef struct
     float gain;         ///< Gain
     float previous;     ///< Previous input to the differentiator
     float clip;         ///< Clipping value
+    float filter_tau;   ///< Time constant of the low-pass filter on the derivative in s, 0 for none (used by Pid_controller_T)
 } differentiator_t;
 
 
@@ -166,4 +178,247 @@ float pid_controller_update(pid_controller_t* controller, float error);
 float pid_controller_update_dt(pid_controller_t* controller, float error, float dt);
 
 
+/**
+ * \brief   PID controller on N axes
+ *
+ * \details The derivative is computed on the measurement rather than on the
+ *          error, so steps of the setpoint do not create spikes, and is
+ *          low-pass filtered. The integrator of an axis stops only while its
+ *          output is saturated in the direction of the error.
+ *          The parameters are public so that they can be registered as
+ *          onboard parameters. gain_scale multiplies the P, I and D gains
+ *          without changing the parameters, it is set by gain scheduling.
+ *          It scales the integrator input rather than the accumulator, so
+ *          changes do not make the output jump
+ *
+ * \tparam  N   Number of axes
+ */
+template<uint32_t N>
+class Pid_controller_T
+{
+public:
+    /**
+     * \brief   Constructor, initializes as pass through controller
+     */
+    Pid_controller_T(void);
+
+
+    /**
+     * \brief   Init from the configuration of each axis
+     *
+     * \param   config      Array of N configurations
+     */
+    void init(const pid_controller_conf_t config[N]);
+
+
+    /**
+     * \brief   Applies configuration without reseting the controller
+     *
+     * \param   config      Array of N configurations
+     */
+    void apply_config(const pid_controller_conf_t config[N]);
+
+
+    /**
+     * \brief   Reset integrators and derivative filters
+     */
+    void reset(void);
+
+
+    /**
+     * \brief   Updates the controller with derivative on measurement
+     *
+     * \param   error       Error on each axis
+     * \param   measurement Measurement on each axis, used for the derivative
+     * \param   dt          Time step, shared by all axes (s)
+     * \param   output      Output on each axis
+     */
+    void update(const float error[N], const float measurement[N], float dt, float output[N]);
+
+
+    /**
+     * \brief   Updates the controller with derivative on error
+     *
+     * \details For loops without a measurement, like errors given by an
+     *          estimator
+     *
+     * \param   error       Error on each axis
+     * \param   dt          Time step, shared by all axes (s)
+     * \param   output      Output on each axis
+     */
+    void update(const float error[N], float dt, float output[N]);
+
+
+    // Parameters
+    float p_gain[N];                ///< Proportional gain
+    float clip_min[N];              ///< Min clipping values
+    float clip_max[N];              ///< Max clipping values
+    float i_gain[N];                ///< Integrator gain
+    float i_clip_pre[N];            ///< Clipping value for the charging rate of the integrator
+    float i_clip[N];                ///< Clipping value for the integrator
+    float d_gain[N];                ///< Derivative gain
+    float d_clip[N];                ///< Clipping value for the derivative term
+    float d_filter_tau[N];          ///< Time constant of the low-pass filter on the derivative (s), 0 for none
+    float soft_zone_width[N];       ///< Width of the soft zone on the error, 0 for none
+
+    // Scheduling
+    float gain_scale[N];            ///< Factor on the P, I and D gains, 1 by default
+
+    // State
+    float accumulator[N];           ///< Integrator
+    float previous[N];              ///< Previous measurement
+    float derivative[N];            ///< Filtered derivative of the measurement
+    float error[N];                 ///< Last error, after the soft zone
+    float output[N];                ///< Last output
+    int8_t saturation[N];           ///< Direction of saturation of the last output: -1, 0 or 1
+
+private:
+    bool has_previous_;             ///< False until the first measurement
+    float d_alpha_[N];              ///< Gain of the derivative filter, computed for d_alpha_dt_ and d_alpha_tau_
+    float d_alpha_tau_[N];          ///< Time constant used to compute d_alpha_
+    float d_alpha_dt_;              ///< Time step used to compute d_alpha_, 0 before the first valid update
+};
+
+
+template<uint32_t N>
+Pid_controller_T<N>::Pid_controller_T(void)
+{
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        p_gain[i]          = 1.0f;
+        clip_min[i]        = -10000.0f;
+        clip_max[i]        = 10000.0f;
+        i_gain[i]          = 0.0f;
+        i_clip_pre[i]      = 0.0f;
+        i_clip[i]          = 0.0f;
+        d_gain[i]          = 0.0f;
+        d_clip[i]          = 0.0f;
+        d_filter_tau[i]    = 0.0f;
+        soft_zone_width[i] = 0.0f;
+        gain_scale[i]      = 1.0f;
+        d_alpha_[i]        = 1.0f;
+        d_alpha_tau_[i]    = 0.0f;
+    }
+    d_alpha_dt_ = 0.0f;
+    reset();
+}
+
+
+template<uint32_t N>
+void Pid_controller_T<N>::init(const pid_controller_conf_t config[N])
+{
+    apply_config(config);
+    reset();
+}
+
+
+template<uint32_t N>
+void Pid_controller_T<N>::apply_config(const pid_controller_conf_t config[N])
+{
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        p_gain[i]          = config[i].p_gain;
+        clip_min[i]        = config[i].clip_min;
+        clip_max[i]        = config[i].clip_max;
+        i_gain[i]          = config[i].integrator.gain;
+        i_clip_pre[i]      = config[i].integrator.clip_pre;
+        i_clip[i]          = config[i].integrator.clip;
+        d_gain[i]          = config[i].differentiator.gain;
+        d_clip[i]          = config[i].differentiator.clip;
+        d_filter_tau[i]    = config[i].differentiator.filter_tau;
+        soft_zone_width[i] = config[i].soft_zone_width;
+    }
+}
+
+
+template<uint32_t N>
+void Pid_controller_T<N>::reset(void)
+{
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        accumulator[i] = 0.0f;
+        previous[i]    = 0.0f;
+        derivative[i]  = 0.0f;
+        error[i]       = 0.0f;
+        output[i]      = 0.0f;
+        saturation[i]  = 0;
+    }
+    has_previous_ = false;
+}
+
+
+template<uint32_t N>
+void Pid_controller_T<N>::update(const float err[N], const float measurement[N], float dt, float out[N])
+{
+    // Terms shared by all axes
+    bool valid_dt      = (dt > 0.000001f) && has_previous_;
+    float inv_dt       = valid_dt ? (1.0f / dt) : 0.0f;
+    has_previous_      = true;
+
+    // Derivative filter gains are recomputed only when dt changes by more than 1%
+    bool new_dt = valid_dt && (maths_f_abs(dt - d_alpha_dt_) > 0.01f * dt);
+    if (new_dt)
+    {
+        d_alpha_dt_ = dt;
+    }
+
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        float e  = maths_soft_zone(err[i], soft_zone_width[i]);
+        error[i] = e;
+
+        // Derivative on measurement, with first order low-pass filter
+        float raw     = (previous[i] - measurement[i]) * inv_dt;
+        if (valid_dt && (new_dt || (d_filter_tau[i] != d_alpha_tau_[i])))
+        {
+            d_alpha_[i]     = d_alpha_dt_ / (d_filter_tau[i] + d_alpha_dt_);
+            d_alpha_tau_[i] = d_filter_tau[i];
+        }
+        float alpha   = valid_dt ? d_alpha_[i] : 0.0f;
+        derivative[i] += alpha * (raw - derivative[i]);
+        previous[i]    = measurement[i];
+        float d_term   = maths_clip(gain_scale[i] * d_gain[i] * derivative[i], d_clip[i]);
+
+        // Integrate unless the output is saturated in the direction of the error
+        bool windup = ((saturation[i] > 0) && (e > 0.0f)) || ((saturation[i] < 0) && (e < 0.0f));
+        if (!windup)
+        {
+            accumulator[i] = maths_clip(accumulator[i] + maths_clip(dt * gain_scale[i] * i_gain[i] * e, i_clip_pre[i]), i_clip[i]);
+        }
+
+        float o = gain_scale[i] * p_gain[i] * e + d_term + accumulator[i];
+        if (o < clip_min[i])
+        {
+            o             = clip_min[i];
+            saturation[i] = -1;
+        }
+        else if (o > clip_max[i])
+        {
+            o             = clip_max[i];
+            saturation[i] = 1;
+        }
+        else
+        {
+            saturation[i] = 0;
+        }
+
+        output[i] = o;
+        out[i]    = o;
+    }
+}
+
+
+template<uint32_t N>
+void Pid_controller_T<N>::update(const float err[N], float dt, float out[N])
+{
+    // The derivative of the error is the derivative of its opposite as measurement
+    float measurement[N];
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        measurement[i] = - maths_soft_zone(err[i], soft_zone_width[i]);
+    }
+    update(err, measurement, dt, out);
+}
+
+
 #endif /* PID_CONTROL_HPP_ */
@@ -111,6 +111,12 @@ bool Position_controller::update()
     velocity_command_.xyz[X] *= yaw_error_factor;
     velocity_command_.xyz[Y] *= yaw_error_factor;
 
+    // Add feed-forward: the correction only compensates for the tracking error
+    velocity_command_.xyz[X] += position_command_.vel[X];
+    velocity_command_.xyz[Y] += position_command_.vel[Y];
+    velocity_command_.xyz[Z] += position_command_.vel[Z];
+    velocity_command_.acc     = position_command_.acc;
+
 	return true;
 }
 
@@ -49,7 +49,7 @@
  ******************************************************************************/
 
 #include "control/rate_controller.hpp"
-#include "hal/common/time_keeper.hpp"
+#include "runtime/cycle_clock.hpp"
 
 //------------------------------------------------------------------------------
 // PUBLIC FUNCTIONS IMPLEMENTATION
@@ -73,28 +73,25 @@ Rate_controller::Rate_controller(const args_t& args, const conf_t& config) :
     torque_command_.xyz[Z]  = 0.0f;
 
     // Init rate gains
-    pid_controller_init(&pid_[ROLL],  &config.pid_config[ROLL]);
-    pid_controller_init(&pid_[PITCH], &config.pid_config[PITCH]);
-    pid_controller_init(&pid_[YAW],   &config.pid_config[YAW]);
+    pid_.init(config.pid_config);
 }
 
 
 bool Rate_controller::update(void)
 {
-    float now      = time_keeper_get_s();
+    float now      = Cycle_clock::now_s();
     dt_s_          = now - last_update_s_;
     last_update_s_ = now;
 
     // Get errors on rate
+    std::array<float,3> rates = ahrs_.angular_speed();
     float errors[3];
-    errors[ROLL]  = rate_command_.xyz[ROLL]  - ahrs_.angular_speed()[ROLL];
-    errors[PITCH] = rate_command_.xyz[PITCH] - ahrs_.angular_speed()[PITCH];
-    errors[YAW]   = rate_command_.xyz[YAW]   - ahrs_.angular_speed()[YAW];
+    errors[ROLL]  = rate_command_.xyz[ROLL]  - rates[ROLL];
+    errors[PITCH] = rate_command_.xyz[PITCH] - rates[PITCH];
+    errors[YAW]   = rate_command_.xyz[YAW]   - rates[YAW];
 
-    // Update PIDs
-    torque_command_.xyz[ROLL]  = pid_controller_update_dt(&pid_[ROLL],  errors[ROLL],  dt_s_);
-    torque_command_.xyz[PITCH] = pid_controller_update_dt(&pid_[PITCH], errors[PITCH], dt_s_);
-    torque_command_.xyz[YAW]   = pid_controller_update_dt(&pid_[YAW],   errors[YAW],   dt_s_);
+    // Update PIDs, with derivative on the measured rates
+    pid_.update(errors, rates.data(), dt_s_, torque_command_.xyz.data());
 
     return true;
 }
@@ -121,19 +118,7 @@ bool Rate_controller::get_output(torque_command_t& command) const
 }
 
 
-pid_controller_t& Rate_controller::get_pid_X(void)
+Pid_controller_T<3>& Rate_controller::get_pid(void)
 {
-    return pid_[X];
-}
-
-
-pid_controller_t& Rate_controller::get_pid_Y(void)
-{
-    return pid_[Y];
-}
-
-
-pid_controller_t& Rate_controller::get_pid_Z(void)
-{
-    return pid_[Z];
+    return pid_;
 }
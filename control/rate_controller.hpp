@@ -141,18 +141,16 @@ public:
     /**
      * \brief   Gives access to internal pid_controller
      *
-     * \return  pid     reference to pid controller
+     * \return  pid     reference to the pid controller of the 3 axes
      */
-    pid_controller_t& get_pid_X(void);
-    pid_controller_t& get_pid_Y(void);
-    pid_controller_t& get_pid_Z(void);
+    Pid_controller_T<3>& get_pid(void);
 
 private:
     const AHRS&         ahrs_;                  ///< Ref to attitude estimation (input)
     rate_command_t&       rate_command_;          ///< Reference to rate command (input)
     torque_command_t&     torque_command_;        ///< Reference to torque command (output)
 
-    pid_controller_t      pid_[3];                ///< Angular rate PID controller for roll, pitch and yaw
+    Pid_controller_T<3>   pid_;                   ///< Angular rate PID controller for roll, pitch and yaw
     float                 dt_s_;                  ///< The time interval between two updates
     float                 last_update_s_;         ///< The time of the last update in s
 };
@@ -175,6 +173,7 @@ Rate_controller::conf_t Rate_controller::default_config()
     conf.pid_config[ROLL].differentiator            = {};
     conf.pid_config[ROLL].differentiator.gain       = 0.008f;
     conf.pid_config[ROLL].differentiator.clip       = 0.14f;
+    conf.pid_config[ROLL].differentiator.filter_tau  = 0.004f;   // About 40 Hz
     conf.pid_config[ROLL].soft_zone_width           = 0.0f;
     // -----------------------------------------------------------------
     // ------ PITCH RATE PID -------------------------------------------
@@ -190,6 +189,7 @@ Rate_controller::conf_t Rate_controller::default_config()
     conf.pid_config[PITCH].differentiator           = {};
     conf.pid_config[PITCH].differentiator.gain      = 0.008f;
     conf.pid_config[PITCH].differentiator.clip      = 0.14f;
+    conf.pid_config[PITCH].differentiator.filter_tau = 0.004f;   // About 40 Hz
     conf.pid_config[PITCH].soft_zone_width          = 0.0f;
     // -----------------------------------------------------------------
     // ------ YAW RATE PID ---------------------------------------------
@@ -205,6 +205,7 @@ Rate_controller::conf_t Rate_controller::default_config()
     conf.pid_config[YAW].differentiator             = {};
     conf.pid_config[YAW].differentiator.gain        = 0.0f;
     conf.pid_config[YAW].differentiator.clip        = 0.0f;
+    conf.pid_config[YAW].differentiator.filter_tau   = 0.004f;   // About 40 Hz
     conf.pid_config[YAW].soft_zone_width            = 0.0;
 
     return conf;
@@ -0,0 +1,251 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file servos_mix_fixed.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Servo mix with a mix table fixed at compile time
+ *
+ * \details The mix table is given as a type, the mixer is unrolled at compile
+ *          time and terms with a zero coefficient are not computed. Trim,
+ *          limits and allocation mode remain configurable. For airframes
+ *          with a mix tuned at runtime, use Servos_mix_matrix.
+ *
+ * Example mix table for a quadcopter in diagonal configuration:
+ *
+ * ```cpp
+ *     struct Mix_quadcopter_diag
+ *     {
+ *         static const uint32_t N = 4;
+ *         //                                  roll, pitch,   yaw,   X,    Y,     Z
+ *         static constexpr float mix[N][6] = {{ 1.0f, -1.0f,  1.0f, 0.0f, 0.0f, -1.0f},
+ *                                             { 1.0f,  1.0f, -1.0f, 0.0f, 0.0f, -1.0f},
+ *                                             {-1.0f,  1.0f,  1.0f, 0.0f, 0.0f, -1.0f},
+ *                                             {-1.0f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f}};
+ *     };
+ *
+ *     Servos_mix_fixed<Mix_quadcopter_diag> servosmix({{{&servo_0, &servo_1, &servo_2, &servo_3}}});
+ * ```
+ ******************************************************************************/
+
+
+#ifndef SERVOS_MIX_FIXED_HPP_
+#define SERVOS_MIX_FIXED_HPP_
+
+#include "control/servos_mix_matrix.hpp"
+
+/**
+ * \brief Servos mix with compile-time mix table
+ *
+ * \tparam  MIX     Mix table, provides the number of servos N and the
+ *                  coefficients as static constexpr float mix[N][6]
+ */
+template<typename MIX>
+class Servos_mix_fixed: public Servos_mix_matrix<MIX::N>
+{
+public:
+    static const uint32_t N = MIX::N;       ///< Number of servos
+
+    typedef typename Servos_mix_matrix<N>::conf_t conf_t;
+    typedef typename Servos_mix_matrix<N>::args_t args_t;
+
+    /**
+     * \brief   Default configuration, with the mix table as mix matrix
+     *
+     * \return  Config structure
+     */
+    static inline conf_t default_config(void)
+    {
+        conf_t conf = Servos_mix_matrix<N>::default_config();
+        conf.mix    = mix_matrix();
+        return conf;
+    };
+
+
+    /**
+     * \brief   Mix table as a matrix
+     *
+     * \return  Mix matrix
+     */
+    static Mat<N, 6> mix_matrix(void)
+    {
+        Mat<N, 6> mix;
+        Rows<0>::copy(mix);
+        return mix;
+    };
+
+
+    /**
+     * \brief   Constructor
+     *
+     * \details The mix matrix of the configuration is replaced by the mix table
+     */
+    Servos_mix_fixed(const args_t& args, const conf_t& config = default_config()):
+        Servos_mix_matrix<N>(args, config)
+    {
+        this->mix_ = mix_matrix();
+    };
+
+
+    /**
+     * \brief  Perform conversion from torque/thrust command to servo command
+     */
+    virtual bool update(void)
+    {
+        const float cmd[6] = {this->torque_command_.xyz[X],
+                              this->torque_command_.xyz[Y],
+                              this->torque_command_.xyz[Z],
+                              this->thrust_command_.xyz[X],
+                              this->thrust_command_.xyz[Y],
+                              this->thrust_command_.xyz[Z]};
+
+        if (this->allocation_ == Servos_mix_matrix<N>::ALLOCATION_PRIORITIZED)
+        {
+            float base[N];
+            float roll_pitch[N];
+            float yaw[N];
+            float collective[N];
+            Rows<0>::split(cmd, this->trim_, base, roll_pitch, yaw, collective);
+            return this->allocate_prioritized(base, roll_pitch, yaw, collective);
+        }
+
+        float servos_cmd[N];
+        Rows<0>::mix(cmd, this->trim_, servos_cmd);
+        return this->write_clipped(servos_cmd);
+    };
+
+
+private:
+    /**
+     * \brief   Coefficient of the mix table, as a compile-time constant
+     */
+    template<uint32_t I, uint32_t J>
+    struct Coef
+    {
+        static constexpr float value = MIX::mix[I][J];
+    };
+
+
+    /**
+     * \brief   Adds one term of a row, nothing when the coefficient is zero
+     */
+    template<uint32_t I, uint32_t J, bool NONZERO = (Coef<I, J>::value != 0.0f)>
+    struct Term
+    {
+        static inline float add(float acc, float cmd)
+        {
+            return acc + Coef<I, J>::value * cmd;
+        }
+    };
+
+    template<uint32_t I, uint32_t J>
+    struct Term<I, J, false>
+    {
+        static inline float add(float acc, float cmd)
+        {
+            return acc;
+        }
+    };
+
+
+    /**
+     * \brief   Adds terms J to J_END - 1 of row I
+     */
+    template<uint32_t I, uint32_t J, uint32_t J_END>
+    struct Terms
+    {
+        static inline float add(float acc, const float cmd[6])
+        {
+            return Terms<I, J + 1, J_END>::add(Term<I, J>::add(acc, cmd[J]), cmd);
+        }
+    };
+
+    template<uint32_t I, uint32_t J_END>
+    struct Terms<I, J_END, J_END>
+    {
+        static inline float add(float acc, const float cmd[6])
+        {
+            return acc;
+        }
+    };
+
+
+    /**
+     * \brief   Computes rows I to N - 1
+     */
+    template<uint32_t I, bool END = (I >= N)>
+    struct Rows
+    {
+        static inline void mix(const float cmd[6], const Mat<N, 1>& trim, float out[N])
+        {
+            out[I] = Terms<I, 0, 6>::add(trim[I], cmd);
+            Rows<I + 1>::mix(cmd, trim, out);
+        }
+
+        static inline void split(const float cmd[6], const Mat<N, 1>& trim, float base[N], float roll_pitch[N], float yaw[N], float collective[N])
+        {
+            base[I]       = Terms<I, 3, 6>::add(trim[I], cmd);
+            roll_pitch[I] = Terms<I, 0, 2>::add(0.0f, cmd);
+            yaw[I]        = Terms<I, 2, 3>::add(0.0f, cmd);
+            collective[I] = - Coef<I, 5>::value;   // Positive shifts increase thrust (-Z)
+            Rows<I + 1>::split(cmd, trim, base, roll_pitch, yaw, collective);
+        }
+
+        static inline void copy(Mat<N, 6>& mix)
+        {
+            mix(I, 0) = Coef<I, 0>::value;
+            mix(I, 1) = Coef<I, 1>::value;
+            mix(I, 2) = Coef<I, 2>::value;
+            mix(I, 3) = Coef<I, 3>::value;
+            mix(I, 4) = Coef<I, 4>::value;
+            mix(I, 5) = Coef<I, 5>::value;
+            Rows<I + 1>::copy(mix);
+        }
+    };
+
+    template<uint32_t I>
+    struct Rows<I, true>
+    {
+        static inline void mix(const float cmd[6], const Mat<N, 1>& trim, float out[N])
+        {}
+
+        static inline void split(const float cmd[6], const Mat<N, 1>& trim, float base[N], float roll_pitch[N], float yaw[N], float collective[N])
+        {}
+
+        static inline void copy(Mat<N, 6>& mix)
+        {}
+    };
+};
+
+
+#endif /* SERVOS_MIX_FIXED_HPP_ */
@@ -71,15 +71,39 @@
 #include "drivers/servo.hpp"
 #include "util/matrix.hpp"
 
+extern "C"
+{
+#include "util/maths.h"
+}
+
 /**
  * \brief Servos mix
  *
+ * \details In PRIORITIZED allocation mode, commands that saturate the servos
+ *          are reduced by priority instead of being clipped servo by servo:
+ *          the collective thrust (along the Z thrust column of the mix) is
+ *          shifted first, then the yaw torque is reduced, then the roll and
+ *          pitch torques. Each reduction is found by a bisection with a fixed
+ *          number of steps.
+ *
  * \tparam  N   Number of servos
  */
 template<uint32_t N>
 class Servos_mix_matrix: public Servos_mix
 {
 public:
+    /**
+     * \brief   Allocation of commands to servos
+     */
+    enum allocation_t
+    {
+        ALLOCATION_CLIP        = 0,     ///< Each servo is clipped independently
+        ALLOCATION_PRIORITIZED = 1,     ///< Roll and pitch have priority over yaw, and yaw over thrust
+    };
+
+    static const uint32_t ALLOCATION_ITERATIONS = 8;   ///< Bisection steps per reduced command, the resolution is 2^-8
+
+
     /**
      * \brief   Configuration structure
      */
@@ -89,6 +113,8 @@ public:
         Mat<N, 1> trim;         ///< Trim values added to output
         Mat<N, 1> min;          ///< Minimum commands to apply to servo
         Mat<N, 1> max;          ///< Maximum commands to apply to servo
+        allocation_t allocation;        ///< Allocation mode
+        bool allow_thrust_increase;     ///< In prioritized mode, allow thrust above the command to keep torques (air mode)
     };
 
     /**
@@ -103,6 +129,8 @@ public:
         conf.trim       = Mat<N,1>(-1.0f);  // -1.0f in case some servos are motors
         conf.min        = Mat<N,1>(-0.9f);
         conf.max        = Mat<N,1>(1.0f);
+        conf.allocation = ALLOCATION_CLIP;
+        conf.allow_thrust_increase = false;
         return conf;
     };
 
@@ -126,7 +154,9 @@ public:
         mix_(config.mix),
         trim_(config.trim),
         min_(config.min),
-        max_(config.max)
+        max_(config.max),
+        allocation_(config.allocation),
+        allow_thrust_increase_(config.allow_thrust_increase)
     {};
 
 
@@ -135,6 +165,11 @@ public:
      */
     virtual bool update(void)
     {
+        if (allocation_ == ALLOCATION_PRIORITIZED)
+        {
+            return update_prioritized();
+        }
+
         // Mix commands into servo values
         Mat<N,1> servos_cmd = mix_ % Mat<6,1>({torque_command_.xyz[X],
                                                torque_command_.xyz[Y],
@@ -159,6 +194,19 @@ public:
     };
 
 
+    /**
+     * \brief   Get allocation mode
+     *
+     * \details Can be changed at runtime, ie. by an onboard parameter
+     *
+     * \return  Reference to allocation mode
+     */
+    allocation_t& allocation(void)
+    {
+        return allocation_;
+    };
+
+
     virtual bool failsafe(void)
     {
         for (uint32_t i = 0; i < N; i++)
@@ -227,6 +275,179 @@ public:
 
 
 protected:
+    /**
+     * \brief   Prioritized allocation
+     *
+     * \details The thrust commands and the trim give the base command. The
+     *          largest part of the roll and pitch command that fits is added,
+     *          then the largest part of the yaw command. Fitting may shift the
+     *          collective thrust. When the base command alone does not fit,
+     *          falls back to clipping
+     */
+    bool update_prioritized(void)
+    {
+        float base[N];
+        float roll_pitch[N];
+        float yaw[N];
+        float collective[N];
+        for (uint32_t i = 0; i < N; ++i)
+        {
+            base[i] = trim_[i]
+                    + mix_(i, 3) * thrust_command_.xyz[X]
+                    + mix_(i, 4) * thrust_command_.xyz[Y]
+                    + mix_(i, 5) * thrust_command_.xyz[Z];
+            roll_pitch[i] = mix_(i, 0) * torque_command_.xyz[X] + mix_(i, 1) * torque_command_.xyz[Y];
+            yaw[i]        = mix_(i, 2) * torque_command_.xyz[Z];
+            collective[i] = - mix_(i, 5);    // Positive shifts increase thrust (-Z)
+        }
+
+        return allocate_prioritized(base, roll_pitch, yaw, collective);
+    }
+
+
+    /**
+     * \brief   Prioritized allocation of the servo commands split per axis
+     *
+     * \param   base        Trim and thrust commands (input, modified)
+     * \param   roll_pitch  Roll and pitch commands (input)
+     * \param   yaw         Yaw commands (input)
+     * \param   collective  Servo commands for a unit of thrust along -Z (input)
+     */
+    bool allocate_prioritized(float base[N], const float roll_pitch[N], const float yaw[N], const float collective[N])
+    {
+        float k_min = 0.0f;
+        float k_max = 0.0f;
+        if (!shift_interval(base, collective, k_min, k_max))
+        {
+            for (uint32_t i = 0; i < N; ++i)
+            {
+                base[i] += roll_pitch[i] + yaw[i];
+            }
+            return write_clipped(base);
+        }
+
+        add_largest_fraction(base, roll_pitch, collective);
+        add_largest_fraction(base, yaw, collective);
+
+        // Smallest change of thrust that fits
+        shift_interval(base, collective, k_min, k_max);
+        float k = maths_f_min(maths_f_max(0.0f, k_min), k_max);
+        for (uint32_t i = 0; i < N; ++i)
+        {
+            base[i] += k * collective[i];
+        }
+
+        return write_clipped(base);
+    }
+
+
+    /**
+     * \brief   Adds to cmd the largest fraction of delta that fits, given that the collective can be shifted
+     *
+     * \param   cmd         Servo commands, must fit (input/output)
+     * \param   delta       Commands to add (input)
+     * \param   collective  Direction of thrust shifts (input)
+     */
+    void add_largest_fraction(float cmd[N], const float delta[N], const float collective[N]) const
+    {
+        float trial[N];
+        float k_min = 0.0f;
+        float k_max = 0.0f;
+
+        float fraction = 1.0f;
+        for (uint32_t i = 0; i < N; ++i)
+        {
+            trial[i] = cmd[i] + delta[i];
+        }
+
+        // The fractions that fit form an interval containing 0, so a bisection finds the largest
+        if (!shift_interval(trial, collective, k_min, k_max))
+        {
+            float low  = 0.0f;
+            float high = 1.0f;
+            for (uint32_t step = 0; step < ALLOCATION_ITERATIONS; ++step)
+            {
+                float mid = 0.5f * (low + high);
+                for (uint32_t i = 0; i < N; ++i)
+                {
+                    trial[i] = cmd[i] + mid * delta[i];
+                }
+                if (shift_interval(trial, collective, k_min, k_max))
+                {
+                    low = mid;
+                }
+                else
+                {
+                    high = mid;
+                }
+            }
+            fraction = low;
+        }
+
+        for (uint32_t i = 0; i < N; ++i)
+        {
+            cmd[i] += fraction * delta[i];
+        }
+    }
+
+
+    /**
+     * \brief   Interval of collective shifts that keep all servos within their limits
+     *
+     * \param   cmd         Servo commands (input)
+     * \param   collective  Direction of thrust shifts (input)
+     * \param   k_min       Smallest shift (output)
+     * \param   k_max       Largest shift (output)
+     *
+     * \return  False if no shift fits
+     */
+    bool shift_interval(const float cmd[N], const float collective[N], float& k_min, float& k_max) const
+    {
+        k_min = -1000.0f;
+        k_max = allow_thrust_increase_ ? 1000.0f : 0.0f;
+
+        for (uint32_t i = 0; i < N; ++i)
+        {
+            float lower = min_[i] - cmd[i];
+            float upper = max_[i] - cmd[i];
+
+            if (collective[i] > 0.000001f)
+            {
+                k_min = maths_f_max(k_min, lower / collective[i]);
+                k_max = maths_f_min(k_max, upper / collective[i]);
+            }
+            else if (collective[i] < -0.000001f)
+            {
+                k_min = maths_f_max(k_min, upper / collective[i]);
+                k_max = maths_f_min(k_max, lower / collective[i]);
+            }
+            else if ((lower > 0.000001f) || (upper < -0.000001f))
+            {
+                // Servo not affected by the thrust, and out of its limits
+                return false;
+            }
+        }
+
+        return k_min <= k_max;
+    }
+
+
+    /**
+     * \brief   Clips and writes commands to servos
+     *
+     * \param   cmd         Servo commands
+     */
+    bool write_clipped(const float cmd[N])
+    {
+        for (uint32_t i = 0; i < N; ++i)
+        {
+            servos_[i]->write(maths_f_min(maths_f_max(cmd[i], min_[i]), max_[i]));
+        }
+
+        return true;
+    }
+
+
     std::array<Servo*, N> servos_;
 
     torque_command_t torque_command_;
@@ -236,6 +457,8 @@ protected:
     Mat<N, 1> trim_;
     Mat<N, 1> min_;
     Mat<N, 1> max_;
+    allocation_t allocation_;               ///< Allocation mode
+    bool allow_thrust_increase_;            ///< Allow thrust above the command in prioritized mode
 };
 
 
@@ -46,6 +46,7 @@
 #include "control/velocity_controller.hpp"
 #include "util/coord_conventions.hpp"
 #include "util/constants.hpp"
+#include "runtime/cycle_clock.hpp"
 
 extern "C"
 {
@@ -61,24 +62,27 @@ Velocity_controller::Velocity_controller(const args_t& args, const conf_t& confi
     velocity_command_(args.velocity_command),
     attitude_command_(args.attitude_command),
     thrust_command_(args.thrust_command),
-    control_frame_(config.control_frame)
+    control_frame_(config.control_frame),
+    max_rate_ff_(config.max_rate_ff),
+    last_ff_attitude_(),
+    last_update_s_(0.0f)
 {
+    accel_ff_gain_[X] = config.accel_ff_gain[X];
+    accel_ff_gain_[Y] = config.accel_ff_gain[Y];
+    accel_ff_gain_[Z] = config.accel_ff_gain[Z];
+
     // Init PID gains
-    pid_controller_init(&pid_[X], &config.pid_config[X]);
-    pid_controller_init(&pid_[Y], &config.pid_config[Y]);
-    pid_controller_init(&pid_[Z], &config.pid_config[Z]);
+    pid_.init(config.pid_config);
 
     // set initial velocity command
     velocity_command_.xyz[X]  = 0.0f;
     velocity_command_.xyz[Y]  = 0.0f;
     velocity_command_.xyz[Z]  = 0.0f;
     velocity_command_.heading = 0.0f;
+    velocity_command_.acc     = std::array<float,3>{{0.0f, 0.0f, 0.0f}};
 
     // set initial attitude command
-    attitude_command_.s     = 1.0f;
-    attitude_command_.v[X]  = 0.0f;
-    attitude_command_.v[Y]  = 0.0f;
-    attitude_command_.v[Z]  = 0.0f;
+    attitude_command_ = attitude_command_t();
 
     // set initial thrust command
     thrust_command_.xyz[X]  = 0.0f;
@@ -89,6 +93,10 @@ Velocity_controller::Velocity_controller(const args_t& args, const conf_t& confi
 
 bool Velocity_controller::update(void)
 {
+    float now      = Cycle_clock::now_s();
+    float dt_s     = now - last_update_s_;
+    last_update_s_ = now;
+
     // Get current velocity in NED
     std::array<float,3> velocity = ins_.velocity_lf();
 
@@ -121,23 +129,59 @@ bool Velocity_controller::update(void)
     errors[Y] = velocity_command_ctrl_frame[Y] - velocity_ctrl_frame[Y];
     errors[Z] = velocity_command_ctrl_frame[Z] - velocity_ctrl_frame[Z];
 
-    // Update PID
+    // Update PID, with derivative on the measured velocity
     std::array<float,3> accel_vector_ctrl_frame;
-    accel_vector_ctrl_frame[X] = pid_controller_update(&pid_[X], errors[X]);
-    accel_vector_ctrl_frame[Y] = pid_controller_update(&pid_[Y], errors[Y]);
-    accel_vector_ctrl_frame[Z] = pid_controller_update(&pid_[Z], errors[Z]);
+    pid_.update(errors, velocity_ctrl_frame.data(), dt_s, accel_vector_ctrl_frame.data());
 
     // Convert output to NED frame
     std::array<float,3> accel_vector;
     quaternions_rotate_vector(q_ctrl_frame, accel_vector_ctrl_frame.data(), accel_vector.data());
 
+    // Add acceleration feed-forward
+    std::array<float,3> accel_ff;
+    accel_ff[X] = accel_ff_gain_[X] * velocity_command_.acc[X];
+    accel_ff[Y] = accel_ff_gain_[Y] * velocity_command_.acc[Y];
+    accel_ff[Z] = accel_ff_gain_[Z] * velocity_command_.acc[Z];
+    accel_vector[X] += accel_ff[X];
+    accel_vector[Y] += accel_ff[Y];
+    accel_vector[Z] += accel_ff[Z];
+
     // Convert accel vector to attitude and thrust command
     bool ret = compute_attitude_and_thrust_from_desired_accel(accel_vector, attitude_command_, thrust_command_);
 
+    // Add rate feed-forward
+    update_rate_ff(accel_ff, dt_s);
+
     return ret;
 }
 
 
+void Velocity_controller::update_rate_ff(const std::array<float,3>& accel_ff, float dt_s)
+{
+    // Attitude required by the feed-forward alone
+    attitude_command_t ff_attitude;
+    thrust_command_t ff_thrust;
+    compute_attitude_and_thrust_from_desired_accel(accel_ff, ff_attitude, ff_thrust);
+
+    // Rotation since the last update, in the frame of the attitude command
+    quat_t dq = quaternions_multiply(quaternions_inverse(last_ff_attitude_), ff_attitude);
+    last_ff_attitude_ = ff_attitude;
+
+    bool has_ff = (accel_ff[X] != 0.0f) || (accel_ff[Y] != 0.0f) || (accel_ff[Z] != 0.0f);
+    if ((!has_ff) || (dt_s <= 0.0f) || (dt_s > 0.1f))
+    {
+        attitude_command_.rate = std::array<float,3>{{0.0f, 0.0f, 0.0f}};
+        return;
+    }
+
+    // Small rotation: the angle is twice the vector part
+    float scale = ((dq.s < 0.0f) ? -2.0f : 2.0f) / dt_s;
+    attitude_command_.rate[X] = maths_clip(scale * dq.v[X], max_rate_ff_);
+    attitude_command_.rate[Y] = maths_clip(scale * dq.v[Y], max_rate_ff_);
+    attitude_command_.rate[Z] = maths_clip(scale * dq.v[Z], max_rate_ff_);
+}
+
+
 bool Velocity_controller::set_command(const velocity_command_t& vel)
 {
     velocity_command_ = vel;
@@ -166,19 +210,7 @@ bool Velocity_controller::get_output(thrust_command_t& thrust) const
 }
 
 
-pid_controller_t& Velocity_controller::get_pid_X(void)
-{
-    return pid_[X];
-}
-
-
-pid_controller_t& Velocity_controller::get_pid_Y(void)
-{
-    return pid_[Y];
-}
-
-
-pid_controller_t& Velocity_controller::get_pid_Z(void)
+Pid_controller_T<3>& Velocity_controller::get_pid(void)
 {
-    return pid_[Z];
+    return pid_;
 }
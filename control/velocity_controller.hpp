@@ -73,6 +73,8 @@ public:
     {
         control_frame_t         control_frame;          ///< Reference frame in which the control is don
         pid_controller_conf_t   pid_config[3];          ///< Config for PID controller on velocity along X, Y and Z in global frame
+        float                   accel_ff_gain[3];       ///< Gain from acceleration feed-forward (m/s^2) to the output of the PIDs along X, Y and Z in global frame, 0 to disable
+        float                   max_rate_ff;            ///< Maximum angular rate feed-forward on each axis (rad/s)
     };
 
 
@@ -149,11 +151,9 @@ public:
     /**
      * \brief   Gives acces to internal pid_controller
      *
-     * \return  pid     reference to pid controller
+     * \return  pid     reference to the pid controller of the 3 axes
      */
-    pid_controller_t& get_pid_X(void);
-    pid_controller_t& get_pid_Y(void);
-    pid_controller_t& get_pid_Z(void);
+    Pid_controller_T<3>& get_pid(void);
 
 protected:
 
@@ -177,7 +177,25 @@ protected:
     thrust_command_t&    thrust_command_;            ///< Thrust command (output)
 
     control_frame_t      control_frame_;             ///< Reference frame in which the control is don
-    pid_controller_t     pid_[3];                    ///< PID controller for velocity along X, Y and Z in global frame
+    Pid_controller_T<3>  pid_;                       ///< PID controller for velocity along X, Y and Z in global frame
+    float                accel_ff_gain_[3];          ///< Gain from acceleration feed-forward to the output of the PIDs
+    float                max_rate_ff_;               ///< Maximum angular rate feed-forward on each axis (rad/s)
+
+private:
+    /**
+     * \brief   Computes the angular rate feed-forward of the attitude command
+     *
+     * \details The rate is the derivative of the attitude required by the
+     *          acceleration feed-forward alone, so it does not amplify the
+     *          noise of the PIDs
+     *
+     * \param   accel_ff            Acceleration feed-forward in units of the PID output (input)
+     * \param   dt_s                Time since the last update (input)
+     */
+    void update_rate_ff(const std::array<float,3>& accel_ff, float dt_s);
+
+    attitude_command_t   last_ff_attitude_;          ///< Attitude required by the acceleration feed-forward at the last update
+    float                last_update_s_;             ///< Time of the last update (s)
 };
 
 #endif /* VELOCITY_CONTROLLER_HPP_ */
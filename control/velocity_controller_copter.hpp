@@ -54,6 +54,7 @@
 #include "control/pid_controller.hpp"
 #include "sensing/ahrs.hpp"
 #include "sensing/ins.hpp"
+#include "util/constants.hpp"
 
 /**
  * \brief Velocity controller for hovering platforms
@@ -123,6 +124,13 @@ Velocity_controller_copter::conf_t Velocity_controller_copter::default_config(vo
     conf.control_frame                         = LOCAL_FRAME;
     conf.thrust_hover_point                    = -0.52f;
 
+    // Small angle: the tilt is the horizontal acceleration over gravity,
+    // and the thrust scales with the vertical acceleration
+    conf.accel_ff_gain[X]                      = 1.0f / GRAVITY;
+    conf.accel_ff_gain[Y]                      = 1.0f / GRAVITY;
+    conf.accel_ff_gain[Z]                      = - conf.thrust_hover_point / GRAVITY;
+    conf.max_rate_ff                           = 1.0f;
+
     // -----------------------------------------------------------------
     // ------ X PID ----------------------------------------------------
     // -----------------------------------------------------------------
@@ -139,6 +147,7 @@ Velocity_controller_copter::conf_t Velocity_controller_copter::default_config(vo
     conf.pid_config[X].differentiator.gain     = 0.01f;
     conf.pid_config[X].differentiator.previous = 0.0f;
     conf.pid_config[X].differentiator.clip     = 1.0f;
+    conf.pid_config[X].differentiator.filter_tau = 0.02f;   // About 8 Hz
     conf.pid_config[X].soft_zone_width         = 0.0f;
 
     // -----------------------------------------------------------------
@@ -157,6 +166,7 @@ Velocity_controller_copter::conf_t Velocity_controller_copter::default_config(vo
     conf.pid_config[Y].differentiator.gain     = 0.01f;
     conf.pid_config[Y].differentiator.previous = 0.0f;
     conf.pid_config[Y].differentiator.clip     = 1.0f;
+    conf.pid_config[Y].differentiator.filter_tau = 0.02f;   // About 8 Hz
     conf.pid_config[Y].soft_zone_width         = 0.0f;
 
     // ---------------------------------------------------------------------
@@ -175,6 +185,7 @@ Velocity_controller_copter::conf_t Velocity_controller_copter::default_config(vo
     conf.pid_config[Z].differentiator.gain     = 0.08f;
     conf.pid_config[Z].differentiator.previous = 0.0f;
     conf.pid_config[Z].differentiator.clip     = 0.04f;
+    conf.pid_config[Z].differentiator.filter_tau = 0.02f;   // About 8 Hz
     conf.pid_config[Z].soft_zone_width         = 0.2f;
 
     return conf;
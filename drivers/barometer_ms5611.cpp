@@ -49,6 +49,10 @@ extern "C"
 #include "util/maths.h"
 }
 
+const float BARO_ALT_LPF    = 0.95f;        ///< low pass filter factor for altitude measured by the barometer
+const float VARIO_LPF       = 0.95f;        ///< low pass filter factor for the Vario altitude speed
+
+
 //------------------------------------------------------------------------------
 // PUBLIC FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
@@ -58,14 +62,27 @@ Barometer_MS5611::Barometer_MS5611(I2c& i2c, conf_t config):
     config_(config),
     state_(state_t::IDLE),
     last_state_update_us_(0.0f),
-    last_update_us_(0.0f),
+    last_update_us_(0),
     dt_s_(0.1f),
-    last_altitudes_{0.0f, 0.0f, 0.0f}
+    offset_(0),
+    sensitivity_(0),
+    compensation_valid_(false),
+    last_altitudes_{0.0f, 0.0f, 0.0f},
+    adc_cmd_(COMMAND_GET_DATA),
+    adc_data_{0, 0, 0},
+    conv_cmd_(0),
+    adc_is_temperature_(false),
+    adc_pending_(false),
+    adc_ready_(false),
+    adc_success_(false),
+    conv_success_(true)
 {
     pressure_           = 0.0f;
     temperature_        = 0.0f;
     altitude_gf_        = 0.0f;
+    altitude_gf_raw_    = 0.0f;
     speed_lf_           = 0.0f;
+    speed_lf_raw_       = 0.0f;
     temperature_        = 24.0f;    // Nice day
 }
 
@@ -118,6 +135,22 @@ bool Barometer_MS5611::update(void)
 {
     bool res = true;
 
+    // Bus transactions of previous update not complete yet, try again later
+    if (adc_pending_)
+    {
+        return res;
+    }
+
+    // Consume sample read at previous update
+    res &= consume_adc();
+
+    // Conversion was not started, restart sampling sequence
+    if (!conv_success_)
+    {
+        conv_success_   = true;
+        state_          = state_t::IDLE;
+    }
+
     switch (state_)
     {
         case state_t::INIT:
@@ -131,18 +164,17 @@ bool Barometer_MS5611::update(void)
 
         case state_t::GET_TEMPERATURE:
             res &= read_temperature();
-            res &= start_pressure_sampling();
             state_ = state_t::GET_PRESSURE;
         break;
 
         case state_t::GET_PRESSURE:
             res &= read_pressure();
-            res &= start_temperature_sampling();
             state_ = state_t::GET_TEMPERATURE;
         break;
     }
 
-    speed_lf_ = (float)state_;  // TODO remove
+    // With a blocking I2C the sample is already available
+    res &= consume_adc();
 
     last_state_update_us_ = time_keeper_get_us();
 
@@ -170,7 +202,7 @@ float Barometer_MS5611::altitude_gf(void) const
 
 float Barometer_MS5611::altitude_gf_raw(void) const
 {
-    return altitude_gf();
+    return altitude_gf_raw_;
 }
 
 
@@ -182,7 +214,7 @@ float Barometer_MS5611::vertical_speed_lf(void) const
 
 float Barometer_MS5611::vertical_speed_lf_raw(void) const
 {
-    return vertical_speed_lf();
+    return speed_lf_raw_;
 }
 
 
@@ -207,58 +239,168 @@ bool Barometer_MS5611::start_temperature_sampling(void)
 }
 
 bool Barometer_MS5611::read_temperature(void)
+{
+    uint8_t command = COMMAND_START_PRESSURE_CONV + (uint8_t)config_.oversampling_ratio_pressure;
+
+    time_sampling_start_ms_ = time_keeper_get_ms();
+
+    return read_adc(true, command);
+}
+
+bool Barometer_MS5611::read_pressure(void)
+{
+    uint8_t command = COMMAND_START_TEMPERATURE_CONV + (uint8_t)config_.oversampling_ratio_temperature;
+
+    return read_adc(false, command);
+}
+
+bool Barometer_MS5611::read_adc(bool is_temperature, uint8_t conv_command)
 {
     bool res = true;
 
-    // Get sampled data
-    uint8_t data[3];
-    uint8_t command = COMMAND_GET_DATA;
-    res &= i2c_.write(&command, 1, (uint8_t)config_.address);
-    res &= i2c_.read(data, 3, (uint8_t)config_.address);
+    adc_is_temperature_ = is_temperature;
+    conv_cmd_           = conv_command;
+    adc_pending_        = true;
 
-    // Convert raw data to temperature and apply calibration
-    int32_t raw_temperature      = ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 0);
-	int64_t delta_temp           = raw_temperature - (calib_.T_REF << 8);
-    int64_t temperature_unscaled = 2000 + ((delta_temp * calib_.TEMPSENS) >> 23);
-    float temperature            = ((float)temperature_unscaled) / 100.0f;
+    res &= i2c_.transfer_async(&adc_cmd_, 1, adc_data_, 3, (uint8_t)config_.address, &Barometer_MS5611::adc_callback, this);
 
-    // second order temperature compensation
-	if (temperature < 2000)
+    if (!res)
     {
-		temperature_unscaled -= (delta_temp * delta_temp) >> 31;
+        adc_pending_ = false;
+        state_       = state_t::IDLE;
     }
 
-    // TODO
-    temperature_ = raw_temperature; // temperature_unscaled;
-
     return res;
 }
 
-bool Barometer_MS5611::start_pressure_sampling(void)
+void Barometer_MS5611::adc_callback(void* data, bool success)
 {
-    bool res = true;
+    Barometer_MS5611* baro = (Barometer_MS5611*)data;
 
-    uint8_t command = COMMAND_START_PRESSURE_CONV + (uint8_t)config_.oversampling_ratio_pressure;
-    res &= i2c_.write(&command, 1, (uint8_t)config_.address);
+    baro->adc_success_  = success;
+    baro->adc_ready_    = true;
 
-    time_sampling_start_ms_ = time_keeper_get_ms();
+    // Start next conversion right away
+    if (!baro->i2c_.transfer_async(&baro->conv_cmd_, 1, NULL, 0, (uint8_t)baro->config_.address, &Barometer_MS5611::conv_callback, baro))
+    {
+        conv_callback(baro, false);
+    }
+}
 
-    return res;
+void Barometer_MS5611::conv_callback(void* data, bool success)
+{
+    Barometer_MS5611* baro = (Barometer_MS5611*)data;
+
+    baro->conv_success_ = success;
+    baro->adc_pending_  = false;
 }
 
-bool Barometer_MS5611::read_pressure(void)
+bool Barometer_MS5611::consume_adc(void)
 {
-    bool res = true;
+    if (!adc_ready_)
+    {
+        return true;
+    }
+    adc_ready_ = false;
 
-    // Get sampled data
-    uint8_t data[3];
-    uint8_t command = COMMAND_GET_DATA;
-    res &= i2c_.write(&command, 1, (uint8_t)config_.address);
-    res &= i2c_.read(data, 3, (uint8_t)config_.address);
+    bool res = adc_success_;
+    const uint8_t* data = adc_data_;
+
+    if (!res)
+    {
+        return res;
+    }
+
+    int64_t raw = ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 0);
+
+    if (adc_is_temperature_)
+    {
+        // Temperature and compensation of the next pressure samples (MS5611 datasheet)
+        int64_t delta_temp  = raw - ((int64_t)calib_.T_REF << 8);
+        int64_t temp        = 2000 + ((delta_temp * calib_.TEMPSENS) >> 23);
+        int64_t offset      = ((int64_t)calib_.OFF_T1 << 16) + ((delta_temp * calib_.TCO) >> 7);
+        int64_t sensitivity = ((int64_t)calib_.SENS_T1 << 15) + ((delta_temp * calib_.TCS) >> 8);
+
+        // Second order temperature compensation, below 20 degrees
+        if (temp < 2000)
+        {
+            int64_t low = SQR(temp - 2000);
+            temp        -= (delta_temp * delta_temp) >> 31;
+            offset      -= (5 * low) >> 1;
+            sensitivity -= (5 * low) >> 2;
+
+            // Below -15 degrees
+            if (temp < -1500)
+            {
+                int64_t very_low = SQR(temp + 1500);
+                offset      -= 7 * very_low;
+                sensitivity -= (11 * very_low) >> 1;
+            }
+        }
+
+        temperature_            = (float)temp / 100.0f;
+        offset_                 = offset;
+        sensitivity_            = sensitivity;
+        compensation_valid_     = true;
+
+        return res;
+    }
+
+    // No temperature sample yet to compensate the pressure
+    if (!compensation_valid_)
+    {
+        return res;
+    }
+
+    // Compensated pressure in Pa
+    pressure_ = (float)((((raw * sensitivity_) >> 21) - offset_) >> 15);
+
+    // Altitude, median filter on last 3 altitudes
+    float altitude_raw_old = altitude_gf_raw_;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        last_altitudes_[i] = last_altitudes_[i + 1];
+    }
+    last_altitudes_[2] = compute_altitude_from_pressure(pressure_);
+    altitude_gf_raw_   = maths_median_filter_3x(last_altitudes_[0], last_altitudes_[1], last_altitudes_[2]);
+
+    // Time interval since last update
+    uint64_t now_us = time_keeper_get_us();
+    dt_s_ = (now_us - last_update_us_) / 1000000.0f;
+
+    // First sample, or no sample for too long: restart the filters
+    if ((last_update_us_ == 0) || (dt_s_ > 1.0f))
+    {
+        altitude_gf_    = altitude_gf_raw_;
+        speed_lf_       = 0.0f;
+        speed_lf_raw_   = 0.0f;
+        last_update_us_ = now_us;
+        return res;
+    }
+
+    // Low pass filter the altitude, only if this is not a spike
+    float altitude_filtered_old = altitude_gf_;
+    if (maths_f_abs(altitude_gf_raw_ - altitude_filtered_old) < 15.0f)
+    {
+        altitude_gf_ = (BARO_ALT_LPF * altitude_filtered_old) + (1.0f - BARO_ALT_LPF) * altitude_gf_raw_;
+    }
+    else
+    {
+        altitude_gf_ = altitude_gf_raw_;
+    }
+
+    // Vertical speed (NED), from raw and filtered altitudes
+    speed_lf_raw_ = - (altitude_gf_raw_ - altitude_raw_old) / dt_s_;
+    float new_speed_lf = - (altitude_gf_ - altitude_filtered_old) / dt_s_;
+
+    // Remove spikes
+    if (maths_f_abs(new_speed_lf) > 20.0f)
+    {
+        new_speed_lf = 0.0f;
+    }
+    speed_lf_ = (VARIO_LPF * speed_lf_) + (1.0f - VARIO_LPF) * new_speed_lf;
 
-    // TODO
-    int32_t raw_pressure      = ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 0);
-    altitude_gf_ = raw_pressure;
+    last_update_us_ = now_us;
 
     return res;
 }
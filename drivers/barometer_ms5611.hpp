@@ -220,15 +220,30 @@ private:
     uint32_t time_sampling_start_ms_;   ///< sampling starting time
 
     float       last_state_update_us_;  ///< Time of the last state update
-    float       last_update_us_;        ///< Time of the last update
+    uint64_t    last_update_us_;        ///< Time of the last update
     float       dt_s_;                  ///< Time step for the derivative
+
+    int64_t     offset_;                ///< Pressure offset at the last measured temperature (OFF)
+    int64_t     sensitivity_;           ///< Pressure sensitivity at the last measured temperature (SENS)
+    bool        compensation_valid_;    ///< A temperature sample was decoded, pressure can be compensated
     float   pressure_;              ///< Measured pressure (in Pa)
     float   temperature_;           ///< Measured temperature
     float   altitude_gf_;           ///< Measured altitude (global frame)
+    float   altitude_gf_raw_;       ///< Measured altitude, median of the last 3 samples (global frame)
     float   speed_lf_;              ///< Vario altitude speed (ned frame)
+    float   speed_lf_raw_;          ///< Unfiltered vario altitude speed (ned frame)
 
     float       last_altitudes_[3];     ///< Array to store previous value of the altitude for low pass filtering the output
 
+    uint8_t         adc_cmd_;               ///< Command sent to read the ADC
+    uint8_t         adc_data_[3];           ///< Raw ADC value of the last asynchronous read
+    uint8_t         conv_cmd_;              ///< Conversion command sent after the ADC read
+    bool            adc_is_temperature_;    ///< The last ADC read is a temperature sample
+    volatile bool   adc_pending_;           ///< ADC read or conversion command in progress
+    volatile bool   adc_ready_;             ///< ADC read completed and not decoded yet
+    volatile bool   adc_success_;           ///< Result of the last ADC read
+    volatile bool   conv_success_;          ///< Result of the last conversion command
+
     /**
      * \brief   Start temperature sampling
      *
@@ -237,25 +252,55 @@ private:
     bool start_temperature_sampling(void);
 
     /**
-     * \brief   Read pressure sampling
+     * \brief   Read temperature sampling, then start pressure sampling
+     *
+     * \details Asynchronous, the sample is decoded by consume_adc
      *
      * \return  success
      */
     bool read_temperature(void);
 
     /**
-     * \brief   Start pressure sampling
+     * \brief   Read pressure sampling, then start temperature sampling
+     *
+     * \details Asynchronous, the sample is decoded by consume_adc
      *
      * \return  success
      */
-    bool start_pressure_sampling(void);
+    bool read_pressure(void);
 
     /**
-     * \brief   Read pressure sampling
+     * \brief   Submit an ADC read followed by a conversion command
+     *
+     * \param   is_temperature  The ADC holds a temperature sample
+     * \param   conv_command    Conversion to start once the ADC is read
      *
      * \return  success
      */
-    bool read_pressure(void);
+    bool read_adc(bool is_temperature, uint8_t conv_command);
+
+    /**
+     * \brief   Decode the last ADC read, if any
+     *
+     * \return  success of the decoded read
+     */
+    bool consume_adc(void);
+
+    /**
+     * \brief   Completion callback of the ADC read, submits the conversion command
+     *
+     * \param   data        Pointer to the Barometer_MS5611 instance
+     * \param   success     Result of the transfer
+     */
+    static void adc_callback(void* data, bool success);
+
+    /**
+     * \brief   Completion callback of the conversion command
+     *
+     * \param   data        Pointer to the Barometer_MS5611 instance
+     * \param   success     Result of the transfer
+     */
+    static void conv_callback(void* data, bool success);
 };
 
 
@@ -37,6 +37,12 @@
  *
  * \brief Hub for GPS redundancy
  *
+ * \details In selection mode, the hub forwards the best receiver. In blending
+ *          mode, the receivers with a 3D fix are fused: positions are shifted
+ *          to the time of the most recent one using their velocity, weighted
+ *          by the inverse of their reported variance, and receivers
+ *          inconsistent with the others are rejected.
+ *
  ******************************************************************************/
 
 
@@ -44,6 +50,36 @@
 #define GPS_HUB_HPP_
 
 #include "drivers/gps.hpp"
+#include "hal/common/time_keeper.hpp"
+
+extern "C"
+{
+#include <math.h>
+}
+
+
+/**
+ * \brief  Mode of the GPS hub
+ */
+typedef enum
+{
+    GPS_HUB_MODE_SELECT = 0,        ///< Forward the receiver with best fix
+    GPS_HUB_MODE_BLEND  = 1,        ///< Fuse receivers weighted by their accuracy
+} gps_hub_mode_t;
+
+
+/**
+ * \brief  Configuration for the GPS hub
+ */
+typedef struct
+{
+    gps_hub_mode_t mode;            ///< Selection or blending
+    float timeout_us;               ///< Receivers without new position for longer are not blended
+    float min_accuracy;             ///< Lower bound on reported accuracies, in m and m/s
+    float outlier_gate;             ///< Receivers further than this number of standard deviations from the blend are rejected
+} gps_hub_conf_t;
+
+static inline gps_hub_conf_t gps_hub_default_config();
 
 
 /**
@@ -59,10 +95,16 @@ public:
 
     /**
      * \brief Constructor
+     *
+     * \param  gps_list    Receivers connected to the hub
+     * \param  config      Configuration
      */
-    Gps_hub(std::array<Gps*, N> gps_list):
+    Gps_hub(std::array<Gps*, N> gps_list, const gps_hub_conf_t& config = gps_hub_default_config()):
+        config_(config),
         gps_list_(gps_list),
-        current_gps_(gps_list_[0])
+        current_gps_(gps_list_[0]),
+        blended_(false),
+        used_count_(0)
     {};
 
     /**
@@ -94,6 +136,15 @@ public:
             }
         }
 
+        if (config_.mode == GPS_HUB_MODE_BLEND)
+        {
+            blended_ = blend();
+        }
+        else
+        {
+            blended_ = false;
+        }
+
         return ret;
     };
 
@@ -136,6 +187,10 @@ public:
      */
     float last_update_us(void) const
     {
+        if (blended_)
+        {
+            return last_update_us_;
+        }
         return current_gps_->last_update_us();
     };
 
@@ -147,6 +202,10 @@ public:
      */
     float last_position_update_us(void) const
     {
+        if (blended_)
+        {
+            return last_position_update_us_;
+        }
         return current_gps_->last_position_update_us();
     };
 
@@ -158,6 +217,10 @@ public:
      */
     float last_velocity_update_us(void) const
     {
+        if (blended_)
+        {
+            return last_velocity_update_us_;
+        }
         return current_gps_->last_velocity_update_us();
     };
 
@@ -169,6 +232,10 @@ public:
      */
     global_position_t position_gf(void) const
     {
+        if (blended_)
+        {
+            return position_gf_;
+        }
         return current_gps_->position_gf();
     };
 
@@ -180,6 +247,10 @@ public:
      */
     float horizontal_position_accuracy(void) const
     {
+        if (blended_)
+        {
+            return horizontal_position_accuracy_;
+        }
         return current_gps_->horizontal_position_accuracy();
     };
 
@@ -191,6 +262,10 @@ public:
      */
     float vertical_position_accuracy(void) const
     {
+        if (blended_)
+        {
+            return vertical_position_accuracy_;
+        }
         return current_gps_->vertical_position_accuracy();
     };
 
@@ -202,6 +277,10 @@ public:
      */
     std::array<float, 3> velocity_lf(void) const
     {
+        if (blended_)
+        {
+            return velocity_lf_;
+        }
         return current_gps_->velocity_lf();
     };
 
@@ -213,6 +292,10 @@ public:
      */
     float velocity_accuracy(void) const
     {
+        if (blended_)
+        {
+            return velocity_accuracy_;
+        }
         return current_gps_->velocity_accuracy();
     };
 
@@ -224,6 +307,10 @@ public:
      */
     float heading(void) const
     {
+        if (blended_)
+        {
+            return heading_;
+        }
         return current_gps_->heading();
     };
 
@@ -235,6 +322,10 @@ public:
      */
     float heading_accuracy(void) const
     {
+        if (blended_)
+        {
+            return heading_accuracy_;
+        }
         return current_gps_->heading_accuracy();
     };
 
@@ -246,6 +337,10 @@ public:
      */
     uint8_t num_sats(void) const
     {
+        if (blended_)
+        {
+            return num_sats_;
+        }
         return current_gps_->num_sats();
     };
 
@@ -257,6 +352,10 @@ public:
      */
     gps_fix_t fix(void) const
     {
+        if (blended_)
+        {
+            return fix_;
+        }
         return current_gps_->fix();
     };
 
@@ -268,13 +367,270 @@ public:
      */
     bool healthy(void) const
     {
+        if (blended_)
+        {
+            return true;
+        }
         return current_gps_->healthy();
     };
 
+
+    /**
+     * \brief   Get the number of receivers used in the last blended solution
+     *
+     * \return  Value, 0 if not blending
+     */
+    uint32_t used_count(void) const
+    {
+        return blended_ ? used_count_ : 0;
+    };
+
+
+    /**
+     * \brief   Get configuration
+     *
+     * \return  Reference to configuration
+     */
+    gps_hub_conf_t& config(void)
+    {
+        return config_;
+    };
+
 protected:
-    std::array<Gps*, N> gps_list_;
-    Gps*                current_gps_;
+    /**
+     * \brief   Computes the blended solution
+     *
+     * \return  false if no receiver can be used
+     */
+    bool blend(void)
+    {
+        float now_us = time_keeper_get_us();
+
+        // Receivers with a recent 3D fix
+        bool used[N];
+        uint32_t count = 0;
+        Gps* reference = NULL;
+        float t_ref_us = 0.0f;
+        for (size_t i = 0; i < N; i++)
+        {
+            Gps* gps = gps_list_[i];
+            used[i] = gps->healthy()
+                      && (gps->fix() >= FIX_3D)
+                      && ((now_us - gps->last_position_update_us()) < config_.timeout_us);
+            if (used[i])
+            {
+                count++;
+                if ((reference == NULL) || (gps->horizontal_position_accuracy() < reference->horizontal_position_accuracy()))
+                {
+                    reference = gps;
+                }
+                if (gps->last_position_update_us() > t_ref_us)
+                {
+                    t_ref_us = gps->last_position_update_us();
+                }
+            }
+        }
+        if (count == 0)
+        {
+            return false;
+        }
+
+        // Positions in a local frame centered on the most accurate receiver,
+        // propagated to the time of the most recent measurement
+        const global_position_t origin = reference->position_gf();
+        local_position_t pos[N];
+        float var_h[N];
+        float var_v[N];
+        float var_vel[N];
+        for (size_t i = 0; i < N; i++)
+        {
+            if (!used[i])
+            {
+                continue;
+            }
+            Gps* gps = gps_list_[i];
+            std::array<float, 3> vel = gps->velocity_lf();
+            float dt_s = (t_ref_us - gps->last_position_update_us()) * 1e-6f;
+            coord_conventions_global_to_local_position(gps->position_gf(), origin, pos[i]);
+            for (size_t k = 0; k < 3; k++)
+            {
+                pos[i][k] += vel[k] * dt_s;
+            }
+
+            float acc_vel = bounded_accuracy(gps->velocity_accuracy());
+            float acc_h   = bounded_accuracy(gps->horizontal_position_accuracy());
+            float acc_v   = bounded_accuracy(gps->vertical_position_accuracy());
+            var_vel[i]  = acc_vel * acc_vel;
+            var_h[i]    = acc_h * acc_h + var_vel[i] * dt_s * dt_s;
+            var_v[i]    = acc_v * acc_v + var_vel[i] * dt_s * dt_s;
+        }
+
+        // Weighted mean, rejecting the least consistent receiver until all agree
+        local_position_t mean;
+        float sum_h = 0.0f;
+        float sum_v = 0.0f;
+        while (true)
+        {
+            mean = local_position_t{{0.0f, 0.0f, 0.0f}};
+            sum_h = 0.0f;
+            sum_v = 0.0f;
+            for (size_t i = 0; i < N; i++)
+            {
+                if (used[i])
+                {
+                    mean[0] += pos[i][0] / var_h[i];
+                    mean[1] += pos[i][1] / var_h[i];
+                    mean[2] += pos[i][2] / var_v[i];
+                    sum_h   += 1.0f / var_h[i];
+                    sum_v   += 1.0f / var_v[i];
+                }
+            }
+            mean[0] /= sum_h;
+            mean[1] /= sum_h;
+            mean[2] /= sum_v;
+
+            if (count == 1)
+            {
+                break;
+            }
+
+            int32_t worst = -1;
+            float worst_distance = config_.outlier_gate * config_.outlier_gate;
+            for (size_t i = 0; i < N; i++)
+            {
+                if (used[i])
+                {
+                    float dx = pos[i][0] - mean[0];
+                    float dy = pos[i][1] - mean[1];
+                    float dz = pos[i][2] - mean[2];
+                    float distance = (dx * dx + dy * dy) / var_h[i] + (dz * dz) / var_v[i];
+                    if (distance > worst_distance)
+                    {
+                        worst_distance = distance;
+                        worst = i;
+                    }
+                }
+            }
+            if (worst < 0)
+            {
+                break;
+            }
+            used[worst] = false;
+            count--;
+        }
+
+        // Velocity and metadata from the remaining receivers
+        std::array<float, 3> velocity = {{0.0f, 0.0f, 0.0f}};
+        float sum_vel = 0.0f;
+        float best_var_vel = 0.0f;
+        Gps* best_vel = NULL;
+        gps_fix_t fix = FIX_ERR;
+        uint8_t num_sats = 0;
+        float last_update_us = 0.0f;
+        float last_velocity_update_us = 0.0f;
+        for (size_t i = 0; i < N; i++)
+        {
+            if (!used[i])
+            {
+                continue;
+            }
+            Gps* gps = gps_list_[i];
+            std::array<float, 3> vel = gps->velocity_lf();
+            for (size_t k = 0; k < 3; k++)
+            {
+                velocity[k] += vel[k] / var_vel[i];
+            }
+            sum_vel += 1.0f / var_vel[i];
+
+            if ((best_vel == NULL) || (var_vel[i] < best_var_vel))
+            {
+                best_vel = gps;
+                best_var_vel = var_vel[i];
+            }
+            if (gps->fix() > fix)
+            {
+                fix = gps->fix();
+            }
+            if (gps->num_sats() > num_sats)
+            {
+                num_sats = gps->num_sats();
+            }
+            if (gps->last_update_us() > last_update_us)
+            {
+                last_update_us = gps->last_update_us();
+            }
+            if (gps->last_velocity_update_us() > last_velocity_update_us)
+            {
+                last_velocity_update_us = gps->last_velocity_update_us();
+            }
+        }
+        for (size_t k = 0; k < 3; k++)
+        {
+            velocity[k] /= sum_vel;
+        }
+
+        coord_conventions_local_to_global_position(mean, origin, position_gf_);
+        horizontal_position_accuracy_   = sqrtf(1.0f / sum_h);
+        vertical_position_accuracy_     = sqrtf(1.0f / sum_v);
+        velocity_lf_                    = velocity;
+        velocity_accuracy_              = sqrtf(1.0f / sum_vel);
+        heading_                        = best_vel->heading();
+        heading_accuracy_               = best_vel->heading_accuracy();
+        num_sats_                       = num_sats;
+        fix_                            = fix;
+        last_update_us_                 = last_update_us;
+        last_position_update_us_        = t_ref_us;
+        last_velocity_update_us_        = last_velocity_update_us;
+        used_count_                     = count;
+
+        return true;
+    };
+
+
+    /**
+     * \brief   Bounds an accuracy reported by a receiver
+     *
+     * \param   accuracy    Reported accuracy
+     *
+     * \return  Accuracy used for weighting
+     */
+    float bounded_accuracy(float accuracy) const
+    {
+        return (accuracy > config_.min_accuracy) ? accuracy : config_.min_accuracy;
+    };
+
+    gps_hub_conf_t      config_;                            ///< Configuration
+    std::array<Gps*, N> gps_list_;                          ///< Receivers
+    Gps*                current_gps_;                       ///< Selected receiver
+    bool                blended_;                           ///< Indicates whether the outputs are the blended solution
+    uint32_t            used_count_;                        ///< Number of receivers in the blended solution
+
+    float               last_update_us_;                    ///< Blended last update time in microseconds
+    float               last_position_update_us_;           ///< Time the blended position refers to, in microseconds
+    float               last_velocity_update_us_;           ///< Blended last velocity update time in microseconds
+    global_position_t   position_gf_;                       ///< Blended global position
+    float               horizontal_position_accuracy_;      ///< Blended horizontal accuracy in m
+    float               vertical_position_accuracy_;        ///< Blended vertical accuracy in m
+    std::array<float, 3> velocity_lf_;                      ///< Blended velocity in local frame in m/s
+    float               velocity_accuracy_;                 ///< Blended velocity accuracy in m/s
+    float               heading_;                           ///< Heading of the receiver with best velocity, in degrees
+    float               heading_accuracy_;                  ///< Heading accuracy in degrees
+    uint8_t             num_sats_;                          ///< Largest number of satellites among used receivers
+    gps_fix_t           fix_;                               ///< Best fix among used receivers
 };
 
 
+static inline gps_hub_conf_t gps_hub_default_config()
+{
+    gps_hub_conf_t conf = {};
+
+    conf.mode           = GPS_HUB_MODE_SELECT;
+    conf.timeout_us     = 500000.0f;
+    conf.min_accuracy   = 0.1f;
+    conf.outlier_gate   = 5.0f;
+
+    return conf;
+}
+
+
 #endif /* GPS_HUB_HPP_ */
@@ -37,8 +37,8 @@
  *
  * \brief Driver for UBLOX GPS
  *
- * \detail  Only one instance can be used
- *          TODO: remove global variables in gps_ublox.cpp
+ * \detail  All state is held by the instance, so several receivers can be
+ *          used on different serial ports
  *
  ******************************************************************************/
 
@@ -49,6 +49,7 @@
 #include "drivers/gps.hpp"
 
 #include "hal/common/serial.hpp"
+#include "drivers/ubx_parser.hpp"
 
 
 /**
@@ -57,6 +58,20 @@
 class Gps_ublox: public Gps
 {
 public:
+    /**
+     * \brief   Date and time received from the GPS, in local time
+     */
+    struct date_time_t
+    {
+        uint16_t year;                          ///< Year
+        uint8_t month;                          ///< Month
+        uint8_t day;                            ///< Day
+        uint8_t hour;                           ///< Hour
+        uint8_t minute;                         ///< Minute
+        uint8_t second;                         ///< Second
+        uint8_t validity;                       ///< Time validity
+    };
+
     /**
      * \brief   Constructor
      *
@@ -195,7 +210,56 @@ public:
     void configure(void);
 
 
+    /**
+     * \brief   Get last date and time received
+     *
+     * \return  date and time
+     */
+    const date_time_t& date(void) const;
+
+
+    /**
+     * \brief   Get statistics of the UBX parser
+     *
+     * \return  statistics
+     */
+    const Ubx_parser::stats_t& parser_stats(void) const;
+
+
 private:
+    /**
+     * \brief   Sends the next configuration message, called by update() while configuring
+     */
+    void configure_gps(void);
+
+    /**
+     * \brief   UBX message handlers, decode the payload in the class members
+     *
+     * \param   data        Pointer to the Gps_ublox instance
+     * \param   msg_class   Class of the message
+     * \param   msg_id      Id of the message
+     * \param   payload     Payload of the message
+     * \param   length      Length of the payload
+     */
+    static void handle_nav_posllh(void* data, uint8_t msg_class, uint8_t msg_id, const uint8_t* payload, uint16_t length);
+    static void handle_nav_status(void* data, uint8_t msg_class, uint8_t msg_id, const uint8_t* payload, uint16_t length);
+    static void handle_nav_sol(void* data, uint8_t msg_class, uint8_t msg_id, const uint8_t* payload, uint16_t length);
+    static void handle_nav_velned(void* data, uint8_t msg_class, uint8_t msg_id, const uint8_t* payload, uint16_t length);
+    static void handle_nav_timeutc(void* data, uint8_t msg_class, uint8_t msg_id, const uint8_t* payload, uint16_t length);
+    static void handle_ack(void* data, uint8_t msg_class, uint8_t msg_id, const uint8_t* payload, uint16_t length);
+    static void handle_cfg_nav_settings(void* data, uint8_t msg_class, uint8_t msg_id, const uint8_t* payload, uint16_t length);
+    static void handle_unknown(void* data, uint8_t msg_class, uint8_t msg_id, const uint8_t* payload, uint16_t length);
+
+    /**
+     * \brief   Converts UBX fix type and status flags
+     *
+     * \param   fix_type    UBX gpsFix field
+     * \param   flags       UBX flags field
+     *
+     * \return  fix
+     */
+    static gps_fix_t fix_from_ubx(uint8_t fix_type, uint8_t flags);
+
     Serial&             serial_;                            ///< Reference to Serial peripheral
 
     float               last_update_us_;                    ///< Last update time in microseconds
@@ -211,6 +275,27 @@ private:
     uint8_t             num_sats_;                          ///< Number of visible satelites
     gps_fix_t           fix_;                               ///< Indicates whether a fix was acquired
     bool                healthy_;                           ///< Indicates whether the measurements can be trusted
+
+    static const uint32_t RX_CHUNK_SIZE = 60;               ///< Largest subscribed frame (NAV-SOL): header (6) + payload (52) + checksum (2)
+    uint8_t             rx_chunk_[RX_CHUNK_SIZE];           ///< Bytes read from serials without direct access to their reception buffer
+    Ubx_parser          parser_;                            ///< UBX framing parser
+    date_time_t         date_;                              ///< Last date and time received
+    uint8_t             time_zone_;                         ///< Time zone used to convert UTC to local time
+    bool                debug_;                             ///< Print unexpected messages
+    uint8_t             engine_nav_setting_;                ///< Dynamic platform model requested to the GPS
+    uint8_t             disable_counter_;                   ///< Counter of unexpected messages before disabling them
+    bool                new_position_;                      ///< Position received since last update
+    bool                new_speed_;                         ///< Velocity received since last update
+    uint32_t            idle_timer_ms_;                     ///< Time of last complete update in ms
+    uint32_t            idle_timeout_ms_;                   ///< Time without update before loosing the fix in ms
+    uint32_t            time_last_posllh_ms_;               ///< Time of last position message in ms
+    uint32_t            time_last_velned_ms_;               ///< Time of last velocity message in ms
+
+    bool                configure_gps_;                     ///< Configuration is ongoing
+    bool                acknowledged_received_;             ///< Last configuration message was acknowledged
+    uint16_t            config_loop_count_;                 ///< Index of the configuration message
+    uint16_t            config_nav_msg_count_;              ///< Number of configuration messages sent
+    uint32_t            configure_timer_;                   ///< Time of last configuration message in ms
 };
 
 
@@ -141,7 +141,12 @@ Hmc5883l::Hmc5883l(I2c& i2c):
     i2c_(i2c),
     data_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
     last_update_us_(0.0f),
-    temperature_(0.0f)
+    temperature_(0.0f),
+    read_cmd_(DATA_REG_BEGIN),
+    read_buffer_{0, 0, 0},
+    read_pending_(false),
+    read_ready_(false),
+    read_success_(false)
 {}
 
 
@@ -169,20 +174,24 @@ bool Hmc5883l::init(void)
 
 bool Hmc5883l::update(void)
 {
-    bool success        = true;
-    uint16_t buffer[3]  = {0, 0, 0};
+    bool success = true;
 
-    // Read data from sensor
-    success &= i2c_.write(&DATA_REG_BEGIN, 1, HMC5883_SLAVE_ADDRESS);
-    success &= i2c_.read((uint8_t*)buffer, 6, HMC5883_SLAVE_ADDRESS);
+    // Consume data read since last update
+    success &= decode();
 
-    // Copy to member data
-    data_[0] = (float)((int16_t)buffer[0]);
-    data_[1] = (float)((int16_t)buffer[1]);
-    data_[2] = (float)((int16_t)buffer[2]);
+    // Submit next read
+    if (!read_pending_)
+    {
+        read_pending_ = true;
+        if (!i2c_.transfer_async(&read_cmd_, 1, (uint8_t*)read_buffer_, 6, HMC5883_SLAVE_ADDRESS, &Hmc5883l::read_callback, this))
+        {
+            read_pending_ = false;
+            success = false;
+        }
+    }
 
-    // Save last update time
-    last_update_us_ = time_keeper_get_us();
+    // With a blocking I2C the read is already complete
+    success &= decode();
 
     return success;
 }
@@ -222,3 +231,38 @@ const float& Hmc5883l::temperature(void) const
 {
     return temperature_;
 }
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+bool Hmc5883l::decode(void)
+{
+    if (!read_ready_)
+    {
+        return true;
+    }
+
+    // Copy to member data
+    data_[0] = (float)((int16_t)read_buffer_[0]);
+    data_[1] = (float)((int16_t)read_buffer_[1]);
+    data_[2] = (float)((int16_t)read_buffer_[2]);
+
+    // Save last update time
+    last_update_us_ = time_keeper_get_us();
+
+    read_ready_ = false;
+
+    return read_success_;
+}
+
+
+void Hmc5883l::read_callback(void* data, bool success)
+{
+    Hmc5883l* hmc = (Hmc5883l*)data;
+
+    hmc->read_success_  = success;
+    hmc->read_ready_    = true;
+    hmc->read_pending_  = false;
+}
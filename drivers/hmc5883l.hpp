@@ -79,7 +79,9 @@ public:
 
     /**
      * \brief   Main update function
-     * \detail  Reads new values from sensor
+     * \detail  Consumes the values read since the previous update and
+     *          submits the next asynchronous read. With a blocking I2C
+     *          the read completes immediately and is consumed right away.
      *
      * \return  Success
      */
@@ -155,6 +157,26 @@ private:
     std::array<float, 3> data_;             ///< sensor data
     float                last_update_us_;   ///< Last update time in microseconds
     float                temperature_;      ///< NOT SUPPORTED : temperature
+    uint8_t              read_cmd_;         ///< Register to read from
+    uint16_t             read_buffer_[3];   ///< Raw data of the last asynchronous read
+    volatile bool        read_pending_;     ///< Asynchronous read in progress
+    volatile bool        read_ready_;       ///< Asynchronous read completed and not decoded yet
+    volatile bool        read_success_;     ///< Result of the last asynchronous read
+
+    /**
+     * \brief   Decode the last completed read, if any
+     *
+     * \return  Success of the decoded read
+     */
+    bool decode(void);
+
+    /**
+     * \brief   Completion callback of the asynchronous read
+     *
+     * \param   data        Pointer to the Hmc5883l instance
+     * \param   success     Result of the transfer
+     */
+    static void read_callback(void* data, bool success);
 };
 
 
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file inertial_fifo.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Interface for inertial sensors buffering samples between updates
+ *
+ ******************************************************************************/
+
+
+#ifndef INERTIAL_FIFO_HPP_
+#define INERTIAL_FIFO_HPP_
+
+
+#include <cstdint>
+#include <array>
+
+
+/**
+ * \brief Abstract class for sensors providing all accelerometer and gyroscope
+ *        samples measured since the previous update
+ *
+ * \details Samples are raw data in the sensor frame, with the same units as
+ *          Accelerometer::acc and Gyroscope::gyro. They are ordered from the
+ *          oldest to the newest and are evenly spaced in time.
+ */
+class Inertial_fifo
+{
+public:
+    /**
+     * \brief   Get the number of samples read during the last update
+     *
+     * \return  Number of samples, 0 if the FIFO is not used
+     */
+    virtual uint32_t fifo_sample_count(void) const = 0;
+
+
+    /**
+     * \brief   Get time between two samples
+     *
+     * \return  Sample period in seconds
+     */
+    virtual float fifo_sample_period_s(void) const = 0;
+
+
+    /**
+     * \brief   Get one sample read during the last update
+     *
+     * \param   index   Index of the sample, 0 being the oldest
+     * \param   acc     Output acceleration
+     * \param   gyro    Output angular velocity
+     *
+     * \return  Success, false if index is out of range
+     */
+    virtual bool fifo_sample(uint32_t index, std::array<float, 3>& acc, std::array<float, 3>& gyro) const = 0;
+};
+
+
+#endif /* INERTIAL_FIFO_HPP_ */
@@ -54,8 +54,24 @@ Mpu_9250::Mpu_9250(Spi& spi, Gpio& nss_gpio, const conf_t config):
     mag_data_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
     temperature_(0.0f),
     last_update_us_(0.0f),
-    config_(config)
-{
+    config_(config),
+    fifo_sample_count_(0),
+    fifo_sample_period_s_(1.0f / (float)config.default_sample_rate),
+    fifo_fresh_acc_(false),
+    fifo_fresh_gyr_(false),
+    prefetch_pending_(false),
+    prefetch_ready_(false),
+    prefetch_success_(false),
+    prefetch_fresh_acc_(false),
+    prefetch_fresh_gyr_(false),
+    prefetch_fresh_mag_(false)
+{
+    prefetch_tx_[0] = ACCEL_X_OUT_MSB | READ_FLAG;
+    for (uint32_t i = 1; i < PREFETCH_SIZE; ++i)
+    {
+        prefetch_tx_[i] = 0;
+    }
+
     switch (config.acc_range)
     {
         case ACC_2G:
@@ -156,12 +172,35 @@ bool Mpu_9250::init(void)
     success &= set_acc_range();
     success &= set_gyro_range();
 
+    // Configuring FIFO
+    if (config_.fifo_enabled)
+    {
+        uint8_t fifo_en = (uint8_t)(FIFOEN_ACCEL | FIFOEN_GYRO_XYZ);
+        success &= write_reg(FIFO_EN_REG, &fifo_en);
+        success &= reset_fifo();
+    }
+
     return success;
 }
 
 
 bool Mpu_9250::update_acc(void)
 {
+    if (config_.fifo_enabled)
+    {
+        bool success = true;
+        if (!fifo_fresh_acc_)
+        {
+            success &= update_fifo();
+        }
+        fifo_fresh_acc_ = false;
+        return success;
+    }
+    else if (config_.prefetch_enabled)
+    {
+        return update_prefetch(prefetch_fresh_acc_);
+    }
+
     bool success = true;
 
     // Read raw data from accelerometer (big endian)
@@ -184,6 +223,21 @@ bool Mpu_9250::update_acc(void)
 
 bool Mpu_9250::update_gyr(void)
 {
+    if (config_.fifo_enabled)
+    {
+        bool success = true;
+        if (!fifo_fresh_gyr_)
+        {
+            success &= update_fifo();
+        }
+        fifo_fresh_gyr_ = false;
+        return success;
+    }
+    else if (config_.prefetch_enabled)
+    {
+        return update_prefetch(prefetch_fresh_gyr_);
+    }
+
     bool success = true;
 
     // Read raw data from gyroscope (big endian)
@@ -206,6 +260,11 @@ bool Mpu_9250::update_gyr(void)
 
 bool Mpu_9250::update_mag(void)
 {
+    if (config_.prefetch_enabled && !config_.fifo_enabled)
+    {
+        return update_prefetch(prefetch_fresh_mag_);
+    }
+
     bool success = true;
 
     // Read raw data from magnetometer (little endian)
@@ -304,6 +363,38 @@ const float& Mpu_9250::temperature(void) const
     return temperature_;
 }
 
+
+uint32_t Mpu_9250::fifo_sample_count(void) const
+{
+    return fifo_sample_count_;
+}
+
+
+float Mpu_9250::fifo_sample_period_s(void) const
+{
+    return fifo_sample_period_s_;
+}
+
+
+bool Mpu_9250::fifo_sample(uint32_t index, std::array<float, 3>& acc, std::array<float, 3>& gyro) const
+{
+    if (index >= fifo_sample_count_)
+    {
+        return false;
+    }
+
+    const uint8_t* raw = &fifo_data_[index * FIFO_SAMPLE_SIZE];
+
+    // Accelerometer then gyroscope, big endian
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        acc[i]  = (float)((int16_t)(raw[2 * i]     << 8 | raw[2 * i + 1])) / acc_scale_;
+        gyro[i] = (float)((int16_t)(raw[2 * i + 6] << 8 | raw[2 * i + 7])) / gyro_scale_;
+    }
+
+    return true;
+}
+
 bool Mpu_9250::mag_reset(void)
 {
     bool ret = true;
@@ -443,6 +534,150 @@ bool Mpu_9250::write_reg(uint8_t reg, uint8_t* out_data, uint32_t nbytes)
 //------------------------------------------------------------------------------
 // PRIVATE FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
+bool Mpu_9250::update_fifo(void)
+{
+    bool success = true;
+
+    // Read number of bytes in FIFO (big endian)
+    uint8_t count_raw[2] = {0};
+    success &= read_reg(FIFO_COUNT_MSB, count_raw, 2);
+    uint32_t count = (uint32_t)(count_raw[0] << 8 | count_raw[1]);
+
+    if (!success)
+    {
+        fifo_sample_count_ = 0;
+        return false;
+    }
+
+    // The oldest samples were overwritten, data is not aligned anymore
+    if (count > FIFO_MAX_SAMPLES * FIFO_SAMPLE_SIZE)
+    {
+        fifo_sample_count_ = 0;
+        reset_fifo();
+        return false;
+    }
+
+    // Read complete samples in one burst
+    fifo_sample_count_ = count / FIFO_SAMPLE_SIZE;
+    if (fifo_sample_count_ > 0)
+    {
+        success &= read_reg(FIFO_R_W_REG, fifo_data_, fifo_sample_count_ * FIFO_SAMPLE_SIZE);
+    }
+
+    if (!success)
+    {
+        fifo_sample_count_ = 0;
+        return false;
+    }
+
+    // Latest sample becomes the current value
+    if (fifo_sample_count_ > 0)
+    {
+        fifo_sample(fifo_sample_count_ - 1, acc_data_, gyro_data_);
+        last_update_us_ = time_keeper_get_us();
+    }
+
+    fifo_fresh_acc_ = true;
+    fifo_fresh_gyr_ = true;
+
+    return success;
+}
+
+bool Mpu_9250::update_prefetch(bool& fresh)
+{
+    bool success = true;
+
+    if (!fresh)
+    {
+        // Consume the burst completed since last update
+        success &= decode_prefetch();
+
+        // Submit the next burst
+        if (!prefetch_pending_)
+        {
+            prefetch_pending_ = true;
+            select_slave();
+            if (!spi_.transfer_async(prefetch_tx_, prefetch_rx_, PREFETCH_SIZE, &Mpu_9250::prefetch_callback, this))
+            {
+                unselect_slave();
+                prefetch_pending_ = false;
+                success = false;
+            }
+        }
+
+        // With a blocking SPI the burst is already complete
+        success &= decode_prefetch();
+    }
+
+    fresh = false;
+
+    return success;
+}
+
+
+bool Mpu_9250::decode_prefetch(void)
+{
+    if (!prefetch_ready_)
+    {
+        return true;
+    }
+
+    // Skip register address byte
+    const uint8_t* raw = &prefetch_rx_[1];
+
+    // Accelerometer (big endian)
+    acc_data_[0] = (float)((int16_t)(raw[0] << 8 | raw[1])) / acc_scale_;
+    acc_data_[1] = (float)((int16_t)(raw[2] << 8 | raw[3])) / acc_scale_;
+    acc_data_[2] = (float)((int16_t)(raw[4] << 8 | raw[5])) / acc_scale_;
+
+    // Temperature (big endian)
+    temperature_ = (float)((int16_t)(raw[6] << 8 | raw[7])) / 333.87f + 21.0f;
+
+    // Gyroscope (big endian)
+    gyro_data_[0] = (float)((int16_t)(raw[8]  << 8 | raw[9]))  / gyro_scale_;
+    gyro_data_[1] = (float)((int16_t)(raw[10] << 8 | raw[11])) / gyro_scale_;
+    gyro_data_[2] = (float)((int16_t)(raw[12] << 8 | raw[13])) / gyro_scale_;
+
+    // Magnetometer (little endian)
+    mag_data_[0] = (float)((int16_t)(raw[15] << 8 | raw[14]));
+    mag_data_[1] = (float)((int16_t)(raw[17] << 8 | raw[16]));
+    mag_data_[2] = (float)((int16_t)(raw[19] << 8 | raw[18]));
+
+    last_update_us_ = time_keeper_get_us();
+
+    prefetch_fresh_acc_ = true;
+    prefetch_fresh_gyr_ = true;
+    prefetch_fresh_mag_ = true;
+    prefetch_ready_     = false;
+
+    return prefetch_success_;
+}
+
+
+void Mpu_9250::prefetch_callback(void* data, bool success)
+{
+    Mpu_9250* mpu = (Mpu_9250*)data;
+
+    mpu->unselect_slave();
+    mpu->prefetch_success_  = success;
+    mpu->prefetch_ready_    = true;
+    mpu->prefetch_pending_  = false;
+}
+
+
+bool Mpu_9250::reset_fifo(void)
+{
+    bool success = true;
+
+    uint8_t user_ctrl = (uint8_t)(USERCTL_I2C_MST_EN | USERCTL_DIS_I2C | USERCTL_FIFO_RST);
+    success &= write_reg(USER_CTRL_REG, &user_ctrl);
+
+    user_ctrl = (uint8_t)(USERCTL_I2C_MST_EN | USERCTL_DIS_I2C | USERCTL_FIFO_EN);
+    success &= write_reg(USER_CTRL_REG, &user_ctrl);
+
+    return success;
+}
+
 bool Mpu_9250::set_acc_lpf(void)
 {
     uint8_t accelerometer_lpf = config_.acc_filter;
@@ -498,6 +733,7 @@ bool Mpu_9250::set_mpu_sample_rate(void)
     // Write sample rate divisor in register (effective divisor is sample
     // rate divisor +1)
     uint8_t sample_rate_div = (uint8_t)divisor;
+    fifo_sample_period_s_   = (float)(divisor + 1) / (float)filter_frequency;
     return write_reg(SMPLRT_DIV_REG, &sample_rate_div);
 }
 
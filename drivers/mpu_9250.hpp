@@ -50,6 +50,7 @@
 #include "drivers/accelerometer.hpp"
 #include "drivers/gyroscope.hpp"
 #include "drivers/magnetometer.hpp"
+#include "drivers/inertial_fifo.hpp"
 
 #include "hal/common/gpio.hpp"
 #include "hal/common/spi.hpp"
@@ -111,8 +112,19 @@ public:
  *              The inherited method Accelerometer::update is implemented as Mpu9250::update_acc
  *              The inherited method Gyroscope::update is implemented as Mpu9250::update_gyr
  *              The inherited method Magnetometer::update is implemented as Mpu9250::update_mag
+ *
+ *              In FIFO mode, all accelerometer and gyroscope samples measured since the
+ *              previous update are read in one SPI burst, and made available via the
+ *              Inertial_fifo interface. The first of update_acc and update_gyr called
+ *              drains the FIFO, the other one reuses the same data.
+ *
+ *              In prefetch mode, accelerometer, temperature, gyroscope and magnetometer
+ *              registers are read in one asynchronous SPI burst. Each update consumes the
+ *              burst completed since the previous one and submits the next, so that with a
+ *              DMA capable SPI the control loop never waits for the bus. With a blocking SPI,
+ *              the burst completes immediately and is consumed in the same update.
  */
-class Mpu_9250: public Mpu_9250_acc, public Mpu_9250_gyr, public Mpu_9250_mag
+class Mpu_9250: public Mpu_9250_acc, public Mpu_9250_gyr, public Mpu_9250_mag, public Inertial_fifo
 {
 public:
     /*
@@ -177,6 +189,8 @@ public:
         gyro_filter_t      gyro_filter;        ///< Gyroscope lp filter cut off freq
         gyro_range_t       gyro_range;         ///< Gyroscope range
         uint16_t           default_sample_rate;///< Default sample rate in Herz
+        bool               fifo_enabled;       ///< Read all samples from the FIFO at each update
+        bool               prefetch_enabled;   ///< Read all sensors in one asynchronous burst (ignored in FIFO mode)
 
     } conf_t;
 
@@ -196,6 +210,8 @@ public:
         // conf.gyro_range             = GYRO_1000_DEG;
         // conf.gyro_range             = GYRO_250_DEG;
         conf.default_sample_rate    = 500; // in Hz
+        conf.fifo_enabled           = false;
+        conf.prefetch_enabled       = false;
 
         return conf;
     };
@@ -391,6 +407,34 @@ public:
      */
     const float& temperature(void) const;
 
+
+    /**
+     * \brief   Get the number of samples read from the FIFO during the last update
+     *
+     * \return  Number of samples, 0 if the FIFO is disabled
+     */
+    uint32_t fifo_sample_count(void) const;
+
+
+    /**
+     * \brief   Get time between two FIFO samples
+     *
+     * \return  Sample period in seconds
+     */
+    float fifo_sample_period_s(void) const;
+
+
+    /**
+     * \brief   Get one sample read from the FIFO during the last update
+     *
+     * \param   index   Index of the sample, 0 being the oldest
+     * \param   acc     Output acceleration
+     * \param   gyro    Output angular velocity
+     *
+     * \return  Success, false if index is out of range
+     */
+    bool fifo_sample(uint32_t index, std::array<float, 3>& acc, std::array<float, 3>& gyro) const;
+
     /**
      * \brief   Reset acc and gyro
      *
@@ -479,6 +523,7 @@ public:
     static const uint8_t ACCEL_CFG2_REG        = 0x1D;
     static const uint8_t SLV0_ADDR_REG         = 0x25;
     static const uint8_t SLV0_REG_REG          = 0x26;
+    static const uint8_t FIFO_EN_REG           = 0x23;
     static const uint8_t SLV0_CTRL_REG         = 0x27;
     static const uint8_t SLV4_ADDR_REG         = 0x31;
     static const uint8_t SLV4_REG_REG          = 0x32;
@@ -501,6 +546,9 @@ public:
     static const uint8_t EXT_SENS_DATA_00      = 0x49;
     static const uint8_t USER_CTRL_REG         = 0x6A;
     static const uint8_t PWR_MGMT_REG          = 0x6B;
+    static const uint8_t FIFO_COUNT_MSB        = 0x72;
+    static const uint8_t FIFO_COUNT_LSB        = 0x73;
+    static const uint8_t FIFO_R_W_REG          = 0x74;
     static const uint8_t WHOAMI_REG            = 0x75;
 
     // MPU9250 register bits
@@ -523,6 +571,20 @@ public:
     static const uint8_t USERCTL_DIS_I2C       = 0x10;
     static const uint8_t USERCTL_I2C_MST_EN    = 0x20;
     static const uint8_t USERCTL_GYRO_RST      = 0x01;
+    static const uint8_t USERCTL_FIFO_RST      = 0x04;
+    static const uint8_t USERCTL_FIFO_EN       = 0x40;
+
+    // FIFO enable register bits
+    static const uint8_t FIFOEN_ACCEL          = 0x08;
+    static const uint8_t FIFOEN_GYRO_XYZ       = 0x70;
+
+    // FIFO layout: accelerometer then gyroscope, 3 x 16 bits each, big endian
+    static const uint32_t FIFO_SAMPLE_SIZE     = 12;
+    static const uint32_t FIFO_SIZE            = 512;
+    static const uint32_t FIFO_MAX_SAMPLES     = FIFO_SIZE / FIFO_SAMPLE_SIZE;
+
+    // Prefetch burst: register address, then acc (6), temperature (2), gyro (6) and mag (6) from ACCEL_X_OUT_MSB
+    static const uint32_t PREFETCH_SIZE        = 1 + 20;
 
 private:
     Spi&                    spi_;              ///< SPI peripheral
@@ -535,6 +597,61 @@ private:
     conf_t                  config_;           ///< Device configuration
     float                   acc_scale_;        ///< Acceleromter data scaling factor
     float                   gyro_scale_;       ///< Gyroscope data scaling factor
+    uint8_t                 fifo_data_[FIFO_MAX_SAMPLES * FIFO_SAMPLE_SIZE]; ///< Raw samples read from the FIFO
+    uint32_t                fifo_sample_count_;     ///< Number of samples in fifo_data_
+    float                   fifo_sample_period_s_;  ///< Time between two FIFO samples
+    bool                    fifo_fresh_acc_;        ///< FIFO data not yet used by update_acc
+    bool                    fifo_fresh_gyr_;        ///< FIFO data not yet used by update_gyr
+    uint8_t                 prefetch_tx_[PREFETCH_SIZE];    ///< Outgoing bytes of the prefetch burst
+    uint8_t                 prefetch_rx_[PREFETCH_SIZE];    ///< Incoming bytes of the prefetch burst
+    volatile bool           prefetch_pending_;      ///< A prefetch burst is in progress
+    volatile bool           prefetch_ready_;        ///< A prefetch burst completed and was not decoded yet
+    volatile bool           prefetch_success_;      ///< Result of the last completed burst
+    bool                    prefetch_fresh_acc_;    ///< Prefetched data not yet used by update_acc
+    bool                    prefetch_fresh_gyr_;    ///< Prefetched data not yet used by update_gyr
+    bool                    prefetch_fresh_mag_;    ///< Prefetched data not yet used by update_mag
+
+    /**
+     * \brief   Read all samples available in the FIFO
+     *
+     * \details Updates acc and gyro data with the newest sample
+     *
+     * \return  success, false if the FIFO overflowed
+     */
+    bool update_fifo(void);
+
+    /**
+     * \brief   Clear the FIFO and enable it
+     *
+     * \return  success
+     */
+    bool reset_fifo(void);
+
+    /**
+     * \brief   Decode the last completed prefetch burst and submit the next one
+     *
+     * \param   fresh       Prefetched data not yet used by the caller, cleared on return
+     *
+     * \return  success of the decoded burst
+     */
+    bool update_prefetch(bool& fresh);
+
+    /**
+     * \brief   Decode the last completed prefetch burst, if any
+     *
+     * \return  success of the decoded burst
+     */
+    bool decode_prefetch(void);
+
+    /**
+     * \brief   Completion callback of the prefetch burst
+     *
+     * \details Called from interrupt context with a DMA capable SPI
+     *
+     * \param   data        Pointer to the Mpu_9250 instance
+     * \param   success     Result of the transfer
+     */
+    static void prefetch_callback(void* data, bool success);
 
     /**
      * \brief   Set accelerometer lowpass filter cut-off frequency
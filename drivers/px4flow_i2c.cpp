@@ -46,7 +46,11 @@
 PX4Flow_i2c::PX4Flow_i2c(I2c& i2c, conf_t config):
     PX4Flow(),
     i2c_(i2c),
-    config_(config)
+    config_(config),
+    frame_cmd_(GET_FRAME_COMMAND),
+    frame_pending_(false),
+    frame_ready_(false),
+    frame_success_(false)
 {}
 
 
@@ -54,12 +58,42 @@ bool PX4Flow_i2c::update(void)
 {
     bool res = true;
 
-    // Send command
-    uint8_t buff = GET_FRAME_COMMAND;
-    res &= i2c_.write(&buff, 1, config_.i2c_address);
+    // Consume frame read since last update
+    res &= decode();
 
-    uint8_t rec[22];
-    res &= i2c_.read(rec, 22, config_.i2c_address);
+    // Send command and read next frame
+    if (!frame_pending_)
+    {
+        frame_pending_ = true;
+        if (!i2c_.transfer_async(&frame_cmd_, 1, frame_, 22, config_.i2c_address, &PX4Flow_i2c::frame_callback, this))
+        {
+            frame_pending_  = false;
+            is_healthy_     = false;
+            res             = false;
+        }
+    }
+
+    // With a blocking I2C the frame is already available
+    res &= decode();
+
+    return res;
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+bool PX4Flow_i2c::decode(void)
+{
+    if (!frame_ready_)
+    {
+        return true;
+    }
+    frame_ready_ = false;
+
+    bool res = frame_success_;
+    const uint8_t* rec = frame_;
 
     if (res == true)
     {
@@ -111,3 +145,13 @@ bool PX4Flow_i2c::update(void)
 
     return res;
 }
+
+
+void PX4Flow_i2c::frame_callback(void* data, bool success)
+{
+    PX4Flow_i2c* flow = (PX4Flow_i2c*)data;
+
+    flow->frame_success_  = success;
+    flow->frame_ready_    = true;
+    flow->frame_pending_  = false;
+}
@@ -69,6 +69,10 @@ public:
     /**
      * \brief   Main update function
      *
+     * \details Consumes the frame read since the previous update and
+     *          submits the next asynchronous read. With a blocking I2C
+     *          the read completes immediately and is consumed right away.
+     *
      * \return  success
      */
     bool update(void);
@@ -84,6 +88,28 @@ public:
 protected:
     I2c&                i2c_;                       ///< reference to I2C
     conf_t              config_;                    ///< Configuration
+
+private:
+    uint8_t             frame_cmd_;                 ///< Command sent to request a frame
+    uint8_t             frame_[22];                 ///< Raw frame of the last asynchronous read
+    volatile bool       frame_pending_;             ///< Asynchronous read in progress
+    volatile bool       frame_ready_;               ///< Asynchronous read completed and not decoded yet
+    volatile bool       frame_success_;             ///< Result of the last asynchronous read
+
+    /**
+     * \brief   Decode the last completed frame, if any
+     *
+     * \return  success of the decoded read
+     */
+    bool decode(void);
+
+    /**
+     * \brief   Completion callback of the asynchronous read
+     *
+     * \param   data        Pointer to the PX4Flow_i2c instance
+     * \param   success     Result of the transfer
+     */
+    static void frame_callback(void* data, bool success);
 };
 
 
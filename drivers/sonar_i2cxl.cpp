@@ -65,7 +65,12 @@ Sonar_i2cxl::Sonar_i2cxl(I2c& i2c, sonar_i2cxl_conf_t config):
     velocity_(0.0f),
     healthy_(false),
     last_update_us_(0.0f),
-    last_distances_{0.0f, 0.0f, 0.0f}
+    last_distances_{0.0f, 0.0f, 0.0f},
+    range_cmd_(SONAR_I2CXL_RANGE_COMMAND),
+    measure_{0, 0},
+    measure_pending_(false),
+    measure_ready_(false),
+    measure_success_(false)
 {}
 
 
@@ -80,9 +85,17 @@ bool Sonar_i2cxl::update(void)
 {
     bool res = true;
 
-    // Get measure
-    res &= get_last_measure();
-    res &= send_range_command();
+    // Consume measure read since last update
+    res &= decode_measure();
+
+    // Get measure and start next one
+    if (!measure_pending_)
+    {
+        res &= get_last_measure();
+    }
+
+    // With a blocking I2C the measure is already available
+    res &= decode_measure();
 
     // Update timing
     last_update_us_ = time_keeper_get_us();
@@ -129,8 +142,7 @@ bool Sonar_i2cxl::send_range_command(void)
 {
     bool res;
 
-    uint8_t buff = SONAR_I2CXL_RANGE_COMMAND;
-    res = i2c_.write(&buff, 1, config_.i2c_address);
+    res = i2c_.transfer_async(&range_cmd_, 1, NULL, 0, config_.i2c_address, &Sonar_i2cxl::range_callback, this);
 
     return res;
 }
@@ -139,15 +151,61 @@ bool Sonar_i2cxl::send_range_command(void)
 bool Sonar_i2cxl::get_last_measure(void)
 {
     bool res;
-    uint8_t buf[2];
+
+    measure_pending_ = true;
+    res = i2c_.transfer_async(NULL, 0, measure_, 2, config_.i2c_address, &Sonar_i2cxl::measure_callback, this);
+
+    if (!res)
+    {
+        measure_pending_ = false;
+    }
+
+    return res;
+}
+
+
+void Sonar_i2cxl::measure_callback(void* data, bool success)
+{
+    Sonar_i2cxl* sonar = (Sonar_i2cxl*)data;
+
+    sonar->measure_success_ = success;
+    sonar->measure_ready_   = true;
+
+    // Start next measure right away
+    if (!sonar->send_range_command())
+    {
+        range_callback(sonar, false);
+    }
+}
+
+
+void Sonar_i2cxl::range_callback(void* data, bool success)
+{
+    Sonar_i2cxl* sonar = (Sonar_i2cxl*)data;
+
+    // A failed range command only delays the next measure
+    (void)success;
+
+    sonar->measure_pending_ = false;
+}
+
+
+bool Sonar_i2cxl::decode_measure(void)
+{
+    if (!measure_ready_)
+    {
+        return true;
+    }
+    measure_ready_ = false;
+
+    bool res                = measure_success_;
+    const uint8_t* buf      = measure_;
     uint16_t distance_cm    = 0;
     float distance_m        = 0.0f;
     float new_velocity      = 0.0f;
     float dt_s              = 0.0f;
     float time_us           = time_keeper_get_us();
 
-    res = i2c_.read(buf, 2, config_.i2c_address);
-
     if (res)
     {
         distance_cm = (buf[0] << 8) + buf[1];
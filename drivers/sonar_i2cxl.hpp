@@ -91,7 +91,9 @@ public:
 
     /**
      * \brief   Main update function
-     * \detail  Reads new values from sensor
+     * \detail  Consumes the measure read since the previous update, then
+     *          asynchronously reads the last measure and starts the next one.
+     *          With a blocking I2C the measure is consumed in the same update.
      *
      * \return  Success
      */
@@ -148,10 +150,18 @@ private:
     float               last_update_us_;        ///< Last update time in microseconds
     float               last_distances_[5];     ///< Last distances in m, to compute median filter
 
+    uint8_t             range_cmd_;             ///< Range command sent after reading a measure
+    uint8_t             measure_[2];            ///< Raw measure of the last asynchronous read
+    volatile bool       measure_pending_;       ///< Read or range command in progress
+    volatile bool       measure_ready_;         ///< Read completed and not decoded yet
+    volatile bool       measure_success_;       ///< Result of the last read
+
 
     /**
      * \brief   Send range Command for the Sonar_i2cxl
      *
+     * \details Asynchronous, called once the last measure is read
+     *
      * \return  true    Success
      * \return  false   Failed
      */
@@ -159,7 +169,9 @@ private:
 
 
     /**
-     * \brief   Get the last measurement
+     * \brief   Read the last measurement, then send range command
+     *
+     * \details Asynchronous, the measure is decoded by decode_measure
      *
      * \return  true    Success
      * \return  false   Failed
@@ -167,6 +179,33 @@ private:
     bool get_last_measure(void);
 
 
+    /**
+     * \brief   Decode the last measurement read, if any
+     *
+     * \return  true    Success
+     * \return  false   Failed
+     */
+    bool decode_measure(void);
+
+
+    /**
+     * \brief   Completion callback of the measure read
+     *
+     * \param   data        Pointer to the Sonar_i2cxl instance
+     * \param   success     Result of the transfer
+     */
+    static void measure_callback(void* data, bool success);
+
+
+    /**
+     * \brief   Completion callback of the range command
+     *
+     * \param   data        Pointer to the Sonar_i2cxl instance
+     * \param   success     Result of the transfer
+     */
+    static void range_callback(void* data, bool success);
+
+
     /**
      * \brief           Median filter with n measures (n should be odd)
      * 
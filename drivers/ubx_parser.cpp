@@ -0,0 +1,284 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file ubx_parser.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Framing parser for the U-Blox UBX binary protocol
+ *
+ ******************************************************************************/
+
+
+#include "drivers/ubx_parser.hpp"
+
+#include <cstring>
+
+#define UBX_PREAMBLE1 0xb5
+#define UBX_PREAMBLE2 0x62
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Ubx_parser::Ubx_parser(void):
+    subscription_count_(0),
+    default_handler_(NULL),
+    default_data_(NULL),
+    step_(STEP_PREAMBLE_1),
+    msg_class_(0),
+    msg_id_(0),
+    length_(0),
+    counter_(0),
+    ck_a_(0),
+    ck_b_(0),
+    subscription_(NULL),
+    payload_(buffer_),
+    stats_{0, 0, 0, 0}
+{}
+
+
+bool Ubx_parser::subscribe(uint8_t msg_class, uint8_t msg_id, uint16_t min_length, uint16_t max_length, handler_t handler, void* data)
+{
+    if ((subscription_count_ >= MAX_SUBSCRIPTIONS) || (max_length > MAX_PAYLOAD) || (handler == NULL))
+    {
+        return false;
+    }
+
+    subscription_t& sub = subscriptions_[subscription_count_];
+    sub.msg_class   = msg_class;
+    sub.msg_id      = msg_id;
+    sub.min_length  = min_length;
+    sub.max_length  = max_length;
+    sub.handler     = handler;
+    sub.data        = data;
+    subscription_count_ += 1;
+
+    return true;
+}
+
+
+void Ubx_parser::set_default_handler(handler_t handler, void* data)
+{
+    default_handler_ = handler;
+    default_data_    = data;
+}
+
+
+uint32_t Ubx_parser::parse(const uint8_t* bytes, uint32_t size)
+{
+    uint32_t handled = 0;
+    uint32_t i       = 0;
+
+    while (i < size)
+    {
+        switch (step_)
+        {
+            // If we fail to match any of the expected bytes, the failed byte is
+            // considered again as the first byte of the preamble. This avoids
+            // being fooled by the preamble appearing as data in other messages.
+            case STEP_PREAMBLE_1:
+                while ((i < size) && (bytes[i] != UBX_PREAMBLE1))
+                {
+                    ++i;
+                }
+                if (i < size)
+                {
+                    ++i;
+                    step_ = STEP_PREAMBLE_2;
+                }
+            break;
+
+            case STEP_PREAMBLE_2:
+                if (bytes[i] == UBX_PREAMBLE2)
+                {
+                    ++i;
+                    step_ = STEP_CLASS;
+                }
+                else
+                {
+                    step_ = STEP_PREAMBLE_1;
+                }
+            break;
+
+            case STEP_CLASS:
+                msg_class_ = bytes[i];
+                ck_a_      = 0;
+                ck_b_      = 0;
+                checksum(bytes[i++]);
+                step_      = STEP_ID;
+            break;
+
+            case STEP_ID:
+                msg_id_ = bytes[i];
+                checksum(bytes[i++]);
+                step_   = STEP_LENGTH_1;
+            break;
+
+            case STEP_LENGTH_1:
+                length_ = bytes[i];
+                checksum(bytes[i++]);
+                step_   = STEP_LENGTH_2;
+            break;
+
+            case STEP_LENGTH_2:
+                length_ |= (uint16_t)bytes[i] << 8;
+                checksum(bytes[i++]);
+
+                // Large payloads are line noise
+                if (length_ > MAX_PAYLOAD)
+                {
+                    stats_.length_error_count += 1;
+                    step_ = STEP_PREAMBLE_1;
+                    break;
+                }
+
+                subscription_ = find_subscription();
+                if ((subscription_ != NULL) && ((length_ < subscription_->min_length) || (length_ > subscription_->max_length)))
+                {
+                    stats_.length_error_count += 1;
+                    step_ = STEP_PREAMBLE_1;
+                    break;
+                }
+
+                counter_ = 0;
+                payload_ = buffer_;
+                step_    = (length_ > 0) ? STEP_PAYLOAD : STEP_CHECKSUM_A;
+            break;
+
+            case STEP_PAYLOAD:
+            {
+                uint32_t        available = size - i;
+                uint32_t        count     = length_ - counter_;
+                const uint8_t*  src       = &bytes[i];
+                if (available < count)
+                {
+                    count = available;
+                }
+
+                for (uint32_t k = 0; k < count; ++k)
+                {
+                    checksum(src[k]);
+                }
+
+                if (subscription_ != NULL)
+                {
+                    if ((counter_ == 0) && (available >= (uint32_t)length_ + 2))
+                    {
+                        // Whole frame in this span: no copy
+                        payload_ = src;
+                    }
+                    else
+                    {
+                        memcpy(&buffer_[counter_], src, count);
+                    }
+                }
+
+                counter_ += count;
+                i        += count;
+                if (counter_ == length_)
+                {
+                    step_ = STEP_CHECKSUM_A;
+                }
+            }
+            break;
+
+            case STEP_CHECKSUM_A:
+                if (bytes[i] == ck_a_)
+                {
+                    ++i;
+                    step_ = STEP_CHECKSUM_B;
+                }
+                else
+                {
+                    stats_.checksum_error_count += 1;
+                    step_ = STEP_PREAMBLE_1;
+                }
+            break;
+
+            case STEP_CHECKSUM_B:
+                step_ = STEP_PREAMBLE_1;
+                if (bytes[i] != ck_b_)
+                {
+                    stats_.checksum_error_count += 1;
+                    break;
+                }
+                ++i;
+
+                stats_.message_count += 1;
+                if (subscription_ != NULL)
+                {
+                    stats_.handled_count += 1;
+                    handled += 1;
+                    subscription_->handler(subscription_->data, msg_class_, msg_id_, payload_, length_);
+                }
+                else if (default_handler_ != NULL)
+                {
+                    default_handler_(default_data_, msg_class_, msg_id_, NULL, length_);
+                }
+            break;
+        }
+    }
+
+    return handled;
+}
+
+
+void Ubx_parser::reset(void)
+{
+    step_ = STEP_PREAMBLE_1;
+}
+
+
+const Ubx_parser::stats_t& Ubx_parser::stats(void) const
+{
+    return stats_;
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+const Ubx_parser::subscription_t* Ubx_parser::find_subscription(void) const
+{
+    for (uint32_t i = 0; i < subscription_count_; ++i)
+    {
+        if ((subscriptions_[i].msg_class == msg_class_) && (subscriptions_[i].msg_id == msg_id_))
+        {
+            return &subscriptions_[i];
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file ubx_parser.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Framing parser for the U-Blox UBX binary protocol
+ *
+ * \details Bytes are consumed by spans, as returned by the serial peripheral.
+ *          The Fletcher checksum is updated while bytes arrive. Only messages
+ *          with a registered handler are stored: when a whole frame lies in
+ *          the span given to parse(), the handler reads the payload directly
+ *          from that span, otherwise the payload is gathered in an internal
+ *          buffer. Other messages are only checksummed and skipped.
+ *
+ *          Payload fields are little endian and not aligned: use the read_*
+ *          functions to decode them.
+ *
+ ******************************************************************************/
+
+
+#ifndef UBX_PARSER_HPP_
+#define UBX_PARSER_HPP_
+
+#include <cstdint>
+#include <cstdbool>
+
+
+/**
+ * \brief   UBX protocol framing parser
+ */
+class Ubx_parser
+{
+public:
+    static const uint32_t MAX_SUBSCRIPTIONS = 12;       ///< Maximum number of message handlers
+    static const uint16_t MAX_PAYLOAD       = 512;      ///< Larger payloads are considered as line noise
+
+    /**
+     * \brief   Message handler
+     *
+     * \param   data        Pointer given at subscription
+     * \param   msg_class   Class of the message
+     * \param   msg_id      Id of the message
+     * \param   payload     Payload, valid only during the call (NULL for the default handler)
+     * \param   length      Length of the payload
+     */
+    typedef void (*handler_t)(void* data, uint8_t msg_class, uint8_t msg_id, const uint8_t* payload, uint16_t length);
+
+    /**
+     * \brief   Parser statistics
+     */
+    struct stats_t
+    {
+        uint32_t message_count;         ///< Number of messages with valid checksum
+        uint32_t handled_count;         ///< Number of messages given to a handler
+        uint32_t checksum_error_count;  ///< Number of messages with wrong checksum
+        uint32_t length_error_count;    ///< Number of messages with unexpected length
+    };
+
+    /**
+     * \brief   Constructor
+     */
+    Ubx_parser(void);
+
+    /**
+     * \brief   Registers a handler for one message type
+     *
+     * \details Messages of this type whose length is out of bounds are dropped
+     *
+     * \param   msg_class   Class of the message
+     * \param   msg_id      Id of the message
+     * \param   min_length  Minimum payload length
+     * \param   max_length  Maximum payload length
+     * \param   handler     Function called for each valid message
+     * \param   data        Pointer passed to the handler
+     *
+     * \return  false if the table is full or the maximum length is too large
+     */
+    bool subscribe(uint8_t msg_class, uint8_t msg_id, uint16_t min_length, uint16_t max_length, handler_t handler, void* data);
+
+    /**
+     * \brief   Sets the handler called for valid messages without subscription
+     *
+     * \details The payload is not stored, the handler is called with NULL payload
+     *
+     * \param   handler     Function called, NULL to ignore these messages
+     * \param   data        Pointer passed to the handler
+     */
+    void set_default_handler(handler_t handler, void* data);
+
+    /**
+     * \brief   Parses a span of received bytes
+     *
+     * \param   bytes   Received bytes
+     * \param   size    Number of bytes
+     *
+     * \return  Number of messages given to subscribed handlers
+     */
+    uint32_t parse(const uint8_t* bytes, uint32_t size);
+
+    /**
+     * \brief   Drops the message being received and waits for next preamble
+     */
+    void reset(void);
+
+    /**
+     * \brief   Get parser statistics
+     *
+     * \return  statistics
+     */
+    const stats_t& stats(void) const;
+
+    /**
+     * \brief   Reads fields from a little endian payload
+     *
+     * \param   payload     Payload
+     * \param   offset      Offset of the field in bytes
+     *
+     * \return  value
+     */
+    static inline uint8_t read_u8(const uint8_t* payload, uint16_t offset)
+    {
+        return payload[offset];
+    }
+
+    static inline int8_t read_i8(const uint8_t* payload, uint16_t offset)
+    {
+        return (int8_t)payload[offset];
+    }
+
+    static inline uint16_t read_u16(const uint8_t* payload, uint16_t offset)
+    {
+        return (uint16_t)payload[offset] | ((uint16_t)payload[offset + 1] << 8);
+    }
+
+    static inline int16_t read_i16(const uint8_t* payload, uint16_t offset)
+    {
+        return (int16_t)read_u16(payload, offset);
+    }
+
+    static inline uint32_t read_u32(const uint8_t* payload, uint16_t offset)
+    {
+        return (uint32_t)payload[offset]
+               | ((uint32_t)payload[offset + 1] << 8)
+               | ((uint32_t)payload[offset + 2] << 16)
+               | ((uint32_t)payload[offset + 3] << 24);
+    }
+
+    static inline int32_t read_i32(const uint8_t* payload, uint16_t offset)
+    {
+        return (int32_t)read_u32(payload, offset);
+    }
+
+private:
+    /**
+     * \brief   Position in the frame
+     */
+    enum step_t
+    {
+        STEP_PREAMBLE_1,
+        STEP_PREAMBLE_2,
+        STEP_CLASS,
+        STEP_ID,
+        STEP_LENGTH_1,
+        STEP_LENGTH_2,
+        STEP_PAYLOAD,
+        STEP_CHECKSUM_A,
+        STEP_CHECKSUM_B,
+    };
+
+    /**
+     * \brief   Entry of the subscription table
+     */
+    struct subscription_t
+    {
+        uint8_t     msg_class;          ///< Class of the message
+        uint8_t     msg_id;             ///< Id of the message
+        uint16_t    min_length;         ///< Minimum payload length
+        uint16_t    max_length;         ///< Maximum payload length
+        handler_t   handler;            ///< Handler
+        void*       data;               ///< Argument of the handler
+    };
+
+    /**
+     * \brief   Adds one byte to the checksum
+     *
+     * \param   byte    Byte
+     */
+    inline void checksum(uint8_t byte)
+    {
+        ck_a_ += byte;
+        ck_b_ += ck_a_;
+    }
+
+    /**
+     * \brief   Finds the subscription of the current message
+     *
+     * \return  subscription, NULL if none
+     */
+    const subscription_t* find_subscription(void) const;
+
+    subscription_t          subscriptions_[MAX_SUBSCRIPTIONS];  ///< Subscription table
+    uint32_t                subscription_count_;                ///< Number of subscriptions
+    handler_t               default_handler_;                   ///< Handler for other messages
+    void*                   default_data_;                      ///< Argument of the default handler
+
+    step_t                  step_;                              ///< Position in the frame
+    uint8_t                 msg_class_;                         ///< Class of the current message
+    uint8_t                 msg_id_;                            ///< Id of the current message
+    uint16_t                length_;                            ///< Payload length of the current message
+    uint16_t                counter_;                           ///< Number of payload bytes received
+    uint8_t                 ck_a_;                              ///< Checksum A
+    uint8_t                 ck_b_;                              ///< Checksum B
+    const subscription_t*   subscription_;                      ///< Subscription of the current message, NULL if skipped
+    const uint8_t*          payload_;                           ///< Payload of the current message, in the input span or in buffer_
+
+    uint8_t                 buffer_[MAX_PAYLOAD];               ///< Payload of subscribed messages split between spans
+
+    stats_t                 stats_;                             ///< Statistics
+};
+
+#endif /* UBX_PARSER_HPP_ */
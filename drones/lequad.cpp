@@ -74,14 +74,21 @@ LEQuad::LEQuad(Imu& imu,
                Battery& battery,
                File& file1,
                File& file2,
+               Mission_store& mission_store,
                Servo& servo_0,
                Servo& servo_1,
                Servo& servo_2,
                Servo& servo_3,
                const conf_t& config):
-    MAV(imu, barometer, gps, sonar, flow, serial_mavlink, satellite, state_display, file_flash, battery, file1, file2, flight_controller_quadcopter_, config.mav_config),
-    flight_controller_quadcopter_(ins_, ahrs_, servo_0, servo_1, servo_2, servo_3, config.flight_controller_config)
-{}
+    MAV(imu, barometer, gps, sonar, flow, serial_mavlink, satellite, state_display, file_flash, battery, file1, file2, mission_store, flight_controller_quadcopter_, config.mav_config),
+    flight_controller_quadcopter_(ins_, ahrs_, servo_0, servo_1, servo_2, servo_3, config.flight_controller_config),
+    gain_scheduler_({ins_, battery, flight_controller_quadcopter_.mix_ctrl_, flight_controller_quadcopter_.rate_ctrl_, flight_controller_quadcopter_.att_ctrl_}, config.gain_scheduler_config)
+{
+    dynamic_notch_.add_motor(servo_0);
+    dynamic_notch_.add_motor(servo_1);
+    dynamic_notch_.add_motor(servo_2);
+    dynamic_notch_.add_motor(servo_3);
+}
 
 
 bool LEQuad::init_controller(void)
@@ -90,53 +97,107 @@ bool LEQuad::init_controller(void)
 
     // Parameters
     Onboard_parameters& op = communication.parameters();
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_X().p_gain,               "C_RAT_X_KP");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_X().integrator.clip_pre,  "C_RAT_X_I_CLPRE");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_X().integrator.gain,      "C_RAT_X_KI");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_X().integrator.clip,      "C_RAT_X_I_CLIP");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_X().differentiator.gain,  "C_RAT_X_KD");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Y().p_gain,               "C_RAT_Y_KP");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Y().integrator.clip_pre,  "C_RAT_Y_I_CLPRE");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Y().integrator.gain,      "C_RAT_Y_KI");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Y().integrator.clip,      "C_RAT_Y_I_CLIP");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Y().differentiator.gain,  "C_RAT_Y_KD");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Z().p_gain,               "C_RAT_Z_KP");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Z().integrator.clip_pre,  "C_RAT_Z_I_CLPRE");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Z().integrator.gain,      "C_RAT_Z_KI");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Z().integrator.clip,      "C_RAT_Z_I_CLIP");
-    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid_Z().differentiator.gain,  "C_RAT_Z_KD");
-
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_X().p_gain,               "C_ATT_X_KP");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_X().integrator.clip_pre,  "C_ATT_X_I_CLPRE");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_X().integrator.gain,      "C_ATT_X_KI");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_X().integrator.clip,      "C_ATT_X_I_CLIP");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_X().differentiator.gain,  "C_ATT_X_KD");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Y().p_gain,               "C_ATT_Y_KP");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Y().integrator.clip_pre,  "C_ATT_Y_I_CLPRE");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Y().integrator.gain,      "C_ATT_Y_KI");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Y().integrator.clip,      "C_ATT_Y_I_CLIP");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Y().differentiator.gain,  "C_ATT_Y_KD");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Z().p_gain,               "C_ATT_Z_KP");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Z().integrator.clip_pre,  "C_ATT_Z_I_CLPRE");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Z().integrator.gain,      "C_ATT_Z_KI");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Z().integrator.clip,      "C_ATT_Z_I_CLIP");
-    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid_Z().differentiator.gain,  "C_ATT_Z_KD");
-
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_X().p_gain,               "C_VEL_X_KP");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_X().integrator.clip_pre,  "C_VEL_X_I_CLPRE");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_X().integrator.gain,      "C_VEL_X_KI");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_X().integrator.clip,      "C_VEL_X_I_CLIP");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_X().differentiator.gain,  "C_VEL_X_KD");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Y().p_gain,               "C_VEL_Y_KP");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Y().integrator.clip_pre,  "C_VEL_Y_I_CLPRE");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Y().integrator.gain,      "C_VEL_Y_KI");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Y().integrator.clip,      "C_VEL_Y_I_CLIP");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Y().differentiator.gain,  "C_VEL_Y_KD");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Z().p_gain,               "C_VEL_Z_KP");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Z().integrator.clip_pre,  "C_VEL_Z_I_CLPRE");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Z().integrator.gain,      "C_VEL_Z_KI");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Z().integrator.clip,      "C_VEL_Z_I_CLIP");
-    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid_Z().differentiator.gain,  "C_VEL_Z_KD");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().p_gain[X],     "C_RAT_X_KP");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().i_clip_pre[X], "C_RAT_X_I_CLPRE");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().i_gain[X],     "C_RAT_X_KI");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().i_clip[X],     "C_RAT_X_I_CLIP");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().d_gain[X],     "C_RAT_X_KD");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().d_filter_tau[X], "C_RAT_X_D_TAU");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().p_gain[Y],     "C_RAT_Y_KP");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().i_clip_pre[Y], "C_RAT_Y_I_CLPRE");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().i_gain[Y],     "C_RAT_Y_KI");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().i_clip[Y],     "C_RAT_Y_I_CLIP");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().d_gain[Y],     "C_RAT_Y_KD");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().d_filter_tau[Y], "C_RAT_Y_D_TAU");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().p_gain[Z],     "C_RAT_Z_KP");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().i_clip_pre[Z], "C_RAT_Z_I_CLPRE");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().i_gain[Z],     "C_RAT_Z_KI");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().i_clip[Z],     "C_RAT_Z_I_CLIP");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().d_gain[Z],     "C_RAT_Z_KD");
+    ret &= op.add(&flight_controller_quadcopter_.rate_ctrl_.get_pid().d_filter_tau[Z], "C_RAT_Z_D_TAU");
+
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().p_gain[X],      "C_ATT_X_KP");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().i_clip_pre[X],  "C_ATT_X_I_CLPRE");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().i_gain[X],      "C_ATT_X_KI");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().i_clip[X],      "C_ATT_X_I_CLIP");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().d_gain[X],      "C_ATT_X_KD");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().d_filter_tau[X], "C_ATT_X_D_TAU");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().p_gain[Y],      "C_ATT_Y_KP");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().i_clip_pre[Y],  "C_ATT_Y_I_CLPRE");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().i_gain[Y],      "C_ATT_Y_KI");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().i_clip[Y],      "C_ATT_Y_I_CLIP");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().d_gain[Y],      "C_ATT_Y_KD");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().d_filter_tau[Y], "C_ATT_Y_D_TAU");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().p_gain[Z],      "C_ATT_Z_KP");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().i_clip_pre[Z],  "C_ATT_Z_I_CLPRE");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().i_gain[Z],      "C_ATT_Z_KI");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().i_clip[Z],      "C_ATT_Z_I_CLIP");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().d_gain[Z],      "C_ATT_Z_KD");
+    ret &= op.add(&flight_controller_quadcopter_.att_ctrl_.get_pid().d_filter_tau[Z], "C_ATT_Z_D_TAU");
+
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().p_gain[X],      "C_VEL_X_KP");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().i_clip_pre[X],  "C_VEL_X_I_CLPRE");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().i_gain[X],      "C_VEL_X_KI");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().i_clip[X],      "C_VEL_X_I_CLIP");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().d_gain[X],      "C_VEL_X_KD");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().d_filter_tau[X], "C_VEL_X_D_TAU");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().p_gain[Y],      "C_VEL_Y_KP");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().i_clip_pre[Y],  "C_VEL_Y_I_CLPRE");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().i_gain[Y],      "C_VEL_Y_KI");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().i_clip[Y],      "C_VEL_Y_I_CLIP");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().d_gain[Y],      "C_VEL_Y_KD");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().d_filter_tau[Y], "C_VEL_Y_D_TAU");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().p_gain[Z],      "C_VEL_Z_KP");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().i_clip_pre[Z],  "C_VEL_Z_I_CLPRE");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().i_gain[Z],      "C_VEL_Z_KI");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().i_clip[Z],      "C_VEL_Z_I_CLIP");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().d_gain[Z],      "C_VEL_Z_KD");
+    ret &= op.add(&flight_controller_quadcopter_.vel_ctrl_.get_pid().d_filter_tau[Z], "C_VEL_Z_D_TAU");
+
+    // Control allocation (0: clip each servo, 1: prioritized)
+    ret &= op.add((int32_t*) &flight_controller_quadcopter_.mix_ctrl_.allocation(), "C_MIX_ALLOC");
+
+    // Gain scheduling
+    ret &= op.add(&gain_scheduler_.config().airspeed.min,         "GS_AIR_MIN");
+    ret &= op.add(&gain_scheduler_.config().airspeed.max,         "GS_AIR_MAX");
+    ret &= op.add(&gain_scheduler_.config().airspeed.rate[0],     "GS_AIR_RAT0");
+    ret &= op.add(&gain_scheduler_.config().airspeed.rate[1],     "GS_AIR_RAT1");
+    ret &= op.add(&gain_scheduler_.config().airspeed.rate[2],     "GS_AIR_RAT2");
+    ret &= op.add(&gain_scheduler_.config().airspeed.rate[3],     "GS_AIR_RAT3");
+    ret &= op.add(&gain_scheduler_.config().airspeed.rate[4],     "GS_AIR_RAT4");
+    ret &= op.add(&gain_scheduler_.config().airspeed.attitude[0], "GS_AIR_ATT0");
+    ret &= op.add(&gain_scheduler_.config().airspeed.attitude[1], "GS_AIR_ATT1");
+    ret &= op.add(&gain_scheduler_.config().airspeed.attitude[2], "GS_AIR_ATT2");
+    ret &= op.add(&gain_scheduler_.config().airspeed.attitude[3], "GS_AIR_ATT3");
+    ret &= op.add(&gain_scheduler_.config().airspeed.attitude[4], "GS_AIR_ATT4");
+
+    ret &= op.add(&gain_scheduler_.config().thrust.min,           "GS_THR_MIN");
+    ret &= op.add(&gain_scheduler_.config().thrust.max,           "GS_THR_MAX");
+    ret &= op.add(&gain_scheduler_.config().thrust.rate[0],       "GS_THR_RAT0");
+    ret &= op.add(&gain_scheduler_.config().thrust.rate[1],       "GS_THR_RAT1");
+    ret &= op.add(&gain_scheduler_.config().thrust.rate[2],       "GS_THR_RAT2");
+    ret &= op.add(&gain_scheduler_.config().thrust.rate[3],       "GS_THR_RAT3");
+    ret &= op.add(&gain_scheduler_.config().thrust.rate[4],       "GS_THR_RAT4");
+    ret &= op.add(&gain_scheduler_.config().thrust.attitude[0],   "GS_THR_ATT0");
+    ret &= op.add(&gain_scheduler_.config().thrust.attitude[1],   "GS_THR_ATT1");
+    ret &= op.add(&gain_scheduler_.config().thrust.attitude[2],   "GS_THR_ATT2");
+    ret &= op.add(&gain_scheduler_.config().thrust.attitude[3],   "GS_THR_ATT3");
+    ret &= op.add(&gain_scheduler_.config().thrust.attitude[4],   "GS_THR_ATT4");
+
+    ret &= op.add(&gain_scheduler_.config().voltage.min,          "GS_VLT_MIN");
+    ret &= op.add(&gain_scheduler_.config().voltage.max,          "GS_VLT_MAX");
+    ret &= op.add(&gain_scheduler_.config().voltage.rate[0],      "GS_VLT_RAT0");
+    ret &= op.add(&gain_scheduler_.config().voltage.rate[1],      "GS_VLT_RAT1");
+    ret &= op.add(&gain_scheduler_.config().voltage.rate[2],      "GS_VLT_RAT2");
+    ret &= op.add(&gain_scheduler_.config().voltage.rate[3],      "GS_VLT_RAT3");
+    ret &= op.add(&gain_scheduler_.config().voltage.rate[4],      "GS_VLT_RAT4");
+    ret &= op.add(&gain_scheduler_.config().voltage.attitude[0],  "GS_VLT_ATT0");
+    ret &= op.add(&gain_scheduler_.config().voltage.attitude[1],  "GS_VLT_ATT1");
+    ret &= op.add(&gain_scheduler_.config().voltage.attitude[2],  "GS_VLT_ATT2");
+    ret &= op.add(&gain_scheduler_.config().voltage.attitude[3],  "GS_VLT_ATT3");
+    ret &= op.add(&gain_scheduler_.config().voltage.attitude[4],  "GS_VLT_ATT4");
+
+    ret &= scheduler.add_task(20000, &Gain_scheduler::update_task, &gain_scheduler_, Scheduler_task::PRIORITY_HIGH);
 
     return ret;
 }
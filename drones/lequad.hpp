@@ -44,6 +44,7 @@
 
 #include "drones/mav.hpp"
 #include "flight_controller/flight_controller_quadcopter.hpp"
+#include "control/gain_scheduler.hpp"
 
 /**
  * \brief MAV class
@@ -59,6 +60,7 @@ public:
     {
         MAV::conf_t mav_config;
         Flight_controller_quadcopter::conf_t flight_controller_config;
+        Gain_scheduler::conf_t gain_scheduler_config;
     };
 
     /**
@@ -96,6 +98,7 @@ public:
             Battery& battery,
             File& file1,
             File& file2,
+            Mission_store& mission_store,
             Servo& servo_0,
             Servo& servo_1,
             Servo& servo_2,
@@ -106,6 +109,7 @@ public:
 
 protected:
     Flight_controller_quadcopter    flight_controller_quadcopter_;
+    Gain_scheduler                  gain_scheduler_;    ///< Schedules rate and attitude gains
 };
 
 
@@ -115,6 +119,7 @@ LEQuad::conf_t LEQuad::default_config(uint8_t sysid)
 
     conf.mav_config = MAV::default_config();
     conf.flight_controller_config = Flight_controller_quadcopter::default_config();
+    conf.gain_scheduler_config = Gain_scheduler::default_config();
 
     return conf;
 };
@@ -126,6 +131,7 @@ LEQuad::conf_t LEQuad::dronedome_config(uint8_t sysid)
 
     conf.mav_config = MAV::dronedome_config(sysid);
     conf.flight_controller_config = Flight_controller_quadcopter::default_config();
+    conf.gain_scheduler_config = Gain_scheduler::default_config();
 
     return conf;
 }
@@ -74,6 +74,7 @@ MAV::MAV(  Imu& imu,
            Battery& battery,
            File& file1,
            File& file2,
+           Mission_store& mission_store,
            Flight_controller& flight_controller,
            const conf_t& config):
     imu(imu),
@@ -87,12 +88,13 @@ MAV::MAV(  Imu& imu,
     file_flash(file_flash),
     battery(battery),
     gps_mocap(communication.handler()),
-    gps_hub(std::array<Gps*,2>{{&gps, &gps_mocap}}),
+    gps_hub(std::array<Gps*,2>{{&gps, &gps_mocap}}, config.gps_hub_config),
     ahrs_ekf_mocap(communication.handler(), ahrs_ekf),
     manual_control(&satellite, config.manual_control_config, config.remote_config),
     state(communication.mavlink_stream(), battery, config.state_config),
     scheduler(config.scheduler_config),
     communication(serial_mavlink, state, file_flash, config.mavlink_communication_config),
+    dynamic_notch_(imu, config.dynamic_notch_config),
     ahrs_(ahrs_ekf),
     ahrs_ekf(imu, config.ahrs_ekf_config),
     ahrs_qfilter(imu, config.qfilter_config),
@@ -100,16 +102,16 @@ MAV::MAV(  Imu& imu,
     ins_complementary(state, barometer, sonar, gps_hub, flow, ahrs_, config.ins_complementary_config),
     ins_kf(state, gps, gps_mocap, barometer, sonar, flow, ahrs_),
     flight_controller_(flight_controller),
-    waypoint_handler(ins_, communication.handler(), communication.mavlink_stream(), mission_handler_registry, config.waypoint_handler_config),
+    waypoint_handler(ins_, communication.handler(), communication.mavlink_stream(), mission_handler_registry, mission_store, config.waypoint_handler_config),
     mission_handler_registry(),
     hold_position_handler(ins_),
     landing_handler(ins_, state),
-    navigating_handler(ins_, communication.mavlink_stream(), waypoint_handler),
+    navigating_handler(ins_, communication.mavlink_stream(), waypoint_handler, config.trajectory_config),
     on_ground_handler(),
     manual_ctrl_handler(),
     takeoff_handler(ins_, state),
     critical_landing_handler(ins_, state),
-    critical_navigating_handler(ins_, communication.mavlink_stream(), waypoint_handler),
+    critical_navigating_handler(ins_, communication.mavlink_stream(), waypoint_handler, config.trajectory_config),
     mission_planner_(ins_, ahrs_, state, manual_control, safety_geofence_, communication.handler(), communication.mavlink_stream(), waypoint_handler, mission_handler_registry),
     safety_geofence_(config.safety_geofence_config),
     emergency_geofence_(config.emergency_geofence_config),
@@ -117,7 +119,8 @@ MAV::MAV(  Imu& imu,
     data_logging_continuous(file1, state, config.data_logging_continuous_config),
     data_logging_stat(file2, state, config.data_logging_stat_config),
     sysid_(communication.sysid()),
-    config_(config)
+    config_(config),
+    control_enabled_(false)
 {}
 
 
@@ -181,8 +184,10 @@ bool MAV::init_main_task(void)
 {
     bool ret = true;
 
-    // Task
-    ret &= scheduler.add_task(4000, &MAV::main_task_func, this, Scheduler_task::PRIORITY_HIGHEST);
+    // Tasks, from the fastest rate group to the slowest
+    ret &= scheduler.add_task(config_.rate_task_period_us,     &MAV::main_task_func,     this, Scheduler_task::PRIORITY_HIGHEST);
+    ret &= scheduler.add_task(config_.attitude_task_period_us, &MAV::attitude_task_func, this, Scheduler_task::PRIORITY_HIGHEST);
+    ret &= scheduler.add_task(config_.position_task_period_us, &MAV::position_task_func, this, Scheduler_task::PRIORITY_HIGHEST);
 
     // DOWN link
     ret &= communication.telemetry().add<Scheduler>(MAVLINK_MSG_ID_NAMED_VALUE_FLOAT,  5000000, &scheduler_telemetry_send_rt_stats, &scheduler);
@@ -264,6 +269,9 @@ bool MAV::init_gps(void)
     // DOWN telemetry
     ret &= communication.telemetry().add<Gps>(MAVLINK_MSG_ID_GPS_RAW_INT, 1000000, &gps_telemetry_send_raw,  &gps_hub);
 
+    // Parameters
+    ret &= communication.parameters().add((int32_t*) &gps_hub.config().mode, "GPS_HUB_MODE");
+
     // Task
     ret &= scheduler.add_task<Gps>(100000, &task_gps_update, &gps_hub, Scheduler_task::PRIORITY_HIGH);
 
@@ -418,6 +426,8 @@ bool MAV::init_ins(void)
     ret &= communication.parameters().add(&ins_kf.config_.sigma_baro,       "INS_Z_BARO"        );
     ret &= communication.parameters().add(&ins_kf.config_.sigma_flow,       "INS_Z_FLOW"        );
     ret &= communication.parameters().add(&ins_kf.config_.sigma_sonar,      "INS_Z_SONAR"       );
+    ret &= communication.parameters().add(&ins_kf.config_.delay_gps_s,      "INS_DELAY_GPS"     );
+    ret &= communication.parameters().add(&ins_kf.config_.delay_flow_s,     "INS_DELAY_FLOW"    );
     ret &= communication.parameters().add(&ins_kf.init_flag,                "INS_INIT"          );
 
     return ret;
@@ -557,10 +567,10 @@ bool MAV::init_ground_control(void)
 // -------------------------------------------------------------------------
 bool MAV::main_task(void)
 {
-    // Update estimation
+    // Update attitude estimation
     imu.update();
+    dynamic_notch_.update();
     ahrs_.update();
-    ins_.update();
 
     bool failsafe = false;
 
@@ -599,10 +609,12 @@ bool MAV::main_task(void)
     }
 
     // if behaviour defined, execute controller and mix; otherwise: set servos to failsafe
+    // slower rate groups run only while the controller is enabled
+    control_enabled_ = !failsafe;
     if(!failsafe)
     {
-        // update controller cascade down to the motors
-        flight_controller_.update();
+        // update inner loop down to the motors, outer loops hand over their last output
+        flight_controller_.update_rate_group(Flight_controller::RATE_GROUP_RATE);
     }
     else
     {
@@ -611,3 +623,28 @@ bool MAV::main_task(void)
 
     return true;
 }
+
+
+bool MAV::attitude_task(void)
+{
+    if (control_enabled_)
+    {
+        flight_controller_.update_rate_group(Flight_controller::RATE_GROUP_ATTITUDE);
+    }
+
+    return true;
+}
+
+
+bool MAV::position_task(void)
+{
+    // Update position estimation
+    ins_.update();
+
+    if (control_enabled_)
+    {
+        flight_controller_.update_rate_group(Flight_controller::RATE_GROUP_POSITION);
+    }
+
+    return true;
+}
@@ -88,10 +88,13 @@
 #include "navigation/navigation_directto.hpp"
 #include "navigation/vector_field_waypoint.hpp"
 
+#include "runtime/cycle_clock.hpp"
+
 #include "sensing/ahrs.hpp"
 #include "sensing/ahrs_ekf.hpp"
 #include "sensing/ahrs_qfilter.hpp"
 #include "sensing/altitude_estimation.hpp"
+#include "sensing/dynamic_notch.hpp"
 #include "sensing/imu.hpp"
 #include "sensing/ins_complementary.hpp"
 #include "sensing/ins_kf.hpp"
@@ -122,7 +125,7 @@ public:
     static const uint32_t N_TELEM  = 30;
     static const uint32_t N_MSG_CB = 20;
     static const uint32_t N_CMD_CB = 20;
-    static const uint32_t N_PARAM  = 120;
+    static const uint32_t N_PARAM  = 200;     ///< LEQuad on avr32 registers 177 parameters
     typedef Mavlink_communication_T<N_TELEM, N_MSG_CB, N_CMD_CB, N_PARAM> Mavlink_communication;
 
 
@@ -135,12 +138,19 @@ public:
         Data_logging::conf_t data_logging_continuous_config;
         Data_logging::conf_t data_logging_stat_config;
         Scheduler::conf_t scheduler_config;
+        // Periods of the control rate groups in microseconds
+        uint32_t rate_task_period_us;           ///< IMU, attitude estimation, rate control and mixing
+        uint32_t attitude_task_period_us;       ///< Attitude control
+        uint32_t position_task_period_us;       ///< Position estimation, position and velocity control
         Mavlink_communication::conf_t mavlink_communication_config;
         Mavlink_waypoint_handler::conf_t waypoint_handler_config;
         Mission_planner::conf_t mission_planner_config;
         Mission_handler_landing::conf_t mission_handler_landing_config;
+        Trajectory::conf_t trajectory_config;
         AHRS_qfilter::conf_t qfilter_config;
         AHRS_ekf::conf_t ahrs_ekf_config;
+        Dynamic_notch::conf_t dynamic_notch_config;
+        gps_hub_conf_t gps_hub_config;
         INS_complementary::conf_t ins_complementary_config;
         Manual_control::conf_t manual_control_config;
         remote_conf_t remote_config;
@@ -183,6 +193,7 @@ public:
             Battery& battery,
             File& file1,
             File& file2,
+            Mission_store& mission_store,
             Flight_controller& flight_controller,
             const conf_t& config = default_config());
 
@@ -239,12 +250,37 @@ protected:
     // virtual bool init_servos(void);
     virtual bool init_ground_control(void);
 
+    /**
+     * \brief   Rate group task: estimates attitude, selects the flight command and runs rate control
+     */
     virtual bool main_task(void);
     static inline bool main_task_func(MAV* mav)
     {
+        // Sample time once, all modules updated in this cycle share it
+        Cycle_clock::Scope cycle;
         return mav->main_task();
     };
 
+    /**
+     * \brief   Attitude group task: runs attitude control with the last command
+     */
+    virtual bool attitude_task(void);
+    static inline bool attitude_task_func(MAV* mav)
+    {
+        Cycle_clock::Scope cycle;
+        return mav->attitude_task();
+    };
+
+    /**
+     * \brief   Position group task: estimates position and runs position and velocity control
+     */
+    virtual bool position_task(void);
+    static inline bool position_task_func(MAV* mav)
+    {
+        Cycle_clock::Scope cycle;
+        return mav->position_task();
+    };
+
     Imu&            imu;                ///< Reference to IMU
     Barometer&      barometer;          ///< Reference to barometer
     Gps&            gps;                ///< Reference to GPS
@@ -268,6 +304,8 @@ protected:
     Scheduler_T<20>       scheduler;
     Mavlink_communication   communication;
 
+    Dynamic_notch   dynamic_notch_;     ///< Tunes gyroscope notch filters on motor noise
+
     AHRS&           ahrs_;              ///< The attitude estimation structure
     AHRS_ekf        ahrs_ekf;
     AHRS_qfilter    ahrs_qfilter;
@@ -306,6 +344,8 @@ protected:
 
     uint8_t sysid_;    ///< System ID
     conf_t config_;    ///< Configuration
+
+    bool control_enabled_;  ///< Set by the rate group when controllers may run, read by slower groups
 };
 
 
@@ -325,12 +365,20 @@ MAV::conf_t MAV::default_config(uint8_t sysid)
 
     conf.scheduler_config = Scheduler::default_config();
 
+    // Rate loop twice as fast as attitude loop, so that rate control sees fresh gyro data
+    conf.rate_task_period_us        = 2000;
+    conf.attitude_task_period_us    = 4000;
+    conf.position_task_period_us    = 10000;
+
     conf.waypoint_handler_config = Mavlink_waypoint_handler::default_config();
 
     conf.mission_planner_config = Mission_planner::default_config();
     conf.mission_handler_landing_config = Mission_handler_landing::default_config();
+    conf.trajectory_config = Trajectory::default_config();
 
     conf.ahrs_ekf_config = AHRS_ekf::default_config();
+    conf.dynamic_notch_config = Dynamic_notch::default_config();
+    conf.gps_hub_config = gps_hub_default_config();
     conf.qfilter_config = AHRS_qfilter::default_config();
 
     conf.ins_complementary_config = INS_complementary::default_config();
@@ -57,11 +57,38 @@ class Flight_controller: public Controller<position_command_t>,
                          public Controller<thrust_command_t>
 {
 public:
+    /**
+     * \brief   Groups of control layers that can be updated at different rates
+     */
+    enum rate_group_t
+    {
+        RATE_GROUP_POSITION,    ///< Position and velocity control
+        RATE_GROUP_ATTITUDE,    ///< Attitude control
+        RATE_GROUP_RATE,        ///< Rate control and servo mixing
+    };
+
+
     /**
      * \brief   Main update function
      */
     virtual bool update(void) = 0;
 
+
+    /**
+     * \brief   Updates the control layers of one rate group
+     *
+     * \details Each group hands its output to the next inner one with
+     *          set_command, the inner group uses the last command until the
+     *          outer group runs again. By default the whole controller is
+     *          updated with the rate group.
+     *
+     * \param   group   Rate group to update
+     */
+    virtual bool update_rate_group(rate_group_t group)
+    {
+        return (group == RATE_GROUP_RATE) ? update() : true;
+    };
+
     /**
      * \brief   Sets actuators in safety mode
      */
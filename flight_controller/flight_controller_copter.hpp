@@ -48,13 +48,15 @@
 #include "control/attitude_controller.hpp"
 #include "control/rate_controller.hpp"
 #include "control/servos_mix_matrix.hpp"
+#include "control/servos_mix_fixed.hpp"
 
 /**
  * \brief   Full flight controller for copter
  *
  * \tparam  N_ROTORS     Number of rotors
+ * \tparam  MIX_T        Servos mix, Servos_mix_matrix or Servos_mix_fixed
  */
-template<uint32_t N_ROTORS>
+template<uint32_t N_ROTORS, typename MIX_T = Servos_mix_matrix<N_ROTORS> >
 class Flight_controller_copter: public Flight_controller_stack
 {
 public:
@@ -67,7 +69,7 @@ public:
         Velocity_controller_copter::conf_t  vel_config;
         Attitude_controller::conf_t         att_config;
         Rate_controller::conf_t             rate_config;
-        typename Servos_mix_matrix<N_ROTORS>::conf_t mix_config;
+        typename MIX_T::conf_t              mix_config;
     };
 
     /**
@@ -83,7 +85,7 @@ public:
         conf.vel_config  = Velocity_controller_copter::default_config();
         conf.att_config  = Attitude_controller::default_config();
         conf.rate_config = Rate_controller::default_config();
-        conf.mix_config  = Servos_mix_matrix<N_ROTORS>::default_config();
+        conf.mix_config  = MIX_T::default_config();
 
         return conf;
     };
@@ -91,7 +93,7 @@ public:
     /**
      * \brief   Constructor
      */
-    Flight_controller_copter(const INS& ins, const AHRS& ahrs, typename Servos_mix_matrix<N_ROTORS>::args_t mix_args, conf_t config);
+    Flight_controller_copter(const INS& ins, const AHRS& ahrs, typename MIX_T::args_t mix_args, conf_t config);
 
     /**
      * \brief   Set command from manual control in rate mode
@@ -119,7 +121,7 @@ public:
     Velocity_controller_copter  vel_ctrl_;      ///< Velocity controller
     Attitude_controller         att_ctrl_;      ///< Attitude controller
     Rate_controller             rate_ctrl_;     ///< Rate controller
-    Servos_mix_matrix<N_ROTORS> mix_ctrl_;      ///< Servos mix
+    MIX_T                       mix_ctrl_;      ///< Servos mix
 
 private:
     const AHRS& ahrs_;                          ///< Reference to estimated attitude
@@ -42,8 +42,8 @@
  #ifndef FLIGHT_CONTROLLER_COPTER_HXX_
  #define FLIGHT_CONTROLLER_COPTER_HXX_
 
-template<uint32_t N_ROTORS>
-Flight_controller_copter<N_ROTORS>::Flight_controller_copter(const INS& ins, const AHRS& ahrs, typename Servos_mix_matrix<N_ROTORS>::args_t mix_args, conf_t config):
+template<uint32_t N_ROTORS, typename MIX_T>
+Flight_controller_copter<N_ROTORS, MIX_T>::Flight_controller_copter(const INS& ins, const AHRS& ahrs, typename MIX_T::args_t mix_args, conf_t config):
     Flight_controller_stack(pos_ctrl_, vel_ctrl_, att_ctrl_, rate_ctrl_, mix_ctrl_),
     pos_ctrl_({ahrs, ins}, config.pos_config),
     vel_ctrl_({{ahrs, ins, command_.velocity, command_.attitude, command_.thrust}}, config.vel_config),
@@ -54,8 +54,8 @@ Flight_controller_copter<N_ROTORS>::Flight_controller_copter(const INS& ins, con
 {};
 
 
-template<uint32_t N_ROTORS>
-bool Flight_controller_copter<N_ROTORS>::set_manual_rate_command(const Manual_control& manual_control)
+template<uint32_t N_ROTORS, typename MIX_T>
+bool Flight_controller_copter<N_ROTORS, MIX_T>::set_manual_rate_command(const Manual_control& manual_control)
 {
     bool ret = true;
     rate_command_t rate_command;
@@ -68,8 +68,8 @@ bool Flight_controller_copter<N_ROTORS>::set_manual_rate_command(const Manual_co
 };
 
 
-template<uint32_t N_ROTORS>
-bool Flight_controller_copter<N_ROTORS>::set_manual_attitude_command(const Manual_control& manual_control)
+template<uint32_t N_ROTORS, typename MIX_T>
+bool Flight_controller_copter<N_ROTORS, MIX_T>::set_manual_attitude_command(const Manual_control& manual_control)
 {
     bool ret = true;
     attitude_command_t att_command;
@@ -82,11 +82,11 @@ bool Flight_controller_copter<N_ROTORS>::set_manual_attitude_command(const Manua
 };
 
 
-template<uint32_t N_ROTORS>
-bool Flight_controller_copter<N_ROTORS>::set_manual_velocity_command(const Manual_control& manual_control)
+template<uint32_t N_ROTORS, typename MIX_T>
+bool Flight_controller_copter<N_ROTORS, MIX_T>::set_manual_velocity_command(const Manual_control& manual_control)
 {
     bool ret = true;
-    velocity_command_t new_vel_command;
+    velocity_command_t new_vel_command = {};
     manual_control.get_velocity_command_copter(new_vel_command, ahrs_.attitude(), command_.velocity);
     ret &= set_command(new_vel_command);
     return ret;
@@ -44,6 +44,21 @@
 
 #include "flight_controller/flight_controller_copter.hpp"
 
+/**
+ * \brief   Mix table for hexacopter
+ */
+struct Mix_hexacopter
+{
+    static const uint32_t N = 6;
+    //                                  roll,   pitch,   yaw,   X,    Y,     Z
+    static constexpr float mix[N][6] = {{ 0.0f,      -1.0f,  1.0f, 0.0f, 0.0f, -1.0f},   // rear
+                                        { 0.866025f, -0.5f, -1.0f, 0.0f, 0.0f, -1.0f},   // rear left
+                                        { 0.866025f,  0.5f,  1.0f, 0.0f, 0.0f, -1.0f},   // front left
+                                        { 0.0f,       1.0f, -1.0f, 0.0f, 0.0f, -1.0f},   // front
+                                        {-0.866025f,  0.5f,  1.0f, 0.0f, 0.0f, -1.0f},   // front right
+                                        {-0.866025f, -0.5f, -1.0f, 0.0f, 0.0f, -1.0f}};  // rear right
+};
+
 /**
  * \brief   Full flight controller for hexacopter
  */
@@ -73,17 +88,33 @@ public:
     static conf_t default_config(void)
     {
         conf_t conf = Flight_controller_copter<6>::default_config();
-        float s60 = 0.866025f;
-        //                                 roll, pitch,   yaw,   X,    Y,     Z
-        conf.mix_config.mix  = Mat<6, 6>({ 0.0f, -1.0f,  1.0f, 0.0f, 0.0f, -1.0f,   // rear
-                                            s60, -0.5f, -1.0f, 0.0f, 0.0f, -1.0f,   // rear left
-                                            s60,  0.5f,  1.0f, 0.0f, 0.0f, -1.0f,   // front left
-                                           0.0f,  1.0f, -1.0f, 0.0f, 0.0f, -1.0f,   // front
-                                           -s60,  0.5f,  1.0f, 0.0f, 0.0f, -1.0f,   // front right
-                                           -s60, -0.5f, -1.0f, 0.0f, 0.0f, -1.0f}); // rear right
+        conf.mix_config.mix = Servos_mix_fixed<Mix_hexacopter>::mix_matrix();
 
         return conf;
     };
 };
 
+
+/**
+ * \brief   Full flight controller for hexacopter, with a mix fixed at compile time
+ */
+class Flight_controller_hexacopter_fixed: public Flight_controller_copter<6, Servos_mix_fixed<Mix_hexacopter> >
+{
+public:
+    /**
+     * \brief   Constructor
+     */
+    Flight_controller_hexacopter_fixed( const INS& ins,
+                                        const AHRS& ahrs,
+                                        Servo& motor_rear,
+                                        Servo& motor_rear_left,
+                                        Servo& motor_front_left,
+                                        Servo& motor_front,
+                                        Servo& motor_front_right,
+                                        Servo& motor_rear_right,
+                                        conf_t config):
+        Flight_controller_copter<6, Servos_mix_fixed<Mix_hexacopter> >(ins, ahrs, Servos_mix_fixed<Mix_hexacopter>::args_t{{{&motor_rear, &motor_rear_left, &motor_front_left, &motor_front, &motor_front_right, &motor_rear_right}}}, config)
+    {};
+};
+
 #endif  // FLIGHT_CONTROLLER_HEXACOPTER_HPP_
@@ -89,7 +89,7 @@ bool Flight_controller_hexhog::set_manual_attitude_command(const Manual_control&
 bool Flight_controller_hexhog::set_manual_velocity_command(const Manual_control& manual_control)
 {
     bool ret = true;
-    velocity_command_t new_vel_command;
+    velocity_command_t new_vel_command = {};
     manual_control.get_velocity_command_copter(new_vel_command, ahrs_.attitude(), command_.velocity);
     ret &= set_command(new_vel_command);
     return ret;
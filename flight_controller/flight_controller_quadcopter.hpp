@@ -44,6 +44,34 @@
 
 #include "flight_controller/flight_controller_copter.hpp"
 
+/**
+ * \brief   Mix table for quadcopter in diagonal configuration
+ */
+struct Mix_quadcopter_diag
+{
+    static const uint32_t N = 4;
+    //                                  roll, pitch,   yaw,   X,    Y,     Z
+    static constexpr float mix[N][6] = {{ 1.0f, -1.0f,  1.0f, 0.0f, 0.0f, -1.0f},    // rear left
+                                        { 1.0f,  1.0f, -1.0f, 0.0f, 0.0f, -1.0f},    // front left
+                                        {-1.0f,  1.0f,  1.0f, 0.0f, 0.0f, -1.0f},    // front right
+                                        {-1.0f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f}};   // rear right
+};
+
+
+/**
+ * \brief   Mix table for quadcopter in cross configuration
+ */
+struct Mix_quadcopter_cross
+{
+    static const uint32_t N = 4;
+    //                                  roll, pitch,   yaw,   X,    Y,     Z
+    static constexpr float mix[N][6] = {{ 0.0f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f},    // rear
+                                        { 1.0f,  0.0f,  1.0f, 0.0f, 0.0f, -1.0f},    // left
+                                        { 0.0f,  1.0f, -1.0f, 0.0f, 0.0f, -1.0f},    // front
+                                        {-1.0f,  0.0f,  1.0f, 0.0f, 0.0f, -1.0f}};   // right
+};
+
+
 class Flight_controller_quadcopter: public Flight_controller_copter<4>
 {
 public:
@@ -59,11 +87,7 @@ public:
     static conf_t default_config_diag(void)
     {
         conf_t conf = Flight_controller_copter<4>::default_config();
-        //                                 roll, pitch,   yaw,   X,    Y,     Z
-        conf.mix_config.mix  = Mat<4, 6>({ 1.0f, -1.0f,  1.0f, 0.0f, 0.0f, -1.0f,   // rear left
-                                           1.0f,  1.0f, -1.0f, 0.0f, 0.0f, -1.0f,   // front left
-                                          -1.0f,  1.0f,  1.0f, 0.0f, 0.0f, -1.0f,   // front right
-                                          -1.0f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f}); // rear right
+        conf.mix_config.mix = Servos_mix_fixed<Mix_quadcopter_diag>::mix_matrix();
 
         return conf;
     };
@@ -71,14 +95,27 @@ public:
     static conf_t default_config_cross(void)
     {
         conf_t conf = Flight_controller_copter<4>::default_config();
-        //                                 roll, pitch,   yaw,   X,    Y,     Z
-        conf.mix_config.mix  = Mat<4, 6>({ 0.0f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f,    // rear
-                                           1.0f,  0.0f,  1.0f, 0.0f, 0.0f, -1.0f,    // left
-                                           0.0f,  1.0f, -1.0f, 0.0f, 0.0f, -1.0f,    // front
-                                          -1.0f,  0.0f,  1.0f, 0.0f, 0.0f, -1.0f }); // right
+        conf.mix_config.mix = Servos_mix_fixed<Mix_quadcopter_cross>::mix_matrix();
 
         return conf;
     };
 };
 
+
+/**
+ * \brief   Full flight controller for quadcopter, with a mix fixed at compile time
+ *
+ * \tparam  MIX     Mix table, Mix_quadcopter_diag or Mix_quadcopter_cross
+ */
+template<typename MIX = Mix_quadcopter_diag>
+class Flight_controller_quadcopter_fixed: public Flight_controller_copter<4, Servos_mix_fixed<MIX> >
+{
+public:
+    typedef typename Flight_controller_copter<4, Servos_mix_fixed<MIX> >::conf_t conf_t;
+
+    Flight_controller_quadcopter_fixed(const INS& ins, const AHRS& ahrs, Servo& motor_rl, Servo& motor_fl, Servo& motor_fr, Servo& motor_rr, conf_t config):
+        Flight_controller_copter<4, Servos_mix_fixed<MIX> >(ins, ahrs, typename Servos_mix_fixed<MIX>::args_t{{{&motor_rl, &motor_fl, &motor_fr, &motor_rr}}}, config)
+    {};
+};
+
 #endif  // FLIGHT_CONTROLLER_QUADCOPTER_HPP_
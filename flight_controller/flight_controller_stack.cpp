@@ -57,7 +57,7 @@ Flight_controller_stack::Flight_controller_stack(pos_ctrl_t& pos_ctrl,
     command_.thrust   = thrust_command_t{{{0.0f, 0.0f, 0.0f}}};
     command_.torque   = torque_command_t{{{0.0f, 0.0f, 0.0f}}};
     command_.rate     = rate_command_t{{{0.0f, 0.0f, 0.0f}}};
-    command_.attitude = attitude_command_t{1.0f, {0.0f, 0.0f, 0.0f}};
+    command_.attitude = attitude_command_t();
     command_.velocity = velocity_command_t{{{0.0f, 0.0f, 0.0f}}, 0.0f};
     command_.position = position_command_t{{{0.0f, 0.0f, 0.0f}}, 0.0f};
 };
@@ -93,6 +93,8 @@ bool Flight_controller_stack::update(void)
 };
 
 
+
+// The whole command is passed to the next level, including its feed-forward terms
 template<typename CTRL1, typename CTRL2, typename MID_COMMAND_T = typename CTRL1::out_command_t>
 bool update_cascade_level(CTRL1& ctrl1, CTRL2& ctrl2)
 {
@@ -132,6 +134,43 @@ bool update_cascade_level(CTRL1& ctrl1, CTRL2_A& ctrl2_a, CTRL2_B& ctrl2_b)
 }
 
 
+bool Flight_controller_stack::update_rate_group(rate_group_t group)
+{
+    bool ret = true;
+
+    switch (group)
+    {
+        case RATE_GROUP_POSITION:
+            if (command_.mode == COMMAND_MODE_POSITION)
+            {
+                ret &= update_cascade_level(pos_ctrl_, vel_ctrl_);
+            }
+            if ((command_.mode == COMMAND_MODE_POSITION) || (command_.mode == COMMAND_MODE_VELOCITY))
+            {
+                ret &= update_cascade_level<vel_ctrl_t, att_ctrl_t, mix_ctrl_t,
+                                            attitude_command_t, thrust_command_t>(vel_ctrl_, att_ctrl_, mix_ctrl_);
+            }
+        break;
+
+        case RATE_GROUP_ATTITUDE:
+            if (command_.mode >= COMMAND_MODE_THRUST_AND_ATTITUDE)
+            {
+                ret &= update_cascade_level(att_ctrl_, rate_ctrl_);
+            }
+        break;
+
+        case RATE_GROUP_RATE:
+            if (command_.mode >= COMMAND_MODE_THRUST_AND_RATE)
+            {
+                ret &= update_cascade_level(rate_ctrl_, mix_ctrl_);
+            }
+            ret &= mix_ctrl_.update();
+        break;
+    }
+
+    return ret;
+}
+
 bool Flight_controller_stack::update_in_thrust_and_torque_mode(void)
 {
     // Servo mix
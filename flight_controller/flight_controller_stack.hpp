@@ -86,6 +86,14 @@ public:
     virtual bool update(void);
 
 
+    /**
+     * \brief   Updates the layers of one rate group that are active for the current command
+     *
+     * \param   group   Rate group to update
+     */
+    virtual bool update_rate_group(rate_group_t group);
+
+
     /**
      * \brief   Sets actuators in safety mode
      */
@@ -38,6 +38,7 @@
  *
  ******************************************************************************/
 
+#include <cstring>
 #include <cstdlib>
 #include <cstdbool>
 
@@ -64,7 +65,7 @@ bool File_fat_fs::open(const char* path)
     bool success = true;
     FRESULT fr;
 
-    file_name = (char*)malloc(sizeof(path) + 2);
+    file_name = (char*)malloc(strlen(path) + 3);
     strcpy(file_name, "1:");
     strcat(file_name, path);
 
@@ -79,7 +80,7 @@ bool File_fat_fs::open(const char* path)
 
     if (fat_fs_mounting->sys_mounted)
     {
-        fr = f_open(&file_, file_name, FA_WRITE | FA_OPEN_ALWAYS);
+        fr = f_open(&file_, file_name, FA_READ | FA_WRITE | FA_OPEN_ALWAYS);
 
         if (fr == FR_OK)
         {
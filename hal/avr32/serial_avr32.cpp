@@ -190,6 +190,18 @@ bool Serial_avr32::read(uint8_t* bytes, const uint32_t size)
 }
 
 
+uint32_t Serial_avr32::peek(const uint8_t*& bytes)
+{
+    return rx_buffer_.peek(bytes);
+}
+
+
+bool Serial_avr32::consume(const uint32_t size)
+{
+    return rx_buffer_.consume(size);
+}
+
+
 //------------------------------------------------------------------------------
 // PRIVATE FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
@@ -194,6 +194,18 @@ bool Serial_chibios::read(uint8_t* bytes, const uint32_t size)
 }
 
 
+uint32_t Serial_chibios::peek(const uint8_t*& bytes)
+{
+    return rx_buffer_.peek(bytes);
+}
+
+
+bool Serial_chibios::consume(const uint32_t size)
+{
+    return rx_buffer_.consume(size);
+}
+
+
 //------------------------------------------------------------------------------
 // PRIVATE FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
@@ -42,14 +42,33 @@
 #include "hal/chibios/spi_chibios.hpp"
 
 
+///< Array of 'this' pointers used to dispatch end of transfer callbacks
+static Spi_chibios* handlers_[6] = {0};
+
+
 Spi_chibios::Spi_chibios(conf_t config):
     driver_(config.driver),
-    config_(config.config)
-{}
+    config_(config.config),
+    busy_(false),
+    callback_(NULL),
+    callback_data_(NULL)
+{
+    config_.end_cb = &Spi_chibios::end_callback;
+}
 
 
 bool Spi_chibios::init(void)
 {
+    // Register this instance for end of transfer callbacks
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        if (handlers_[i] == NULL || handlers_[i] == this)
+        {
+            handlers_[i] = this;
+            break;
+        }
+    }
+
     spiAcquireBus(driver_);
     spiStart(driver_, &config_);
     spiReleaseBus(driver_);
@@ -59,6 +78,11 @@ bool Spi_chibios::init(void)
 
 bool Spi_chibios::write(uint8_t* out_buffer, uint32_t nbytes)
 {
+    if (busy_)
+    {
+        return false;
+    }
+
     spiAcquireBus(driver_);
     spiStart(driver_, &config_);
     spiSend(driver_, nbytes, out_buffer);
@@ -70,6 +94,11 @@ bool Spi_chibios::write(uint8_t* out_buffer, uint32_t nbytes)
 
 bool Spi_chibios::read(uint8_t* in_buffer, uint32_t nbytes)
 {
+    if (busy_)
+    {
+        return false;
+    }
+
     spiAcquireBus(driver_);
     spiStart(driver_, &config_);
     spiReceive(driver_, nbytes, in_buffer);
@@ -81,6 +110,11 @@ bool Spi_chibios::read(uint8_t* in_buffer, uint32_t nbytes)
 
 bool Spi_chibios::transfer(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbytes)
 {
+    if (busy_)
+    {
+        return false;
+    }
+
     spiAcquireBus(driver_);
     spiStart(driver_, &config_);
     spiExchange(driver_, nbytes, out_buffer, in_buffer);
@@ -88,3 +122,64 @@ bool Spi_chibios::transfer(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nby
     spiReleaseBus(driver_);
     return true;
 }
+
+
+bool Spi_chibios::transfer_async(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbytes, spi_callback_t callback, void* data)
+{
+    if (busy_ || (nbytes == 0) || ((out_buffer == NULL) && (in_buffer == NULL)))
+    {
+        return false;
+    }
+
+    busy_           = true;
+    callback_       = callback;
+    callback_data_  = data;
+
+    // The bus lock only protects the start of the transfer, busy_ protects the rest
+    spiAcquireBus(driver_);
+    spiStart(driver_, &config_);
+    if (out_buffer == NULL)
+    {
+        spiStartReceive(driver_, nbytes, in_buffer);
+    }
+    else if (in_buffer == NULL)
+    {
+        spiStartSend(driver_, nbytes, out_buffer);
+    }
+    else
+    {
+        spiStartExchange(driver_, nbytes, out_buffer, in_buffer);
+    }
+    spiReleaseBus(driver_);
+
+    return true;
+}
+
+
+bool Spi_chibios::is_busy(void) const
+{
+    return busy_;
+}
+
+
+void Spi_chibios::end_callback(SPIDriver* spip)
+{
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        Spi_chibios* spi = handlers_[i];
+
+        // Blocking transfers also end here, ignore them
+        if ((spi != NULL) && (spi->driver_ == spip) && spi->busy_)
+        {
+            spi_callback_t callback = spi->callback_;
+            void* data              = spi->callback_data_;
+            spi->busy_              = false;
+
+            if (callback != NULL)
+            {
+                callback(data, true);
+            }
+            return;
+        }
+    }
+}
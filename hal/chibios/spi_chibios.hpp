@@ -117,9 +117,49 @@ public:
      */
     bool transfer(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbytes);
 
+
+    /**
+     * \brief   Submit a write and read transfer, completed by the ChibiOS DMA driver
+     *
+     * \details The callback is called from interrupt context, it must not
+     *          submit another transfer on this bus
+     *
+     * \param   out_buffer  Data buffer (output), can be NULL
+     * \param   in_buffer   Data buffer (input), can be NULL
+     * \param   nbytes      Number of bytes to write/read
+     * \param   callback    Function called on completion (can be NULL)
+     * \param   data        User data passed to the callback
+     *
+     * \return  true        Transfer submitted
+     * \return  false       Bus busy or invalid arguments
+     */
+    bool transfer_async(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbytes, spi_callback_t callback, void* data);
+
+
+    /**
+     * \brief   Indicates if an asynchronous transfer is in progress
+     *
+     * \return  true        Transfer in progress
+     * \return  false       Bus idle
+     */
+    bool is_busy(void) const;
+
 private:
     SPIDriver* driver_;   ///< SPI peripheral
     SPIConfig config_;    ///< Configuration
+
+    volatile bool   busy_;          ///< True while an asynchronous transfer is in progress
+    spi_callback_t  callback_;      ///< Completion callback of the current transfer
+    void*           callback_data_; ///< User data of the current transfer
+
+    /**
+     * \brief   End of transfer callback registered in the ChibiOS SPI configuration
+     *
+     * \details Dispatches to the instance using this driver
+     *
+     * \param   spip        SPI driver that completed a transfer
+     */
+    static void end_callback(SPIDriver* spip);
 };
 
 
@@ -42,6 +42,19 @@
 #define I2C_HPP_
 
 #include <cstdint>
+#include <cstddef>
+
+
+/**
+ * @brief   Completion callback of an asynchronous I2C transfer
+ *
+ * @details May be called from interrupt context: keep it short
+ *
+ * @param   data        User data given when the transfer was submitted
+ * @param   success     Result of the transfer
+ */
+typedef void (*i2c_callback_t)(void* data, bool success);
+
 
 class I2c
 {
@@ -116,6 +129,76 @@ public:
 
         return ret;
     };
+
+
+    /**
+     * @brief   Submit a write then read transfer, return without waiting for its completion
+     *
+     * @details The buffers must stay valid until the callback is called.
+     *          Either part of the transfer can be empty (0 bytes).
+     *          The default implementation performs a blocking transfer and
+     *          calls the callback before returning. Override this method
+     *          if the peripheral can complete transfers by DMA or interrupt.
+     *
+     * @param   out_buffer  Data buffer (output)
+     * @param   ntxbytes    Number of bytes to write
+     * @param   in_buffer   Data buffer (input)
+     * @param   nrxbytes    Number of bytes to read
+     * @param   address     Slave adress
+     * @param   callback    Function called on completion (can be NULL)
+     * @param   data        User data passed to the callback
+     *
+     * @return  true        Transfer submitted
+     * @return  false       Bus busy or invalid arguments, the callback will not be called
+     */
+    virtual bool transfer_async(uint8_t* out_buffer, uint32_t ntxbytes, uint8_t* in_buffer, uint32_t nrxbytes, uint32_t address, i2c_callback_t callback, void* data)
+    {
+        bool ret = true;
+
+        if (ntxbytes > 0 && nrxbytes > 0)
+        {
+            ret = transfer(out_buffer, ntxbytes, in_buffer, nrxbytes, address);
+        }
+        else if (ntxbytes > 0)
+        {
+            ret = write(out_buffer, ntxbytes, address);
+        }
+        else if (nrxbytes > 0)
+        {
+            ret = read(in_buffer, nrxbytes, address);
+        }
+
+        if (callback != NULL)
+        {
+            callback(data, ret);
+        }
+
+        return true;
+    };
+
+
+    /**
+     * @brief   Indicates if an asynchronous transfer is in progress
+     *
+     * @return  true        Transfer in progress
+     * @return  false       Bus idle
+     */
+    virtual bool is_busy(void) const
+    {
+        return false;
+    };
+
+
+    /**
+     * @brief   Abort the asynchronous transfer in progress, if any
+     *
+     * @details The callback of the aborted transfer is not called.
+     *          Does nothing by default, as transfers complete before transfer_async returns
+     */
+    virtual void cancel_async(void)
+    {
+        ;
+    };
 };
 
 
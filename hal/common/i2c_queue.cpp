@@ -0,0 +1,435 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file i2c_queue.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Transaction queue sharing one I2C bus between several drivers
+ *
+ ******************************************************************************/
+
+
+#include "hal/common/i2c_queue.hpp"
+#include "hal/common/time_keeper.hpp"
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+I2c_queue::I2c_queue(I2c& bus, conf_t config):
+    bus_(bus),
+    config_(config),
+    device_count_(0),
+    sequence_(0),
+    active_(-1),
+    active_done_(false),
+    active_success_(false),
+    active_start_us_(0),
+    busy_time_us_(0),
+    processing_(false)
+{}
+
+
+bool I2c_queue::add_device(uint32_t address, uint8_t priority, uint32_t timeout_us)
+{
+    device_t* device = get_device(address);
+
+    if (device == NULL)
+    {
+        return false;
+    }
+
+    device->priority   = priority;
+    device->timeout_us = timeout_us;
+
+    return true;
+}
+
+
+bool I2c_queue::init(void)
+{
+    return bus_.init();
+}
+
+
+bool I2c_queue::probe(uint32_t address)
+{
+    if (!wait_idle())
+    {
+        return false;
+    }
+
+    return bus_.probe(address);
+}
+
+
+bool I2c_queue::write(const uint8_t* buffer, uint32_t nbytes, uint32_t address)
+{
+    if (!wait_idle())
+    {
+        return false;
+    }
+
+    return bus_.write(buffer, nbytes, address);
+}
+
+
+bool I2c_queue::read(uint8_t* buffer, uint32_t nbytes, uint32_t address)
+{
+    if (!wait_idle())
+    {
+        return false;
+    }
+
+    return bus_.read(buffer, nbytes, address);
+}
+
+
+bool I2c_queue::transfer(uint8_t* out_buffer, uint32_t ntxbytes, uint8_t* in_buffer, uint32_t nrxbytes, uint32_t address)
+{
+    if (!wait_idle())
+    {
+        return false;
+    }
+
+    return bus_.transfer(out_buffer, ntxbytes, in_buffer, nrxbytes, address);
+}
+
+
+bool I2c_queue::transfer_async(uint8_t* out_buffer, uint32_t ntxbytes, uint8_t* in_buffer, uint32_t nrxbytes, uint32_t address, i2c_callback_t callback, void* data)
+{
+    if ((ntxbytes == 0) && (nrxbytes == 0))
+    {
+        return false;
+    }
+
+    device_t* device = get_device(address);
+    if (device == NULL)
+    {
+        return false;
+    }
+
+    // Find free slot
+    transaction_t* slot = NULL;
+    for (uint32_t i = 0; i < max_transaction_count(); ++i)
+    {
+        if (!transactions()[i].used)
+        {
+            slot = &transactions()[i];
+            break;
+        }
+    }
+
+    if (slot == NULL)
+    {
+        device->drop_count += 1;
+        return false;
+    }
+
+    slot->used          = true;
+    slot->out_buffer    = out_buffer;
+    slot->ntxbytes      = ntxbytes;
+    slot->in_buffer     = in_buffer;
+    slot->nrxbytes      = nrxbytes;
+    slot->callback      = callback;
+    slot->data          = data;
+    slot->device        = device;
+    slot->sequence      = sequence_++;
+    slot->submit_us     = time_keeper_get_us();
+
+    // Start right away if the bus is idle
+    process();
+
+    return true;
+}
+
+
+bool I2c_queue::is_busy(void) const
+{
+    if (active_ >= 0)
+    {
+        return true;
+    }
+
+    for (uint32_t i = 0; i < max_transaction_count(); ++i)
+    {
+        if (transactions()[i].used)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool I2c_queue::update(void)
+{
+    process();
+
+    return true;
+}
+
+
+uint32_t I2c_queue::device_count(void) const
+{
+    return device_count_;
+}
+
+
+const I2c_queue::device_t* I2c_queue::device(uint32_t index) const
+{
+    if (index >= device_count_)
+    {
+        return NULL;
+    }
+
+    return &devices()[index];
+}
+
+
+const I2c_queue::device_t* I2c_queue::find_device(uint32_t address) const
+{
+    for (uint32_t i = 0; i < device_count_; ++i)
+    {
+        if (devices()[i].address == address)
+        {
+            return &devices()[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+uint64_t I2c_queue::busy_time_us(void) const
+{
+    return busy_time_us_;
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+I2c_queue::device_t* I2c_queue::get_device(uint32_t address)
+{
+    for (uint32_t i = 0; i < device_count_; ++i)
+    {
+        if (devices()[i].address == address)
+        {
+            return &devices()[i];
+        }
+    }
+
+    if (device_count_ >= max_device_count())
+    {
+        return NULL;
+    }
+
+    device_t* device = &devices()[device_count_++];
+    *device             = {};
+    device->address     = address;
+    device->priority    = config_.default_priority;
+    device->timeout_us  = config_.default_timeout_us;
+
+    return device;
+}
+
+
+void I2c_queue::process(void)
+{
+    // Callbacks may submit transfers: the outer call takes care of them
+    if (processing_)
+    {
+        return;
+    }
+    processing_ = true;
+
+    bool progress = true;
+    while (progress)
+    {
+        progress        = false;
+        uint64_t now_us = time_keeper_get_us();
+
+        // Transfer on the bus
+        if (active_ >= 0)
+        {
+            transaction_t& active = transactions()[active_];
+
+            if (active_done_)
+            {
+                finish(active_, active_success_, now_us);
+                progress = true;
+            }
+            else if ((now_us - active_start_us_) > active.device->timeout_us)
+            {
+                bus_.cancel_async();
+                active.device->timeout_count += 1;
+                finish(active_, false, now_us);
+                progress = true;
+            }
+        }
+
+        // Drop expired transfers and select the next one
+        int32_t next = -1;
+        for (uint32_t i = 0; i < max_transaction_count(); ++i)
+        {
+            transaction_t& t = transactions()[i];
+
+            if (!t.used || ((int32_t)i == active_))
+            {
+                continue;
+            }
+
+            if ((now_us - t.submit_us) > t.device->timeout_us)
+            {
+                t.device->drop_count += 1;
+                finish(i, false, now_us);
+                progress = true;
+                continue;
+            }
+
+            if (next < 0)
+            {
+                next = i;
+            }
+            else
+            {
+                const transaction_t& best = transactions()[next];
+                if ((t.device->priority > best.device->priority) ||
+                    ((t.device->priority == best.device->priority) && ((int32_t)(t.sequence - best.sequence) < 0)))
+                {
+                    next = i;
+                }
+            }
+        }
+
+        // Start next transfer
+        if ((next >= 0) && (active_ < 0) && !bus_.is_busy())
+        {
+            transaction_t& t = transactions()[next];
+
+            active_             = next;
+            active_done_        = false;
+            active_success_     = false;
+            active_start_us_    = now_us;
+
+            // Blocking buses call bus_callback before returning
+            if (!bus_.transfer_async(t.out_buffer, t.ntxbytes, t.in_buffer, t.nrxbytes, t.device->address, &I2c_queue::bus_callback, this))
+            {
+                active_success_ = false;
+                active_done_    = true;
+            }
+            progress = true;
+        }
+    }
+
+    processing_ = false;
+}
+
+
+bool I2c_queue::wait_idle(void)
+{
+    // Called from a callback: cannot wait for the queue to be processed
+    if (processing_)
+    {
+        return !bus_.is_busy();
+    }
+
+    uint64_t start_us = time_keeper_get_us();
+    while (is_busy())
+    {
+        process();
+
+        if ((time_keeper_get_us() - start_us) > config_.default_timeout_us)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void I2c_queue::finish(uint32_t index, bool success, uint64_t now_us)
+{
+    transaction_t& t    = transactions()[index];
+    device_t& device    = *t.device;
+
+    if ((int32_t)index == active_)
+    {
+        busy_time_us_   += now_us - active_start_us_;
+        active_         = -1;
+
+        uint32_t latency_us     = (uint32_t)(now_us - t.submit_us);
+        device.latency_last_us  = latency_us;
+        if (latency_us > device.latency_max_us)
+        {
+            device.latency_max_us = latency_us;
+        }
+
+        if (success)
+        {
+            device.transfer_count  += 1;
+            device.latency_mean_us += ((float)latency_us - device.latency_mean_us) / (float)device.transfer_count;
+        }
+        else if (active_done_)
+        {
+            device.error_count += 1;
+        }
+    }
+
+    // Release the slot before calling back, so that the callback can submit the next transfer
+    i2c_callback_t callback = t.callback;
+    void* data              = t.data;
+    t.used                  = false;
+
+    if (callback != NULL)
+    {
+        callback(data, success);
+    }
+}
+
+
+void I2c_queue::bus_callback(void* data, bool success)
+{
+    I2c_queue* queue = (I2c_queue*)data;
+
+    if (queue->active_ >= 0)
+    {
+        queue->active_success_  = success;
+        queue->active_done_     = true;
+    }
+}
@@ -0,0 +1,463 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file i2c_queue.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Transaction queue sharing one I2C bus between several drivers
+ *
+ * \details Drivers use the queue as a regular I2c. Asynchronous transfers are
+ *          queued and started one at a time, by decreasing device priority
+ *          then by submission order. Transfers that wait in the queue longer
+ *          than the device timeout are dropped, and transfers that stay on the
+ *          bus longer than the device timeout (measured from their start) are
+ *          aborted, so that a slow or absent device cannot hold the bus.
+ *
+ ******************************************************************************/
+
+
+#ifndef I2C_QUEUE_HPP_
+#define I2C_QUEUE_HPP_
+
+#include <cstdint>
+
+#include "hal/common/i2c.hpp"
+
+
+/**
+ * \brief   I2C transaction queue base class
+ *
+ * \details This class is abstract and does not contain the transaction and device
+ *          tables, use the child class I2c_queue_T
+ */
+class I2c_queue: public I2c
+{
+public:
+    /**
+     * \brief   Configuration structure
+     */
+    struct conf_t
+    {
+        uint8_t     default_priority;       ///< Priority of devices not registered with add_device
+        uint32_t    default_timeout_us;     ///< Timeout of devices not registered with add_device
+    };
+
+
+    /**
+     * \brief   Per device scheduling parameters and statistics
+     */
+    struct device_t
+    {
+        uint32_t    address;                ///< Slave address
+        uint8_t     priority;               ///< Transfers of devices with higher priority are started first
+        uint32_t    timeout_us;             ///< Maximum time of a transfer in the queue, and on the bus
+        uint32_t    transfer_count;         ///< Number of successful transfers
+        uint32_t    error_count;            ///< Number of transfers failed on the bus (NACK, bus error)
+        uint32_t    timeout_count;          ///< Number of transfers aborted while on the bus
+        uint32_t    drop_count;             ///< Number of transfers dropped before being started (queue full or expired)
+        uint32_t    latency_last_us;        ///< Time between submission and completion of the last transfer
+        uint32_t    latency_max_us;         ///< Maximum latency
+        float       latency_mean_us;        ///< Mean latency of successful transfers
+    };
+
+
+    /**
+     * \brief   Default configuration
+     *
+     * \return  Config structure
+     */
+    static inline conf_t default_config(void);
+
+
+    /**
+     * \brief   Constructor
+     *
+     * \param   bus         I2C peripheral shared by the drivers
+     * \param   config      Configuration
+     */
+    I2c_queue(I2c& bus, conf_t config = default_config());
+
+
+    /**
+     * \brief   Register a device with its priority and timeout
+     *
+     * \details Devices are registered with the default priority and timeout at their first transfer otherwise
+     *
+     * \param   address     Slave address
+     * \param   priority    Priority, higher value is served first
+     * \param   timeout_us  Maximum time of a transfer in the queue, and on the bus
+     *
+     * \return  true        Success
+     * \return  false       Device table full
+     */
+    bool add_device(uint32_t address, uint8_t priority, uint32_t timeout_us);
+
+
+    /**
+     * \brief   Hardware initialization of the underlying bus
+     *
+     * \return  true        Success
+     * \return  false       Error
+     */
+    bool init(void);
+
+
+    /**
+     * \brief   Test if a chip answers for a given I2C address
+     *
+     * \details Blocking: waits for the queue to be empty
+     *
+     * \param   address     Slave adress
+     *
+     * \return  true        Slave found
+     * \return  false       Slave not found
+     */
+    bool probe(uint32_t address);
+
+
+    /**
+     * \brief   Write multiple bytes to a I2C slave device
+     *
+     * \details Blocking: waits for the queue to be empty
+     *
+     * \param   buffer      Data buffer
+     * \param   nbytes      Number of bytes to write
+     * \param   address     Slave adress
+     *
+     * \return  true        Data successfully written
+     * \return  false       Data not written
+     */
+    bool write(const uint8_t* buffer, uint32_t nbytes, uint32_t address);
+
+
+    /**
+     * \brief   Read multiple bytes to a I2C slave device
+     *
+     * \details Blocking: waits for the queue to be empty
+     *
+     * \param   buffer      Data buffer
+     * \param   nbytes      Number of bytes to read
+     * \param   address     Slave adress
+     *
+     * \return  true        Data successfully read
+     * \return  false       Data not read
+     */
+    bool read(uint8_t* buffer, uint32_t nbytes, uint32_t address);
+
+
+    /**
+     * \brief   Write then Read data to/from an I2C device
+     *
+     * \details Blocking: waits for the queue to be empty
+     *
+     * \param   out_buffer  Data buffer (output)
+     * \param   ntxbytes    Number of bytes to write
+     * \param   in_buffer   Data buffer (input)
+     * \param   nrxbytes    Number of bytes to read
+     * \param   address     Slave adress
+     *
+     * \return  true        Success
+     * \return  false       Failed
+     */
+    bool transfer(uint8_t* out_buffer, uint32_t ntxbytes, uint8_t* in_buffer, uint32_t nrxbytes, uint32_t address);
+
+
+    /**
+     * \brief   Queue a write then read transfer
+     *
+     * \details The transfer is started immediately if the bus is idle.
+     *          Callbacks are called from update() or from the calling
+     *          context, never from interrupts. A callback can submit a new transfer.
+     *
+     * \param   out_buffer  Data buffer (output)
+     * \param   ntxbytes    Number of bytes to write
+     * \param   in_buffer   Data buffer (input)
+     * \param   nrxbytes    Number of bytes to read
+     * \param   address     Slave adress
+     * \param   callback    Function called on completion, failure or timeout (can be NULL)
+     * \param   data        User data passed to the callback
+     *
+     * \return  true        Transfer queued
+     * \return  false       Queue full
+     */
+    bool transfer_async(uint8_t* out_buffer, uint32_t ntxbytes, uint8_t* in_buffer, uint32_t nrxbytes, uint32_t address, i2c_callback_t callback, void* data);
+
+
+    /**
+     * \brief   Indicates if transfers are queued or in progress
+     *
+     * \return  true        Queue not empty
+     * \return  false       Queue empty
+     */
+    bool is_busy(void) const;
+
+
+    /**
+     * \brief   Complete finished transfers, abort late ones and start the next one
+     *
+     * \details To be called periodically, see update_task
+     *
+     * \return  true        Success
+     */
+    bool update(void);
+
+
+    /**
+     * \brief   Task function for the scheduler
+     *
+     * \param   queue       Pointer to queue
+     *
+     * \return  Success
+     */
+    static bool update_task(I2c_queue* queue)
+    {
+        return queue->update();
+    }
+
+
+    /**
+     * \brief   Number of known devices
+     *
+     * \return  count
+     */
+    uint32_t device_count(void) const;
+
+
+    /**
+     * \brief   Get device parameters and statistics by index
+     *
+     * \param   index       Index in the device table
+     *
+     * \return  Pointer to the device, NULL if index is out of range
+     */
+    const device_t* device(uint32_t index) const;
+
+
+    /**
+     * \brief   Get device parameters and statistics by address
+     *
+     * \param   address     Slave address
+     *
+     * \return  Pointer to the device, NULL if the device is unknown
+     */
+    const device_t* find_device(uint32_t address) const;
+
+
+    /**
+     * \brief   Cumulated time during which the bus was used by queued transfers
+     *
+     * \return  time in microseconds
+     */
+    uint64_t busy_time_us(void) const;
+
+
+protected:
+    /**
+     * \brief   Queued transfer
+     */
+    struct transaction_t
+    {
+        bool            used;               ///< Slot holds a transfer
+        uint8_t*        out_buffer;         ///< Data buffer (output)
+        uint32_t        ntxbytes;           ///< Number of bytes to write
+        uint8_t*        in_buffer;          ///< Data buffer (input)
+        uint32_t        nrxbytes;           ///< Number of bytes to read
+        i2c_callback_t  callback;           ///< Completion callback
+        void*           data;               ///< User data passed to the callback
+        device_t*       device;             ///< Target device
+        uint32_t        sequence;           ///< Submission number, orders transfers of equal priority
+        uint64_t        submit_us;          ///< Submission time
+    };
+
+
+    /**
+     * \brief   Get maximum number of queued transfers
+     * \details To be overriden by child class
+     *
+     * \return  Maximum number of transfers
+     */
+    virtual uint32_t max_transaction_count(void) const = 0;
+
+
+    /**
+     * \brief   Get pointer to the transaction table
+     *
+     * \return  transaction table
+     */
+    virtual transaction_t* transactions(void) = 0;
+    virtual const transaction_t* transactions(void) const = 0;
+
+
+    /**
+     * \brief   Get maximum number of devices
+     * \details To be overriden by child class
+     *
+     * \return  Maximum number of devices
+     */
+    virtual uint32_t max_device_count(void) const = 0;
+
+
+    /**
+     * \brief   Get pointer to the device table
+     *
+     * \return  device table
+     */
+    virtual device_t* devices(void) = 0;
+    virtual const device_t* devices(void) const = 0;
+
+
+private:
+    I2c&            bus_;                   ///< Underlying I2C peripheral
+    conf_t          config_;                ///< Configuration
+    uint32_t        device_count_;          ///< Number of known devices
+    uint32_t        sequence_;              ///< Submission counter
+    int32_t         active_;                ///< Index of the transfer on the bus, -1 if none
+    volatile bool   active_done_;           ///< The transfer on the bus completed
+    volatile bool   active_success_;        ///< Result of the transfer on the bus
+    uint64_t        active_start_us_;       ///< Start time of the transfer on the bus
+    uint64_t        busy_time_us_;          ///< Cumulated bus usage
+    bool            processing_;            ///< process() is running, prevents recursion from callbacks
+
+    /**
+     * \brief   Find a device, register it with default parameters if unknown
+     *
+     * \param   address     Slave address
+     *
+     * \return  Pointer to the device, NULL if the device table is full
+     */
+    device_t* get_device(uint32_t address);
+
+    /**
+     * \brief   Complete, abort, drop and start transfers until nothing changes
+     */
+    void process(void);
+
+    /**
+     * \brief   Wait until all queued transfers are complete, before a blocking operation
+     *
+     * \return  true if the queue is empty
+     */
+    bool wait_idle(void);
+
+    /**
+     * \brief   Release a transfer slot, update statistics and call the callback
+     *
+     * \param   index       Index of the transfer
+     * \param   success     Transfer completed successfully
+     * \param   now_us      Current time
+     */
+    void finish(uint32_t index, bool success, uint64_t now_us);
+
+    /**
+     * \brief   Completion callback given to the underlying bus
+     *
+     * \details May be called from interrupt context, only records the result
+     *
+     * \param   data        Pointer to the queue
+     * \param   success     Result of the transfer
+     */
+    static void bus_callback(void* data, bool success);
+};
+
+
+/**
+ * \brief   I2C transaction queue
+ *
+ * \tparam  N   Maximum number of queued transfers
+ * \tparam  D   Maximum number of devices
+ */
+template<uint32_t N = 8, uint32_t D = 4>
+class I2c_queue_T: public I2c_queue
+{
+public:
+    /**
+     * \brief   Constructor
+     *
+     * \param   bus         I2C peripheral shared by the drivers
+     * \param   config      Configuration
+     */
+    I2c_queue_T(I2c& bus, conf_t config = default_config()):
+        I2c_queue(bus, config),
+        transactions_(),
+        devices_()
+    {}
+
+protected:
+    uint32_t max_transaction_count(void) const
+    {
+        return N;
+    }
+
+    transaction_t* transactions(void)
+    {
+        return transactions_;
+    }
+
+    const transaction_t* transactions(void) const
+    {
+        return transactions_;
+    }
+
+    uint32_t max_device_count(void) const
+    {
+        return D;
+    }
+
+    device_t* devices(void)
+    {
+        return devices_;
+    }
+
+    const device_t* devices(void) const
+    {
+        return devices_;
+    }
+
+private:
+    transaction_t   transactions_[N];       ///< Transaction table
+    device_t        devices_[D];            ///< Device table
+};
+
+
+I2c_queue::conf_t I2c_queue::default_config(void)
+{
+    conf_t conf = {};
+
+    conf.default_priority   = 0;
+    conf.default_timeout_us = 20000;
+
+    return conf;
+}
+
+
+#endif /* I2C_QUEUE_HPP_ */
@@ -1,4 +1,5 @@
 #include "hal/common/serial.hpp"
+#include <cstddef>
 
 /**
  * \brief   write newline character to stream ('\n\r')
@@ -9,4 +10,26 @@ bool Serial::newline()
 {
     const uint8_t newline[2] = {'\n', '\r'};
     return write(newline, 2);
-}
\ No newline at end of file
+}
+
+/**
+ * \brief   Get the oldest contiguous span of received bytes, without reading them
+ *
+ * \return  0, serials without direct access to their buffer use read()
+ */
+uint32_t Serial::peek(const uint8_t*& bytes)
+{
+    bytes = NULL;
+    return 0;
+}
+
+
+/**
+ * \brief   Drop received bytes previously returned by peek()
+ *
+ * \return  false, serials without direct access to their buffer use read()
+ */
+bool Serial::consume(const uint32_t size)
+{
+    return false;
+}
@@ -122,6 +122,30 @@ public:
      */
     virtual bool read(uint8_t* bytes, const uint32_t size = 1) = 0;
 
+
+    /**
+     * \brief   Get the oldest contiguous span of received bytes, without reading them
+     *
+     * \details Lets parsers work in place in the reception buffer. Serials
+     *          without direct access to their buffer return 0, use read() instead
+     *
+     * \param   bytes       Pointer to the oldest received byte (output)
+     *
+     * \return  Number of contiguous bytes available at bytes
+     */
+    virtual uint32_t peek(const uint8_t*& bytes);
+
+
+    /**
+     * \brief   Drop received bytes previously returned by peek()
+     *
+     * \param   size        Number of bytes to drop
+     *
+     * \return  success
+     */
+    virtual bool consume(const uint32_t size);
+
+
     /**
      * \brief   write newline character to stream ('\n\r')
      *
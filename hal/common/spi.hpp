@@ -43,6 +43,18 @@
 
 
 #include <cstdint>
+#include <cstddef>
+
+
+/**
+ * \brief   Completion callback of an asynchronous SPI transfer
+ *
+ * \details May be called from interrupt context: keep it short
+ *
+ * \param   data        User data given when the transfer was submitted
+ * \param   success     Result of the transfer
+ */
+typedef void (*spi_callback_t)(void* data, bool success);
 
 
 class Spi
@@ -94,6 +106,47 @@ public:
      */
     virtual bool transfer(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbytes) = 0;
 
+
+    /**
+     * \brief   Submit a write and read transfer, return without waiting for its completion
+     *
+     * \details The buffers must stay valid until the callback is called.
+     *          The default implementation performs a blocking transfer and
+     *          calls the callback before returning. Override this method
+     *          if the peripheral can complete transfers by DMA or interrupt.
+     *
+     * \param   out_buffer  Data buffer (output), can be NULL
+     * \param   in_buffer   Data buffer (input), can be NULL
+     * \param   nbytes      Number of bytes to write/read
+     * \param   callback    Function called on completion (can be NULL)
+     * \param   data        User data passed to the callback
+     *
+     * \return  true        Transfer submitted
+     * \return  false       Bus busy or invalid arguments, the callback will not be called
+     */
+    virtual bool transfer_async(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbytes, spi_callback_t callback, void* data)
+    {
+        bool ret = transfer(out_buffer, in_buffer, nbytes);
+
+        if (callback != NULL)
+        {
+            callback(data, ret);
+        }
+
+        return true;
+    };
+
+
+    /**
+     * \brief   Indicates if an asynchronous transfer is in progress
+     *
+     * \return  true        Transfer in progress
+     * \return  false       Bus idle
+     */
+    virtual bool is_busy(void) const
+    {
+        return false;
+    };
 };
 
 
@@ -47,9 +47,14 @@ extern "C"
 #include <libopencm3/stm32/i2c.h>
 #include <libopencm3/stm32/rcc.h>
 #include <libopencm3/stm32/gpio.h>
+#include <libopencm3/cm3/nvic.h>
 }
 
 
+///< Array of 'this' pointers used for interrupt handling
+static I2c_stm32* handlers_[3] = {0};
+
+
 const uint32_t FLAG_MASK                = 0x00FFFFFF;
 const uint32_t DATA_RECEIVED            = 0x00030040;
 const uint32_t RECEIVER_MODE_SELECTED   = 0x00030002;
@@ -207,6 +212,16 @@ I2c_stm32::I2c_stm32(i2c_stm32_conf_t config)
     config_         = config;
     i2c_            = config.i2c_device_config;
     i2c_timeout_    = config.timeout;
+    async_state_    = ASYNC_IDLE;
+    async_address_  = 0;
+    async_out_      = NULL;
+    async_ntx_      = 0;
+    async_itx_      = 0;
+    async_in_       = NULL;
+    async_nrx_      = 0;
+    async_irx_      = 0;
+    async_callback_ = NULL;
+    async_data_     = NULL;
 }
 
 
@@ -288,6 +303,31 @@ bool I2c_stm32::init(void)
     //enable I2C1
     i2c_peripheral_enable(i2c_);
 
+    //enable interrupts used by asynchronous transfers
+    if (config_.async_enabled)
+    {
+        switch (config_.i2c_device_config)
+        {
+            case STM32_I2C1:
+                nvic_enable_irq(NVIC_I2C1_EV_IRQ);
+                nvic_enable_irq(NVIC_I2C1_ER_IRQ);
+                handlers_[0] = this;
+            break;
+
+            case STM32_I2C2:
+                nvic_enable_irq(NVIC_I2C2_EV_IRQ);
+                nvic_enable_irq(NVIC_I2C2_ER_IRQ);
+                handlers_[1] = this;
+            break;
+
+            case STM32_I2C3:
+                nvic_enable_irq(NVIC_I2C3_EV_IRQ);
+                nvic_enable_irq(NVIC_I2C3_ER_IRQ);
+                handlers_[2] = this;
+            break;
+        }
+    }
+
     return init_success;
 }
 
@@ -309,6 +349,12 @@ bool I2c_stm32::write(const uint8_t* buffer, uint32_t nbytes, uint32_t address)
 {
     bool success = true;
 
+    //do not interfere with an asynchronous transfer
+    if (is_busy())
+    {
+        return false;
+    }
+
     //start
     success &= start(address, true, true);
 
@@ -338,6 +384,12 @@ bool I2c_stm32::read(uint8_t* buffer, uint32_t nbytes, uint32_t address)
 {
     bool success = true;
 
+    //do not interfere with an asynchronous transfer
+    if (is_busy())
+    {
+        return false;
+    }
+
     //Start
     success &= start(address, false, true);
 
@@ -356,3 +408,219 @@ bool I2c_stm32::read(uint8_t* buffer, uint32_t nbytes, uint32_t address)
 
     return success;
 }
+
+
+bool I2c_stm32::transfer_async(uint8_t* out_buffer, uint32_t ntxbytes, uint8_t* in_buffer, uint32_t nrxbytes, uint32_t address, i2c_callback_t callback, void* data)
+{
+    if (!config_.async_enabled)
+    {
+        return I2c::transfer_async(out_buffer, ntxbytes, in_buffer, nrxbytes, address, callback, data);
+    }
+
+    if (is_busy() || ((ntxbytes == 0) && (nrxbytes == 0)))
+    {
+        return false;
+    }
+
+    async_address_  = address;
+    async_out_      = out_buffer;
+    async_ntx_      = ntxbytes;
+    async_itx_      = 0;
+    async_in_       = in_buffer;
+    async_nrx_      = nrxbytes;
+    async_irx_      = 0;
+    async_callback_ = callback;
+    async_data_     = data;
+    async_state_    = (ntxbytes > 0) ? ASYNC_WRITE : ASYNC_READ;
+
+    //enable interrupts, then generate start: the rest is done in ev_irq_handler
+    I2C_CR2(i2c_) |= I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN | I2C_CR2_ITERREN;
+    I2C_CR1(i2c_) |= I2C_CR1_ACK;
+    i2c_send_start(i2c_);
+
+    return true;
+}
+
+
+bool I2c_stm32::is_busy(void) const
+{
+    return async_state_ != ASYNC_IDLE;
+}
+
+
+void I2c_stm32::cancel_async(void)
+{
+    if (!is_busy())
+    {
+        return;
+    }
+
+    I2C_CR2(i2c_) &= ~(I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN | I2C_CR2_ITERREN);
+    I2C_CR1(i2c_) |= I2C_CR1_STOP;
+    async_state_ = ASYNC_IDLE;
+}
+
+
+void I2c_stm32::ev_irq_handler(void)
+{
+    uint32_t sr1 = I2C_SR1(i2c_);
+
+    if (sr1 & I2C_SR1_SB)
+    {
+        //start sent: send address with write/read bit
+        if (async_state_ == ASYNC_WRITE)
+        {
+            I2C_DR(i2c_) = async_address_<<1 & ~((uint16_t)0x0001);
+        }
+        else
+        {
+            I2C_DR(i2c_) = async_address_<<1 | ((uint16_t)0x0001);
+        }
+    }
+    else if (sr1 & I2C_SR1_ADDR)
+    {
+        //address acknowledged
+        if ((async_state_ == ASYNC_READ) && (async_nrx_ == 1))
+        {
+            //single byte: nack and stop must be programmed before clearing ADDR
+            I2C_CR1(i2c_) &= ~I2C_CR1_ACK;
+            I2C_SR2(i2c_);
+            I2C_CR1(i2c_) |= I2C_CR1_STOP;
+        }
+        else
+        {
+            //read status register to clear flag
+            I2C_SR2(i2c_);
+        }
+    }
+    else if (async_state_ == ASYNC_WRITE)
+    {
+        if ((sr1 & I2C_SR1_TxE) && (async_itx_ < async_ntx_))
+        {
+            I2C_DR(i2c_) = async_out_[async_itx_++];
+
+            if (async_itx_ == async_ntx_)
+            {
+                //last byte queued, wait for byte transfer finished
+                I2C_CR2(i2c_) &= ~I2C_CR2_ITBUFEN;
+            }
+        }
+        else if (sr1 & I2C_SR1_BTF)
+        {
+            if (async_nrx_ > 0)
+            {
+                //repeated start for the read phase
+                async_state_ = ASYNC_READ;
+                I2C_CR2(i2c_) |= I2C_CR2_ITBUFEN;
+                I2C_CR1(i2c_) |= I2C_CR1_ACK;
+                i2c_send_start(i2c_);
+            }
+            else
+            {
+                I2C_CR1(i2c_) |= I2C_CR1_STOP;
+                async_complete(true);
+            }
+        }
+    }
+    else if (async_state_ == ASYNC_READ)
+    {
+        if (sr1 & I2C_SR1_RxNE)
+        {
+            async_in_[async_irx_++] = I2C_DR(i2c_);
+
+            if ((async_nrx_ - async_irx_) == 1)
+            {
+                //next byte is the last one: nack it and stop
+                I2C_CR1(i2c_) &= ~I2C_CR1_ACK;
+                I2C_CR1(i2c_) |= I2C_CR1_STOP;
+            }
+            else if (async_irx_ == async_nrx_)
+            {
+                async_complete(true);
+            }
+        }
+    }
+}
+
+
+void I2c_stm32::er_irq_handler(void)
+{
+    //clear error flags (acknowledge failure, arbitration lost, bus error, overrun)
+    I2C_SR1(i2c_) &= ~(I2C_SR1_AF | I2C_SR1_ARLO | I2C_SR1_BERR | I2C_SR1_OVR);
+
+    I2C_CR1(i2c_) |= I2C_CR1_STOP;
+
+    if (is_busy())
+    {
+        async_complete(false);
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+void I2c_stm32::async_complete(bool success)
+{
+    I2C_CR2(i2c_) &= ~(I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN | I2C_CR2_ITERREN);
+
+    //release the bus before calling back, so that the callback can submit the next transfer
+    i2c_callback_t callback = async_callback_;
+    void* data              = async_data_;
+    async_state_            = ASYNC_IDLE;
+
+    if (callback != NULL)
+    {
+        callback(data, success);
+    }
+}
+
+
+/**
+ * @brief   Event and error irq functions
+ *
+ * @details These functions have to be static in order to be registerable
+ *          as interrupt handlers. They do internally the dispatch to
+ *          call the irq handlers on the right object instance
+ */
+__attribute__((interrupt))
+void i2c1_ev_isr(void)
+{
+    handlers_[0]->ev_irq_handler();
+}
+
+
+__attribute__((interrupt))
+void i2c1_er_isr(void)
+{
+    handlers_[0]->er_irq_handler();
+}
+
+
+__attribute__((interrupt))
+void i2c2_ev_isr(void)
+{
+    handlers_[1]->ev_irq_handler();
+}
+
+
+__attribute__((interrupt))
+void i2c2_er_isr(void)
+{
+    handlers_[1]->er_irq_handler();
+}
+
+
+__attribute__((interrupt))
+void i2c3_ev_isr(void)
+{
+    handlers_[2]->ev_irq_handler();
+}
+
+
+__attribute__((interrupt))
+void i2c3_er_isr(void)
+{
+    handlers_[2]->er_irq_handler();
+}
@@ -77,6 +77,7 @@ typedef struct
     rcc_periph_clken    rcc_clk_port_config;    ///< corresponding port for rcc
     uint32_t            clk_speed;              ///< i2c clk speed
     uint16_t            timeout;                ///< i2c timeout
+    bool                async_enabled;          ///< Complete asynchronous transfers by interrupts
 } i2c_stm32_conf_t;
 
 /**
@@ -146,11 +147,92 @@ public:
     bool read(uint8_t* buffer, uint32_t nbytes, uint32_t address);
 
 
+    /**
+     * @brief   Submit a write then read transfer completed by interrupts
+     *
+     * @details Falls back to a blocking transfer if async_enabled is false in the configuration
+     *
+     * @param   out_buffer  Data buffer (output)
+     * @param   ntxbytes    Number of bytes to write
+     * @param   in_buffer   Data buffer (input)
+     * @param   nrxbytes    Number of bytes to read
+     * @param   address     Slave adress
+     * @param   callback    Function called from the I2C interrupt on completion (can be NULL)
+     * @param   data        User data passed to the callback
+     *
+     * @return  True        Transfer submitted
+     * @return  False       Bus busy or invalid arguments
+     */
+    bool transfer_async(uint8_t* out_buffer, uint32_t ntxbytes, uint8_t* in_buffer, uint32_t nrxbytes, uint32_t address, i2c_callback_t callback, void* data);
+
+
+    /**
+     * @brief   Indicates if an asynchronous transfer is in progress
+     *
+     * @return  True        Transfer in progress
+     * @return  False       Bus idle
+     */
+    bool is_busy(void) const;
+
+
+    /**
+     * @brief   Abort the asynchronous transfer in progress, if any
+     *
+     * @details Generates a stop condition, the callback is not called
+     */
+    void cancel_async(void);
+
+
+    /**
+     * @brief   Event interrupt handler
+     *
+     * @details This function is called by i2cX_ev_isr(), it is not
+     *          static, thus has access to object members
+     */
+    void ev_irq_handler(void);
+
+
+    /**
+     * @brief   Error interrupt handler
+     *
+     * @details This function is called by i2cX_er_isr()
+     */
+    void er_irq_handler(void);
+
+
 private:
     i2c_stm32_conf_t        config_;        ///< Configuration
     i2c_stm32_devices_t     i2c_;           ///< I2C device
     uint16_t                i2c_timeout_;   ///< I2C timeout
 
+    /**
+     * @brief   Phases of an asynchronous transfer
+     */
+    typedef enum
+    {
+        ASYNC_IDLE,                             ///< No transfer in progress
+        ASYNC_WRITE,                            ///< Sending address and data bytes
+        ASYNC_READ,                             ///< Sending address and receiving data bytes
+    } async_state_t;
+
+    volatile async_state_t  async_state_;       ///< Phase of the current asynchronous transfer
+    uint8_t                 async_address_;     ///< Slave address of the current transfer
+    uint8_t*                async_out_;         ///< Output buffer of the current transfer
+    uint32_t                async_ntx_;         ///< Number of bytes to write
+    uint32_t                async_itx_;         ///< Number of bytes written
+    uint8_t*                async_in_;          ///< Input buffer of the current transfer
+    uint32_t                async_nrx_;         ///< Number of bytes to read
+    uint32_t                async_irx_;         ///< Number of bytes read
+    i2c_callback_t          async_callback_;    ///< Completion callback of the current transfer
+    void*                   async_data_;        ///< User data of the current transfer
+
+    /**
+     * @brief   End the current asynchronous transfer and call its callback
+     *
+     * @param   success     Result of the transfer
+     */
+    void async_complete(bool success);
+
     /**
      * @brief   Check if an i2c event occured
      *
@@ -212,6 +294,7 @@ static inline  i2c_stm32_conf_t i2c_stm32_default_config()
     conf.clk_speed          = 100000;
     conf.tenbit_config      = false;  // currently only support 8 bits addressing
     conf.timeout            = 20000;
+    conf.async_enabled      = false;
     return conf;
 }
 
@@ -227,6 +227,18 @@ bool Serial_stm32::read(uint8_t* bytes, const uint32_t size)
 }
 
 
+uint32_t Serial_stm32::peek(const uint8_t*& bytes)
+{
+    return rx_buffer_.peek(bytes);
+}
+
+
+bool Serial_stm32::consume(const uint32_t size)
+{
+    return rx_buffer_.consume(size);
+}
+
+
 //------------------------------------------------------------------------------
 // PRIVATE FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
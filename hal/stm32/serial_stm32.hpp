@@ -248,6 +248,26 @@ public:
     bool read(uint8_t* bytes, const uint32_t size = 1);
 
 
+    /**
+     * \brief   Get the oldest contiguous span of the reception buffer
+     *
+     * \param   bytes       Pointer to the oldest received byte (output)
+     *
+     * \return  Number of contiguous bytes available at bytes
+     */
+    uint32_t peek(const uint8_t*& bytes);
+
+
+    /**
+     * \brief   Drop bytes from the reception buffer
+     *
+     * \param   size        Number of bytes to drop
+     *
+     * \return  success
+     */
+    bool consume(const uint32_t size);
+
+
     /**
      * \brief       Default interrupt-handling function
      *
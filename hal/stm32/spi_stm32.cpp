@@ -46,16 +46,57 @@ extern "C"
 {
 #include <libopencm3/stm32/gpio.h>
 #include <libopencm3/stm32/rcc.h>
+#include <libopencm3/stm32/dma.h>
+#include <libopencm3/cm3/nvic.h>
 }
 
+
+///< Array of 'this' pointers used for interrupt handling
+static Spi_stm32* handlers_[3] = {0};
+
+
 //------------------------------------------------------------------------------
 // PUBLIC FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
 
 Spi_stm32::Spi_stm32(spi_stm32_conf_t spi_config):
     config_(spi_config),
-    spi_(spi_config.spi_device)
-{}
+    spi_(spi_config.spi_device),
+    dma_(DMA2),
+    rx_stream_(DMA_STREAM0),
+    tx_stream_(DMA_STREAM3),
+    dma_channel_(DMA_SxCR_CHSEL_3),
+    busy_(false),
+    callback_(NULL),
+    callback_data_(NULL),
+    dummy_tx_(0),
+    dummy_rx_(0)
+{
+    // DMA request mapping (RM0090 tables 42 and 43)
+    switch (config_.spi_device)
+    {
+        case STM32_SPI1:
+            dma_         = DMA2;
+            rx_stream_   = DMA_STREAM0;
+            tx_stream_   = DMA_STREAM3;
+            dma_channel_ = DMA_SxCR_CHSEL_3;
+        break;
+
+        case STM32_SPI2:
+            dma_         = DMA1;
+            rx_stream_   = DMA_STREAM3;
+            tx_stream_   = DMA_STREAM4;
+            dma_channel_ = DMA_SxCR_CHSEL_0;
+        break;
+
+        case STM32_SPI3:
+            dma_         = DMA1;
+            rx_stream_   = DMA_STREAM0;
+            tx_stream_   = DMA_STREAM5;
+            dma_channel_ = DMA_SxCR_CHSEL_0;
+        break;
+    }
+}
 
 
 bool Spi_stm32::init(void)
@@ -148,6 +189,37 @@ bool Spi_stm32::init(void)
     spi_enable(spi_);
     spi_set_master_mode(spi_);
 
+    // DMA configuration
+    if (config_.dma_enabled)
+    {
+        if (dma_ == DMA1)
+        {
+            rcc_periph_clock_enable(RCC_DMA1);
+        }
+        else
+        {
+            rcc_periph_clock_enable(RCC_DMA2);
+        }
+
+        switch (config_.spi_device)
+        {
+            case STM32_SPI1:
+                nvic_enable_irq(NVIC_DMA2_STREAM0_IRQ);
+                handlers_[0] = this;
+            break;
+
+            case STM32_SPI2:
+                nvic_enable_irq(NVIC_DMA1_STREAM3_IRQ);
+                handlers_[1] = this;
+            break;
+
+            case STM32_SPI3:
+                nvic_enable_irq(NVIC_DMA1_STREAM0_IRQ);
+                handlers_[2] = this;
+            break;
+        }
+    }
+
     return ret;
 }
 
@@ -175,6 +247,12 @@ bool Spi_stm32::transfer(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbyte
 {
     bool ret = true;
 
+    // Do not interfere with a DMA transfer
+    if (busy_)
+    {
+        return false;
+    }
+
     if (!config_.ss_mode_hard)
     {
         spi_set_nss_high(spi_);
@@ -216,4 +294,155 @@ bool Spi_stm32::transfer(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbyte
     }
 
     return ret;
-}
\ No newline at end of file
+}
+
+
+bool Spi_stm32::transfer_async(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbytes, spi_callback_t callback, void* data)
+{
+    if (!config_.dma_enabled)
+    {
+        return Spi::transfer_async(out_buffer, in_buffer, nbytes, callback, data);
+    }
+
+    if (busy_ || (nbytes == 0) || ((out_buffer == NULL) && (in_buffer == NULL)))
+    {
+        return false;
+    }
+
+    busy_           = true;
+    callback_       = callback;
+    callback_data_  = data;
+
+    if (!config_.ss_mode_hard)
+    {
+        spi_set_nss_high(spi_);
+    }
+
+    // Flush data received before this transfer
+    (void)SPI_DR(spi_);
+
+    // Reception stream: the transfer is complete when the last byte is received
+    dma_stream_reset(dma_, rx_stream_);
+    dma_channel_select(dma_, rx_stream_, dma_channel_);
+    dma_set_priority(dma_, rx_stream_, DMA_SxCR_PL_VERY_HIGH);
+    dma_set_transfer_mode(dma_, rx_stream_, DMA_SxCR_DIR_PERIPHERAL_TO_MEM);
+    dma_set_peripheral_address(dma_, rx_stream_, (uint32_t)&SPI_DR(spi_));
+    dma_set_peripheral_size(dma_, rx_stream_, DMA_SxCR_PSIZE_8BIT);
+    dma_set_memory_size(dma_, rx_stream_, DMA_SxCR_MSIZE_8BIT);
+    dma_set_number_of_data(dma_, rx_stream_, nbytes);
+    if (in_buffer != NULL)
+    {
+        dma_set_memory_address(dma_, rx_stream_, (uint32_t)in_buffer);
+        dma_enable_memory_increment_mode(dma_, rx_stream_);
+    }
+    else
+    {
+        dma_set_memory_address(dma_, rx_stream_, (uint32_t)&dummy_rx_);
+        dma_disable_memory_increment_mode(dma_, rx_stream_);
+    }
+    dma_enable_transfer_complete_interrupt(dma_, rx_stream_);
+    dma_enable_transfer_error_interrupt(dma_, rx_stream_);
+
+    // Transmission stream
+    dma_stream_reset(dma_, tx_stream_);
+    dma_channel_select(dma_, tx_stream_, dma_channel_);
+    dma_set_priority(dma_, tx_stream_, DMA_SxCR_PL_HIGH);
+    dma_set_transfer_mode(dma_, tx_stream_, DMA_SxCR_DIR_MEM_TO_PERIPHERAL);
+    dma_set_peripheral_address(dma_, tx_stream_, (uint32_t)&SPI_DR(spi_));
+    dma_set_peripheral_size(dma_, tx_stream_, DMA_SxCR_PSIZE_8BIT);
+    dma_set_memory_size(dma_, tx_stream_, DMA_SxCR_MSIZE_8BIT);
+    dma_set_number_of_data(dma_, tx_stream_, nbytes);
+    if (out_buffer != NULL)
+    {
+        dma_set_memory_address(dma_, tx_stream_, (uint32_t)out_buffer);
+        dma_enable_memory_increment_mode(dma_, tx_stream_);
+    }
+    else
+    {
+        dummy_tx_ = 0;
+        dma_set_memory_address(dma_, tx_stream_, (uint32_t)&dummy_tx_);
+        dma_disable_memory_increment_mode(dma_, tx_stream_);
+    }
+
+    // Start reception before transmission so that no byte is missed
+    dma_enable_stream(dma_, rx_stream_);
+    dma_enable_stream(dma_, tx_stream_);
+    spi_enable_rx_dma(spi_);
+    spi_enable_tx_dma(spi_);
+
+    return true;
+}
+
+
+bool Spi_stm32::is_busy(void) const
+{
+    return busy_;
+}
+
+
+void Spi_stm32::irq_handler(void)
+{
+    bool success = true;
+
+    if (dma_get_interrupt_flag(dma_, rx_stream_, DMA_TEIF))
+    {
+        success = false;
+    }
+    else if (!dma_get_interrupt_flag(dma_, rx_stream_, DMA_TCIF))
+    {
+        return;
+    }
+    dma_clear_interrupt_flags(dma_, rx_stream_, DMA_TCIF | DMA_TEIF);
+
+    spi_disable_rx_dma(spi_);
+    spi_disable_tx_dma(spi_);
+    dma_disable_stream(dma_, tx_stream_);
+    dma_disable_stream(dma_, rx_stream_);
+
+    if (!config_.ss_mode_hard)
+    {
+        spi_set_nss_low(spi_);
+    }
+
+    // Release the bus before calling back, so that the callback can submit the next transfer
+    spi_callback_t callback = callback_;
+    void* data              = callback_data_;
+    busy_                   = false;
+
+    if (callback != NULL)
+    {
+        callback(data, success);
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+/**
+ * \brief       DMA reception complete irq functions
+ *
+ * \details     These functions have to be static in order to be registerable
+ *              as interrupt handlers. They do internally the dispatch to
+ *              call the 'irq_handler' function on the right object instance
+ */
+__attribute__((interrupt))
+void dma2_stream0_isr(void)
+{
+    handlers_[0]->irq_handler();
+}
+
+
+__attribute__((interrupt))
+void dma1_stream3_isr(void)
+{
+    handlers_[1]->irq_handler();
+}
+
+
+__attribute__((interrupt))
+void dma1_stream0_isr(void)
+{
+    handlers_[2]->irq_handler();
+}
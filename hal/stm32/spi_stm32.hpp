@@ -84,6 +84,7 @@ typedef struct
     gpio_stm32_conf_t       miso_gpio_config;   ///< Master Out Slave In config
     gpio_stm32_conf_t       mosi_gpio_config;   ///< Master In Slave Out config
     gpio_stm32_conf_t       sck_gpio_config;    ///< Serial Clock config
+    bool                    dma_enabled;        ///< Complete asynchronous transfers by DMA (SPI1: DMA2 streams 0/3, SPI2: DMA1 streams 3/4, SPI3: DMA1 streams 0/5)
 } spi_stm32_conf_t;
 
 
@@ -146,6 +147,38 @@ public:
      */
     bool transfer(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbytes);
 
+    /**
+     * \brief   Submit a write and read transfer completed by DMA
+     *
+     * \details Falls back to a blocking transfer if DMA is not enabled in the configuration
+     *
+     * \param   out_buffer  Data buffer (output), can be NULL
+     * \param   in_buffer   Data buffer (input), can be NULL
+     * \param   nbytes      Number of bytes to write/read
+     * \param   callback    Function called from the DMA interrupt on completion (can be NULL)
+     * \param   data        User data passed to the callback
+     *
+     * \return  true        Transfer submitted
+     * \return  false       Bus busy or invalid arguments
+     */
+    bool transfer_async(uint8_t* out_buffer, uint8_t* in_buffer, uint32_t nbytes, spi_callback_t callback, void* data);
+
+    /**
+     * \brief   Indicates if a DMA transfer is in progress
+     *
+     * \return  true        Transfer in progress
+     * \return  false       Bus idle
+     */
+    bool is_busy(void) const;
+
+    /**
+     * \brief       DMA transfer complete interrupt handler
+     *
+     * \details     This function is called by dmaX_streamY_isr(), it is not
+     *              static, thus has access to object members
+     */
+    void irq_handler(void);
+
     /**
      * \brief   Select slave
      */
@@ -162,6 +195,16 @@ private:
     spi_stm32_conf_t            config_;        ///< Configuration
     spi_stm32_devices_t         spi_;           ///< Device ID
 
+    uint32_t                    dma_;           ///< DMA controller serving this SPI
+    uint8_t                     rx_stream_;     ///< DMA stream for reception
+    uint8_t                     tx_stream_;     ///< DMA stream for transmission
+    uint32_t                    dma_channel_;   ///< DMA channel selection (same for rx and tx)
+
+    volatile bool               busy_;          ///< True while a DMA transfer is in progress
+    spi_callback_t              callback_;      ///< Completion callback of the current transfer
+    void*                       callback_data_; ///< User data of the current transfer
+    uint8_t                     dummy_tx_;      ///< Byte sent when no output buffer is given
+    uint8_t                     dummy_rx_;      ///< Byte received when no input buffer is given
 };
 
 
@@ -47,8 +47,9 @@
 
 Mission_handler_critical_navigating::Mission_handler_critical_navigating(const INS& ins,
                                                                          const Mavlink_stream& mavlink_stream,
-                                                                         Mavlink_waypoint_handler& waypoint_handler):
-    Mission_handler_navigating(ins, mavlink_stream, waypoint_handler)
+                                                                         Mavlink_waypoint_handler& waypoint_handler,
+                                                                         const Trajectory::conf_t& trajectory_config):
+    Mission_handler_navigating(ins, mavlink_stream, waypoint_handler, trajectory_config)
 {}
 
 
@@ -61,10 +61,12 @@ public:
      * \param   mission_planner                     The reference to the mission planner
      * \param   mavlink_stream                      The reference to the MAVLink stream structure
      * \param   waypoint_handler                    The handler for the manual control state
+     * \param   trajectory_config                   The configuration of the trajectory generator
      */
      Mission_handler_critical_navigating(const INS& ins,
                                          const Mavlink_stream& mavlink_stream,
-                                         Mavlink_waypoint_handler& waypoint_handler);
+                                         Mavlink_waypoint_handler& waypoint_handler,
+                                         const Trajectory::conf_t& trajectory_config = Trajectory::default_config());
 
     /**
      * \brief   Checks if the waypoint is a navigating waypoint
@@ -154,7 +154,7 @@ Mission_planner::internal_state_t Mission_handler_hold_position::handler_mission
 
 bool Mission_handler_hold_position::write_flight_command(Flight_controller& flight_controller) const
 {
-	position_command_t cmd;
+	position_command_t cmd = {};
 
     // Set heading and position fram waypoint
     float heading = 0.0f;
@@ -192,7 +192,7 @@ Mission_planner::internal_state_t Mission_handler_landing::handler_mission_state
 
 bool Mission_handler_landing::write_desc_to_small_alt_flight_command(Flight_controller& flight_controller) const
 {
-	position_command_t cmd;
+	position_command_t cmd = {};
 
     // Set position at configured altitude above landing location
 	cmd.xyz    = waypoint_.local_pos();
@@ -208,7 +208,7 @@ bool Mission_handler_landing::write_desc_to_small_alt_flight_command(Flight_cont
 
 bool Mission_handler_landing::write_desc_to_ground_flight_command(Flight_controller& flight_controller) const
 {
-    position_command_t cmd;
+    position_command_t cmd = {};
 
     // Set position 1m bellow the drone
 	cmd.xyz    = waypoint_.local_pos();
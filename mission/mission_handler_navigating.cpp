@@ -45,6 +45,7 @@
 #include "navigation/navigation.hpp"
 #include "communication/mavlink_waypoint_handler.hpp"
 #include "hal/common/time_keeper.hpp"
+#include "runtime/cycle_clock.hpp"
 
 void Mission_handler_navigating::send_nav_time(const Mavlink_stream* mavlink_stream_, mavlink_message_t* msg)
 {
@@ -56,6 +57,47 @@ void Mission_handler_navigating::send_nav_time(const Mavlink_stream* mavlink_str
                                      travel_time_);
 }
 
+
+void Mission_handler_navigating::build_trajectory(const local_position_t& start, float start_speed)
+{
+    local_position_t points[Trajectory::MAX_LEGS];
+    bool stops[Trajectory::MAX_LEGS];
+
+    points[0] = waypoint_.local_pos();
+    stops[0]  = (waypoint_.autocontinue() == 0);
+    uint32_t count = 1;
+
+    // Continue through the following waypoints if waypoint_ is the current mission item
+    const Waypoint& current = waypoint_handler_.current_waypoint();
+    bool in_mission = (current.command() == waypoint_.command());
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        in_mission &= (maths_f_abs(current.local_pos()[k] - points[0][k]) < 0.01f);
+    }
+
+    if (in_mission)
+    {
+        uint16_t index = waypoint_handler_.current_waypoint_index();
+        while ((count < Trajectory::MAX_LEGS) &&
+               (!stops[count - 1]) &&
+               ((index + count) < waypoint_handler_.waypoint_count()))
+        {
+            const Waypoint& wpt = waypoint_handler_.waypoint_from_index(index + count);
+            if (!can_handle(wpt))
+            {
+                break;
+            }
+
+            points[count] = wpt.local_pos();
+            stops[count]  = (wpt.autocontinue() == 0);
+            ++count;
+        }
+    }
+
+    trajectory_.build(start, start_speed, points, stops, count);
+    origin_version_ = INS::origin_version();
+}
+
 //------------------------------------------------------------------------------
 // PUBLIC FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
@@ -63,14 +105,19 @@ void Mission_handler_navigating::send_nav_time(const Mavlink_stream* mavlink_str
 
 Mission_handler_navigating::Mission_handler_navigating( const INS& ins,
                                                         const Mavlink_stream& mavlink_stream,
-                                                        Mavlink_waypoint_handler& waypoint_handler):
+                                                        Mavlink_waypoint_handler& waypoint_handler,
+                                                        const Trajectory::conf_t& trajectory_config):
     Mission_handler(),
     ins_(ins),
     mavlink_stream_(mavlink_stream),
     waypoint_handler_(waypoint_handler),
     waypoint_reached_(false),
     start_time_(0),
-    travel_time_(0)
+    travel_time_(0),
+    trajectory_(trajectory_config),
+    trajectory_time_(0.0f),
+    last_update_s_(0.0),
+    origin_version_(0)
 {
     waypoint_ = Waypoint(   MAV_FRAME_LOCAL_NED,
                             MAV_CMD_NAV_WAYPOINT,
@@ -84,7 +131,13 @@ Mission_handler_navigating::Mission_handler_navigating( const INS& ins,
                             0.0f);
 
     position_command_ = position_command_t{{{0.0f, 0.0f, 0.0f}},
-                                            0.0f};
+                                            0.0f,
+                                            {{0.0f, 0.0f, 0.0f}},
+                                            {{0.0f, 0.0f, 0.0f}}};
+
+    trajectory_state_ = Trajectory::state_t{{{0.0f, 0.0f, 0.0f}},
+                                            {{0.0f, 0.0f, 0.0f}},
+                                            {{0.0f, 0.0f, 0.0f}}};
 }
 
 
@@ -105,16 +158,62 @@ bool Mission_handler_navigating::can_handle(const Waypoint& wpt) const
 bool Mission_handler_navigating::setup(const Waypoint& wpt)
 {
     bool success = true;
+    double now   = Cycle_clock::now_s();
+
+    // The new waypoint continues the current trajectory if the previous one
+    // was just reached and it is the end of the second leg
+    bool continued = waypoint_reached_ &&
+                     (trajectory_.leg_count() > 1) &&
+                     ((now - last_update_s_) < 0.5) &&
+                     (origin_version_ == INS::origin_version());
+    for (uint32_t k = 0; continued && (k < 3); ++k)
+    {
+        continued = (maths_f_abs(trajectory_.leg_end(1)[k] - wpt.local_pos()[k]) < 0.01f);
+    }
 
     start_time_       = time_keeper_get_ms();
     waypoint_reached_ = false;
     waypoint_         = wpt;
+    last_update_s_    = now;
+
+    if (continued)
+    {
+        // Start from the junction, at the planned speed
+        local_position_t junction = trajectory_.leg_end(0);
+        float junction_speed      = trajectory_.leg_end_speed(0);
+        trajectory_time_         -= trajectory_.leg_end_time(0);
+        build_trajectory(junction, junction_speed);
+    }
+    else
+    {
+        // Start from the current position, with the current speed towards the waypoint
+        local_position_t local_pos = ins_.position_lf();
+        local_position_t wpt_pos   = waypoint_.local_pos();
+        float rel_pos[3];
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            rel_pos[k] = wpt_pos[k] - local_pos[k];
+        }
+        float dist        = vectors_norm(rel_pos);
+        float start_speed = 0.0f;
+        if (dist > 0.01f)
+        {
+            start_speed = vectors_scalar_product(rel_pos, ins_.velocity_lf().data()) / dist;
+        }
+        trajectory_time_ = 0.0f;
+        build_trajectory(local_pos, start_speed);
+    }
 
     // Compute desired command
-    local_position_t local_pos = ins_.position_lf();
-    position_command_.xyz     = waypoint_.local_pos();
-    position_command_.heading = atan2(position_command_.xyz[Y] - local_pos[Y],
-                                      position_command_.xyz[X] - local_pos[X]);
+    trajectory_.evaluate(trajectory_time_, trajectory_state_);
+    position_command_.xyz = trajectory_state_.pos;
+    position_command_.vel = trajectory_state_.vel;
+    position_command_.acc = trajectory_state_.acc;
+    const float* dir      = trajectory_.leg_direction(0);
+    if ((dir[X] != 0.0f) || (dir[Y] != 0.0f))
+    {
+        position_command_.heading = atan2(dir[Y], dir[X]);
+    }
 
     return success;
 }
@@ -122,6 +221,41 @@ bool Mission_handler_navigating::setup(const Waypoint& wpt)
 
 Mission_handler::update_status_t Mission_handler_navigating::update()
 {
+    /*******************
+    Follow the trajectory
+    ********************/
+    // The origin moved, the trajectory is recomputed from the current position
+    if (origin_version_ != INS::origin_version())
+    {
+        bool waypoint_reached = waypoint_reached_;
+        setup(waypoint_);
+        waypoint_reached_ = waypoint_reached;
+    }
+
+    double now       = Cycle_clock::now_s();
+    trajectory_time_ += (float)(now - last_update_s_);
+    last_update_s_   = now;
+
+    // The command waits at the waypoint until the vehicle reaches it
+    bool waiting = (!waypoint_reached_) && (trajectory_time_ > trajectory_.leg_end_time(0));
+    if (waiting)
+    {
+        trajectory_time_ = trajectory_.leg_end_time(0);
+    }
+
+    trajectory_.evaluate(trajectory_time_, trajectory_state_);
+    if (waiting)
+    {
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            trajectory_state_.vel[k] = 0.0f;
+            trajectory_state_.acc[k] = 0.0f;
+        }
+    }
+    position_command_.xyz = trajectory_state_.pos;
+    position_command_.vel = trajectory_state_.vel;
+    position_command_.acc = trajectory_state_.acc;
+
     /**********************************
     Determine if arrived for first time
     **********************************/
@@ -144,8 +278,11 @@ Mission_handler::update_status_t Mission_handler_navigating::update()
         radius = 2.0f;
     }
 
-    // Check if we reached the waypoint
-    bool is_arrived = (dist2wp_sqr < (radius * radius)) && (vel_sqr < 1.0f); // TODO use a config for this speed threshold
+    // Check if we reached the waypoint, the speed does not matter if the trajectory goes through it
+    bool is_slow    = (vel_sqr < 1.0f) || (trajectory_.leg_end_speed(0) > 0.0f); // TODO use a config for this speed threshold
+    bool is_arrived = (trajectory_time_ >= trajectory_.leg_end_time(0)) &&
+                      (dist2wp_sqr < (radius * radius)) &&
+                      is_slow;
     if (is_arrived)
     {
         // If we are near the waypoint but the flag has not been set, do this once ...
@@ -46,6 +46,7 @@
 
 #include "communication/mavlink_message_handler.hpp"
 #include "mission/mission_handler.hpp"
+#include "navigation/trajectory.hpp"
 
 class Mavlink_waypoint_handler;
 
@@ -61,10 +62,12 @@ public:
      * \param   ins                                 The reference to the ins
      * \param   mavlink_stream                      The reference to the MAVLink stream structure
      * \param   waypoint_handler                    The handler for the manual control state
+     * \param   trajectory_config                   The configuration of the trajectory generator
      */
      Mission_handler_navigating(const INS& ins,
                                 const Mavlink_stream& mavlink_stream,
-                                Mavlink_waypoint_handler& waypoint_handler);
+                                Mavlink_waypoint_handler& waypoint_handler,
+                                const Trajectory::conf_t& trajectory_config = Trajectory::default_config());
 
 
     /**
@@ -83,7 +86,11 @@ public:
     /**
      * \brief   Sets up this handler class for a first time initialization
      *
-     * \details     Records the waypoint reference
+     * \details     Records the waypoint reference and computes the trajectory
+     *              through this waypoint and the following autocontinue
+     *              waypoints of the mission. If the waypoint is the next point
+     *              of the current trajectory, the trajectory continues from the
+     *              junction without stopping
      *
      * \param   wpt                 The waypoint class
      *
@@ -98,7 +105,9 @@ public:
      * \details     Handles the navigation to the waypoint and determines the
      *              status code. The status code is MISSION_IN_PROGRESS for currently navigating
      *              to the waypoint, MISSION_FINISHED for waypoint reached and autocontinue,
-     *              MISSION_FAILED for control command failed.
+     *              MISSION_FAILED for control command failed. The position
+     *              command follows the trajectory; it waits at the waypoint
+     *              until the vehicle reaches it.
      *
      * \return  Status code
      */
@@ -132,6 +141,12 @@ protected:
 
     position_command_t position_command_;                               ///< Desired position command
 
+    Trajectory trajectory_;                                             ///< Trajectory through the upcoming waypoints, the first leg ends at waypoint_
+    Trajectory::state_t trajectory_state_;                              ///< Position, velocity and acceleration from the trajectory
+    float trajectory_time_;                                             ///< Time along the trajectory (s)
+    double last_update_s_;                                              ///< Time of the last update (s)
+    uint32_t origin_version_;                                           ///< Version of the local origin used to compute the trajectory
+
     /**
      * \brief   Sends the travel time between the last two waypoints
      *
@@ -140,6 +155,14 @@ protected:
      * \param   msg                     The pointer to the MAVLink message
      */
     void send_nav_time(const Mavlink_stream* mavlink_stream, mavlink_message_t* msg);
+
+    /**
+     * \brief   Computes the trajectory from a point through waypoint_ and the following waypoints
+     *
+     * \param   start           Starting position
+     * \param   start_speed     Starting speed towards waypoint_
+     */
+    void build_trajectory(const local_position_t& start, float start_speed);
 };
 
 #endif // MISSION_HANDLER_NAVIGATING_HPP_
@@ -133,7 +133,7 @@ Mission_handler::update_status_t Mission_handler_takeoff::update()
 
 bool Mission_handler_takeoff::write_flight_command(Flight_controller& flight_controller) const
 {
-    position_command_t cmd;
+    position_command_t cmd = {};
     float heading = 0.0f;
     waypoint_.heading(heading);
 
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file mission_store.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Storage of the mission items
+ *
+ ******************************************************************************/
+
+
+#include "mission/mission_store.hpp"
+
+#include <cstring>
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS DECLARATION
+//------------------------------------------------------------------------------
+
+/**
+ * \brief   Writes a float in little endian
+ *
+ * \param   data    Output buffer
+ * \param   value   Value
+ */
+static void put_float(uint8_t* data, float value);
+
+
+/**
+ * \brief   Reads a float in little endian
+ *
+ * \param   data    Input buffer
+ *
+ * \return  Value
+ */
+static float get_float(const uint8_t* data);
+
+
+/**
+ * \brief   Writes a double in little endian
+ *
+ * \param   data    Output buffer
+ * \param   value   Value
+ */
+static void put_double(uint8_t* data, double value);
+
+
+/**
+ * \brief   Reads a double in little endian
+ *
+ * \param   data    Input buffer
+ *
+ * \return  Value
+ */
+static double get_double(const uint8_t* data);
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+static void put_float(uint8_t* data, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    data[0] = bits;
+    data[1] = bits >> 8;
+    data[2] = bits >> 16;
+    data[3] = bits >> 24;
+}
+
+
+static float get_float(const uint8_t* data)
+{
+    uint32_t bits = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+static void put_double(uint8_t* data, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        data[i] = bits >> (8 * i);
+    }
+}
+
+
+static double get_double(const uint8_t* data)
+{
+    uint64_t bits = 0;
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        bits |= (uint64_t)data[i] << (8 * i);
+    }
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+void Mission_store::pack(const Waypoint& waypoint, uint8_t record[])
+{
+    record[0] = waypoint.frame();
+    record[1] = waypoint.command();
+    record[2] = waypoint.command() >> 8;
+    record[3] = waypoint.autocontinue();
+    put_float(&record[4],  waypoint.param1());
+    put_float(&record[8],  waypoint.param2());
+    put_float(&record[12], waypoint.param3());
+    put_float(&record[16], waypoint.param4());
+    put_double(&record[20], waypoint.param5());
+    put_double(&record[28], waypoint.param6());
+    put_float(&record[36], waypoint.param7());
+}
+
+
+Waypoint Mission_store::unpack(const uint8_t record[])
+{
+    return Waypoint(record[0],
+                    (uint16_t)record[1] | ((uint16_t)record[2] << 8),
+                    record[3],
+                    get_float(&record[4]),
+                    get_float(&record[8]),
+                    get_float(&record[12]),
+                    get_float(&record[16]),
+                    get_double(&record[20]),
+                    get_double(&record[28]),
+                    get_float(&record[36]));
+}
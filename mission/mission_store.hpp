@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file mission_store.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Storage of the mission items
+ *
+ * \details A mission store holds the waypoints of the mission, either in RAM
+ *          (Mission_store_T) or in a file (Mission_store_file). Waypoints are
+ *          read and written by index, and the number of waypoints is set once
+ *          the upload of a mission is complete
+ *
+ ******************************************************************************/
+
+
+#ifndef MISSION_STORE_HPP_
+#define MISSION_STORE_HPP_
+
+#include <cstdint>
+
+#include "mission/waypoint.hpp"
+
+
+/**
+ * \brief   Interface for mission storage
+ */
+class Mission_store
+{
+public:
+    static const uint32_t RECORD_SIZE = 40;     ///< Size of a packed waypoint in bytes
+
+
+    /**
+     * \brief   Loads the stored mission
+     *
+     * \return  Success, false if the storage cannot be used. A corrupted mission
+     *          is discarded and the store is then empty
+     */
+    virtual bool init(void) = 0;
+
+
+    /**
+     * \brief   Get the maximum number of waypoints
+     *
+     * \return  Capacity
+     */
+    virtual uint16_t capacity(void) const = 0;
+
+
+    /**
+     * \brief   Get the number of waypoints of the mission
+     *
+     * \return  Number of waypoints
+     */
+    virtual uint16_t count(void) const = 0;
+
+
+    /**
+     * \brief   Reads a waypoint
+     *
+     * \param   index       Index of the waypoint
+     * \param   waypoint    Output waypoint
+     *
+     * \return  False if the index is not in the mission
+     */
+    virtual bool read(uint16_t index, Waypoint& waypoint) = 0;
+
+
+    /**
+     * \brief   Writes a waypoint
+     *
+     * \details The waypoint is part of the mission only after a call to set_count()
+     *
+     * \param   index       Index of the waypoint
+     * \param   waypoint    Waypoint
+     *
+     * \return  False if the index is out of capacity
+     */
+    virtual bool write(uint16_t index, const Waypoint& waypoint) = 0;
+
+
+    /**
+     * \brief   Sets the number of waypoints of the mission
+     *
+     * \details Persistent stores save the mission at this point
+     *
+     * \param   count       Number of waypoints
+     *
+     * \return  False if count is larger than capacity or the mission could not be saved
+     */
+    virtual bool set_count(uint16_t count) = 0;
+
+
+    /**
+     * \brief   Packs a waypoint in a record
+     *
+     * \details Little endian: uint8 frame, uint16 command, uint8 autocontinue,
+     *          float param1 to param4, double param5 and param6, float param7
+     *
+     * \param   waypoint    Waypoint
+     * \param   record      Output record of RECORD_SIZE bytes
+     */
+    static void pack(const Waypoint& waypoint, uint8_t record[]);
+
+
+    /**
+     * \brief   Unpacks a waypoint from a record
+     *
+     * \param   record      Record of RECORD_SIZE bytes
+     *
+     * \return  Waypoint
+     */
+    static Waypoint unpack(const uint8_t record[]);
+};
+
+
+/**
+ * \brief   Mission stored in RAM
+ *
+ * \tparam  N   Maximum number of waypoints
+ */
+template<uint16_t N>
+class Mission_store_T: public Mission_store
+{
+public:
+    /**
+     * \brief   Constructor
+     */
+    Mission_store_T(void):
+        count_(0)
+    {}
+
+
+    bool init(void)
+    {
+        count_ = 0;
+        return true;
+    }
+
+
+    uint16_t capacity(void) const
+    {
+        return N;
+    }
+
+
+    uint16_t count(void) const
+    {
+        return count_;
+    }
+
+
+    bool read(uint16_t index, Waypoint& waypoint)
+    {
+        if (index >= count_)
+        {
+            return false;
+        }
+        // Refresh the local position in the store, so that it is not recomputed in each copy
+        waypoints_[index].local_pos();
+        waypoint = waypoints_[index];
+        return true;
+    }
+
+
+    bool write(uint16_t index, const Waypoint& waypoint)
+    {
+        if (index >= N)
+        {
+            return false;
+        }
+        waypoints_[index] = waypoint;
+        return true;
+    }
+
+
+    bool set_count(uint16_t count)
+    {
+        if (count > N)
+        {
+            return false;
+        }
+        count_ = count;
+        return true;
+    }
+
+private:
+    Waypoint waypoints_[N];         ///< Waypoints
+    uint16_t count_;                ///< Number of waypoints of the mission
+};
+
+#endif /* MISSION_STORE_HPP_ */
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file mission_store_file.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Mission stored in a file
+ *
+ ******************************************************************************/
+
+
+#include "mission/mission_store_file.hpp"
+#include "util/print_util.hpp"
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS DECLARATION
+//------------------------------------------------------------------------------
+
+/**
+ * \brief   Writes an integer in little endian
+ *
+ * \param   data    Output buffer
+ * \param   value   Value
+ */
+static void put_u32(uint8_t* data, uint32_t value);
+
+
+/**
+ * \brief   Reads an integer in little endian
+ *
+ * \param   data    Input buffer
+ *
+ * \return  Value
+ */
+static uint32_t get_u32(const uint8_t* data);
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+static void put_u32(uint8_t* data, uint32_t value)
+{
+    data[0] = value;
+    data[1] = value >> 8;
+    data[2] = value >> 16;
+    data[3] = value >> 24;
+}
+
+
+static uint32_t get_u32(const uint8_t* data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+
+void Mission_store_file::page_in(uint16_t index)
+{
+    uint8_t record[RECORD_SIZE];
+
+    page_start_ = index;
+    page_count_ = 0;
+
+    file_.seek(HEADER_SIZE + (uint32_t)index * RECORD_SIZE, FILE_SEEK_START);
+    while ((page_count_ < PAGE_SIZE) && ((index + page_count_) < count_))
+    {
+        file_.read(record, RECORD_SIZE);
+        page_[page_count_] = unpack(record);
+        page_count_++;
+    }
+}
+
+
+uint32_t Mission_store_file::checksum(uint16_t count)
+{
+    uint8_t  record[RECORD_SIZE];
+    uint32_t sum1 = 0xFFFF;
+    uint32_t sum2 = 0xFFFF;
+
+    file_.seek(HEADER_SIZE, FILE_SEEK_START);
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        file_.read(record, RECORD_SIZE);
+
+        // 20 words per record, few enough to reduce the sums once per record
+        for (uint32_t j = 0; j < RECORD_SIZE; j += 2)
+        {
+            sum1 += (uint32_t)record[j] | ((uint32_t)record[j + 1] << 8);
+            sum2 += sum1;
+        }
+        sum1 = (sum1 & 0xFFFF) + (sum1 >> 16);
+        sum2 = (sum2 & 0xFFFF) + (sum2 >> 16);
+    }
+    sum1 = (sum1 & 0xFFFF) + (sum1 >> 16);
+    sum2 = (sum2 & 0xFFFF) + (sum2 >> 16);
+
+    return (sum2 << 16) | sum1;
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Mission_store_file::Mission_store_file(File& file, conf_t config):
+    file_(file),
+    config_(config),
+    count_(0),
+    page_start_(0),
+    page_count_(0)
+{}
+
+
+bool Mission_store_file::init(void)
+{
+    uint8_t header[HEADER_SIZE];
+
+    count_      = 0;
+    page_count_ = 0;
+
+    // Empty file: no mission stored yet
+    uint32_t length = file_.length();
+    if (length == 0)
+    {
+        return true;
+    }
+
+    file_.seek(0, FILE_SEEK_START);
+    file_.read(header, HEADER_SIZE);
+
+    uint16_t version = (uint16_t)header[4] | ((uint16_t)header[5] << 8);
+    uint16_t count   = (uint16_t)header[6] | ((uint16_t)header[7] << 8);
+
+    if ((get_u32(&header[0]) != MAGIC)
+        || (version != VERSION)
+        || (count > config_.capacity)
+        || (length < (HEADER_SIZE + (uint32_t)count * RECORD_SIZE))
+        || (checksum(count) != get_u32(&header[8])))
+    {
+        // Start with an empty mission, the file is overwritten by the next upload
+        print_util_dbg_print("[MISSION_STORE] No valid mission in file, starting empty\r\n");
+        return true;
+    }
+
+    count_ = count;
+
+    print_util_dbg_print("[MISSION_STORE] Loaded ");
+    print_util_dbg_print_num(count_, 10);
+    print_util_dbg_print(" waypoints\r\n");
+
+    return true;
+}
+
+
+uint16_t Mission_store_file::capacity(void) const
+{
+    return config_.capacity;
+}
+
+
+uint16_t Mission_store_file::count(void) const
+{
+    return count_;
+}
+
+
+bool Mission_store_file::read(uint16_t index, Waypoint& waypoint)
+{
+    if (index >= count_)
+    {
+        return false;
+    }
+
+    if ((index < page_start_) || (index >= (page_start_ + page_count_)))
+    {
+        page_in(index);
+    }
+
+    // Refresh the local position in the page, so that it is not recomputed in each copy
+    page_[index - page_start_].local_pos();
+    waypoint = page_[index - page_start_];
+
+    return true;
+}
+
+
+bool Mission_store_file::write(uint16_t index, const Waypoint& waypoint)
+{
+    uint8_t record[RECORD_SIZE];
+
+    if (index >= config_.capacity)
+    {
+        return false;
+    }
+
+    pack(waypoint, record);
+
+    bool success = true;
+    success &= file_.seek(HEADER_SIZE + (uint32_t)index * RECORD_SIZE, FILE_SEEK_START);
+    success &= file_.write(record, RECORD_SIZE);
+
+    // Keep the page consistent with the file
+    if ((index >= page_start_) && (index < (page_start_ + page_count_)))
+    {
+        page_[index - page_start_] = waypoint;
+    }
+
+    return success;
+}
+
+
+bool Mission_store_file::set_count(uint16_t count)
+{
+    uint8_t header[HEADER_SIZE] = {};
+
+    if (count > config_.capacity)
+    {
+        return false;
+    }
+
+    count_      = count;
+    page_count_ = 0;
+
+    put_u32(&header[0], MAGIC);
+    header[4] = VERSION;
+    header[5] = VERSION >> 8;
+    header[6] = count;
+    header[7] = count >> 8;
+    put_u32(&header[8], checksum(count));
+
+    bool success = true;
+    success &= file_.seek(0, FILE_SEEK_START);
+    success &= file_.write(header, HEADER_SIZE);
+    success &= file_.flush();
+
+    return success;
+}
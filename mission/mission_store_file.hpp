@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file mission_store_file.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Mission stored in a file
+ *
+ * \details The file starts with a 16 bytes header (little endian):
+ *              uint32 magic ("MSNF"), uint16 version, uint16 count,
+ *              uint32 checksum of the records, uint32 reserved
+ *          followed by one packed record per waypoint (see Mission_store::pack).
+ *          The header is written when the number of waypoints is set, so an
+ *          interrupted upload leaves an empty mission. A file with an invalid
+ *          header or checksum is reported at init and the store starts empty.
+ *          Reads go through a page of waypoints starting at the requested
+ *          index, so that the waypoints ahead of the current one are loaded
+ *          together
+ *
+ ******************************************************************************/
+
+
+#ifndef MISSION_STORE_FILE_HPP_
+#define MISSION_STORE_FILE_HPP_
+
+#include <cstdint>
+
+#include "hal/common/file.hpp"
+#include "mission/mission_store.hpp"
+
+
+/**
+ * \brief   Mission stored in a file (flash, SD card, or file on linux)
+ */
+class Mission_store_file: public Mission_store
+{
+public:
+    static const uint32_t MAGIC       = 0x464E534D;   ///< "MSNF" in little endian
+    static const uint16_t VERSION     = 2;            ///< Version of the file format
+    static const uint32_t HEADER_SIZE = 16;           ///< Size of the header in bytes
+    static const uint16_t PAGE_SIZE   = 16;           ///< Number of waypoints kept in RAM
+
+
+    /**
+     * \brief   Configuration
+     */
+    struct conf_t
+    {
+        uint16_t capacity;                      ///< Maximum number of waypoints
+    };
+
+
+    /**
+     * \brief   Default configuration
+     *
+     * \return  Config structure
+     */
+    static inline conf_t default_config();
+
+
+    /**
+     * \brief   Constructor
+     *
+     * \param   file        File, already open
+     * \param   config      Configuration
+     */
+    Mission_store_file(File& file, conf_t config = default_config());
+
+
+    bool init(void);
+
+
+    uint16_t capacity(void) const;
+
+
+    uint16_t count(void) const;
+
+
+    bool read(uint16_t index, Waypoint& waypoint);
+
+
+    bool write(uint16_t index, const Waypoint& waypoint);
+
+
+    bool set_count(uint16_t count);
+
+private:
+    /**
+     * \brief   Loads the page of waypoints starting at index
+     *
+     * \param   index       Index of the first waypoint of the page
+     */
+    void page_in(uint16_t index);
+
+
+    /**
+     * \brief   Computes the checksum of the records (Fletcher-32)
+     *
+     * \param   count       Number of records
+     *
+     * \return  Checksum
+     */
+    uint32_t checksum(uint16_t count);
+
+    File&       file_;                  ///< File
+    conf_t      config_;                ///< Configuration
+    uint16_t    count_;                 ///< Number of waypoints of the mission
+    Waypoint    page_[PAGE_SIZE];       ///< Waypoints loaded in RAM
+    uint16_t    page_start_;            ///< Index of the first waypoint of the page
+    uint16_t    page_count_;            ///< Number of waypoints in the page
+};
+
+
+Mission_store_file::conf_t Mission_store_file::default_config()
+{
+    conf_t conf = {};
+
+    conf.capacity = 1000;
+
+    return conf;
+}
+
+#endif /* MISSION_STORE_FILE_HPP_ */
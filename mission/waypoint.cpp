@@ -59,6 +59,12 @@ extern "C"
 // PRIVATE FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
 
+void Waypoint::update_local_pos() const
+{
+    local_pos_         = compute_local_pos();
+    local_pos_version_ = INS::origin_version();
+}
+
 
 
 //------------------------------------------------------------------------------
@@ -73,10 +79,11 @@ Waypoint::Waypoint() :
             param2_(0.0f),
             param3_(0.0f),
             param4_(0.0f),
-            param5_(0.0f),
-            param6_(0.0f),
+            param5_(0.0),
+            param6_(0.0),
             param7_(0.0f)
 {
+    update_local_pos();
 }
 
 Waypoint::Waypoint(mavlink_mission_item_t& packet)
@@ -91,6 +98,52 @@ Waypoint::Waypoint(mavlink_mission_item_t& packet)
     param5_ = packet.x; // longitude
     param6_ = packet.y; // latitude
     param7_ = packet.z; // altitude
+
+    update_local_pos();
+}
+
+Waypoint::Waypoint(mavlink_mission_item_int_t& packet)
+{
+    command_ = packet.command;
+    autocontinue_ = packet.autocontinue;
+    frame_ = packet.frame;
+    param1_ = packet.param1;
+    param2_ = packet.param2;
+    param3_ = packet.param3;
+    param4_ = packet.param4;
+    param7_ = packet.z; // altitude
+
+    switch (packet.frame)
+    {
+        case MAV_FRAME_GLOBAL:
+        case MAV_FRAME_GLOBAL_INT:
+            frame_ = MAV_FRAME_GLOBAL_INT;
+            param5_ = packet.x;
+            param6_ = packet.y;
+            break;
+
+        case MAV_FRAME_GLOBAL_RELATIVE_ALT:
+        case MAV_FRAME_GLOBAL_RELATIVE_ALT_INT:
+            frame_ = MAV_FRAME_GLOBAL_RELATIVE_ALT_INT;
+            param5_ = packet.x;
+            param6_ = packet.y;
+            break;
+
+        case MAV_FRAME_GLOBAL_TERRAIN_ALT:
+        case MAV_FRAME_GLOBAL_TERRAIN_ALT_INT:
+            frame_ = MAV_FRAME_GLOBAL_TERRAIN_ALT_INT;
+            param5_ = packet.x;
+            param6_ = packet.y;
+            break;
+
+        default:
+            // Local frames: meters * 1e4
+            param5_ = packet.x / 10000.0;
+            param6_ = packet.y / 10000.0;
+            break;
+    }
+
+    update_local_pos();
 }
 
 Waypoint::Waypoint( uint8_t frame,
@@ -100,8 +153,8 @@ Waypoint::Waypoint( uint8_t frame,
                     float param2,
                     float param3,
                     float param4,
-                    float param5,
-                    float param6,
+                    double param5,
+                    double param6,
                     float param7) :
             frame_(frame),
             command_(command),
@@ -114,6 +167,7 @@ Waypoint::Waypoint( uint8_t frame,
             param6_(param6),
             param7_(param7)
 {
+    update_local_pos();
 }
 
 void Waypoint::send(const Mavlink_stream& mavlink_stream, uint32_t sysid, const mavlink_message_t* msg, uint16_t seq, uint8_t current)
@@ -178,12 +232,12 @@ float Waypoint::param4() const
     return param4_;
 }
 
-float Waypoint::param5() const
+double Waypoint::param5() const
 {
     return param5_;
 }
 
-float Waypoint::param6() const
+double Waypoint::param6() const
 {
     return param6_;
 }
@@ -240,26 +294,36 @@ bool Waypoint::radius(float& radius) const
     }
 }
 
-local_position_t Waypoint::local_pos() const
+const local_position_t& Waypoint::local_pos() const
+{
+    if (local_pos_version_ != INS::origin_version())
+    {
+        update_local_pos();
+    }
+
+    return local_pos_;
+}
+
+local_position_t Waypoint::compute_local_pos() const
 {
     global_position_t waypoint_global;
-    local_position_t waypoint_local;
+    local_position_t waypoint_local = {{0.0f, 0.0f, 0.0f}};
 
     switch (frame_)
     {
         case MAV_FRAME_GLOBAL_INT:
             // Convert from int to degrees
-            waypoint_global.latitude    = param5_ / 10000000.0f;
-            waypoint_global.longitude   = param6_ / 10000000.0f;
+            waypoint_global.latitude    = param5_ / 10000000.0;
+            waypoint_global.longitude   = param6_ / 10000000.0;
             waypoint_global.altitude    = param7_;
-            coord_conventions_global_to_local_position(waypoint_global, INS::origin(), waypoint_local);
+            INS::projection().global_to_local(waypoint_global, waypoint_local);
             break;
 
         case MAV_FRAME_GLOBAL:
             waypoint_global.latitude    = param5_;
             waypoint_global.longitude   = param6_;
             waypoint_global.altitude    = param7_;
-            coord_conventions_global_to_local_position(waypoint_global, INS::origin(), waypoint_local);
+            INS::projection().global_to_local(waypoint_global, waypoint_local);
             break;
 
         case MAV_FRAME_LOCAL_ENU:
@@ -292,10 +356,10 @@ local_position_t Waypoint::local_pos() const
         case MAV_FRAME_GLOBAL_TERRAIN_ALT_INT:
         case MAV_FRAME_GLOBAL_RELATIVE_ALT_INT:
             // Convert from int to degrees
-            waypoint_global.latitude    = param5_ / 10000000.0f;
-            waypoint_global.longitude   = param6_ / 10000000.0f;
+            waypoint_global.latitude    = param5_ / 10000000.0;
+            waypoint_global.longitude   = param6_ / 10000000.0;
             waypoint_global.altitude    = param7_ + INS::origin().altitude;
-            coord_conventions_global_to_local_position(waypoint_global, INS::origin(), waypoint_local);
+            INS::projection().global_to_local(waypoint_global, waypoint_local);
             break;
 
         case MAV_FRAME_GLOBAL_TERRAIN_ALT:
@@ -303,9 +367,17 @@ local_position_t Waypoint::local_pos() const
             waypoint_global.latitude    = param5_;
             waypoint_global.longitude   = param6_;
             waypoint_global.altitude    = param7_ + INS::origin().altitude;
-            coord_conventions_global_to_local_position(waypoint_global, INS::origin(), waypoint_local);
+            INS::projection().global_to_local(waypoint_global, waypoint_local);
             break;
     }
 
     return waypoint_local;
 }
+
+void Waypoint::local_positions(const Waypoint waypoints[], uint16_t count, local_position_t output[])
+{
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        output[i] = waypoints[i].local_pos();
+    }
+}
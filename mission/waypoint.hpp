@@ -68,6 +68,17 @@ public:
      */
     Waypoint(mavlink_mission_item_t& packet);
 
+    /**
+     * \brief   Initialize the waypoint from an integer mission item
+     *
+     * \details Global positions are kept in degrees * 1e7 and the frame is
+     *          changed to the corresponding _INT frame, local positions are
+     *          converted to meters
+     *
+     * \param   packet                  The received packet for creating a waypoint
+     */
+    Waypoint(mavlink_mission_item_int_t& packet);
+
     /**
      * \brief   Initialize the waypoint handler
      *
@@ -78,8 +89,8 @@ public:
      * \param   param2              Parameter depending on the MAV_CMD_NAV id
      * \param   param3              Parameter depending on the MAV_CMD_NAV id
      * \param   param4              Parameter depending on the MAV_CMD_NAV id
-     * \param   param5              Parameter depending on the MAV_CMD_NAV id (usually x/latitude)
-     * \param   param6              Parameter depending on the MAV_CMD_NAV id (usually y/longitude)
+     * \param   param5              Parameter depending on the MAV_CMD_NAV id (usually x/latitude, in degrees * 1e7 for INT frames)
+     * \param   param6              Parameter depending on the MAV_CMD_NAV id (usually y/longitude, in degrees * 1e7 for INT frames)
      * \param   param7              Parameter depending on the MAV_CMD_NAV id (usually z/altitude)
      */
     Waypoint(   uint8_t frame,
@@ -89,8 +100,8 @@ public:
                 float param2,
                 float param3,
                 float param4,
-                float param5,
-                float param6,
+                double param5,
+                double param6,
                 float param7);
 
     /**
@@ -158,14 +169,14 @@ public:
      *
      * \return  param5
      */
-    float param5() const;
+    double param5() const;
 
     /**
      * \brief   Gets param6 of the waypoint
      *
      * \return  param6
      */
-    float param6() const;
+    double param6() const;
 
     /**
      * \brief   Gets param7 of the waypoint
@@ -199,9 +210,26 @@ public:
     /**
      * \brief   Gets the waypoint in local coordinates
      *
+     * \details The local position is computed when the waypoint is created,
+     *          and computed again only if the origin of the local frame has
+     *          changed since (see INS::origin_version())
+     *
      * \return  Local waypoint position
      */
-    local_position_t local_pos() const;
+    const local_position_t& local_pos() const;
+
+
+    /**
+     * \brief   Gets the local coordinates of a list of waypoints
+     *
+     * \details All waypoints are converted with the projection of the current
+     *          origin (see INS::projection())
+     *
+     * \param   waypoints   Array of waypoints
+     * \param   count       Number of waypoints
+     * \param   output      Array of local positions (size count)
+     */
+    static void local_positions(const Waypoint waypoints[], uint16_t count, local_position_t output[]);
 
 protected:
     uint8_t frame_;                                         ///< The reference frame of the waypoint
@@ -211,9 +239,25 @@ protected:
     float param2_;                                          ///< Parameter depending on the MAV_CMD_NAV id
     float param3_;                                          ///< Parameter depending on the MAV_CMD_NAV id
     float param4_;                                          ///< Parameter depending on the MAV_CMD_NAV id
-    float param5_;                                          ///< Parameter depending on the MAV_CMD_NAV id
-    float param6_;                                          ///< Parameter depending on the MAV_CMD_NAV id
+    double param5_;                                         ///< Parameter depending on the MAV_CMD_NAV id, double to keep 1e-7 degree latitude
+    double param6_;                                         ///< Parameter depending on the MAV_CMD_NAV id, double to keep 1e-7 degree longitude
     float param7_;                                          ///< Parameter depending on the MAV_CMD_NAV id
+
+    mutable local_position_t local_pos_;                    ///< Cached position of the waypoint in the local frame
+    mutable uint32_t local_pos_version_;                    ///< Version of the origin used to compute local_pos_
+
+private:
+    /**
+     * \brief   Converts the waypoint to local coordinates
+     *
+     * \return  Local waypoint position
+     */
+    local_position_t compute_local_pos() const;
+
+    /**
+     * \brief   Updates the cached local position
+     */
+    void update_local_pos() const;
 };
 
 
@@ -64,7 +64,7 @@ Navigation_directto::Navigation_directto(args_t args, const conf_t& config) :
 
 bool Navigation_directto::update()
 {
-    position_command_t pos_command;
+    position_command_t pos_command = {};
     pos_command.xyz = navigation_command_.xyz;
 
     // calculate distance to goal squared
@@ -0,0 +1,412 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file trajectory.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Time-parameterized jerk-limited trajectory through waypoints
+ *
+ ******************************************************************************/
+
+
+#include "navigation/trajectory.hpp"
+
+extern "C"
+{
+#include "util/maths.h"
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+void Trajectory::transition(float v_start, float v_end, transition_t& tr) const
+{
+    float dv = v_end - v_start;
+
+    tr.v_start = v_start;
+    tr.sign    = (dv < 0.0f) ? -1.0f : 1.0f;
+    dv         = maths_f_abs(dv);
+
+    if (dv < 1e-6f)
+    {
+        tr.t_jerk = 0.0f;
+        tr.t_acc  = 0.0f;
+    }
+    else if (dv >= (config_.max_acc * config_.max_acc / config_.max_jerk))
+    {
+        // The acceleration saturates
+        tr.t_jerk = config_.max_acc / config_.max_jerk;
+        tr.t_acc  = dv / config_.max_acc - tr.t_jerk;
+    }
+    else
+    {
+        // The acceleration ramps up and down without reaching its limit
+        tr.t_jerk = maths_fast_sqrt(dv / config_.max_jerk);
+        tr.t_acc  = 0.0f;
+    }
+
+    // The speed profile is symmetric, so the distance is travelled at the mean speed
+    tr.duration = 2.0f * tr.t_jerk + tr.t_acc;
+    tr.length   = 0.5f * (v_start + v_end) * tr.duration;
+}
+
+
+float Trajectory::transition_length(float v_start, float v_end) const
+{
+    transition_t tr;
+    transition(v_start, v_end, tr);
+    return tr.length;
+}
+
+
+float Trajectory::reachable_speed(float v_start, float length, float max_speed) const
+{
+    if (v_start >= max_speed)
+    {
+        return max_speed;
+    }
+
+    if (transition_length(v_start, max_speed) <= length)
+    {
+        return max_speed;
+    }
+
+    // The distance increases with the final speed
+    float low  = v_start;
+    float high = max_speed;
+    for (uint32_t i = 0; i < 24; ++i)
+    {
+        float mid = 0.5f * (low + high);
+        if (transition_length(v_start, mid) <= length)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+
+void Trajectory::evaluate_transition(const transition_t& tr, float t, float& s, float& v, float& a) const
+{
+    const float j  = tr.sign * config_.max_jerk;
+    const float tj = tr.t_jerk;
+    t = maths_f_min(maths_f_max(t, 0.0f), tr.duration);
+
+    // Increasing acceleration
+    if (t < tj)
+    {
+        a = j * t;
+        v = tr.v_start + 0.5f * j * t * t;
+        s = tr.v_start * t + j * t * t * t / 6.0f;
+        return;
+    }
+
+    const float a_peak = j * tj;
+    const float v1     = tr.v_start + 0.5f * j * tj * tj;
+    const float s1     = tr.v_start * tj + j * tj * tj * tj / 6.0f;
+
+    // Constant acceleration
+    if (t < (tj + tr.t_acc))
+    {
+        float u = t - tj;
+        a = a_peak;
+        v = v1 + a_peak * u;
+        s = s1 + v1 * u + 0.5f * a_peak * u * u;
+        return;
+    }
+
+    // Decreasing acceleration
+    const float v2 = v1 + a_peak * tr.t_acc;
+    const float s2 = s1 + v1 * tr.t_acc + 0.5f * a_peak * tr.t_acc * tr.t_acc;
+    float u = t - tj - tr.t_acc;
+    a = a_peak - j * u;
+    v = v2 + a_peak * u - 0.5f * j * u * u;
+    s = s2 + v2 * u + 0.5f * a_peak * u * u - j * u * u * u / 6.0f;
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Trajectory::Trajectory(const conf_t& config):
+    config_(config),
+    leg_count_(0),
+    cursor_(0)
+{}
+
+
+bool Trajectory::build(const local_position_t& start,
+                       float start_speed,
+                       const local_position_t points[],
+                       const bool stops[],
+                       uint32_t count)
+{
+    leg_count_ = (count < MAX_LEGS) ? count : MAX_LEGS;
+    cursor_    = 0;
+
+    if (leg_count_ == 0)
+    {
+        return false;
+    }
+
+    // Geometry of the legs
+    for (uint32_t i = 0; i < leg_count_; ++i)
+    {
+        leg_t& leg = legs_[i];
+        leg.start  = (i == 0) ? start : points[i - 1];
+        leg.end    = points[i];
+
+        float length_sqr = 0.0f;
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            leg.dir[k]  = leg.end[k] - leg.start[k];
+            length_sqr += leg.dir[k] * leg.dir[k];
+        }
+        leg.length = maths_fast_sqrt(length_sqr);
+
+        if (leg.length < 1e-3f)
+        {
+            leg.length    = 0.0f;
+            leg.max_speed = 0.0f;
+            leg.dir[0]    = 0.0f;
+            leg.dir[1]    = 0.0f;
+            leg.dir[2]    = 0.0f;
+            continue;
+        }
+
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            leg.dir[k] /= leg.length;
+        }
+
+        leg.max_speed = config_.max_speed;
+        float climb   = maths_f_abs(leg.dir[2]) * leg.max_speed;
+        if (climb > config_.max_climb_rate)
+        {
+            leg.max_speed = config_.max_climb_rate / maths_f_abs(leg.dir[2]);
+        }
+    }
+
+    // Speed limits at the junctions, v_end of the previous leg is the entry speed of the next
+    float v_entry = maths_f_min(maths_f_max(start_speed, 0.0f), legs_[0].max_speed);
+    for (uint32_t i = 0; i < leg_count_; ++i)
+    {
+        leg_t& leg = legs_[i];
+
+        if ((i == leg_count_ - 1) || stops[i] || (leg.length == 0.0f) || (legs_[i + 1].length == 0.0f))
+        {
+            leg.v_end = 0.0f;
+            continue;
+        }
+
+        const leg_t& next = legs_[i + 1];
+        leg.v_end = maths_f_min(leg.max_speed, next.max_speed);
+
+        // Speed at which a virtual arc tangent to both legs and passing at
+        // junction_deviation from the corner is flown at max_acc
+        float cos_angle = leg.dir[0] * next.dir[0] + leg.dir[1] * next.dir[1] + leg.dir[2] * next.dir[2];
+        if (cos_angle < 0.9999f)
+        {
+            float sin_half  = maths_fast_sqrt(0.5f * (1.0f + cos_angle));
+            float v_sqr     = config_.max_acc * config_.junction_deviation * sin_half / (1.0f - sin_half);
+            leg.v_end       = maths_f_min(leg.v_end, maths_fast_sqrt(v_sqr));
+        }
+    }
+
+    // Backward pass: each leg must be long enough to slow down to its exit speed
+    for (int32_t i = leg_count_ - 1; i > 0; --i)
+    {
+        legs_[i - 1].v_end = reachable_speed(legs_[i].v_end, legs_[i].length, legs_[i - 1].v_end);
+    }
+    v_entry = reachable_speed(legs_[0].v_end, legs_[0].length, v_entry);
+
+    // Forward pass: each leg must be long enough to speed up to its exit speed
+    float t = 0.0f;
+    for (uint32_t i = 0; i < leg_count_; ++i)
+    {
+        leg_t& leg = legs_[i];
+        leg.v_end  = reachable_speed(v_entry, leg.length, leg.v_end);
+
+        // Highest cruise speed for which both transitions fit in the leg
+        float low  = maths_f_max(v_entry, leg.v_end);
+        float high = leg.max_speed;
+        if (high <= low)
+        {
+            leg.v_peak = low;
+        }
+        else if ((transition_length(v_entry, high) + transition_length(high, leg.v_end)) <= leg.length)
+        {
+            leg.v_peak = high;
+        }
+        else
+        {
+            for (uint32_t k = 0; k < 24; ++k)
+            {
+                float mid = 0.5f * (low + high);
+                if ((transition_length(v_entry, mid) + transition_length(mid, leg.v_end)) <= leg.length)
+                {
+                    low = mid;
+                }
+                else
+                {
+                    high = mid;
+                }
+            }
+            leg.v_peak = low;
+        }
+
+        transition(v_entry, leg.v_peak, leg.acc);
+        transition(leg.v_peak, leg.v_end, leg.dec);
+
+        float cruise_length = leg.length - leg.acc.length - leg.dec.length;
+        float cruise_time   = 0.0f;
+        if ((cruise_length > 0.0f) && (leg.v_peak > 1e-3f))
+        {
+            cruise_time = cruise_length / leg.v_peak;
+        }
+
+        leg.t_start  = t;
+        leg.t_cruise = t + leg.acc.duration;
+        leg.t_dec    = leg.t_cruise + cruise_time;
+        leg.t_end    = leg.t_dec + leg.dec.duration;
+
+        t       = leg.t_end;
+        v_entry = leg.v_end;
+    }
+
+    return true;
+}
+
+
+void Trajectory::clear(void)
+{
+    leg_count_ = 0;
+    cursor_    = 0;
+}
+
+
+bool Trajectory::evaluate(float t, state_t& state)
+{
+    if (leg_count_ == 0)
+    {
+        return false;
+    }
+
+    // Time only moves forward by small steps, so the cursor rarely moves by more than one leg
+    while ((cursor_ + 1 < leg_count_) && (t >= legs_[cursor_].t_end))
+    {
+        ++cursor_;
+    }
+    while ((cursor_ > 0) && (t < legs_[cursor_].t_start))
+    {
+        --cursor_;
+    }
+
+    const leg_t& leg = legs_[cursor_];
+    float s = 0.0f;
+    float v = 0.0f;
+    float a = 0.0f;
+
+    if (t < leg.t_start)
+    {
+        // Before the start
+        s = 0.0f;
+    }
+    else if (t < leg.t_cruise)
+    {
+        evaluate_transition(leg.acc, t - leg.t_start, s, v, a);
+    }
+    else if (t < leg.t_dec)
+    {
+        s = leg.acc.length + leg.v_peak * (t - leg.t_cruise);
+        v = leg.v_peak;
+    }
+    else if (t < leg.t_end)
+    {
+        evaluate_transition(leg.dec, t - leg.t_dec, s, v, a);
+        s += leg.acc.length + leg.v_peak * (leg.t_dec - leg.t_cruise);
+    }
+    else
+    {
+        s = leg.length;
+        v = leg.v_end;
+    }
+
+    s = maths_f_min(s, leg.length);
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        state.pos[k] = leg.start[k] + s * leg.dir[k];
+        state.vel[k] = v * leg.dir[k];
+        state.acc[k] = a * leg.dir[k];
+    }
+
+    return true;
+}
+
+
+uint32_t Trajectory::leg_count(void) const
+{
+    return leg_count_;
+}
+
+
+float Trajectory::leg_end_time(uint32_t leg) const
+{
+    return legs_[leg].t_end;
+}
+
+
+float Trajectory::leg_end_speed(uint32_t leg) const
+{
+    return legs_[leg].v_end;
+}
+
+
+const local_position_t& Trajectory::leg_end(uint32_t leg) const
+{
+    return legs_[leg].end;
+}
+
+
+const float* Trajectory::leg_direction(uint32_t leg) const
+{
+    return legs_[leg].dir;
+}
@@ -0,0 +1,300 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file trajectory.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Time-parameterized jerk-limited trajectory through waypoints
+ *
+ * \details The trajectory is a chain of straight legs. Along each leg the
+ *          speed follows an S-curve: a jerk-limited transition from the
+ *          entry speed to a peak speed, a cruise, and a transition to the
+ *          exit speed. The speed at each junction is limited by the angle
+ *          between the legs (junction deviation) and by the distance
+ *          available to reach the next junctions, so the vehicle stops only
+ *          where it has to. All segments are computed by build(); evaluate()
+ *          is closed-form and only moves a cursor by one leg at a time.
+ *
+ ******************************************************************************/
+
+
+#ifndef TRAJECTORY_HPP_
+#define TRAJECTORY_HPP_
+
+#include <cstdint>
+
+#include "util/coord_conventions.hpp"
+
+
+/**
+ * \brief   Jerk-limited trajectory through a list of points
+ */
+class Trajectory
+{
+public:
+    static const uint32_t MAX_LEGS = 8;     ///< Maximum number of legs of a trajectory
+
+
+    /**
+     * \brief   Configuration
+     */
+    struct conf_t
+    {
+        float max_speed;            ///< Maximum speed along the path (m/s)
+        float max_climb_rate;       ///< Maximum vertical speed (m/s)
+        float max_acc;              ///< Maximum acceleration along the path (m/s^2)
+        float max_jerk;             ///< Maximum jerk along the path (m/s^3)
+        float junction_deviation;   ///< Distance from the corner of the virtual arc limiting the speed at junctions (m)
+    };
+
+
+    /**
+     * \brief   Position, velocity and acceleration at a given time
+     */
+    struct state_t
+    {
+        local_position_t pos;       ///< Position in the local frame (m)
+        local_velocity_t vel;       ///< Velocity in the local frame (m/s)
+        std::array<float,3> acc;    ///< Acceleration in the local frame (m/s^2)
+    };
+
+
+    /**
+     * \brief   Default configuration
+     *
+     * \return  Config structure
+     */
+    static inline conf_t default_config(void);
+
+
+    /**
+     * \brief   Constructor
+     *
+     * \param   config      Configuration
+     */
+    Trajectory(const conf_t& config = default_config());
+
+
+    /**
+     * \brief   Computes the trajectory
+     *
+     * \details The trajectory starts at rest in acceleration, at the speed
+     *          start_speed along the first leg, and ends at rest at the last
+     *          point. Points are dropped beyond MAX_LEGS.
+     *
+     * \param   start           Starting position
+     * \param   start_speed     Starting speed along the first leg (m/s)
+     * \param   points          Points to go through
+     * \param   stops           For each point, true if the vehicle has to stop at it
+     * \param   count           Number of points
+     *
+     * \return  False if there is no point
+     */
+    bool build(const local_position_t& start,
+               float start_speed,
+               const local_position_t points[],
+               const bool stops[],
+               uint32_t count);
+
+
+    /**
+     * \brief   Removes the trajectory
+     */
+    void clear(void);
+
+
+    /**
+     * \brief   Evaluates the trajectory
+     *
+     * \details Before the start the state is the start point, after the end
+     *          it is the last point, at rest
+     *
+     * \param   t           Time since the start of the trajectory (s)
+     * \param   state       Output state
+     *
+     * \return  False if the trajectory is empty
+     */
+    bool evaluate(float t, state_t& state);
+
+
+    /**
+     * \brief   Number of legs
+     *
+     * \return  count
+     */
+    uint32_t leg_count(void) const;
+
+
+    /**
+     * \brief   Time at which a leg ends
+     *
+     * \param   leg         Index of the leg
+     *
+     * \return  time since the start of the trajectory (s)
+     */
+    float leg_end_time(uint32_t leg) const;
+
+
+    /**
+     * \brief   Speed at the end of a leg
+     *
+     * \param   leg         Index of the leg
+     *
+     * \return  speed (m/s)
+     */
+    float leg_end_speed(uint32_t leg) const;
+
+
+    /**
+     * \brief   Position at the end of a leg
+     *
+     * \param   leg         Index of the leg
+     *
+     * \return  position
+     */
+    const local_position_t& leg_end(uint32_t leg) const;
+
+
+    /**
+     * \brief   Direction of a leg
+     *
+     * \param   leg         Index of the leg
+     *
+     * \return  unit vector, zero for an empty leg
+     */
+    const float* leg_direction(uint32_t leg) const;
+
+
+private:
+    /**
+     * \brief   Jerk-limited change of speed
+     */
+    struct transition_t
+    {
+        float v_start;              ///< Speed at the start (m/s)
+        float sign;                 ///< 1 to accelerate, -1 to decelerate
+        float t_jerk;               ///< Duration of each constant jerk phase (s)
+        float t_acc;                ///< Duration of the constant acceleration phase (s)
+        float duration;             ///< Total duration (s)
+        float length;               ///< Distance travelled (m)
+    };
+
+
+    /**
+     * \brief   Straight leg with its speed profile
+     */
+    struct leg_t
+    {
+        local_position_t start;     ///< First point
+        local_position_t end;       ///< Last point
+        float dir[3];               ///< Unit direction
+        float length;               ///< Length (m)
+        float max_speed;            ///< Speed limit on this leg (m/s)
+        float v_end;                ///< Speed at the end (m/s)
+        float v_peak;               ///< Cruise speed (m/s)
+        transition_t acc;           ///< Transition from the entry speed to v_peak
+        transition_t dec;           ///< Transition from v_peak to v_end
+        float t_start;              ///< Time of the start of the leg (s)
+        float t_cruise;             ///< Time of the start of the cruise (s)
+        float t_dec;                ///< Time of the start of the deceleration (s)
+        float t_end;                ///< Time of the end of the leg (s)
+    };
+
+
+    /**
+     * \brief   Computes a transition between two speeds
+     *
+     * \param   v_start     Speed at the start
+     * \param   v_end       Speed at the end
+     * \param   tr          Output transition
+     */
+    void transition(float v_start, float v_end, transition_t& tr) const;
+
+
+    /**
+     * \brief   Distance needed to change speed
+     *
+     * \param   v_start     Speed at the start
+     * \param   v_end       Speed at the end
+     *
+     * \return  distance (m)
+     */
+    float transition_length(float v_start, float v_end) const;
+
+
+    /**
+     * \brief   Highest speed reachable from a speed within a distance
+     *
+     * \param   v_start     Speed at the start
+     * \param   length      Available distance
+     * \param   max_speed   Upper bound of the result
+     *
+     * \return  speed (m/s)
+     */
+    float reachable_speed(float v_start, float length, float max_speed) const;
+
+
+    /**
+     * \brief   Evaluates a transition
+     *
+     * \param   tr          Transition
+     * \param   t           Time since the start of the transition
+     * \param   s           Output distance since the start
+     * \param   v           Output speed
+     * \param   a           Output acceleration
+     */
+    void evaluate_transition(const transition_t& tr, float t, float& s, float& v, float& a) const;
+
+
+    conf_t config_;                 ///< Configuration
+    leg_t legs_[MAX_LEGS];          ///< Legs
+    uint32_t leg_count_;            ///< Number of legs
+    uint32_t cursor_;               ///< Leg of the last evaluation
+};
+
+
+Trajectory::conf_t Trajectory::default_config(void)
+{
+    conf_t conf = {};
+
+    conf.max_speed          = 3.0f;
+    conf.max_climb_rate     = 1.0f;
+    conf.max_acc            = 1.5f;
+    conf.max_jerk           = 3.0f;
+    conf.junction_deviation = 0.5f;
+
+    return conf;
+}
+
+
+#endif /* TRAJECTORY_HPP_ */
@@ -0,0 +1,333 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file vector_field_store.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Store of attractors and repulsors for vector field navigation
+ *
+ ******************************************************************************/
+
+
+#include "navigation/vector_field_store.hpp"
+
+extern "C"
+{
+#include "util/maths.h"
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+bool Vector_field_store::is_bounded(const field_t& field)
+{
+    return (field.type == REPULSOR_CYLINDER) || (field.type == REPULSOR_SPHERE);
+}
+
+
+void Vector_field_store::build_index(void)
+{
+    const field_t* field_list = fields();
+    uint16_t* sorted_list     = sorted();
+    uint16_t* start           = cell_start();
+
+    // Bounding box and largest range of the repulsors
+    float min[2]    = {0.0f, 0.0f};
+    float max[2]    = {0.0f, 0.0f};
+    float max_range = 0.0f;
+    bounded_count_  = 0;
+    for (uint16_t i = 0; i < count_; ++i)
+    {
+        const field_t& field = field_list[i];
+        if (!is_bounded(field))
+        {
+            continue;
+        }
+
+        if (bounded_count_ == 0)
+        {
+            min[X] = max[X] = field.pos[X];
+            min[Y] = max[Y] = field.pos[Y];
+        }
+        min[X]    = maths_f_min(min[X], field.pos[X]);
+        min[Y]    = maths_f_min(min[Y], field.pos[Y]);
+        max[X]    = maths_f_max(max[X], field.pos[X]);
+        max[Y]    = maths_f_max(max[Y], field.pos[Y]);
+        max_range = maths_f_max(max_range, field.param2);
+        bounded_count_++;
+    }
+
+    // Cells at least as large as the largest range, enlarged until the grid fits
+    origin_[X] = min[X];
+    origin_[Y] = min[Y];
+    cell_size_ = maths_f_max(config_.min_cell_size, max_range);
+    if (cell_size_ <= 0.0f)
+    {
+        cell_size_ = 1.0f;
+    }
+    cell_x_count_ = (int32_t)((max[X] - min[X]) / cell_size_) + 1;
+    cell_y_count_ = (int32_t)((max[Y] - min[Y]) / cell_size_) + 1;
+    while (((float)cell_x_count_ * (float)cell_y_count_) > (float)cell_max_count())
+    {
+        cell_size_   *= 2.0f;
+        cell_x_count_ = (int32_t)((max[X] - min[X]) / cell_size_) + 1;
+        cell_y_count_ = (int32_t)((max[Y] - min[Y]) / cell_size_) + 1;
+    }
+    int32_t cell_count = cell_x_count_ * cell_y_count_;
+
+    // Count the repulsors in each cell
+    for (int32_t c = 0; c <= cell_count; ++c)
+    {
+        start[c] = 0;
+    }
+    for (uint16_t i = 0; i < count_; ++i)
+    {
+        if (is_bounded(field_list[i]))
+        {
+            int32_t cx = (int32_t)((field_list[i].pos[X] - origin_[X]) / cell_size_);
+            int32_t cy = (int32_t)((field_list[i].pos[Y] - origin_[Y]) / cell_size_);
+            start[cy * cell_x_count_ + cx + 1]++;
+        }
+    }
+
+    // Start of each cell
+    for (int32_t c = 0; c < cell_count; ++c)
+    {
+        start[c + 1] += start[c];
+    }
+
+    // Sort the repulsors by cell (start[c] is moved to the start of cell c + 1),
+    // the unbounded fields are placed after them
+    uint16_t next_unbounded = bounded_count_;
+    for (uint16_t i = 0; i < count_; ++i)
+    {
+        if (is_bounded(field_list[i]))
+        {
+            int32_t cx = (int32_t)((field_list[i].pos[X] - origin_[X]) / cell_size_);
+            int32_t cy = (int32_t)((field_list[i].pos[Y] - origin_[Y]) / cell_size_);
+            sorted_list[start[cy * cell_x_count_ + cx]++] = i;
+        }
+        else
+        {
+            sorted_list[next_unbounded++] = i;
+        }
+    }
+
+    // Restore the start of each cell
+    for (int32_t c = cell_count; c > 0; --c)
+    {
+        start[c] = start[c - 1];
+    }
+    start[0] = 0;
+
+    index_valid_ = true;
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Vector_field_store::Vector_field_store(const conf_t& config):
+    config_(config),
+    count_(0),
+    bounded_count_(0),
+    index_valid_(false),
+    origin_{0.0f, 0.0f},
+    cell_size_(1.0f),
+    cell_x_count_(0),
+    cell_y_count_(0)
+{}
+
+
+bool Vector_field_store::add(const field_t& field)
+{
+    if (count_ >= field_max_count())
+    {
+        return false;
+    }
+
+    fields()[count_] = field;
+    count_++;
+    index_valid_ = false;
+
+    return true;
+}
+
+
+bool Vector_field_store::add(const Waypoint& waypoint)
+{
+    field_t field;
+
+    switch (waypoint.command())
+    {
+        case MAV_CMD_NAV_TAKEOFF:
+            field.type = ATTRACTOR;
+            break;
+
+        case MAV_CMD_NAV_LOITER_UNLIM:
+            field.type = REPULSOR_CYLINDER;
+            break;
+
+        case MAV_CMD_NAV_LOITER_TURNS:
+            field.type = REPULSOR_SPHERE;
+            break;
+
+        case MAV_CMD_NAV_WAYPOINT:
+            field.type = CIRCULAR_WAYPOINT;
+            break;
+
+        default:
+            return false;
+    }
+
+    field.pos    = waypoint.local_pos();
+    field.param1 = waypoint.param1();
+    field.param2 = waypoint.param2();
+    field.param3 = waypoint.param3();
+
+    return add(field);
+}
+
+
+void Vector_field_store::clear(void)
+{
+    count_       = 0;
+    index_valid_ = false;
+}
+
+
+uint16_t Vector_field_store::count(void) const
+{
+    return count_;
+}
+
+
+const Vector_field_store::field_t& Vector_field_store::field(uint16_t index) const
+{
+    return fields()[index];
+}
+
+
+void Vector_field_store::query_begin(query_t& query, const float pos[3])
+{
+    if (!index_valid_)
+    {
+        build_index();
+    }
+
+    query.pos[X]         = pos[X];
+    query.pos[Y]         = pos[Y];
+    query.next_unbounded = bounded_count_;
+
+    // Cells around the position, the range of the repulsors is at most one cell
+    float fx = (pos[X] - origin_[X]) / cell_size_;
+    float fy = (pos[Y] - origin_[Y]) / cell_size_;
+    if ((bounded_count_ == 0)
+        || (fx < -1.0f) || (fx >= (float)(cell_x_count_ + 1))
+        || (fy < -1.0f) || (fy >= (float)(cell_y_count_ + 1)))
+    {
+        // No repulsor close to the position
+        query.cell_x_min = 0;
+        query.cell_x_max = -1;
+        query.cell_y_min = 0;
+        query.cell_y_max = -1;
+    }
+    else
+    {
+        int32_t cx = (int32_t)(fx + 1.0f) - 1;     // floor for fx >= -1
+        int32_t cy = (int32_t)(fy + 1.0f) - 1;
+        query.cell_x_min = (cx > 0) ? (cx - 1) : 0;
+        query.cell_x_max = (cx < (cell_x_count_ - 1)) ? (cx + 1) : (cell_x_count_ - 1);
+        query.cell_y_min = (cy > 0) ? (cy - 1) : 0;
+        query.cell_y_max = (cy < (cell_y_count_ - 1)) ? (cy + 1) : (cell_y_count_ - 1);
+    }
+
+    // Position before the first cell, so that query_next moves to it
+    query.cell_x = query.cell_x_max;
+    query.cell_y = query.cell_y_min - 1;
+    query.next   = 0;
+    query.end    = 0;
+}
+
+
+const Vector_field_store::field_t* Vector_field_store::query_next(query_t& query) const
+{
+    const field_t* field_list = fields();
+    const uint16_t* sorted_list = sorted();
+    const uint16_t* start = cell_start();
+
+    // Repulsors of the cells around the position
+    while (true)
+    {
+        while (query.next < query.end)
+        {
+            const field_t& field = field_list[sorted_list[query.next++]];
+            float dx = field.pos[X] - query.pos[X];
+            float dy = field.pos[Y] - query.pos[Y];
+            if ((dx * dx + dy * dy) <= (field.param2 * field.param2))
+            {
+                return &field;
+            }
+        }
+
+        // Next cell
+        if (query.cell_x < query.cell_x_max)
+        {
+            query.cell_x++;
+        }
+        else if (query.cell_y < query.cell_y_max)
+        {
+            query.cell_x = query.cell_x_min;
+            query.cell_y++;
+        }
+        else
+        {
+            break;
+        }
+
+        int32_t c   = query.cell_y * cell_x_count_ + query.cell_x;
+        query.next  = start[c];
+        query.end   = start[c + 1];
+    }
+
+    // Attractors and circular waypoints
+    if (query.next_unbounded < count_)
+    {
+        return &field_list[sorted_list[query.next_unbounded++]];
+    }
+
+    return NULL;
+}
@@ -0,0 +1,357 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file vector_field_store.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Store of attractors and repulsors for vector field navigation
+ *
+ * \details Fields are kept in the local frame, separately from the mission.
+ *          Repulsors only act within their range, so they are indexed in a
+ *          uniform horizontal grid whose cells are at least as large as the
+ *          largest range: only the 3x3 cells around the vehicle need to be
+ *          visited. Attractors and circular waypoints act everywhere and are
+ *          always returned by queries.
+ *
+ ******************************************************************************/
+
+
+#ifndef VECTOR_FIELD_STORE_HPP_
+#define VECTOR_FIELD_STORE_HPP_
+
+#include <cstdint>
+
+#include "mission/waypoint.hpp"
+#include "util/coord_conventions.hpp"
+
+
+/**
+ * \brief   Store of vector fields with a spatial index
+ */
+class Vector_field_store
+{
+public:
+    /**
+     * \brief   Type of field
+     */
+    enum field_type_t
+    {
+        ATTRACTOR           = 0,    ///< param1: attractiveness
+        REPULSOR_CYLINDER   = 1,    ///< param1: repulsiveness, param2: max_range, param3: safety_radius
+        REPULSOR_SPHERE     = 2,    ///< param1: repulsiveness, param2: max_range, param3: safety_radius
+        CIRCULAR_WAYPOINT   = 3,    ///< param1: attractiveness, param2: cruise_speed, param3: radius
+    };
+
+
+    /**
+     * \brief   Field
+     */
+    struct field_t
+    {
+        field_type_t type;          ///< Type of field
+        local_position_t pos;       ///< Position in the local frame
+        float param1;               ///< Parameter depending on type
+        float param2;               ///< Parameter depending on type
+        float param3;               ///< Parameter depending on type
+    };
+
+
+    /**
+     * \brief   Configuration
+     */
+    struct conf_t
+    {
+        float min_cell_size;        ///< Minimum size of the cells of the grid (m)
+    };
+
+
+    /**
+     * \brief   Iterator over the fields close to a position
+     */
+    struct query_t
+    {
+        float pos[2];               ///< Horizontal position of the query
+        int32_t cell_x_min;         ///< First column of cells to visit
+        int32_t cell_x_max;         ///< Last column of cells to visit
+        int32_t cell_y_min;         ///< First row of cells to visit
+        int32_t cell_y_max;         ///< Last row of cells to visit
+        int32_t cell_x;             ///< Current column
+        int32_t cell_y;             ///< Current row
+        uint16_t next;              ///< Next position in the sorted index
+        uint16_t end;               ///< End of the current cell in the sorted index
+        uint16_t next_unbounded;    ///< Next unbounded field in the sorted index
+    };
+
+
+    /**
+     * \brief   Default configuration
+     *
+     * \return  Config structure
+     */
+    static inline conf_t default_config(void);
+
+
+    /**
+     * \brief   Constructor
+     *
+     * \param   config      Configuration
+     */
+    Vector_field_store(const conf_t& config = default_config());
+
+
+    /**
+     * \brief   Adds a field
+     *
+     * \param   field       Field
+     *
+     * \return  False if the store is full
+     */
+    bool add(const field_t& field);
+
+
+    /**
+     * \brief   Adds a field from a waypoint
+     *
+     * \details The command of the waypoint gives the type of field:
+     *          MAV_CMD_NAV_TAKEOFF (22) attractor, MAV_CMD_NAV_LOITER_UNLIM (17)
+     *          cylindrical repulsor, MAV_CMD_NAV_LOITER_TURNS (18) spherical
+     *          repulsor, MAV_CMD_NAV_WAYPOINT (16) circular waypoint.
+     *          The position is converted to the local frame of the current origin
+     *
+     * \param   waypoint    Waypoint
+     *
+     * \return  False if the store is full or if the command is not a field
+     */
+    bool add(const Waypoint& waypoint);
+
+
+    /**
+     * \brief   Removes all fields
+     */
+    void clear(void);
+
+
+    /**
+     * \brief   Number of fields
+     *
+     * \return  count
+     */
+    uint16_t count(void) const;
+
+
+    /**
+     * \brief   Gets a field
+     *
+     * \param   index       Index of the field (in the order of insertion)
+     *
+     * \return  field
+     */
+    const field_t& field(uint16_t index) const;
+
+
+    /**
+     * \brief   Starts a query of the fields acting on a position
+     *
+     * \details Rebuilds the index if fields were added since the last query.
+     *          The query returns all attractors and circular waypoints, and
+     *          the repulsors whose horizontal distance to pos is smaller than
+     *          their range
+     *
+     * \param   query       Query to initialize
+     * \param   pos         Position in the local frame
+     */
+    void query_begin(query_t& query, const float pos[3]);
+
+
+    /**
+     * \brief   Gets the next field of a query
+     *
+     * \param   query       Query started with query_begin
+     *
+     * \return  Pointer to the next field, NULL at the end of the query
+     */
+    const field_t* query_next(query_t& query) const;
+
+
+protected:
+    /**
+     * \brief   Get maximum number of fields
+     *
+     * \return  Maximum number of fields
+     */
+    virtual uint16_t field_max_count(void) const = 0;
+
+
+    /**
+     * \brief   Get maximum number of cells of the grid
+     *
+     * \return  Maximum number of cells
+     */
+    virtual uint16_t cell_max_count(void) const = 0;
+
+
+    /**
+     * \brief   Get the array of fields
+     *
+     * \return  array of field_max_count() fields
+     */
+    virtual field_t* fields(void) = 0;
+    virtual const field_t* fields(void) const = 0;
+
+
+    /**
+     * \brief   Get the sorted index, field indices sorted by cell followed by unbounded fields
+     *
+     * \return  array of field_max_count() indices
+     */
+    virtual uint16_t* sorted(void) = 0;
+    virtual const uint16_t* sorted(void) const = 0;
+
+
+    /**
+     * \brief   Get the start of each cell in the sorted index
+     *
+     * \return  array of cell_max_count() + 1 positions
+     */
+    virtual uint16_t* cell_start(void) = 0;
+    virtual const uint16_t* cell_start(void) const = 0;
+
+
+private:
+    /**
+     * \brief   Builds the grid index
+     */
+    void build_index(void);
+
+
+    /**
+     * \brief   Indicates whether a field acts only within a range
+     *
+     * \param   field       Field
+     *
+     * \return  True for repulsors
+     */
+    static bool is_bounded(const field_t& field);
+
+
+    conf_t config_;                 ///< Configuration
+    uint16_t count_;                ///< Number of fields
+    uint16_t bounded_count_;        ///< Number of fields in the grid
+    bool index_valid_;              ///< False if fields were added since the index was built
+    float origin_[2];               ///< Position of the corner of the grid
+    float cell_size_;               ///< Size of the cells
+    int32_t cell_x_count_;          ///< Number of columns
+    int32_t cell_y_count_;          ///< Number of rows
+};
+
+
+/**
+ * \brief   Store of vector fields
+ *
+ * \tparam  N       Maximum number of fields
+ * \tparam  CELLS   Maximum number of cells of the grid
+ */
+template<uint16_t N, uint16_t CELLS = 1024>
+class Vector_field_store_T: public Vector_field_store
+{
+public:
+    /**
+     * \brief   Constructor
+     *
+     * \param   config      Configuration
+     */
+    Vector_field_store_T(const conf_t& config = default_config()):
+        Vector_field_store(config)
+    {}
+
+
+protected:
+    uint16_t field_max_count(void) const
+    {
+        return N;
+    }
+
+    uint16_t cell_max_count(void) const
+    {
+        return CELLS;
+    }
+
+    field_t* fields(void)
+    {
+        return fields_;
+    }
+
+    const field_t* fields(void) const
+    {
+        return fields_;
+    }
+
+    uint16_t* sorted(void)
+    {
+        return sorted_;
+    }
+
+    const uint16_t* sorted(void) const
+    {
+        return sorted_;
+    }
+
+    uint16_t* cell_start(void)
+    {
+        return cell_start_;
+    }
+
+    const uint16_t* cell_start(void) const
+    {
+        return cell_start_;
+    }
+
+
+private:
+    field_t fields_[N];                 ///< Fields in the order of insertion
+    uint16_t sorted_[N];                ///< Field indices sorted by cell
+    uint16_t cell_start_[CELLS + 1];    ///< Start of each cell in sorted_
+};
+
+
+Vector_field_store::conf_t Vector_field_store::default_config(void)
+{
+    conf_t conf = {};
+
+    conf.min_cell_size = 10.0f;
+
+    return conf;
+}
+
+
+#endif /* VECTOR_FIELD_STORE_HPP_ */
@@ -386,10 +386,10 @@ static void vector_field_circular_waypoint(const float pos_mav[3], const float p
 // PUBLIC FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
 
-bool vector_field_waypoint_init(vector_field_waypoint_t* vector_field, Mavlink_waypoint_handler* waypoint_handler, const INS* ins, velocity_command_t* velocity_command, const vector_field_waypoint_conf_t* config)
+bool vector_field_waypoint_init(vector_field_waypoint_t* vector_field, Vector_field_store* field_store, const INS* ins, velocity_command_t* velocity_command, const vector_field_waypoint_conf_t* config)
 {
     // Init dependencies
-    vector_field->waypoint_handler  = waypoint_handler;
+    vector_field->field_store       = field_store;
     vector_field->ins               = ins;
     vector_field->velocity_command  = velocity_command;
 
@@ -417,54 +417,55 @@ bool vector_field_waypoint_update(vector_field_waypoint_t* vector_field)
     vector_field->velocity_command->xyz[Y] += tmp_vector[Y];
     vector_field->velocity_command->xyz[Z] += tmp_vector[Z];
 
-    // Go through waypoint list
-    for (uint16_t i = 0; i < vector_field->waypoint_handler->waypoint_count(); ++i)
-    {
-        const Waypoint& waypoint = vector_field->waypoint_handler->waypoint_from_index(i);
-        local_position_t local_wpt = waypoint.local_pos();
+    // Go through the fields acting on the current position
+    Vector_field_store::query_t query;
+    vector_field->field_store->query_begin(query, vector_field->ins->position_lf().data());
 
+    const Vector_field_store::field_t* field;
+    while ((field = vector_field->field_store->query_next(query)) != NULL)
+    {
         // Get object position
-        pos_obj[X] = local_wpt[X];
-        pos_obj[Y] = local_wpt[Y];
-        pos_obj[Z] = local_wpt[Z];
+        pos_obj[X] = field->pos[X];
+        pos_obj[Y] = field->pos[Y];
+        pos_obj[Z] = field->pos[Z];
 
-        switch (waypoint.command())
+        switch (field->type)
         {
             // Attractive object
-            case 22:
+            case Vector_field_store::ATTRACTOR:
                 vector_field_attractor(vector_field->ins->position_lf().data(),
                                        pos_obj,
-                                       waypoint.param1(),     // attractiveness
+                                       field->param1,       // attractiveness
                                        tmp_vector);
                 break;
 
             // Cylindrical repulsive object
-            case 17:
+            case Vector_field_store::REPULSOR_CYLINDER:
                 vector_field_repulsor_cylinder(vector_field->ins->position_lf().data(),
                                                pos_obj,
-                                               waypoint.param1(),     // repulsiveness
-                                               waypoint.param2(),     // max_range
-                                               waypoint.param3(),     // safety_radius
+                                               field->param1,       // repulsiveness
+                                               field->param2,       // max_range
+                                               field->param3,       // safety_radius
                                                tmp_vector);
                 break;
 
             // Spherical repulsive object
-            case 18:
+            case Vector_field_store::REPULSOR_SPHERE:
                 vector_field_repulsor_sphere(vector_field->ins->position_lf().data(),
                                              pos_obj,
-                                             waypoint.param1(),   // repulsiveness
-                                             waypoint.param2(),   // max_range
-                                             waypoint.param3(),   // safety_radius
+                                             field->param1,     // repulsiveness
+                                             field->param2,     // max_range
+                                             field->param3,     // safety_radius
                                              tmp_vector);
                 break;
 
             // Circular waypoint
-          case 16:
+            case Vector_field_store::CIRCULAR_WAYPOINT:
                 vector_field_circular_waypoint(vector_field->ins->position_lf().data(),
                                                pos_obj,
-                                               waypoint.param1(),     // attractiveness
-                                               waypoint.param2(),     // cruise_speed
-                                               waypoint.param3(), // radius
+                                               field->param1,       // attractiveness
+                                               field->param2,       // cruise_speed
+                                               field->param3,       // radius
                                                tmp_vector);
                 break;
 
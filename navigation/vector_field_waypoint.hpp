@@ -35,7 +35,10 @@
  * \author MAV'RIC Team
  * \author Julien Lecoeur
  *
- * \brief Vector field navigation using repulsors and attractors set through GPS waypoints
+ * \brief Vector field navigation using repulsors and attractors
+ *
+ * \details The fields are kept in a Vector_field_store, separately from the
+ *          mission. Only the repulsors in range of the vehicle are evaluated
  *
  ******************************************************************************/
 
@@ -43,8 +46,7 @@
 #ifndef VECTOR_FIELD_WAYPOINT_HPP_
 #define VECTOR_FIELD_WAYPOINT_HPP_
 
-#include "communication/mavlink_waypoint_handler.hpp"
-#include "mission/waypoint.hpp"
+#include "navigation/vector_field_store.hpp"
 #include "sensing/ins.hpp"
 #include "control/control_command.hpp"
 
@@ -53,7 +55,7 @@
  */
 typedef struct
 {
-    const Mavlink_waypoint_handler*   waypoint_handler;         ///< Waypoint list (input)
+    Vector_field_store*               field_store;              ///< Attractors and repulsors (input)
     const INS*                        ins;                      ///< Estimated position and speed (input)
     velocity_command_t*               velocity_command;         ///< Velocity command (output)
 } vector_field_waypoint_t;
@@ -71,12 +73,12 @@ typedef struct
  * \brief                       Initialises the attitude controller structure
  *
  * \param   vector_field        Pointer to data structure
- * \param   waypoint_handler    Pointer to waypoint list (input)
+ * \param   field_store         Pointer to the attractors and repulsors (input)
  * \param   ins                 Pointer to the Inertial Navigation System (input)
  * \param   velocity_command    Pointer to velocity command (output)
  * \param   config              Pointer to configuration
  */
-bool vector_field_waypoint_init(vector_field_waypoint_t* vector_field, Mavlink_waypoint_handler* waypoint_handler, const INS* ins, velocity_command_t* velocity_command, const vector_field_waypoint_conf_t* config);
+bool vector_field_waypoint_init(vector_field_waypoint_t* vector_field, Vector_field_store* field_store, const INS* ins, velocity_command_t* velocity_command, const vector_field_waypoint_conf_t* config);
 
 
 /**
@@ -58,6 +58,7 @@ LIB_SRCS += control/velocity_controller_copter.cpp
 LIB_SRCS += control/velocity_controller_holonomic.cpp
 LIB_SRCS += control/position_controller.cpp
 LIB_SRCS += control/pid_controller.cpp
+LIB_SRCS += control/gain_scheduler.cpp
 
 LIB_SRCS += drivers/airspeed_analog.cpp
 LIB_SRCS += drivers/battery.cpp
@@ -66,6 +67,7 @@ LIB_SRCS += drivers/barometer_telemetry.cpp
 LIB_SRCS += drivers/barometer_bmp085.cpp
 LIB_SRCS += drivers/barometer_ms5611.cpp
 LIB_SRCS += drivers/gps_ublox.cpp
+LIB_SRCS += drivers/ubx_parser.cpp
 LIB_SRCS += drivers/gps_telemetry.cpp
 LIB_SRCS += drivers/gps_mocap.cpp
 LIB_SRCS += drivers/hmc5883l.cpp
@@ -91,6 +93,7 @@ LIB_SRCS += drones/lequad.cpp
 LIB_SRCS += hal/common/dbg.cpp
 LIB_SRCS += hal/common/led_gpio.cpp
 LIB_SRCS += hal/common/file.cpp
+LIB_SRCS += hal/common/i2c_queue.cpp
 LIB_SRCS += hal/common/serial.cpp
 
 LIB_SRCS += flight_controller/flight_controller_stack.cpp
@@ -113,12 +116,17 @@ LIB_SRCS += mission/mission_handler_critical_navigating.cpp
 LIB_SRCS += mission/mission_handler_on_ground.cpp
 LIB_SRCS += mission/mission_handler_registry.cpp
 LIB_SRCS += mission/mission_handler_takeoff.cpp
+LIB_SRCS += mission/mission_store.cpp
+LIB_SRCS += mission/mission_store_file.cpp
 LIB_SRCS += mission/waypoint.cpp
 
 LIB_SRCS += navigation/dubin.cpp
+LIB_SRCS += navigation/vector_field_store.cpp
 LIB_SRCS += navigation/vector_field_waypoint.cpp
 LIB_SRCS += navigation/navigation_directto.cpp
+LIB_SRCS += navigation/trajectory.cpp
 
+LIB_SRCS += runtime/cycle_clock.cpp
 LIB_SRCS += runtime/scheduler.cpp
 LIB_SRCS += runtime/scheduler_task.cpp
 LIB_SRCS += runtime/scheduler_telemetry.cpp
@@ -129,33 +137,47 @@ LIB_SRCS += sensing/ahrs_qfilter.cpp
 LIB_SRCS += sensing/ahrs_telemetry.cpp
 LIB_SRCS += sensing/ahrs_madgwick.cpp
 LIB_SRCS += sensing/altitude_estimation.cpp
+LIB_SRCS += sensing/dynamic_notch.cpp
 LIB_SRCS += sensing/imu.cpp
+LIB_SRCS += sensing/imu_pipeline.cpp
 LIB_SRCS += sensing/imu_telemetry.cpp
 LIB_SRCS += sensing/ins.cpp
 LIB_SRCS += sensing/ins_complementary.cpp
 LIB_SRCS += sensing/ins_kf.cpp
 LIB_SRCS += sensing/ins_telemetry.cpp
 
+LIB_SRCS += simulation/accelerometer_replay.cpp
 LIB_SRCS += simulation/accelerometer_sim.cpp
+LIB_SRCS += simulation/barometer_replay.cpp
 LIB_SRCS += simulation/barometer_sim.cpp
 LIB_SRCS += simulation/dynamic_model_quad_diag.cpp
 LIB_SRCS += simulation/dynamic_model_telemetry.cpp
 LIB_SRCS += simulation/flow_sim.cpp
+LIB_SRCS += simulation/gps_replay.cpp
 LIB_SRCS += simulation/gps_sim.cpp
+LIB_SRCS += simulation/gyroscope_replay.cpp
 LIB_SRCS += simulation/gyroscope_sim.cpp
 LIB_SRCS += simulation/ins_ahrs_groundtruth.cpp
+LIB_SRCS += simulation/magnetometer_replay.cpp
 LIB_SRCS += simulation/magnetometer_sim.cpp
+LIB_SRCS += simulation/px4flow_replay.cpp
+LIB_SRCS += simulation/sensor_replay.cpp
 LIB_SRCS += simulation/simulation.cpp
+LIB_SRCS += simulation/sonar_replay.cpp
 LIB_SRCS += simulation/sonar_sim.cpp
 
 LIB_SRCS += status/geofence_cylinder.cpp
+LIB_SRCS += status/geofence_polygon.cpp
 LIB_SRCS += status/state.cpp
 LIB_SRCS += status/state_machine.cpp
 LIB_SRCS += status/state_telemetry.cpp
 
 LIB_SRCS += util/coord_conventions.cpp
+LIB_SRCS += util/local_tangent_plane.cpp
 LIB_SRCS += util/matrix.cpp
 LIB_SRCS += util/print_util.cpp
+LIB_SRCS += util/quaternions_batch.cpp
 LIB_SRCS += util/quick_trig.cpp
 LIB_SRCS += util/raytracing.cpp
 LIB_SRCS += util/string_util.cpp
+LIB_SRCS += util/vectors_batch.cpp
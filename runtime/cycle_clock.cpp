@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file cycle_clock.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Time sample shared by all modules updated during one control cycle
+ *
+ ******************************************************************************/
+
+
+#include "runtime/cycle_clock.hpp"
+#include "hal/common/time_keeper.hpp"
+
+uint64_t Cycle_clock::time_us_  = 0;
+double   Cycle_clock::time_s_   = 0.0;
+bool     Cycle_clock::in_cycle_ = false;
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+void Cycle_clock::begin(void)
+{
+    begin(time_keeper_get_us());
+}
+
+
+void Cycle_clock::begin(uint64_t time_us)
+{
+    time_us_  = time_us;
+    time_s_   = (double)time_us / 1000000.0;
+    in_cycle_ = true;
+}
+
+
+void Cycle_clock::end(void)
+{
+    in_cycle_ = false;
+}
+
+
+bool Cycle_clock::in_cycle(void)
+{
+    return in_cycle_;
+}
+
+
+uint64_t Cycle_clock::now_us(void)
+{
+    if (in_cycle_)
+    {
+        return time_us_;
+    }
+    return time_keeper_get_us();
+}
+
+
+double Cycle_clock::now_s(void)
+{
+    if (in_cycle_)
+    {
+        return time_s_;
+    }
+    return time_keeper_get_s();
+}
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file cycle_clock.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Time sample shared by all modules updated during one control cycle
+ *
+ * \details The clock is read once at the beginning of a cycle, and modules
+ *          updated during that cycle read the sample instead of the hardware
+ *          clock, so that they all see the same time. Each module computes its
+ *          own dt from consecutive samples, since rate groups run at different
+ *          periods.
+ *          Outside of a cycle the functions fall back to time_keeper, so
+ *          modules updated from other tasks keep working unchanged.
+ *
+ ******************************************************************************/
+
+
+#ifndef CYCLE_CLOCK_HPP_
+#define CYCLE_CLOCK_HPP_
+
+#include <cstdint>
+
+
+/**
+ * \brief   Time sample of the current control cycle
+ */
+class Cycle_clock
+{
+public:
+    /**
+     * \brief   Samples the clock and starts a new cycle
+     */
+    static void begin(void);
+
+
+    /**
+     * \brief   Starts a new cycle at a given time
+     *
+     * \details Used when time does not come from the hardware clock, for
+     *          example when replaying recorded sensor data
+     *
+     * \param   time_us     Time of the beginning of the cycle in microseconds
+     */
+    static void begin(uint64_t time_us);
+
+
+    /**
+     * \brief   Ends the current cycle
+     *
+     * \details Following calls read the hardware clock again
+     */
+    static void end(void);
+
+
+    /**
+     * \brief   Indicates whether a cycle is running
+     *
+     * \return  True between begin() and end()
+     */
+    static bool in_cycle(void);
+
+
+    /**
+     * \brief   Get the time in microseconds
+     *
+     * \return  Time of the beginning of the cycle, or current time outside of a cycle
+     */
+    static uint64_t now_us(void);
+
+
+    /**
+     * \brief   Get the time in seconds
+     *
+     * \return  Time of the beginning of the cycle, or current time outside of a cycle
+     */
+    static double now_s(void);
+
+
+    /**
+     * \brief   Runs a cycle during the lifetime of the object
+     */
+    class Scope
+    {
+    public:
+        Scope(void)
+        {
+            Cycle_clock::begin();
+        };
+
+        Scope(uint64_t time_us)
+        {
+            Cycle_clock::begin(time_us);
+        };
+
+        ~Scope(void)
+        {
+            Cycle_clock::end();
+        };
+    };
+
+private:
+    static uint64_t time_us_;       ///< Time at the beginning of the cycle in microseconds
+    static double   time_s_;        ///< Time at the beginning of the cycle in seconds
+    static bool     in_cycle_;      ///< Indicates whether a cycle is running
+};
+
+#endif /* CYCLE_CLOCK_HPP_ */
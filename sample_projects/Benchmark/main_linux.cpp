@@ -0,0 +1,702 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file main_linux.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Host side micro-benchmarks
+ *
+ * \details Runs each benchmark on fixed inputs and prints one CSV line per
+ *          benchmark on stdout:
+ *          name,iterations,elements,ns_per_call,ns_per_element,max_error
+ *
+ *          max_error is the maximum absolute difference with the reference
+ *          implementation, or 0 when the benchmark has no reference
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+#include "control/servos_mix_matrix.hpp"
+#include "communication/mavlink_message_handler.hpp"
+#include "communication/mavlink_stream.hpp"
+#include "drivers/airspeed_analog.hpp"
+#include "drivers/battery.hpp"
+#include "drivers/gps_mocap.hpp"
+#include "drivers/px4flow_i2c.hpp"
+#include "drivers/servo.hpp"
+#include "flight_controller/flight_controller_quadcopter.hpp"
+#include "runtime/cycle_clock.hpp"
+#include "hal/dummy/adc_dummy.hpp"
+#include "hal/dummy/i2c_dummy.hpp"
+#include "hal/dummy/pwm_dummy.hpp"
+#include "hal/dummy/serial_dummy.hpp"
+#include "sensing/ahrs_ekf.hpp"
+#include "sensing/ahrs_madgwick.hpp"
+#include "sensing/ahrs_qfilter.hpp"
+#include "sensing/imu.hpp"
+#include "sensing/ins_complementary.hpp"
+#include "sensing/ins_kf.hpp"
+#include "simulation/dynamic_model_quad_diag.hpp"
+#include "simulation/simulation.hpp"
+#include "status/state.hpp"
+#include "util/coord_conventions.hpp"
+#include "util/fast_math.hpp"
+#include "util/local_tangent_plane.hpp"
+#include "util/quaternions_batch.hpp"
+#include "util/quick_trig.hpp"
+#include "util/vectors_batch.hpp"
+
+extern "C"
+{
+#include "util/quaternions.h"
+#include "util/vectors.h"
+}
+
+/**
+ * \brief   Sink preventing the compiler from removing benchmarked code
+ */
+static volatile float benchmark_sink = 0.0f;
+
+
+/**
+ * \brief   Period of the synthetic clock of the flight path benchmarks (rate task of MAV)
+ */
+static const uint64_t BENCHMARK_DT_US = 2000;
+
+
+/**
+ * \brief   Synthetic time of the flight path benchmarks
+ */
+static uint64_t benchmark_time_us = 0;
+
+
+/**
+ * \brief   Advances the synthetic clock by one period
+ *
+ * \details Used to start one Cycle_clock cycle per benchmarked update, so that
+ *          modules integrate over a fixed, realistic dt instead of the time
+ *          elapsed between two back to back calls
+ *
+ * \return  Time of the new cycle in microseconds
+ */
+static uint64_t benchmark_tick(void)
+{
+    benchmark_time_us += BENCHMARK_DT_US;
+    return benchmark_time_us;
+}
+
+
+/**
+ * \brief   Runs a function several times and prints the timing
+ *
+ * \param   name        Benchmark name
+ * \param   iterations  Number of calls to function
+ * \param   elements    Number of elements processed per call
+ * \param   max_error   Maximum error with respect to the reference implementation
+ * \param   function    Function to benchmark
+ */
+template<typename F>
+static void benchmark_run(const char* name, uint32_t iterations, uint32_t elements, float max_error, F function)
+{
+    // Warm up caches
+    function();
+
+    auto t_start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+    auto t_end = std::chrono::steady_clock::now();
+
+    double ns_per_call = std::chrono::duration<double, std::nano>(t_end - t_start).count() / (double)iterations;
+
+    printf("%s,%lu,%lu,%.2f,%.3f,%g\n",
+           name,
+           (unsigned long)iterations,
+           (unsigned long)elements,
+           ns_per_call,
+           ns_per_call / (double)elements,
+           max_error);
+}
+
+
+/**
+ * \brief   Fills an array with fixed pseudo-random values in [-1, 1]
+ *
+ * \param   array   Array to fill
+ * \param   seed    Seed of the sequence
+ */
+static void benchmark_fill(std::vector<float>& array, uint32_t seed)
+{
+    uint32_t state = seed;
+    for (float& value : array)
+    {
+        // Linear congruential generator, so that inputs are identical across runs and hosts
+        state = 1664525u * state + 1013904223u;
+        value = (float)(state >> 8) / (float)(1u << 23) - 1.0f;
+    }
+}
+
+
+/**
+ * \brief   Benchmarks batch vector and quaternion kernels against scalar loops
+ */
+static void benchmark_batch_kernels(void)
+{
+    const uint32_t n          = 1024;
+    const uint32_t iterations = 10000;
+
+    std::vector<float> ux(n), uy(n), uz(n), vx(n), vy(n), vz(n);
+    std::vector<float> q1s(n), q1x(n), q1y(n), q1z(n), q2s(n), q2x(n), q2y(n), q2z(n);
+    std::vector<float> os(n), ox(n), oy(n), oz(n);
+    benchmark_fill(ux, 1);
+    benchmark_fill(uy, 2);
+    benchmark_fill(uz, 3);
+    benchmark_fill(q1s, 4);
+    benchmark_fill(q1x, 5);
+    benchmark_fill(q1y, 6);
+    benchmark_fill(q1z, 7);
+    benchmark_fill(q2s, 8);
+    benchmark_fill(q2x, 9);
+    benchmark_fill(q2y, 10);
+    benchmark_fill(q2z, 11);
+
+    vectors_soa_t u     = {ux.data(), uy.data(), uz.data()};
+    vectors_soa_t v     = {vx.data(), vy.data(), vz.data()};
+    quaternions_soa_t q1  = {q1s.data(), q1x.data(), q1y.data(), q1z.data()};
+    quaternions_soa_t q2  = {q2s.data(), q2x.data(), q2y.data(), q2z.data()};
+    quaternions_soa_t out = {os.data(), ox.data(), oy.data(), oz.data()};
+    quat_t q = quaternions_normalise(quaternions_create(0.9f, 0.1f, -0.3f, 0.2f));
+
+    float max_error;
+
+    // Rotation of vectors
+    quaternions_batch_rotate_vectors(q, u, v, n);
+    max_error = 0.0f;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        float in[3] = {ux[i], uy[i], uz[i]};
+        float ref[3];
+        quaternions_rotate_vector(q, in, ref);
+        max_error = fmaxf(max_error, fabsf(ref[0] - vx[i]));
+        max_error = fmaxf(max_error, fabsf(ref[1] - vy[i]));
+        max_error = fmaxf(max_error, fabsf(ref[2] - vz[i]));
+    }
+    benchmark_run("quaternions_rotate_vector", iterations, n, 0.0f, [&]()
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            float in[3] = {ux[i], uy[i], uz[i]};
+            float o[3];
+            quaternions_rotate_vector(q, in, o);
+            vx[i] = o[0];
+            vy[i] = o[1];
+            vz[i] = o[2];
+        }
+        benchmark_sink = vx[n - 1];
+    });
+    benchmark_run("quaternions_batch_rotate_vectors", iterations, n, max_error, [&]()
+    {
+        quaternions_batch_rotate_vectors(q, u, v, n);
+        benchmark_sink = vx[n - 1];
+    });
+
+    // Multiplication of quaternions
+    quaternions_batch_multiply(q1, q2, out, n);
+    max_error = 0.0f;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        quat_t ref = quaternions_multiply(quaternions_create(q1s[i], q1x[i], q1y[i], q1z[i]),
+                                          quaternions_create(q2s[i], q2x[i], q2y[i], q2z[i]));
+        max_error = fmaxf(max_error, fabsf(ref.s - os[i]));
+        max_error = fmaxf(max_error, fabsf(ref.v[0] - ox[i]));
+        max_error = fmaxf(max_error, fabsf(ref.v[1] - oy[i]));
+        max_error = fmaxf(max_error, fabsf(ref.v[2] - oz[i]));
+    }
+    benchmark_run("quaternions_multiply", iterations, n, 0.0f, [&]()
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            quat_t r = quaternions_multiply(quaternions_create(q1s[i], q1x[i], q1y[i], q1z[i]),
+                                            quaternions_create(q2s[i], q2x[i], q2y[i], q2z[i]));
+            os[i] = r.s;
+            ox[i] = r.v[0];
+            oy[i] = r.v[1];
+            oz[i] = r.v[2];
+        }
+        benchmark_sink = os[n - 1];
+    });
+    benchmark_run("quaternions_batch_multiply", iterations, n, max_error, [&]()
+    {
+        quaternions_batch_multiply(q1, q2, out, n);
+        benchmark_sink = os[n - 1];
+    });
+
+    // Normalization of vectors
+    vectors_batch_normalize(u, v, n);
+    max_error = 0.0f;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        float in[3] = {ux[i], uy[i], uz[i]};
+        float ref[3];
+        vectors_normalize(in, ref);
+        max_error = fmaxf(max_error, fabsf(ref[0] - vx[i]));
+        max_error = fmaxf(max_error, fabsf(ref[1] - vy[i]));
+        max_error = fmaxf(max_error, fabsf(ref[2] - vz[i]));
+    }
+    benchmark_run("vectors_normalize", iterations, n, 0.0f, [&]()
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            float in[3] = {ux[i], uy[i], uz[i]};
+            float o[3];
+            vectors_normalize(in, o);
+            vx[i] = o[0];
+            vy[i] = o[1];
+            vz[i] = o[2];
+        }
+        benchmark_sink = vx[n - 1];
+    });
+    benchmark_run("vectors_batch_normalize", iterations, n, max_error, [&]()
+    {
+        vectors_batch_normalize(u, v, n);
+        benchmark_sink = vx[n - 1];
+    });
+
+    // Cross product
+    vectors_soa_t w = {ox.data(), oy.data(), oz.data()};
+    benchmark_run("vectors_batch_cross_product", iterations, n, 0.0f, [&]()
+    {
+        vectors_batch_cross_product(u, v, w, n);
+        benchmark_sink = ox[n - 1];
+    });
+}
+
+
+/**
+ * \brief   Benchmarks one fast_math function at the three accuracy tiers, against libm
+ *
+ * \param   name        Function name
+ * \param   x_min       Lower bound of the input range
+ * \param   x_max       Upper bound of the input range
+ * \param   reference   Reference implementation (double precision)
+ * \param   libm        Float implementation from libm
+ * \param   function    Fast implementation, taking the accuracy tier as second argument
+ */
+template<typename R, typename L, typename F>
+static void benchmark_fast_math_function(const char* name, float x_min, float x_max, R reference, L libm, F function)
+{
+    const uint32_t n          = 4096;
+    const uint32_t iterations = 2000;
+    const fast_math_tier_t tiers[3]      = {FAST_MATH_TIER_LOW, FAST_MATH_TIER_MEDIUM, FAST_MATH_TIER_HIGH};
+    const char*            tier_names[3] = {"low", "medium", "high"};
+
+    // Evenly spaced inputs for the error, shuffled inputs for the timing
+    std::vector<float> x(n), y(n), x_shuffled(n);
+    benchmark_fill(x_shuffled, 42);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        x[i]          = x_min + (x_max - x_min) * (float)i / (float)(n - 1);
+        x_shuffled[i] = x_min + (x_max - x_min) * 0.5f * (x_shuffled[i] + 1.0f);
+    }
+
+    char label[64];
+    float max_error = 0.0f;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        max_error = fmaxf(max_error, (float)fabs(reference((double)x[i]) - (double)libm(x[i])));
+    }
+    snprintf(label, sizeof(label), "libm_%s", name);
+    benchmark_run(label, iterations, n, max_error, [&]()
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            y[i] = libm(x_shuffled[i]);
+        }
+        benchmark_sink = y[n - 1];
+    });
+
+    for (uint32_t t = 0; t < 3; ++t)
+    {
+        fast_math_tier_t tier = tiers[t];
+
+        max_error = 0.0f;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            max_error = fmaxf(max_error, (float)fabs(reference((double)x[i]) - (double)function(x[i], tier)));
+        }
+
+        snprintf(label, sizeof(label), "fast_math_%s_%s", name, tier_names[t]);
+        benchmark_run(label, iterations, n, max_error, [&]()
+        {
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                y[i] = function(x_shuffled[i], tier);
+            }
+            benchmark_sink = y[n - 1];
+        });
+    }
+}
+
+
+/**
+ * \brief   Benchmarks fast_math functions
+ */
+static void benchmark_fast_math(void)
+{
+    benchmark_fast_math_function("sin", -10.0f, 10.0f,
+                                 [](double x) { return sin(x); },
+                                 [](float x) { return sinf(x); },
+                                 [](float x, fast_math_tier_t tier) { return fast_math_sin(x, tier); });
+
+    benchmark_fast_math_function("cos", -10.0f, 10.0f,
+                                 [](double x) { return cos(x); },
+                                 [](float x) { return cosf(x); },
+                                 [](float x, fast_math_tier_t tier) { return fast_math_cos(x, tier); });
+
+    benchmark_fast_math_function("atan", -20.0f, 20.0f,
+                                 [](double x) { return atan(x); },
+                                 [](float x) { return atanf(x); },
+                                 [](float x, fast_math_tier_t tier) { return fast_math_atan(x, tier); });
+
+    // atan2 is evaluated on the unit circle, the input being the angle
+    benchmark_fast_math_function("atan2", -PI, PI,
+                                 [](double x) { return atan2(sin(x), cos(x)); },
+                                 [](float x) { return atan2f(sinf(x), cosf(x)); },
+                                 [](float x, fast_math_tier_t tier) { return fast_math_atan2(sinf(x), cosf(x), tier); });
+
+    benchmark_fast_math_function("asin", -1.0f, 1.0f,
+                                 [](double x) { return asin(x); },
+                                 [](float x) { return asinf(x); },
+                                 [](float x, fast_math_tier_t tier) { return fast_math_asin(x, tier); });
+
+    benchmark_fast_math_function("acos", -1.0f, 1.0f,
+                                 [](double x) { return acos(x); },
+                                 [](float x) { return acosf(x); },
+                                 [](float x, fast_math_tier_t tier) { return fast_math_acos(x, tier); });
+
+    // Relative error for square root
+    benchmark_fast_math_function("sqrt", 0.01f, 100.0f,
+                                 [](double x) { return 1.0; },
+                                 [](float x) { return (float)(sqrtf(x) / sqrt((double)x)); },
+                                 [](float x, fast_math_tier_t tier) { return (float)(fast_math_sqrt(x, tier) / sqrt((double)x)); });
+}
+
+
+/**
+ * \brief   Benchmarks the cached local projection against coord_conventions
+ *
+ * \details The error is in meters, for points up to 50km from the origin
+ */
+static void benchmark_local_tangent_plane(void)
+{
+    const uint32_t n          = 1024;
+    const uint32_t iterations = 2000;
+    const global_position_t origin = {6.566044801857777, 46.51852236174565, 400.0f};
+
+    std::vector<float> dlat(n), dlon(n);
+    benchmark_fill(dlat, 12);
+    benchmark_fill(dlon, 13);
+
+    std::vector<global_position_t> global(n);
+    std::vector<local_position_t> local(n), reference(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        // +- 0.45 degrees is about +- 50km
+        global[i].latitude  = origin.latitude  + 0.45 * (double)dlat[i];
+        global[i].longitude = origin.longitude + 0.45 * (double)dlon[i];
+        global[i].altitude  = origin.altitude  + 100.0f * dlat[i];
+    }
+
+    Local_tangent_plane projection(origin);
+
+    // Global to local
+    float max_error = 0.0f;
+    projection.global_to_local(global.data(), local.data(), n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        coord_conventions_global_to_local_position(global[i], origin, reference[i]);
+        for (uint32_t j = 0; j < 3; ++j)
+        {
+            max_error = fmaxf(max_error, fabsf(reference[i][j] - local[i][j]));
+        }
+    }
+    benchmark_run("coord_conventions_global_to_local_position", iterations, n, 0.0f, [&]()
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            coord_conventions_global_to_local_position(global[i], origin, reference[i]);
+        }
+        benchmark_sink = reference[n - 1][0];
+    });
+    benchmark_run("local_tangent_plane_global_to_local", iterations, n, max_error, [&]()
+    {
+        projection.global_to_local(global.data(), local.data(), n);
+        benchmark_sink = local[n - 1][0];
+    });
+
+    // Local to global (error converted to meters)
+    std::vector<global_position_t> global_out(n), global_ref(n);
+    max_error = 0.0f;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        projection.local_to_global(reference[i], global_out[i]);
+        coord_conventions_local_to_global_position(reference[i], origin, global_ref[i]);
+        max_error = fmaxf(max_error, (float)(fabs(global_out[i].latitude  - global_ref[i].latitude)  * 111319.5));
+        max_error = fmaxf(max_error, (float)(fabs(global_out[i].longitude - global_ref[i].longitude) * 111319.5));
+    }
+    benchmark_run("coord_conventions_local_to_global_position", iterations, n, 0.0f, [&]()
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            coord_conventions_local_to_global_position(reference[i], origin, global_ref[i]);
+        }
+        benchmark_sink = global_ref[n - 1].altitude;
+    });
+    benchmark_run("local_tangent_plane_local_to_global", iterations, n, max_error, [&]()
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            projection.local_to_global(reference[i], global_out[i]);
+        }
+        benchmark_sink = global_out[n - 1].altitude;
+    });
+}
+
+
+/**
+ * \brief   Simulated quadcopter used to benchmark the flight-critical path
+ *
+ * \details Modules are wired as on the linux board, with dummy peripherals and
+ *          simulated sensors, so that each update runs on realistic inputs
+ */
+class Benchmark_vehicle
+{
+public:
+    Benchmark_vehicle(void):
+        servo_0(pwm_0, servo_default_config_esc()),
+        servo_1(pwm_1, servo_default_config_esc()),
+        servo_2(pwm_2, servo_default_config_esc()),
+        servo_3(pwm_3, servo_default_config_esc()),
+        dynamic_model(servo_0, servo_1, servo_2, servo_3),
+        sim(dynamic_model),
+        imu(sim.accelerometer(), sim.gyroscope(), sim.magnetometer()),
+        i2c({false}),
+        flow(i2c),
+        adc_battery(12.34f),
+        battery(adc_battery),
+        adc_airspeed(12.0f),
+        airspeed(adc_airspeed),
+        mavlink_stream(serial),
+        message_handler(mavlink_stream, Mavlink_message_handler::default_config()),
+        gps_mocap(message_handler),
+        state(mavlink_stream, battery),
+        ahrs_ekf(imu),
+        ahrs_madgwick(imu, airspeed),
+        ahrs_qfilter(imu),
+        ins_kf(state, sim.gps(), gps_mocap, sim.barometer(), sim.sonar(), flow, ahrs_ekf),
+        ins_complementary(state, sim.barometer(), sim.sonar(), sim.gps(), flow, ahrs_ekf),
+        flight_controller(ins_kf, ahrs_ekf, servo_0, servo_1, servo_2, servo_3, Flight_controller_quadcopter::default_config())
+    {}
+
+    Pwm_dummy                   pwm_0;
+    Pwm_dummy                   pwm_1;
+    Pwm_dummy                   pwm_2;
+    Pwm_dummy                   pwm_3;
+    Servo                       servo_0;
+    Servo                       servo_1;
+    Servo                       servo_2;
+    Servo                       servo_3;
+    Dynamic_model_quad_diag     dynamic_model;
+    Simulation                  sim;
+    Imu                         imu;
+    I2c_dummy                   i2c;
+    PX4Flow_i2c                 flow;
+    Adc_dummy                   adc_battery;
+    Battery                     battery;
+    Adc_dummy                   adc_airspeed;
+    Airspeed_analog             airspeed;
+    Serial_dummy                serial;
+    Mavlink_stream              mavlink_stream;
+    Mavlink_message_handler_T<10, 10> message_handler;
+    Gps_mocap                   gps_mocap;
+    State                       state;
+    AHRS_ekf                    ahrs_ekf;
+    AHRS_madgwick               ahrs_madgwick;
+    AHRS_qfilter                ahrs_qfilter;
+    INS_kf                      ins_kf;
+    INS_complementary           ins_complementary;
+    Flight_controller_quadcopter flight_controller;
+};
+
+
+/**
+ * \brief   Benchmarks one update of each module on the flight-critical path
+ *
+ * \details Sensors and estimators are run for 1000 updates before timing,
+ *          so that the benchmarks start from a converged state. Each update
+ *          runs in its own Cycle_clock cycle on a synthetic clock advanced by
+ *          BENCHMARK_DT_US, the cost of starting the cycle is included.
+ *          The flight controller is benchmarked in each command mode, from
+ *          the lowest (torque) to the highest (position) level of the cascade
+ */
+static void benchmark_flight_path(void)
+{
+    const uint32_t iterations = 20000;
+
+    Benchmark_vehicle* vehicle = new Benchmark_vehicle();
+    Benchmark_vehicle& v       = *vehicle;
+
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        v.sim.update();
+        v.imu.update();
+        v.ahrs_ekf.update();
+        v.ins_kf.update();
+    }
+
+    benchmark_run("imu_update", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        v.imu.update();
+        benchmark_sink = v.imu.gyro()[0];
+    });
+
+    benchmark_run("ahrs_ekf_update", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        v.ahrs_ekf.update();
+        benchmark_sink = v.ahrs_ekf.attitude().s;
+    });
+
+    benchmark_run("ahrs_madgwick_update", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        v.ahrs_madgwick.update();
+        benchmark_sink = v.ahrs_madgwick.attitude().s;
+    });
+
+    benchmark_run("ahrs_qfilter_update", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        v.ahrs_qfilter.update();
+        benchmark_sink = v.ahrs_qfilter.attitude().s;
+    });
+
+    benchmark_run("ins_kf_update", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        v.ins_kf.update();
+        benchmark_sink = v.ins_kf.position_lf()[0];
+    });
+
+    benchmark_run("ins_complementary_update", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        v.ins_complementary.update();
+        benchmark_sink = v.ins_complementary.position_lf()[0];
+    });
+
+    // Flight controller, one benchmark per command mode
+    Flight_controller_quadcopter& fc = v.flight_controller;
+    fc.set_command(thrust_command_t{{{0.0f, 0.0f, -0.5f}}});
+
+    fc.set_command(torque_command_t{{{0.01f, -0.02f, 0.03f}}});
+    benchmark_run("flight_controller_torque_mode", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        fc.update();
+        benchmark_sink = v.servo_0.read();
+    });
+
+    fc.set_command(rate_command_t{{{0.1f, -0.2f, 0.3f}}});
+    benchmark_run("flight_controller_rate_mode", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        fc.update();
+        benchmark_sink = v.servo_0.read();
+    });
+
+    fc.set_command(attitude_command_t(quaternions_normalise(quaternions_create(0.99f, 0.05f, -0.05f, 0.1f))));
+    benchmark_run("flight_controller_attitude_mode", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        fc.update();
+        benchmark_sink = v.servo_0.read();
+    });
+
+    fc.set_command(velocity_command_t{{{1.0f, -0.5f, 0.2f}}, 0.0f});
+    benchmark_run("flight_controller_velocity_mode", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        fc.update();
+        benchmark_sink = v.servo_0.read();
+    });
+
+    fc.set_command(position_command_t{{{10.0f, -5.0f, -2.0f}}, 0.0f});
+    benchmark_run("flight_controller_position_mode", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        fc.update();
+        benchmark_sink = v.servo_0.read();
+    });
+
+    // Servo mix alone
+    benchmark_run("servos_mix_matrix_update", iterations, 1, 0.0f, [&]()
+    {
+        Cycle_clock::Scope cycle(benchmark_tick());
+        fc.mix_ctrl_.update();
+        benchmark_sink = v.servo_0.read();
+    });
+
+    delete vehicle;
+}
+
+
+int main(int argc, char** argv)
+{
+    printf("name,iterations,elements,ns_per_call,ns_per_element,max_error\n");
+
+    benchmark_batch_kernels();
+    benchmark_fast_math();
+    benchmark_local_tangent_plane();
+    benchmark_flight_path();
+
+    return 0;
+}
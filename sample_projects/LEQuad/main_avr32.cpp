@@ -46,6 +46,7 @@
 // #include "hal/dummy/file_dummy.hpp"
 #include "hal/avr32/file_flash_avr32.hpp"
 #include "hal/avr32/serial_usb_avr32.hpp"
+#include "mission/mission_store_file.hpp"
 
 // //uncomment to go in simulation
 // #include "simulation/dynamic_model_quad_diag.hpp"
@@ -79,12 +80,13 @@ public:
             Battery& battery,
             File& file1,
             File& file2,
+            Mission_store& mission_store,
             Servo& servo_0,
             Servo& servo_1,
             Servo& servo_2,
             Servo& servo_3,
             const conf_t& config = default_config()):
-        LEQuad(imu, barometer, gps_dummy_, sonar, flow, serial_mavlink, satellite, state_display, file_flash, battery, file1, file2, servo_0, servo_1, servo_2, servo_3, config),
+        LEQuad(imu, barometer, gps_dummy_, sonar, flow, serial_mavlink, satellite, state_display, file_flash, battery, file1, file2, mission_store, servo_0, servo_1, servo_2, servo_3, config),
         serial_dummy_(),
         gps_dummy_(serial_dummy_),
         ins_no_gps_(state, barometer, sonar, gps_dummy_, flow, ahrs_, config.mav_config.ins_complementary_config)
@@ -172,6 +174,11 @@ int main(void)
     File_fat_fs file_log(true, &fat_fs_mounting); // boolean value = debug mode
     File_fat_fs file_stat(true, &fat_fs_mounting); // boolean value = debug mode
 
+    // Mission is stored on the SD card, the flash user page is used by the onboard parameters
+    File_fat_fs file_mission(true, &fat_fs_mounting); // boolean value = debug mode
+    file_mission.open("mission.bin");
+    Mission_store_file mission_store(file_mission);
+
     // -------------------------------------------------------------------------
     // Create MAV
     // -------------------------------------------------------------------------
@@ -190,6 +197,7 @@ int main(void)
                         board.battery,
                         file_log,
                         file_stat,
+                        mission_store,
                         board.servo_0,
                         board.servo_1,
                         board.servo_2,
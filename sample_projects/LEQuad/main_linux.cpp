@@ -44,6 +44,8 @@
 
 #include "hal/dummy/i2c_dummy.hpp"
 
+#include "mission/mission_store_file.hpp"
+
 #include "simulation/dynamic_model_telemetry.hpp"
 
 #include "util/print_util.hpp"
@@ -83,6 +85,11 @@ int main(int argc, char** argv)
     File_linux file_log;
     File_linux file_stat;
 
+    // Mission is stored in its own file, the flash file is used by the onboard parameters
+    File_linux file_mission;
+    file_mission.open((std::string("mission") + std::to_string(sysid) + std::string(".bin")).c_str());
+    Mission_store_file mission_store(file_mission);
+
     // Board initialisation
     init_success &= board.init();
 
@@ -110,6 +117,7 @@ int main(int argc, char** argv)
                         board.battery,
                         file_log,
                         file_stat,
+                        mission_store,
                         board.servo_0,
                         board.servo_1,
                         board.servo_2,
@@ -106,6 +106,8 @@ int main(int argc, char** argv)
     Serial_dummy        serial_dummy;
     I2c_dummy           i2c_dummy;
     File_dummy          file_dummy;
+    // No persistent File on this board yet (flash is File_dummy), mission is kept in RAM
+    Mission_store_T<100> mission_store;
     Gpio_dummy          gpio_dummy;
     Spektrum_satellite  satellite_dummy(serial_dummy, gpio_dummy, gpio_dummy);
     Adc_dummy           adc_dummy(11.1f);
@@ -148,6 +150,7 @@ int main(int argc, char** argv)
                         battery_dummy,
                         file_dummy,
                         file_dummy,
+                        mission_store,
                         board.servo_[0],
                         board.servo_[1],
                         board.servo_[2],
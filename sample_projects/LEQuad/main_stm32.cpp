@@ -66,6 +66,8 @@ int main(int argc, char** argv)
     // Dummy objects
     File_dummy dummy_file_log;
     File_dummy dummy_file_stat;
+    // No persistent File on this board yet (flash is File_dummy), mission is kept in RAM
+    Mission_store_T<100> mission_store;
     I2c_dummy  i2c_dummy;
     PX4Flow_i2c flow_dummy(i2c_dummy);
 
@@ -87,6 +89,7 @@ int main(int argc, char** argv)
                         board.battery,
                         dummy_file_log,
                         dummy_file_stat,
+                        mission_store,
                         board.servo_0,
                         board.servo_1,
                         board.servo_2,
@@ -96,6 +99,9 @@ int main(int argc, char** argv)
     // initialize MAV
     init_success &= mav.init();
 
+    // Complete and start the transfers of the devices sharing i2c_2
+    init_success &= mav.get_scheduler().add_task(1000, &I2c_queue::update_task, &board.i2c_2_queue, Scheduler_task::PRIORITY_HIGH);
+
     // -------------------------------------------------------------------------
     // Create simulation
     // -------------------------------------------------------------------------
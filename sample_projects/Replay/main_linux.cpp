@@ -0,0 +1,226 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file main_linux.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Runs the estimators on recorded sensor logs
+ *
+ * \details Usage: ReplayLI.elf log_1.bin [log_2.bin ...]
+ *
+ *          Each log is replayed as fast as possible through Imu, AHRS_ekf,
+ *          INS_kf and Altitude_estimation, starting from fresh estimators.
+ *          The estimated states are written after each gyroscope record in
+ *          <log>.csv:
+ *          time_s,qs,qx,qy,qz,roll,pitch,yaw,x,y,z,vx,vy,vz,altitude_gf,above_ground
+ *
+ *          One summary line per log is printed on stdout:
+ *          log,records,skipped,errors,log_duration_s,wall_time_s
+ *
+ *          See simulation/sensor_replay.hpp for the format of the logs
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+
+#include "communication/mavlink_message_handler.hpp"
+#include "communication/mavlink_stream.hpp"
+#include "drivers/battery.hpp"
+#include "drivers/gps_mocap.hpp"
+#include "hal/dummy/adc_dummy.hpp"
+#include "hal/dummy/serial_dummy.hpp"
+#include "hal/linux/file_linux.hpp"
+#include "runtime/cycle_clock.hpp"
+#include "sensing/ahrs_ekf.hpp"
+#include "sensing/altitude_estimation.hpp"
+#include "sensing/imu.hpp"
+#include "sensing/ins_kf.hpp"
+#include "simulation/sensor_replay.hpp"
+#include "status/state.hpp"
+#include "util/coord_conventions.hpp"
+
+
+/**
+ * \brief   Estimators fed by a sensor log
+ *
+ * \details Modules are wired as on the linux board, with dummy peripherals
+ *          for the modules that are not used by the estimators
+ */
+class Replay_vehicle
+{
+public:
+    Replay_vehicle(File& log):
+        replay(log),
+        imu(replay.accelerometer(), replay.gyroscope(), replay.magnetometer()),
+        adc_battery(12.34f),
+        battery(adc_battery),
+        mavlink_stream(serial),
+        message_handler(mavlink_stream, Mavlink_message_handler::default_config()),
+        gps_mocap(message_handler),
+        state(mavlink_stream, battery),
+        ahrs_ekf(imu),
+        ins_kf(state, replay.gps(), gps_mocap, replay.barometer(), replay.sonar(), replay.flow(), ahrs_ekf),
+        altitude({0.0f, 0.0f}),
+        altitude_estimation(replay.sonar(), replay.barometer(), ahrs_ekf, altitude)
+    {}
+
+    Sensor_replay               replay;
+    Imu                         imu;
+    Adc_dummy                   adc_battery;
+    Battery                     battery;
+    Serial_dummy                serial;
+    Mavlink_stream              mavlink_stream;
+    Mavlink_message_handler_T<10, 10> message_handler;
+    Gps_mocap                   gps_mocap;
+    State                       state;
+    AHRS_ekf                    ahrs_ekf;
+    INS_kf                      ins_kf;
+    altitude_t                  altitude;
+    Altitude_estimation         altitude_estimation;
+};
+
+
+/**
+ * \brief   Replays one log and writes the estimated states
+ *
+ * \param   log_path    Path to the sensor log
+ *
+ * \return  Success
+ */
+static bool replay_log(const char* log_path)
+{
+    File_linux log;
+    if ((log.exists(log_path) == 0) || (log.open(log_path) == false))
+    {
+        fprintf(stderr, "[REPLAY] Cannot open %s\n", log_path);
+        return false;
+    }
+
+    std::string output_path = std::string(log_path) + ".csv";
+    FILE* output = fopen(output_path.c_str(), "w");
+    if (output == NULL)
+    {
+        fprintf(stderr, "[REPLAY] Cannot create %s\n", output_path.c_str());
+        return false;
+    }
+
+    Replay_vehicle* vehicle = new Replay_vehicle(log);
+    Replay_vehicle& v       = *vehicle;
+
+    bool success = v.replay.init();
+    if (success == false)
+    {
+        fprintf(stderr, "[REPLAY] %s is not a sensor log\n", log_path);
+    }
+    success &= v.altitude_estimation.init();
+
+    fprintf(output, "time_s,qs,qx,qy,qz,roll,pitch,yaw,x,y,z,vx,vy,vz,altitude_gf,above_ground\n");
+
+    auto     t_start       = std::chrono::steady_clock::now();
+    uint64_t first_time_us = 0;
+    bool     first_record  = true;
+
+    while (success && v.replay.next())
+    {
+        if (first_record)
+        {
+            first_time_us = v.replay.time_us();
+            first_record  = false;
+        }
+
+        // The estimators are run at the rate of the gyroscope, other records only update the sensors
+        if (v.replay.type() != Sensor_replay::RECORD_GYROSCOPE)
+        {
+            continue;
+        }
+
+        Cycle_clock::Scope cycle_scope(v.replay.time_us());
+        v.imu.update();
+        v.ahrs_ekf.update();
+        v.ins_kf.update();
+        v.altitude_estimation.update();
+
+        quat_t               q        = v.ahrs_ekf.attitude();
+        aero_attitude_t      aero     = coord_conventions_quat_to_aero(q);
+        std::array<float, 3> position = v.ins_kf.position_lf();
+        std::array<float, 3> velocity = v.ins_kf.velocity_lf();
+        fprintf(output, "%.6f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f\n",
+                Cycle_clock::now_s(),
+                q.s, q.v[0], q.v[1], q.v[2],
+                aero.rpy[0], aero.rpy[1], aero.rpy[2],
+                position[0], position[1], position[2],
+                velocity[0], velocity[1], velocity[2],
+                v.ins_kf.absolute_altitude(),
+                v.altitude.above_ground);
+    }
+
+    auto t_end = std::chrono::steady_clock::now();
+
+    const Sensor_replay::stats_t& stats = v.replay.stats();
+    printf("%s,%lu,%lu,%lu,%.3f,%.3f\n",
+           log_path,
+           (unsigned long)stats.records,
+           (unsigned long)stats.skipped,
+           (unsigned long)stats.errors,
+           (double)(v.replay.time_us() - first_time_us) / 1000000.0,
+           std::chrono::duration<double>(t_end - t_start).count());
+
+    fclose(output);
+    log.close();
+    delete vehicle;
+
+    return success;
+}
+
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s log_1.bin [log_2.bin ...]\n", argv[0]);
+        return 1;
+    }
+
+    bool success = true;
+
+    printf("log,records,skipped,errors,log_duration_s,wall_time_s\n");
+    for (int i = 1; i < argc; ++i)
+    {
+        success &= replay_log(argv[i]);
+    }
+
+    return success ? 0 : 1;
+}
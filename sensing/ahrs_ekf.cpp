@@ -48,7 +48,7 @@
  ******************************************************************************/
 
 #include "sensing/ahrs_ekf.hpp"
-#include "hal/common/time_keeper.hpp"
+#include "runtime/cycle_clock.hpp"
 #include "util/coord_conventions.hpp"
 #include "util/constants.hpp"
 #include "util/print_util.hpp"
@@ -89,7 +89,7 @@ bool AHRS_ekf::update(void)
     bool task_return = true;
 
     // Update time in us
-    float now_s    = time_keeper_get_s();
+    float now_s    = Cycle_clock::now_s();
 
     // Delta t in seconds
     dt_s_          = now_s - last_update_s_;
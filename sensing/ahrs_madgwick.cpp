@@ -50,7 +50,7 @@
  ******************************************************************************/
 
 #include "sensing/ahrs_madgwick.hpp"
-#include "hal/common/time_keeper.hpp"
+#include "runtime/cycle_clock.hpp"
 #include "util/constants.hpp"
 #include "util/print_util.hpp"
 
@@ -93,7 +93,7 @@ AHRS_madgwick::AHRS_madgwick(const Imu& imu, const Airspeed_analog& airspeed, co
 bool AHRS_madgwick::update(void)
 {
     // Compute time
-    float t = time_keeper_get_s();
+    float t = Cycle_clock::now_s();
     float dt_s = (float)(t - last_update_s_);
 
     std::array<float, 3> acc  = imu_.acc();
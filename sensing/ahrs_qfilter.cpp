@@ -40,7 +40,7 @@
  ******************************************************************************/
 
 
-#include "hal/common/time_keeper.hpp"
+#include "runtime/cycle_clock.hpp"
 #include "sensing/ahrs_qfilter.hpp"
 #include "util/coord_conventions.hpp"
 #include "util/constants.hpp"
@@ -88,7 +88,7 @@ bool AHRS_qfilter::update(void)
     float ki_mag = ki_mag_;
 
     // Update time in us
-    float now_s    = time_keeper_get_s();
+    float now_s    = Cycle_clock::now_s();
 
     // Delta t in seconds
     float dt_s     = (float)(now_s - last_update_s_);
@@ -169,7 +169,7 @@ bool AHRS_qfilter::update(void)
     switch (internal_state_)
     {
         case AHRS_INITIALISING:
-            time_s_ = time_keeper_get_s();
+            time_s_ = Cycle_clock::now_s();
             internal_state_ = AHRS_LEVELING;
         case AHRS_LEVELING:
             kp = kp_ * 10.0f;
@@ -178,9 +178,9 @@ bool AHRS_qfilter::update(void)
             ki = 0.0f * ki_;
             ki_mag = 0.0f * ki_mag_;
 
-            if ((time_keeper_get_s() - time_s_) > 8.0f)
+            if ((Cycle_clock::now_s() - time_s_) > 8.0f)
             {
-                time_s_ = time_keeper_get_s();
+                time_s_ = Cycle_clock::now_s();
                 internal_state_ = AHRS_CONVERGING;
                 print_util_dbg_print("End of AHRS attitude initialization.\r\n");
             }
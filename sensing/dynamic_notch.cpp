@@ -0,0 +1,378 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file dynamic_notch.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Tracks the frequency of motor vibrations and tunes the gyroscope
+ *          notch filters of the IMU
+ *
+ ******************************************************************************/
+
+
+#include "sensing/dynamic_notch.hpp"
+
+extern "C"
+{
+#include <math.h>
+#include "util/maths.h"
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Dynamic_notch::Dynamic_notch(Imu& imu, const conf_t& config):
+    imu_(imu),
+    config_(config),
+    motor_count_(0),
+    sample_index_(0),
+    sample_count_(0),
+    last_sample_us_(0.0f),
+    sample_rate_hz_(0.0f),
+    fft_step_(FFT_LOAD),
+    fft_axis_(0),
+    fft_stage_(0),
+    frequency_(0.0f),
+    applied_frequency_(0.0f)
+{
+    for (uint32_t i = 0; i < FFT_SIZE; ++i)
+    {
+        window_[i] = 0.5f - 0.5f * cosf(2.0f * PI * (float)i / (float)(FFT_SIZE - 1));
+    }
+
+    for (uint32_t i = 0; i < FFT_SIZE / 2; ++i)
+    {
+        twiddle_re_[i] = cosf(2.0f * PI * (float)i / (float)FFT_SIZE);
+        twiddle_im_[i] = -sinf(2.0f * PI * (float)i / (float)FFT_SIZE);
+        power_[i]      = 0.0f;
+    }
+}
+
+
+bool Dynamic_notch::add_motor(const Servo& motor)
+{
+    if (motor_count_ >= MAX_MOTORS)
+    {
+        return false;
+    }
+
+    motors_[motor_count_] = &motor;
+    motor_count_ += 1;
+
+    return true;
+}
+
+
+bool Dynamic_notch::update(void)
+{
+    float frequency = 0.0f;
+
+    switch (config_.mode)
+    {
+        case MODE_MOTORS:
+            if (motor_frequency(frequency))
+            {
+                set_frequency(frequency);
+            }
+        break;
+
+        case MODE_FFT:
+            add_sample();
+            if (fft_step(frequency))
+            {
+                set_frequency(frequency);
+            }
+        break;
+
+        case MODE_DISABLED:
+        default:
+        break;
+    }
+
+    return true;
+}
+
+
+bool Dynamic_notch::update_task(Dynamic_notch* notch)
+{
+    return notch->update();
+}
+
+
+float Dynamic_notch::frequency(void) const
+{
+    return frequency_;
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+void Dynamic_notch::add_sample(void)
+{
+    // Only one batch of samples per IMU update
+    if (imu_.last_update_us() == last_sample_us_)
+    {
+        return;
+    }
+    last_sample_us_ = imu_.last_update_us();
+
+    float gyro[3];
+    uint32_t count = imu_.gyro_sample_count();
+    for (uint32_t k = 0; k < count; ++k)
+    {
+        if (!imu_.gyro_sample(k, gyro))
+        {
+            break;
+        }
+
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            samples_[axis][sample_index_] = gyro[axis];
+        }
+
+        sample_index_ = (sample_index_ + 1) % FFT_SIZE;
+        if (sample_count_ < FFT_SIZE)
+        {
+            sample_count_ += 1;
+        }
+    }
+}
+
+
+bool Dynamic_notch::fft_step(float& frequency)
+{
+    bool found = false;
+
+    switch (fft_step_)
+    {
+        case FFT_LOAD:
+        {
+            if (sample_count_ < FFT_SIZE)
+            {
+                break;
+            }
+
+            // Same rate as the notch filters, so that measured and filtered frequencies match
+            if (fft_axis_ == 0)
+            {
+                sample_rate_hz_ = imu_.sample_rate_hz();
+                if (sample_rate_hz_ <= 0.0f)
+                {
+                    break;
+                }
+            }
+
+            // Oldest sample is at sample_index_
+
+            // Windowed copy, in bit-reversed order
+            for (uint32_t i = 0; i < FFT_SIZE; ++i)
+            {
+                uint32_t rev = 0;
+                for (uint32_t b = 0; b < FFT_STAGES; ++b)
+                {
+                    rev |= ((i >> b) & 1) << (FFT_STAGES - 1 - b);
+                }
+                work_re_[rev] = window_[i] * samples_[fft_axis_][(sample_index_ + i) % FFT_SIZE];
+                work_im_[rev] = 0.0f;
+            }
+
+            fft_stage_ = 0;
+            fft_step_  = FFT_BUTTERFLY;
+        }
+        break;
+
+        case FFT_BUTTERFLY:
+        {
+            uint32_t half = 1 << fft_stage_;
+            uint32_t step = FFT_SIZE / (2 * half);
+            for (uint32_t start = 0; start < FFT_SIZE; start += 2 * half)
+            {
+                for (uint32_t k = 0; k < half; ++k)
+                {
+                    uint32_t i  = start + k;
+                    uint32_t j  = i + half;
+                    float    wr = twiddle_re_[k * step];
+                    float    wi = twiddle_im_[k * step];
+                    float    tr = wr * work_re_[j] - wi * work_im_[j];
+                    float    ti = wr * work_im_[j] + wi * work_re_[j];
+                    work_re_[j] = work_re_[i] - tr;
+                    work_im_[j] = work_im_[i] - ti;
+                    work_re_[i] += tr;
+                    work_im_[i] += ti;
+                }
+            }
+
+            fft_stage_ += 1;
+            if (fft_stage_ >= FFT_STAGES)
+            {
+                fft_step_ = FFT_ACCUMULATE;
+            }
+        }
+        break;
+
+        case FFT_ACCUMULATE:
+        {
+            for (uint32_t k = 1; k < FFT_SIZE / 2; ++k)
+            {
+                power_[k] += work_re_[k] * work_re_[k] + work_im_[k] * work_im_[k];
+            }
+
+            fft_axis_ += 1;
+            if (fft_axis_ >= 3)
+            {
+                fft_axis_ = 0;
+                fft_step_ = FFT_PEAK;
+            }
+            else
+            {
+                fft_step_ = FFT_LOAD;
+            }
+        }
+        break;
+
+        case FFT_PEAK:
+        {
+            float resolution = sample_rate_hz_ / (float)FFT_SIZE;
+            int32_t k_min = (int32_t)ceilf(config_.min_hz / resolution);
+            int32_t k_max = (int32_t)(config_.max_hz / resolution);
+
+            // Keep one bin on each side of the peak for interpolation
+            if (k_min < 1)
+            {
+                k_min = 1;
+            }
+            if (k_max > (int32_t)(FFT_SIZE / 2 - 2))
+            {
+                k_max = FFT_SIZE / 2 - 2;
+            }
+
+            int32_t k_peak = k_min;
+            float   sum    = 0.0f;
+            for (int32_t k = k_min; k <= k_max; ++k)
+            {
+                sum += power_[k];
+                if (power_[k] > power_[k_peak])
+                {
+                    k_peak = k;
+                }
+            }
+
+            if ((k_max > k_min) && (power_[k_peak] * (float)(k_max - k_min + 1) > config_.min_peak_ratio * sum))
+            {
+                // Parabolic interpolation on magnitudes
+                float left   = maths_fast_sqrt(power_[k_peak - 1]);
+                float center = maths_fast_sqrt(power_[k_peak]);
+                float right  = maths_fast_sqrt(power_[k_peak + 1]);
+                float denom  = left - 2.0f * center + right;
+                float offset = 0.0f;
+                if (denom < 0.0f)
+                {
+                    offset = maths_f_max(-0.5f, maths_f_min(0.5f, 0.5f * (left - right) / denom));
+                }
+
+                frequency = ((float)k_peak + offset) * resolution;
+                found     = true;
+            }
+
+            for (uint32_t k = 0; k < FFT_SIZE / 2; ++k)
+            {
+                power_[k] = 0.0f;
+            }
+
+            fft_step_ = FFT_LOAD;
+        }
+        break;
+    }
+
+    return found;
+}
+
+
+bool Dynamic_notch::motor_frequency(float& frequency) const
+{
+    if (motor_count_ == 0)
+    {
+        return false;
+    }
+
+    float mean = 0.0f;
+    for (uint32_t i = 0; i < motor_count_; ++i)
+    {
+        mean += motors_[i]->read();
+    }
+    mean /= (float)motor_count_;
+
+    // Linear between min and max command
+    frequency = config_.motor_min_hz + 0.5f * (mean + 1.0f) * (config_.motor_max_hz - config_.motor_min_hz);
+
+    return true;
+}
+
+
+void Dynamic_notch::set_frequency(float frequency)
+{
+    // Notch filters must stay below half the sample rate of the IMU
+    float max_hz = maths_f_min(config_.max_hz, MAX_NYQUIST_RATIO * 0.5f * imu_.sample_rate_hz());
+    frequency = maths_f_max(config_.min_hz, maths_f_min(max_hz, frequency));
+
+    if (frequency_ == 0.0f)
+    {
+        frequency_ = frequency;
+    }
+    else
+    {
+        frequency_ += config_.lpf_frequency * (frequency - frequency_);
+    }
+
+    // Recompute coefficients only on significant change
+    if (maths_f_abs(frequency_ - applied_frequency_) < config_.update_threshold_hz)
+    {
+        return;
+    }
+    applied_frequency_ = frequency_;
+
+    imu_.set_gyro_notch(0, frequency_);
+    if (config_.harmonic > 0.0f)
+    {
+        float harmonic_hz = config_.harmonic * frequency_;
+        if (harmonic_hz > MAX_NYQUIST_RATIO * 0.5f * imu_.sample_rate_hz())
+        {
+            harmonic_hz = 0.0f;
+        }
+        imu_.set_gyro_notch(1, harmonic_hz);
+    }
+}
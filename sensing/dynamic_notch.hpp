@@ -0,0 +1,237 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file dynamic_notch.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Tracks the frequency of motor vibrations and tunes the gyroscope
+ *          notch filters of the IMU
+ *
+ * \details The noise frequency is either derived from motor commands, or
+ *          measured by a small FFT of unfiltered gyroscope samples, taken at
+ *          the sensor rate when the IMU reads a FIFO. The FFT is computed one step per update (loading one axis, one butterfly
+ *          stage, accumulation, or peak search), so the CPU time per update is
+ *          bounded whatever the mode.
+ *
+ ******************************************************************************/
+
+
+#ifndef DYNAMIC_NOTCH_HPP_
+#define DYNAMIC_NOTCH_HPP_
+
+#include <cstdint>
+#include <cstdbool>
+
+#include "drivers/servo.hpp"
+#include "sensing/imu.hpp"
+
+
+/**
+ * \brief   Dynamic notch filter tuning
+ *
+ * \details The first notch of the IMU is placed on the noise frequency, the
+ *          second one on a harmonic. Must be updated after each IMU update,
+ *          each IMU update brings all its gyroscope samples to the FFT.
+ *          Notch frequencies are limited to MAX_NYQUIST_RATIO times half the
+ *          IMU sample rate, the harmonic notch is disabled above this limit.
+ */
+class Dynamic_notch
+{
+public:
+    static const uint32_t MAX_MOTORS   = 8;     ///< Maximum number of motors used to estimate noise frequency
+    static const uint32_t FFT_SIZE     = 64;    ///< Number of samples per FFT
+    static const uint32_t FFT_STAGES   = 6;     ///< log2(FFT_SIZE)
+    static constexpr float MAX_NYQUIST_RATIO = 0.8f;  ///< Highest notch frequency, relative to half the IMU sample rate
+
+    /**
+     * \brief   Source of the noise frequency
+     */
+    enum mode_t
+    {
+        MODE_DISABLED   = 0,    ///< Notch filters left untouched
+        MODE_MOTORS     = 1,    ///< Frequency derived from motor commands
+        MODE_FFT        = 2,    ///< Frequency measured on gyroscope spectrum
+    };
+
+    /**
+     * \brief   Configuration
+     */
+    struct conf_t
+    {
+        mode_t  mode;                   ///< Source of the noise frequency
+        float   min_hz;                 ///< Lowest notch frequency
+        float   max_hz;                 ///< Highest notch frequency, also limited by the IMU sample rate
+        float   motor_min_hz;           ///< Noise frequency at minimum motor command (-1)
+        float   motor_max_hz;           ///< Noise frequency at maximum motor command (+1)
+        float   harmonic;               ///< Ratio between second and first notch frequencies, 0 to leave second notch untouched.
+                                        ///< The second notch is disabled when the harmonic is above the sample rate limit
+        float   min_peak_ratio;         ///< FFT: minimum ratio between peak and mean power in the band to accept a peak
+        float   lpf_frequency;          ///< Low pass filter gain on the tracked frequency
+        float   update_threshold_hz;    ///< Minimum change of frequency before filter coefficients are recomputed
+    };
+
+    /**
+     * \brief   Default configuration
+     *
+     * \return  Config structure
+     */
+    static inline conf_t default_config(void);
+
+    /**
+     * \brief   Constructor
+     *
+     * \param   imu     IMU whose gyroscope notch filters are tuned
+     * \param   config  Configuration
+     */
+    Dynamic_notch(Imu& imu, const conf_t& config = default_config());
+
+    /**
+     * \brief   Registers a motor used in MODE_MOTORS
+     *
+     * \param   motor   Servo driving the motor
+     *
+     * \return  false if there is no space left
+     */
+    bool add_motor(const Servo& motor);
+
+    /**
+     * \brief   Main update function, to call after each IMU update
+     *
+     * \return  success
+     */
+    bool update(void);
+
+    /**
+     * \brief   Task function
+     *
+     * \param   notch   Pointer to object
+     *
+     * \return  success
+     */
+    static bool update_task(Dynamic_notch* notch);
+
+    /**
+     * \brief   Current noise frequency
+     *
+     * \return  frequency in Hz
+     */
+    float frequency(void) const;
+
+private:
+    /**
+     * \brief   Steps of the FFT analysis, one is done per update
+     */
+    enum fft_step_t
+    {
+        FFT_LOAD,           ///< Windowed, bit-reversed copy of the latest samples of one axis
+        FFT_BUTTERFLY,      ///< One butterfly stage
+        FFT_ACCUMULATE,     ///< Adds power spectrum of one axis
+        FFT_PEAK,           ///< Looks for the peak in the accumulated spectrum
+    };
+
+    /**
+     * \brief   Stores the gyroscope samples of the latest IMU update
+     */
+    void add_sample(void);
+
+    /**
+     * \brief   Performs one step of the FFT analysis
+     *
+     * \param   frequency   Measured frequency, set if a peak was found
+     *
+     * \return  true if a peak was found
+     */
+    bool fft_step(float& frequency);
+
+    /**
+     * \brief   Estimates noise frequency from motor commands
+     *
+     * \param   frequency   Estimated frequency
+     *
+     * \return  false if no motor is registered
+     */
+    bool motor_frequency(float& frequency) const;
+
+    /**
+     * \brief   Filters frequency and updates IMU notch filters if needed
+     *
+     * \param   frequency   New frequency
+     */
+    void set_frequency(float frequency);
+
+    Imu&            imu_;                           ///< IMU
+    conf_t          config_;                        ///< Configuration
+
+    const Servo*    motors_[MAX_MOTORS];            ///< Motors
+    uint32_t        motor_count_;                   ///< Number of motors
+
+    float           samples_[3][FFT_SIZE];          ///< Ring buffer of unfiltered gyroscope samples
+    uint32_t        sample_index_;                  ///< Index of next sample
+    uint32_t        sample_count_;                  ///< Number of samples stored, up to FFT_SIZE
+    float           last_sample_us_;                ///< IMU update time of the last sample
+
+    float           window_[FFT_SIZE];              ///< Hann window
+    float           twiddle_re_[FFT_SIZE / 2];      ///< FFT twiddle factors, real part
+    float           twiddle_im_[FFT_SIZE / 2];      ///< FFT twiddle factors, imaginary part
+    float           work_re_[FFT_SIZE];             ///< FFT work buffer, real part
+    float           work_im_[FFT_SIZE];             ///< FFT work buffer, imaginary part
+    float           power_[FFT_SIZE / 2];           ///< Power spectrum accumulated over axes
+    float           sample_rate_hz_;                ///< Sample rate of the loaded window
+
+    fft_step_t      fft_step_;                      ///< Next FFT step
+    uint32_t        fft_axis_;                      ///< Axis being analysed
+    uint32_t        fft_stage_;                     ///< Next butterfly stage
+
+    float           frequency_;                     ///< Filtered noise frequency
+    float           applied_frequency_;             ///< Frequency of the IMU notch filters
+};
+
+
+Dynamic_notch::conf_t Dynamic_notch::default_config(void)
+{
+    conf_t conf = {};
+
+    conf.mode                   = MODE_DISABLED;
+    conf.min_hz                 = 40.0f;
+    conf.max_hz                 = 400.0f;
+    conf.motor_min_hz           = 30.0f;
+    conf.motor_max_hz           = 150.0f;
+    conf.harmonic               = 2.0f;
+    conf.min_peak_ratio         = 4.0f;
+    conf.lpf_frequency          = 0.3f;
+    conf.update_threshold_hz    = 0.5f;
+
+    return conf;
+}
+
+#endif /* DYNAMIC_NOTCH_HPP_ */
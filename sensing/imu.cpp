@@ -43,32 +43,73 @@
 
 
 #include "sensing/imu.hpp"
-#include "hal/common/time_keeper.hpp"
+#include "runtime/cycle_clock.hpp"
 #include "util/constants.hpp"
 #include "util/print_util.hpp"
 #include "util/quick_trig.hpp"
 
+extern "C"
+{
+#include "util/maths.h"
+#include "util/vectors.h"
+}
+
 
 Imu::Imu(Accelerometer& accelerometer, Gyroscope& gyroscope, Magnetometer& magnetometer, imu_conf_t config):
     accelerometer_(accelerometer),
     gyroscope_(gyroscope),
     magnetometer_(magnetometer),
+    fifo_(NULL),
     config_(config),
-    oriented_acc_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
-    oriented_gyro_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
-    oriented_mag_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
+    acc_calibration_(config_.accelerometer.axis,
+                     config_.accelerometer.sign,
+                     config_.accelerometer.scale_factor,
+                     config_.accelerometer.misalignment,
+                     config_.accelerometer.bias),
+    gyro_calibration_(config_.gyroscope.axis,
+                      config_.gyroscope.sign,
+                      config_.gyroscope.scale_factor,
+                      config_.gyroscope.misalignment,
+                      config_.gyroscope.bias),
+    mag_calibration_(config_.magnetometer.axis,
+                     config_.magnetometer.sign,
+                     config_.magnetometer.scale_factor,
+                     config_.magnetometer.misalignment,
+                     config_.magnetometer.bias),
+    acc_lowpass_(config_.lpf_acc),
+    gyro_lowpass_(config_.lpf_gyro),
+    sample_rate_hz_(0.0f),
     scaled_acc_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
     scaled_gyro_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
     scaled_mag_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
+    unfiltered_gyro_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
+    delta_angle_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
+    delta_velocity_(std::array<float,3>{{0.0f, 0.0f, 0.0f}}),
+    delta_dt_s_(0.0f),
     do_startup_calibration_(true),
     do_accelerometer_bias_calibration_(false),
     do_gyroscope_bias_calibration_(false),
     do_magnetometer_bias_calibration_(false),
     do_magnetic_north_calibration_(false),
-    dt_s_(0.004f),
+    dt_s_(1.0f / config.filter_rate_hz),
     last_update_us_(0.0f),
     startup_calibration_start_time_(0.0f)
-{}
+{
+    // Precompute filter coefficients, filters with null frequency stay disabled
+    set_sample_rate(config_.filter_rate_hz);
+
+    mag_filters_.first() = Imu_lowpass(config_.lpf_mag);
+}
+
+
+Imu::Imu(Accelerometer& accelerometer, Gyroscope& gyroscope, Magnetometer& magnetometer, const Inertial_fifo& fifo, imu_conf_t config):
+    Imu(accelerometer, gyroscope, magnetometer, config)
+{
+    fifo_ = &fifo;
+
+    // Filters run on FIFO samples, the rate may change once the sensor is configured
+    set_sample_rate(1.0f / fifo_->fifo_sample_period_s());
+}
 
 
 bool Imu::update(void)
@@ -76,7 +117,7 @@ bool Imu::update(void)
     bool success = true;
 
     // Update timing
-    uint32_t t      = time_keeper_get_us();
+    uint32_t t      = Cycle_clock::now_us();
     dt_s_           = (float)(t - last_update_us_) / 1000000.0f;
     last_update_us_ = t;
 
@@ -90,33 +131,55 @@ bool Imu::update(void)
     std::array<float, 3> raw_gyro = gyroscope_.gyro();
     std::array<float, 3> raw_mag  = magnetometer_.mag();
 
-    // Rotate sensor values
-    for (uint8_t i = 0; i < 3; i++)
-    {
-        oriented_acc_[i]  = raw_acc[  config_.accelerometer.axis[i] ] * config_.accelerometer.sign[i];
-        oriented_gyro_[i] = raw_gyro[ config_.gyroscope.axis[i]     ] * config_.gyroscope.sign[i];
-        oriented_mag_[i]  = raw_mag[  config_.magnetometer.axis[i]  ] * config_.magnetometer.sign[i];
-    }
-
-    // Scale sensor values
+    // Rotate, scale, then remove bias
     float new_scaled_acc[3];
     float new_scaled_gyro[3];
     float new_scaled_mag[3];
+    acc_calibration_.apply(raw_acc, new_scaled_acc);
+    gyro_calibration_.apply(raw_gyro, new_scaled_gyro);
+    mag_calibration_.apply(raw_mag, new_scaled_mag);
+
+    // Integrate and filter high rate samples, or the latest sample if there is none
+    if ((fifo_ != NULL) && (fifo_->fifo_sample_count() > 0))
+    {
+        float sample_hz = 1.0f / fifo_->fifo_sample_period_s();
+        if (maths_f_abs(sample_hz - sample_rate_hz_) > 0.01f * sample_rate_hz_)
+        {
+            set_sample_rate(sample_hz);
+        }
+
+        integrate_fifo(new_scaled_acc, new_scaled_gyro);
+    }
+    else
+    {
+        for (int8_t i = 0; i < 3; i++)
+        {
+            delta_angle_[i]     = new_scaled_gyro[i] * dt_s_;
+            delta_velocity_[i]  = new_scaled_acc[i]  * dt_s_;
+            unfiltered_gyro_[i] = new_scaled_gyro[i];
+        }
+        delta_dt_s_ = dt_s_;
+
+        acc_filters_.apply(new_scaled_acc);
+        gyro_filters_.apply(new_scaled_gyro);
+    }
+
+    // Filter at update rate
+    acc_lowpass_.apply(new_scaled_acc);
+    gyro_lowpass_.apply(new_scaled_gyro);
+    mag_filters_.apply(new_scaled_mag);
     for (int8_t i = 0; i < 3; i++)
     {
-        // Scale, then remove bias
-        new_scaled_acc[i]  = oriented_acc_[i]  / config_.accelerometer.scale_factor[i] - config_.accelerometer.bias[i];
-        new_scaled_gyro[i] = oriented_gyro_[i] / config_.gyroscope.scale_factor[i]     - config_.gyroscope.bias[i];
-        new_scaled_mag[i]  = oriented_mag_[i]  / config_.magnetometer.scale_factor[i]  - config_.magnetometer.bias[i];
-
-        // Low pass filter
-        scaled_acc_[i]  = config_.lpf_acc   * new_scaled_acc[i]  + (1.0f - config_.lpf_acc) * scaled_acc_[i];
-        scaled_gyro_[i] = config_.lpf_gyro  * new_scaled_gyro[i] + (1.0f - config_.lpf_gyro) * scaled_gyro_[i];
-        scaled_mag_[i]  = config_.lpf_mag   * new_scaled_mag[i]  + (1.0f - config_.lpf_mag) * scaled_mag_[i];
+        scaled_acc_[i]  = new_scaled_acc[i];
+        scaled_gyro_[i] = new_scaled_gyro[i];
+        scaled_mag_[i]  = new_scaled_mag[i];
     }
 
     // Perform calibration of sensors
-    do_calibration();
+    if (is_calibration_ongoing())
+    {
+        do_calibration();
+    }
 
     return success;
 }
@@ -152,6 +215,99 @@ const std::array<float, 3>& Imu::mag(void) const
 }
 
 
+const std::array<float, 3>& Imu::gyro_unfiltered(void) const
+{
+    return unfiltered_gyro_;
+}
+
+
+uint32_t Imu::gyro_sample_count(void) const
+{
+    if ((fifo_ != NULL) && (fifo_->fifo_sample_count() > 0))
+    {
+        return fifo_->fifo_sample_count();
+    }
+    return 1;
+}
+
+
+bool Imu::gyro_sample(uint32_t index, float gyro[3]) const
+{
+    if ((fifo_ != NULL) && (fifo_->fifo_sample_count() > 0))
+    {
+        std::array<float, 3> raw_acc;
+        std::array<float, 3> raw_gyro;
+        if (!fifo_->fifo_sample(index, raw_acc, raw_gyro))
+        {
+            return false;
+        }
+        gyro_calibration_.apply(raw_gyro, gyro);
+        return true;
+    }
+
+    if (index != 0)
+    {
+        return false;
+    }
+    for (int8_t i = 0; i < 3; i++)
+    {
+        gyro[i] = unfiltered_gyro_[i];
+    }
+    return true;
+}
+
+
+float Imu::sample_rate_hz(void) const
+{
+    return sample_rate_hz_;
+}
+
+
+bool Imu::set_gyro_notch(uint8_t index, float center_hz)
+{
+    if (index >= config_.gyro_notch.size())
+    {
+        return false;
+    }
+
+    // Kept in configuration, so that the notch follows sample rate changes
+    config_.gyro_notch[index].center_hz = center_hz;
+
+    bool success = false;
+    switch (index)
+    {
+        case 0:
+            success = gyro_filters_.first().set_notch(center_hz, sample_rate_hz_, config_.gyro_notch[0].q);
+        break;
+
+        case 1:
+            success = gyro_filters_.rest().first().set_notch(center_hz, sample_rate_hz_, config_.gyro_notch[1].q);
+        break;
+    }
+
+    // A null frequency only disables the filter
+    return success || (center_hz == 0.0f);
+}
+
+
+const std::array<float, 3>& Imu::delta_angle(void) const
+{
+    return delta_angle_;
+}
+
+
+const std::array<float, 3>& Imu::delta_velocity(void) const
+{
+    return delta_velocity_;
+}
+
+
+const float& Imu::delta_dt_s(void) const
+{
+    return delta_dt_s_;
+}
+
+
 const std::array<float, 3>& Imu::magnetic_north(void) const
 {
     return config_.magnetic_north;
@@ -361,7 +517,7 @@ void Imu::do_calibration(void)
          if (do_gyroscope_bias_calibration_ == false)
          {
              start_gyroscope_bias_calibration();
-             startup_calibration_start_time_ = time_keeper_get_s();
+             startup_calibration_start_time_ = Cycle_clock::now_s();
          }
 
          // Check if the gyroscope values are stable
@@ -372,11 +528,11 @@ void Imu::do_calibration(void)
          if (gyro_is_stable == false)
          {
              // Reset timestamp
-             startup_calibration_start_time_ = time_keeper_get_s();
+             startup_calibration_start_time_ = Cycle_clock::now_s();
          }
 
          // If gyros have been stable for long enough
-         if ((gyro_is_stable == true) && ((time_keeper_get_s() - startup_calibration_start_time_) > config_.startup_calib_duration_s))
+         if ((gyro_is_stable == true) && ((Cycle_clock::now_s() - startup_calibration_start_time_) > config_.startup_calib_duration_s))
          {
              // Startup calibration is done
              print_util_dbg_print("[IMU] Startup calib ok\n");
@@ -434,3 +590,124 @@ void Imu::do_calibration(void)
 
     }
 }
+
+
+void Imu::integrate_fifo(float mean_acc[3], float mean_gyro[3])
+{
+    uint32_t count  = fifo_->fifo_sample_count();
+    float    period = fifo_->fifo_sample_period_s();
+
+    float alpha[3]          = {0.0f, 0.0f, 0.0f};   // Integrated angle
+    float velocity[3]       = {0.0f, 0.0f, 0.0f};   // Integrated velocity
+    float coning[3]         = {0.0f, 0.0f, 0.0f};   // Coning correction
+    float sculling[3]       = {0.0f, 0.0f, 0.0f};   // Sculling correction
+    float last_d_alpha[3]   = {0.0f, 0.0f, 0.0f};
+    float last_d_velocity[3]= {0.0f, 0.0f, 0.0f};
+    float sum_acc[3]        = {0.0f, 0.0f, 0.0f};   // Sum of filtered samples
+    float sum_gyro[3]       = {0.0f, 0.0f, 0.0f};
+
+    std::array<float, 3> raw_acc;
+    std::array<float, 3> raw_gyro;
+
+    for (uint32_t k = 0; k < count; k++)
+    {
+        fifo_->fifo_sample(k, raw_acc, raw_gyro);
+
+        float acc[3];
+        float gyro[3];
+        acc_calibration_.apply(raw_acc, acc);
+        gyro_calibration_.apply(raw_gyro, gyro);
+
+        float d_alpha[3];
+        float d_velocity[3];
+        float a[3];
+        float v[3];
+        for (int8_t i = 0; i < 3; i++)
+        {
+            d_alpha[i]    = gyro[i] * period;
+            d_velocity[i] = acc[i]  * period;
+
+            // Second order estimate of the previous sample, as in Savage's algorithms
+            a[i] = alpha[i]    + last_d_alpha[i]    / 6.0f;
+            v[i] = velocity[i] + last_d_velocity[i] / 6.0f;
+        }
+
+        // Coning: 0.5 * a x d_alpha
+        // Sculling: 0.5 * (a x d_velocity + v x d_alpha)
+        float c[3];
+        float s1[3];
+        float s2[3];
+        vectors_cross_product(a, d_alpha, c);
+        vectors_cross_product(a, d_velocity, s1);
+        vectors_cross_product(v, d_alpha, s2);
+
+        for (int8_t i = 0; i < 3; i++)
+        {
+            coning[i]   += 0.5f * c[i];
+            sculling[i] += 0.5f * (s1[i] + s2[i]);
+
+            alpha[i]    += d_alpha[i];
+            velocity[i] += d_velocity[i];
+
+            last_d_alpha[i]    = d_alpha[i];
+            last_d_velocity[i] = d_velocity[i];
+        }
+
+        // Notch and low pass filters run at sensor rate, integration uses raw samples
+        acc_filters_.apply(acc);
+        gyro_filters_.apply(gyro);
+        for (int8_t i = 0; i < 3; i++)
+        {
+            sum_acc[i]  += acc[i];
+            sum_gyro[i] += gyro[i];
+        }
+    }
+
+    // Rotation of the velocity during the interval
+    float rotation[3];
+    vectors_cross_product(alpha, velocity, rotation);
+
+    delta_dt_s_ = (float)count * period;
+    for (int8_t i = 0; i < 3; i++)
+    {
+        delta_angle_[i]    = alpha[i] + coning[i];
+        delta_velocity_[i] = velocity[i] + 0.5f * rotation[i] + sculling[i];
+
+        unfiltered_gyro_[i] = alpha[i] / delta_dt_s_;
+
+        mean_gyro[i] = sum_gyro[i] / (float)count;
+        mean_acc[i]  = sum_acc[i]  / (float)count;
+    }
+}
+
+
+bool Imu::set_sample_rate(float sample_hz)
+{
+    bool success = true;
+
+    sample_rate_hz_ = sample_hz;
+
+    // Filters with null frequency stay disabled without error
+    if (!acc_filters_.first().set_lowpass(config_.acc_lowpass_hz, sample_hz) && (config_.acc_lowpass_hz > 0.0f))
+    {
+        print_util_dbg_print("[IMU] Accelerometer low pass filter rejected, above half sample rate\n");
+        success = false;
+    }
+
+    for (uint8_t n = 0; n < config_.gyro_notch.size(); n++)
+    {
+        if (!set_gyro_notch(n, config_.gyro_notch[n].center_hz))
+        {
+            print_util_dbg_log_value("[IMU] Gyroscope notch filter rejected, above half sample rate: ", n, 10);
+            success = false;
+        }
+    }
+
+    if (!gyro_filters_.rest().rest().first().set_lowpass(config_.gyro_lowpass_hz, sample_hz) && (config_.gyro_lowpass_hz > 0.0f))
+    {
+        print_util_dbg_print("[IMU] Gyroscope low pass filter rejected, above half sample rate\n");
+        success = false;
+    }
+
+    return success;
+}
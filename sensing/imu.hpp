@@ -52,6 +52,8 @@
 #include "drivers/accelerometer.hpp"
 #include "drivers/gyroscope.hpp"
 #include "drivers/magnetometer.hpp"
+#include "drivers/inertial_fifo.hpp"
+#include "sensing/imu_pipeline.hpp"
 #include "status/state.hpp"
 
 extern "C"
@@ -76,9 +78,20 @@ typedef struct
     std::array<float, 3>    max_values;   ///< Used only during calibration: max scaled value
     std::array<float, 3>    min_values;   ///< Used only during calibration: min scaled value
     std::array<float, 3>    mean_values;  ///< Used only during calibration: mean scaled value
+    std::array<float, 9>    misalignment; ///< Misalignment correction applied after scaling (row major, identity if not calibrated)
 } imu_sensor_config_t;
 
 
+/**
+ * \brief Notch filter configuration
+ */
+typedef struct
+{
+    float center_hz;                    ///< Center frequency in Hz, 0 to disable the filter
+    float q;                            ///< Quality factor (center frequency / bandwidth)
+} imu_notch_config_t;
+
+
 /**
  * \brief The configuration IMU structure
  */
@@ -92,6 +105,10 @@ typedef struct
     float lpf_gyro;                     ///< Low pass filter gain for accelerometer
     float lpf_mag;                      ///< Low pass filter gain for accelerometer
     float lpf_mean;                     ///< Low pass filter gain for the mean values
+    float filter_rate_hz;               ///< Nominal update rate, used to compute filter coefficients when no FIFO is available
+    float acc_lowpass_hz;               ///< Cut-off frequency of 2nd order low pass filter for accelerometer, 0 to disable
+    float gyro_lowpass_hz;              ///< Cut-off frequency of 2nd order low pass filter for gyroscope, 0 to disable
+    std::array<imu_notch_config_t, 2> gyro_notch;   ///< Notch filters for gyroscope (motor frequencies)
     float startup_calib_gyro_threshold; ///< Threshold on gyroscope value used to decide wheter the autopilot is held stable
     float startup_calib_duration_s;     ///< Duration in seconds of the automatic startup calibration of gyroscopes
 } imu_conf_t;
@@ -111,6 +128,19 @@ static inline imu_conf_t imu_default_config(void);
  * \details This module gathers new data from inertial sensors and takes care of
  *          rotating, removing bias, and scaling raw sensor values (in this order)
  *
+ *          Rotation, scale and misalignment are combined into one matrix when
+ *          the module is constructed, so changes to these fields of the
+ *          configuration are not taken into account afterwards. Biases are read
+ *          at each update. Calibrated values then go through filter pipelines
+ *          (notch, 2nd order and 1st order low pass), disabled stages are skipped.
+ *
+ *          When constructed with an Inertial_fifo, all samples measured since the
+ *          previous update are integrated into delta angle and delta velocity, with
+ *          coning and sculling corrections. Notch and 2nd order low pass filters
+ *          then run on each sample at the sensor rate, and angular velocity and
+ *          acceleration are the mean filtered values over the update interval.
+ *          Without FIFO, these filters run once per update at filter_rate_hz.
+ *
  *          If this module is used, then it is not needed to call each sensor's
  *          update function.
  */
@@ -126,6 +156,19 @@ public:
         imu_conf_t config = imu_default_config());
 
 
+    /**
+     * \brief Constructor for sensors buffering high rate samples
+     *
+     * \param   fifo    Sensor providing the samples, usually the same object as
+     *                  accelerometer and gyroscope
+     */
+    Imu(Accelerometer& accelerometer,
+        Gyroscope& gyroscope,
+        Magnetometer& magnetometer,
+        const Inertial_fifo& fifo,
+        imu_conf_t config = imu_default_config());
+
+
     /**
      * \brief   Main update
      *
@@ -173,6 +216,85 @@ public:
      */
     const std::array<float, 3>& mag(void) const;
 
+
+    /**
+     * \brief   Get angular velocity before notch and low pass filters
+     *
+     * \return  Value
+     */
+    const std::array<float, 3>& gyro_unfiltered(void) const;
+
+
+    /**
+     * \brief   Get the number of gyroscope samples measured during the last update
+     *
+     * \return  Number of samples in the FIFO, or 1 without FIFO
+     */
+    uint32_t gyro_sample_count(void) const;
+
+
+    /**
+     * \brief   Get one calibrated gyroscope sample of the last update, before filters
+     *
+     * \param   index   Index of the sample, 0 being the oldest
+     * \param   gyro    Output angular velocity
+     *
+     * \return  Success, false if index is out of range
+     */
+    bool gyro_sample(uint32_t index, float gyro[3]) const;
+
+
+    /**
+     * \brief   Get the rate of the samples going through notch and 2nd order filters
+     *
+     * \return  Sensor rate with FIFO, filter_rate_hz otherwise
+     */
+    float sample_rate_hz(void) const;
+
+
+    /**
+     * \brief   Changes the center frequency of one gyroscope notch filter
+     *
+     * \details Quality factor is taken from configuration. The filter state is
+     *          kept, so this can be called in flight to track motor noise.
+     *
+     * \param   index       Index of the notch filter (0 or 1)
+     * \param   center_hz   Center frequency in Hz, 0 to disable the filter
+     *
+     * \return  false if the index is invalid, or if the frequency is not below
+     *          half the sample rate, in which case the filter is disabled
+     */
+    bool set_gyro_notch(uint8_t index, float center_hz);
+
+
+    /**
+     * \brief   Get rotation integrated during the last update, in rad
+     *
+     * \details Includes coning correction when high rate samples are available
+     *
+     * \return  Value
+     */
+    const std::array<float, 3>& delta_angle(void) const;
+
+
+    /**
+     * \brief   Get velocity change integrated during the last update, in g.s
+     *
+     * \details Includes rotation and sculling corrections when high rate samples
+     *          are available
+     *
+     * \return  Value
+     */
+    const std::array<float, 3>& delta_velocity(void) const;
+
+
+    /**
+     * \brief   Get duration covered by delta_angle and delta_velocity
+     *
+     * \return  Value in seconds
+     */
+    const float& delta_dt_s(void) const;
+
     /**
      * \brief   Get X, Y and Z components of magnetic north (in NED frame)
      *
@@ -324,19 +446,54 @@ private:
     void do_calibration(void);
 
 
+    /**
+     * \brief   Integrates and filters samples read from the FIFO during the last update
+     *
+     * \param   mean_acc    Output mean filtered acceleration over the samples
+     * \param   mean_gyro   Output mean filtered angular velocity over the samples
+     */
+    void integrate_fifo(float mean_acc[3], float mean_gyro[3]);
+
+
+    /**
+     * \brief   Computes notch and 2nd order filter coefficients for a sample rate
+     *
+     * \details Filters whose frequency is not below half the sample rate are
+     *          disabled, and a message is printed on the debug stream
+     *
+     * \param   sample_hz   Rate of the filtered samples
+     *
+     * \return  false if one of the configured filters was rejected
+     */
+    bool set_sample_rate(float sample_hz);
+
+
     Accelerometer&  accelerometer_;     ///< Reference to accelerometer sensor
     Gyroscope&      gyroscope_;         ///< Reference to gyroscope sensor
     Magnetometer&   magnetometer_;      ///< Reference to magnetometer sensor
+    const Inertial_fifo* fifo_;         ///< Pointer to high rate samples, NULL if not available
 
     imu_conf_t      config_;            ///< Configuration
 
-    std::array<float, 3> oriented_acc_; ///< Oriented acceleration
-    std::array<float, 3> oriented_gyro_;///< Oriented angular velocity
-    std::array<float, 3> oriented_mag_; ///< Oriented magnetic field
+    Imu_calibration acc_calibration_;   ///< Rotation, scale and bias of accelerometer
+    Imu_calibration gyro_calibration_;  ///< Rotation, scale and bias of gyroscope
+    Imu_calibration mag_calibration_;   ///< Rotation, scale and bias of magnetometer
+
+    Imu_pipeline<Imu_biquad>                         acc_filters_;   ///< 2nd order low pass filter for accelerometer, on each sample
+    Imu_pipeline<Imu_biquad, Imu_biquad, Imu_biquad> gyro_filters_;  ///< Notch and 2nd order low pass filters for gyroscope, on each sample
+    Imu_lowpass                                      acc_lowpass_;   ///< 1st order low pass filter for accelerometer, at each update
+    Imu_lowpass                                      gyro_lowpass_;  ///< 1st order low pass filter for gyroscope, at each update
+    Imu_pipeline<Imu_lowpass>                        mag_filters_;   ///< Low pass filter for magnetometer
+    float                                            sample_rate_hz_;///< Rate used to compute notch and 2nd order filter coefficients
 
     std::array<float, 3> scaled_acc_;   ///< Scaled acceleration
     std::array<float, 3> scaled_gyro_;  ///< Scaled angular velocity
     std::array<float, 3> scaled_mag_;   ///< Scaled magnetic field
+    std::array<float, 3> unfiltered_gyro_;  ///< Scaled angular velocity, before filters
+
+    std::array<float, 3> delta_angle_;      ///< Rotation integrated during the last update
+    std::array<float, 3> delta_velocity_;   ///< Velocity change integrated during the last update
+    float delta_dt_s_;                      ///< Duration of integration
     float magnetic_inclination_;        ///< Angle between horizontal plane and magnetic north (magnetic dip)
     float magnetic_norm_;               ///< Norm of magnetic north
 
@@ -393,6 +550,9 @@ static inline imu_conf_t imu_default_config()
     conf.accelerometer.mean_values[1] = 0.0f;
     conf.accelerometer.mean_values[2] = 0.0f;
 
+    // Misalignment
+    conf.accelerometer.misalignment = std::array<float, 9>{{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f}};  ///< Identity
+
     // Gyroscope
     // Bias
     conf.gyroscope.bias[0] = 0.0f;      ///< Positive or negative
@@ -423,6 +583,9 @@ static inline imu_conf_t imu_default_config()
     conf.gyroscope.mean_values[1] = 0.0f;
     conf.gyroscope.mean_values[2] = 0.0f;
 
+    // Misalignment
+    conf.gyroscope.misalignment = std::array<float, 9>{{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f}};  ///< Identity
+
     // Magnetometer
     // Bias
     conf.magnetometer.bias[0] = 0.0f;       ///< Positive or negative
@@ -453,6 +616,9 @@ static inline imu_conf_t imu_default_config()
     conf.magnetometer.mean_values[1] = 0.0f;
     conf.magnetometer.mean_values[2] = 0.0f;
 
+    // Misalignment
+    conf.magnetometer.misalignment = std::array<float, 9>{{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f}};  ///< Identity
+
     // Magnetic north (default value in Lausanne: 62° inclination)
     conf.magnetic_north[0] = 0.46947156f;   // cos(62°)
     conf.magnetic_north[1] = 0.0f;
@@ -464,6 +630,15 @@ static inline imu_conf_t imu_default_config()
     conf.lpf_mag    = 0.1f;
     conf.lpf_mean   = 0.01f;
 
+    // Notch and 2nd order low pass filters, disabled by default
+    conf.filter_rate_hz     = 500.0f;      // Rate task period of MAV
+    conf.acc_lowpass_hz     = 0.0f;
+    conf.gyro_lowpass_hz    = 0.0f;
+    conf.gyro_notch[0].center_hz = 0.0f;
+    conf.gyro_notch[0].q         = 3.0f;
+    conf.gyro_notch[1].center_hz = 0.0f;
+    conf.gyro_notch[1].q         = 3.0f;
+
     // startup calibration length
     conf.startup_calib_gyro_threshold = 0.5f;
     conf.startup_calib_duration_s     = 10.0f;
@@ -0,0 +1,185 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file imu_pipeline.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Processing stages for inertial sensors: calibration and filters
+ *
+ ******************************************************************************/
+
+
+#include "sensing/imu_pipeline.hpp"
+
+extern "C"
+{
+#include <math.h>
+#include "util/maths.h"
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Imu_calibration::Imu_calibration(const std::array<uint8_t, 3>& axis,
+                                 const std::array<float, 3>& sign,
+                                 const std::array<float, 3>& scale_factor,
+                                 const std::array<float, 9>& misalignment,
+                                 const std::array<float, 3>& bias):
+    bias_(bias)
+{
+    // Rotation and scale: row i picks raw axis axis[i]
+    float rotation[9] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        rotation[3 * i + axis[i]] = sign[i] / scale_factor[i];
+    }
+
+    // Misalignment is applied on scaled values
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        for (uint8_t j = 0; j < 3; ++j)
+        {
+            matrix_[3 * i + j] = misalignment[3 * i]     * rotation[j]
+                               + misalignment[3 * i + 1] * rotation[3 + j]
+                               + misalignment[3 * i + 2] * rotation[6 + j];
+        }
+    }
+}
+
+
+const std::array<float, 9>& Imu_calibration::matrix(void) const
+{
+    return matrix_;
+}
+
+
+Imu_biquad::Imu_biquad(void):
+    b0_(1.0f),
+    b1_(0.0f),
+    b2_(0.0f),
+    a1_(0.0f),
+    a2_(0.0f),
+    z1_{0.0f, 0.0f, 0.0f},
+    z2_{0.0f, 0.0f, 0.0f},
+    active_(false),
+    initialized_(false)
+{}
+
+
+bool Imu_biquad::set_lowpass(float cutoff_hz, float sample_hz)
+{
+    if ((cutoff_hz <= 0.0f) || (cutoff_hz >= 0.5f * sample_hz))
+    {
+        disable();
+        return false;
+    }
+
+    // Butterworth (Q = 1/sqrt(2)), from R. Bristow-Johnson's audio EQ cookbook
+    float w0    = 2.0f * PI * cutoff_hz / sample_hz;
+    float cosw  = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * 0.70710678f);
+    float a0    = 1.0f + alpha;
+
+    b0_ = 0.5f * (1.0f - cosw) / a0;
+    b1_ = (1.0f - cosw) / a0;
+    b2_ = b0_;
+    a1_ = -2.0f * cosw / a0;
+    a2_ = (1.0f - alpha) / a0;
+
+    if (!active_)
+    {
+        initialized_ = false;
+    }
+    active_ = true;
+
+    return true;
+}
+
+
+bool Imu_biquad::set_notch(float center_hz, float sample_hz, float q)
+{
+    if ((center_hz <= 0.0f) || (center_hz >= 0.5f * sample_hz) || (q <= 0.0f))
+    {
+        disable();
+        return false;
+    }
+
+    float w0    = 2.0f * PI * center_hz / sample_hz;
+    float cosw  = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0    = 1.0f + alpha;
+
+    b0_ = 1.0f / a0;
+    b1_ = -2.0f * cosw / a0;
+    b2_ = b0_;
+    a1_ = b1_;
+    a2_ = (1.0f - alpha) / a0;
+
+    if (!active_)
+    {
+        initialized_ = false;
+    }
+    active_ = true;
+
+    return true;
+}
+
+
+void Imu_biquad::disable(void)
+{
+    active_ = false;
+}
+
+
+void Imu_biquad::reset(const float x[3])
+{
+    // Steady state: y = dc_gain * x
+    float dc_gain = (b0_ + b1_ + b2_) / (1.0f + a1_ + a2_);
+
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        float y = dc_gain * x[i];
+        z1_[i]  = y - b0_ * x[i];
+        z2_[i]  = b2_ * x[i] - a2_ * y;
+    }
+
+    initialized_ = true;
+}
+
+
+Imu_lowpass::Imu_lowpass(float gain):
+    gain_(gain),
+    y_{0.0f, 0.0f, 0.0f}
+{}
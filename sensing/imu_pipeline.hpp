@@ -0,0 +1,317 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file imu_pipeline.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Processing stages for inertial sensors: calibration and filters
+ *
+ * \details Stages are composed at compile time with Imu_pipeline, without
+ *          allocation nor virtual calls. Stages whose configuration makes them
+ *          pass-through (disabled filter) are skipped at runtime.
+ *
+ ******************************************************************************/
+
+
+#ifndef IMU_PIPELINE_HPP_
+#define IMU_PIPELINE_HPP_
+
+#include <cstdint>
+#include <array>
+
+
+/**
+ * \brief   Calibration stage: rotation, scale and misalignment as one 3x3 matrix, then bias
+ *
+ * \details The matrix is precomputed, the bias is read at each sample so that
+ *          it can be changed at runtime (onboard parameters, bias calibration)
+ */
+class Imu_calibration
+{
+public:
+    /**
+     * \brief   Constructor
+     *
+     * \param   axis            Raw axis used for each output axis
+     * \param   sign            Sign applied to each output axis (+1 or -1)
+     * \param   scale_factor    Scale factor of each output axis (raw units per unit)
+     * \param   misalignment    Axes misalignment correction, row major, identity if not calibrated
+     * \param   bias            Bias of each output axis (scaled units)
+     */
+    Imu_calibration(const std::array<uint8_t, 3>& axis,
+                    const std::array<float, 3>& sign,
+                    const std::array<float, 3>& scale_factor,
+                    const std::array<float, 9>& misalignment,
+                    const std::array<float, 3>& bias);
+
+    /**
+     * \brief   Calibrate one sample
+     *
+     * \param   raw     Raw sample in sensor frame
+     * \param   out     Calibrated sample
+     */
+    inline void apply(const std::array<float, 3>& raw, float out[3]) const
+    {
+        for (uint8_t i = 0; i < 3; ++i)
+        {
+            out[i] = matrix_[3 * i]     * raw[0]
+                   + matrix_[3 * i + 1] * raw[1]
+                   + matrix_[3 * i + 2] * raw[2]
+                   - bias_[i];
+        }
+    }
+
+    /**
+     * \brief   Get calibration matrix
+     *
+     * \return  Matrix, row major
+     */
+    const std::array<float, 9>& matrix(void) const;
+
+private:
+    std::array<float, 9>        matrix_;        ///< Rotation, scale and misalignment
+    const std::array<float, 3>& bias_;          ///< Bias, owned by the configuration
+};
+
+
+/**
+ * \brief   Second order IIR filter on 3 axes (transposed direct form II)
+ *
+ * \details Coefficients are precomputed by set_lowpass or set_notch. The filter
+ *          is inactive until one of them is called with a valid frequency.
+ *          On the first sample, the state is set as if the input had always
+ *          been constant, to avoid startup transients.
+ */
+class Imu_biquad
+{
+public:
+    /**
+     * \brief   Constructor, inactive filter
+     */
+    Imu_biquad(void);
+
+    /**
+     * \brief   Configure as Butterworth low-pass filter
+     *
+     * \param   cutoff_hz   Cut-off frequency, 0 to disable the filter
+     * \param   sample_hz   Sampling frequency
+     *
+     * \return  false if the frequencies are invalid (filter disabled)
+     */
+    bool set_lowpass(float cutoff_hz, float sample_hz);
+
+    /**
+     * \brief   Configure as notch filter
+     *
+     * \details Coefficients are updated without resetting the state, so that
+     *          the center frequency can be changed on the fly
+     *
+     * \param   center_hz   Center frequency, 0 to disable the filter
+     * \param   sample_hz   Sampling frequency
+     * \param   q           Quality factor (center frequency / bandwidth)
+     *
+     * \return  false if the frequencies are invalid (filter disabled)
+     */
+    bool set_notch(float center_hz, float sample_hz, float q);
+
+    /**
+     * \brief   Disable the filter
+     */
+    void disable(void);
+
+    /**
+     * \brief   Indicates whether the filter modifies the signal
+     *
+     * \return  active
+     */
+    inline bool active(void) const
+    {
+        return active_;
+    }
+
+    /**
+     * \brief   Filter one sample in place
+     *
+     * \param   x   Sample
+     */
+    inline void apply(float x[3])
+    {
+        if (!initialized_)
+        {
+            reset(x);
+        }
+
+        for (uint8_t i = 0; i < 3; ++i)
+        {
+            float y = b0_ * x[i] + z1_[i];
+            z1_[i]  = b1_ * x[i] - a1_ * y + z2_[i];
+            z2_[i]  = b2_ * x[i] - a2_ * y;
+            x[i]    = y;
+        }
+    }
+
+    /**
+     * \brief   Set the state to the steady state of a constant input
+     *
+     * \param   x   Input value
+     */
+    void reset(const float x[3]);
+
+private:
+    float   b0_;            ///< Feedforward coefficient
+    float   b1_;            ///< Feedforward coefficient
+    float   b2_;            ///< Feedforward coefficient
+    float   a1_;            ///< Feedback coefficient (normalized, a0 = 1)
+    float   a2_;            ///< Feedback coefficient (normalized, a0 = 1)
+    float   z1_[3];         ///< State
+    float   z2_[3];         ///< State
+    bool    active_;        ///< Filter configured
+    bool    initialized_;   ///< State initialized from the first sample
+};
+
+
+/**
+ * \brief   First order low-pass filter on 3 axes
+ *
+ * \details Inactive if the gain is 1 (output equals input)
+ */
+class Imu_lowpass
+{
+public:
+    /**
+     * \brief   Constructor
+     *
+     * \param   gain    Weight of the new sample, in ]0, 1]
+     */
+    Imu_lowpass(float gain = 1.0f);
+
+    /**
+     * \brief   Indicates whether the filter modifies the signal
+     *
+     * \return  active
+     */
+    inline bool active(void) const
+    {
+        return gain_ < 1.0f;
+    }
+
+    /**
+     * \brief   Filter one sample in place
+     *
+     * \param   x   Sample
+     */
+    inline void apply(float x[3])
+    {
+        for (uint8_t i = 0; i < 3; ++i)
+        {
+            y_[i] = gain_ * x[i] + (1.0f - gain_) * y_[i];
+            x[i]  = y_[i];
+        }
+    }
+
+private:
+    float gain_;            ///< Weight of the new sample
+    float y_[3];            ///< Last output
+};
+
+
+/**
+ * \brief   Chain of filter stages applied in order
+ *
+ * \details Each stage type must provide active() and apply(float[3])
+ *
+ * \tparam  Stages  Stage types
+ */
+template<typename... Stages>
+class Imu_pipeline;
+
+
+/**
+ * \brief   Empty pipeline, end of the recursion
+ */
+template<>
+class Imu_pipeline<>
+{
+public:
+    inline void apply(float x[3])
+    {
+        (void)x;
+    }
+};
+
+
+template<typename First, typename... Rest>
+class Imu_pipeline<First, Rest...>
+{
+public:
+    /**
+     * \brief   Filter one sample in place, skipping inactive stages
+     *
+     * \param   x   Sample
+     */
+    inline void apply(float x[3])
+    {
+        if (first_.active())
+        {
+            first_.apply(x);
+        }
+        rest_.apply(x);
+    }
+
+    /**
+     * \brief   Get first stage
+     *
+     * \return  stage
+     */
+    First& first(void)
+    {
+        return first_;
+    }
+
+    /**
+     * \brief   Get the pipeline of the remaining stages
+     *
+     * \return  pipeline
+     */
+    Imu_pipeline<Rest...>& rest(void)
+    {
+        return rest_;
+    }
+
+private:
+    First                   first_;     ///< First stage
+    Imu_pipeline<Rest...>   rest_;      ///< Remaining stages
+};
+
+
+#endif /* IMU_PIPELINE_HPP_ */
@@ -45,17 +45,17 @@
 
 // It is a static member (meaning it is shared by all instances of that class),
  // => it has to be defined somewhere.
-global_position_t INS::origin_;
+Local_tangent_plane INS::projection_;
 
 
 INS::INS(global_position_t origin)
 {
-    INS::origin_ = origin;
+    INS::projection_.set_origin(origin);
 };
 
 
 bool INS::set_origin(global_position_t origin)
 {
-    origin_ = origin;
+    projection_.set_origin(origin);
     return true;
 }
\ No newline at end of file
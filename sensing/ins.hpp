@@ -47,6 +47,7 @@
 #include "communication/mavlink_stream.hpp"
 #include "hal/common/time_keeper.hpp"
 #include "util/coord_conventions.hpp"
+#include "util/local_tangent_plane.hpp"
 #include "util/constants.hpp"
 
 class INS
@@ -129,7 +130,26 @@ public:
      *
      * \return    origin
      */
-    static inline const global_position_t& origin(void) {return origin_;};
+    static inline const global_position_t& origin(void) {return projection_.origin();};
+
+
+    /**
+     * \brief     Version of the origin, incremented each time the origin changes
+     *
+     * \return    version
+     */
+    static inline uint32_t origin_version(void) {return projection_.version();};
+
+
+    /**
+     * \brief     Projection between global coordinates and the local frame
+     *
+     * \details   Updated each time the origin changes, use it instead of
+     *            coord_conventions_global_to_local_position(..., origin(), ...)
+     *
+     * \return    projection
+     */
+    static inline const Local_tangent_plane& projection(void) {return projection_;};
 
 
     /**
@@ -140,7 +160,7 @@ public:
     virtual global_position_t position_gf(void) const
     {
         global_position_t position_gf;
-        coord_conventions_local_to_global_position(position_lf(), origin(), position_gf);
+        projection().local_to_global(position_lf(), position_gf);
         return position_gf;
     };
 
@@ -156,7 +176,7 @@ protected:
     static bool set_origin(global_position_t origin);
 
 private:
-    static global_position_t origin_;
+    static Local_tangent_plane projection_;     ///< Projection to local frame, holds the origin
 
     /* declare callback for setting the origin as friend to give access to set_origin */
     friend void ins_telemetry_set_gps_global_origin_callback(INS* ins, uint32_t sysid, const mavlink_message_t* msg);
@@ -42,7 +42,7 @@
 
 
 #include "sensing/ins_complementary.hpp"
-#include "hal/common/time_keeper.hpp"
+#include "runtime/cycle_clock.hpp"
 #include "util/print_util.hpp"
 
 extern "C"
@@ -85,7 +85,7 @@ INS_complementary::INS_complementary(State& state, const Barometer& barometer, c
 bool INS_complementary::update(void)
 {
     // Updat timing
-    float now      = time_keeper_get_s();
+    float now      = Cycle_clock::now_s();
     dt_s_          = now - last_update_s_;
     last_update_s_ = now;
 
@@ -300,7 +300,7 @@ void INS_complementary::correction_from_gps_pos(void)
 
             // get local position from GPS
             local_position_t gps_pos;
-            coord_conventions_global_to_local_position(gps_.position_gf(), origin(), gps_pos);
+            projection().global_to_local(gps_.position_gf(), gps_pos);
 
             // Compute position error and velocity error from gps
             std::array<float,3> pos_error;
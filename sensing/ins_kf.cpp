@@ -42,6 +42,7 @@
 
 
 #include "sensing/ins_kf.hpp"
+#include "runtime/cycle_clock.hpp"
 #include "util/coord_conventions.hpp"
 
 //------------------------------------------------------------------------------
@@ -115,7 +116,11 @@ INS_kf::INS_kf( State& state,
     last_gps_mocap_update_s_(0.0f),
     first_fix_received_(false),
     dt_(0.0f),
-    last_update_(0.0f)
+    last_update_(0.0f),
+    step_(0),
+    pending_count_(0),
+    fused_next_(0),
+    fused_count_(0)
 {
     // Init the filter
     init();
@@ -136,7 +141,15 @@ void INS_kf::init(void)
 
 
     // Update last time to avoid glitches at initilaization
-    last_update_ = time_keeper_get_s();
+    last_update_ = Cycle_clock::now_s();
+
+    // Restart history, measurements older than now are fused now
+    step_ = 0;
+    inputs_[0].time_s   = last_update_;
+    inputs_[0].dt       = 0.0f;
+    pending_count_      = 0;
+    fused_count_        = 0;
+    save_snapshot(step_);
 }
 
 
@@ -176,7 +189,7 @@ bool INS_kf::is_healthy(INS::healthy_t type) const
 {
     bool ret = false;
 
-    float now     = time_keeper_get_s();
+    float now     = Cycle_clock::now_s();
     float timeout = 1.0f;  // timeout after 1 second
 
     switch(type)
@@ -258,12 +271,21 @@ bool INS_kf::update(void)
         if (last_accel_update_s_ < ahrs_.last_update_s())
         {
             // Update the delta time (in second)
-            float now       = time_keeper_get_s();
+            float now       = Cycle_clock::now_s();
             dt_             = now - last_update_;
             last_update_    = now;
 
             // Make the prediciton
-            predict_kf();
+            input_t input;
+            input.time_s    = now;
+            input.dt        = dt_;
+            input.attitude  = ahrs_.attitude();
+            input.acc       = ahrs_.linear_acceleration();
+            predict_kf(input);
+
+            // Keep input for later replays
+            step_++;
+            inputs_[step_ % INPUT_HISTORY] = input;
 
             // update timimg
             last_accel_update_s_ = ahrs_.last_update_s();
@@ -354,6 +376,10 @@ bool INS_kf::update(void)
         }
     }
 
+    // Fuse measurements at their timestamp
+    fuse_pending();
+    save_snapshot(step_);
+
     return true;
 }
 
@@ -361,16 +387,15 @@ bool INS_kf::update(void)
 // PRIVATE FUNCTIONS IMPLEMENTATION
 //------------------------------------------------------------------------------
 
-void INS_kf::predict_kf(void)
+void INS_kf::predict_kf(const input_t& input)
 {
     // Recompute the variable model matrices
     // Get time
-    //float dt = 0.004; //dt_;
-    float dt = dt_;
+    float dt = input.dt;
     float dt2 = (dt*dt)/2.0f;
 
     // Get attitude quaternion
-    quat_t q = ahrs_.attitude();
+    quat_t q = input.attitude;
     float q0 = q.s;
     float q1 = q.v[0];
     float q2 = q.v[1];
@@ -442,7 +467,7 @@ void INS_kf::predict_kf(void)
                       0,              0,              0,              0,      0,              0,              0,              0,            0,            0,            dt*sb2 });
 
     // Compute default KF prediciton step (using local accelerations as input, warning z acceleration sign)
-    predict({ahrs_.linear_acceleration()[0], ahrs_.linear_acceleration()[1], ahrs_.linear_acceleration()[2]});
+    predict({input.acc[0], input.acc[1], input.acc[2]});
 }
 
 
@@ -451,15 +476,13 @@ void INS_kf::update_gps_pos(void)
     // Get local position from gps
     local_position_t  gps_local;
     global_position_t gps_global = gps_.position_gf();
-    coord_conventions_global_to_local_position(gps_global, origin(), gps_local);
+    projection().global_to_local(gps_global, gps_local);
 
-    // Recompute the measurement noise matrix
-    R_ = Mat<3,3>({ SQR(config_.sigma_gps_xy), 0,                         0,
-                    0,                         SQR(config_.sigma_gps_xy), 0,
-                    0,                         0,                         SQR(config_.sigma_gps_z)});
-
-    // Run kalman update using default matrices
-    Kalman<11,3,3>::update({gps_local[0], gps_local[1], gps_local[2]});
+    float sigma[3] = {config_.sigma_gps_xy, config_.sigma_gps_xy, config_.sigma_gps_z};
+    queue_measurement(MEASUREMENT_GPS_POS,
+                      (float)(gps_.last_position_update_us())/1e6f - config_.delay_gps_s,
+                      gps_local.data(),
+                      sigma);
 }
 
 
@@ -468,15 +491,11 @@ void INS_kf::update_gps_vel(void)
     // Get velocity from GPS
     std::array<float,3> gps_velocity = gps_.velocity_lf();
 
-    // Recompute the measurement noise matrix
-    R_gpsvel_ = Mat<3,3>({ SQR(config_.sigma_gps_velxy),  0,                            0,
-                           0,                             SQR(config_.sigma_gps_velxy), 0,
-                           0,                             0,                            SQR(config_.sigma_gps_velz)});
-
-    // Run kalman update
-    Kalman<11,3,3>::update(Mat<3,1>(gps_velocity),
-                           H_gpsvel_,
-                           R_gpsvel_);
+    float sigma[3] = {config_.sigma_gps_velxy, config_.sigma_gps_velxy, config_.sigma_gps_velz};
+    queue_measurement(MEASUREMENT_GPS_VEL,
+                      (float)(gps_.last_velocity_update_us())/1e6f - config_.delay_gps_s,
+                      gps_velocity.data(),
+                      sigma);
 }
 
 
@@ -485,28 +504,24 @@ void INS_kf::update_gps_mocap(void)
     // Get local position from gps
     local_position_t  gps_local;
     global_position_t gps_global = gps_mocap_.position_gf();
-    coord_conventions_global_to_local_position(gps_global, origin(), gps_local);
+    projection().global_to_local(gps_global, gps_local);
 
-    // Recompute the measurement noise matrix
-    R_ = Mat<3,3>({ SQR(config_.sigma_gps_mocap), 0,                         0,
-                    0,                         SQR(config_.sigma_gps_mocap), 0,
-                    0,                         0,                         SQR(config_.sigma_gps_mocap)});
-
-    // Run kalman update using default matrices
-    Kalman<11,3,3>::update({gps_local[0], gps_local[1], gps_local[2]});
+    float sigma[3] = {config_.sigma_gps_mocap, config_.sigma_gps_mocap, config_.sigma_gps_mocap};
+    queue_measurement(MEASUREMENT_GPS_MOCAP,
+                      (float)(gps_mocap_.last_position_update_us())/1e6f - config_.delay_gps_mocap_s,
+                      gps_local.data(),
+                      sigma);
 }
 
 
 void INS_kf::update_barometer(void)
 {
-    // Recompute the measurement noise matrix
-    R_baro_ = Mat<1,1>({ SQR(config_.sigma_baro) });
-
-    // Run kalman Update
-    float z_baro = barometer_.altitude_gf_raw() - origin().altitude;
-    Kalman<11,3,3>::update(Mat<1,1>(z_baro),
-                           H_baro_,
-                           R_baro_);
+    float z_baro[3] = {barometer_.altitude_gf_raw() - origin().altitude, 0.0f, 0.0f};
+    float sigma[3]  = {config_.sigma_baro, 0.0f, 0.0f};
+    queue_measurement(MEASUREMENT_BARO,
+                      (float)(barometer_.last_update_us())/1e6f - config_.delay_baro_s,
+                      z_baro,
+                      sigma);
 }
 
 
@@ -535,13 +550,12 @@ void INS_kf::update_sonar(void)
         sigma_sonar = 0.0001f;
     }
 
-    // Recompute the measurement noise matrix
-    R_sonar_ = Mat<1,1>({ SQR(sigma_sonar) });
-
-    // Run kalman Update
-    Kalman<11,3,3>::update(Mat<1,1>(z_sonar),
-                           H_sonar_,
-                           R_sonar_);
+    float z[3]      = {z_sonar, 0.0f, 0.0f};
+    float sigma[3]  = {sigma_sonar, 0.0f, 0.0f};
+    queue_measurement(MEASUREMENT_SONAR,
+                      (float)(sonar_.last_update_us())/1e6f - config_.delay_sonar_s,
+                      z,
+                      sigma);
 }
 
 
@@ -573,13 +587,227 @@ void INS_kf::update_flow(void)
         }
     }
 
-    // Recompute the measurement noise matrix
-    R_flow_(0,0) = SQR(sigma_flow);
-    R_flow_(1,1) = SQR(sigma_flow);
-    R_flow_(2,2) = SQR(sigma_sonar);
+    float z[3]      = {vel_lf[0], vel_lf[1], z_sonar};
+    float sigma[3]  = {sigma_flow, sigma_flow, sigma_sonar};
+    queue_measurement(MEASUREMENT_FLOW,
+                      flow_.last_update_s() - config_.delay_flow_s,
+                      z,
+                      sigma);
+}
+
+
+void INS_kf::queue_measurement(measurement_type_t type, float time_s, const float z[3], const float sigma[3])
+{
+    measurement_t measurement;
+    measurement.type = type;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        measurement.z[i]     = z[i];
+        measurement.sigma[i] = sigma[i];
+    }
+
+    // Find the last prediction step before the measurement
+    uint32_t oldest = oldest_step();
+    measurement.step = step_;
+    while ((measurement.step > oldest) && (inputs_[measurement.step % INPUT_HISTORY].time_s > time_s))
+    {
+        measurement.step--;
+    }
+
+    if (pending_count_ < MAX_PENDING)
+    {
+        pending_[pending_count_] = measurement;
+        pending_count_++;
+    }
+    else
+    {
+        // No room left, fuse now
+        measurement.step = step_;
+        apply_measurement(measurement);
+        record_fused(measurement);
+    }
+}
+
+
+void INS_kf::apply_measurement(const measurement_t& measurement)
+{
+    const float* z     = measurement.z;
+    const float* sigma = measurement.sigma;
 
-    // Do update
-    Kalman<11,3,3>::update(Mat<3,1>({vel_lf[0], vel_lf[1], z_sonar}),
-                           H_flow_,
-                           R_flow_);
+    switch (measurement.type)
+    {
+        case MEASUREMENT_GPS_POS:
+        case MEASUREMENT_GPS_MOCAP:
+            // Run kalman update using default matrices
+            R_ = Mat<3,3>({ SQR(sigma[0]), 0,             0,
+                            0,             SQR(sigma[1]), 0,
+                            0,             0,             SQR(sigma[2])});
+            Kalman<11,3,3>::update({z[0], z[1], z[2]});
+        break;
+
+        case MEASUREMENT_GPS_VEL:
+            R_gpsvel_ = Mat<3,3>({ SQR(sigma[0]), 0,             0,
+                                   0,             SQR(sigma[1]), 0,
+                                   0,             0,             SQR(sigma[2])});
+            Kalman<11,3,3>::update(Mat<3,1>({z[0], z[1], z[2]}),
+                                   H_gpsvel_,
+                                   R_gpsvel_);
+        break;
+
+        case MEASUREMENT_BARO:
+            R_baro_ = Mat<1,1>({ SQR(sigma[0]) });
+            Kalman<11,3,3>::update(Mat<1,1>(z[0]),
+                                   H_baro_,
+                                   R_baro_);
+        break;
+
+        case MEASUREMENT_SONAR:
+            R_sonar_ = Mat<1,1>({ SQR(sigma[0]) });
+            Kalman<11,3,3>::update(Mat<1,1>(z[0]),
+                                   H_sonar_,
+                                   R_sonar_);
+        break;
+
+        case MEASUREMENT_FLOW:
+            R_flow_(0,0) = SQR(sigma[0]);
+            R_flow_(1,1) = SQR(sigma[1]);
+            R_flow_(2,2) = SQR(sigma[2]);
+            Kalman<11,3,3>::update(Mat<3,1>({z[0], z[1], z[2]}),
+                                   H_flow_,
+                                   R_flow_);
+        break;
+    }
+}
+
+
+void INS_kf::fuse_pending(void)
+{
+    if (pending_count_ == 0)
+    {
+        return;
+    }
+
+    // Oldest step with a measurement
+    uint32_t first = step_;
+    for (uint32_t i = 0; i < pending_count_; i++)
+    {
+        if (pending_[i].step < first)
+        {
+            first = pending_[i].step;
+        }
+    }
+
+    // No replay when all measurements are at the current step
+    if (first == step_)
+    {
+        for (uint32_t i = 0; i < pending_count_; i++)
+        {
+            apply_measurement(pending_[i]);
+            record_fused(pending_[i]);
+        }
+        pending_count_ = 0;
+        return;
+    }
+
+    // Restart from the snapshot preceding the oldest measurement
+    uint32_t start = first - (first % SNAPSHOT_PERIOD);
+    const snapshot_t& snapshot = snapshots_[(start / SNAPSHOT_PERIOD) % SNAPSHOT_COUNT];
+    x_ = snapshot.x;
+    P_ = snapshot.P;
+
+    // Measurements to fuse after the snapshot: the ones already fused after it
+    // (the snapshot includes those at its own step), then the pending ones
+    const measurement_t** replay = replay_;
+    uint32_t replay_count = 0;
+    for (uint32_t i = 0; i < fused_count_; i++)
+    {
+        const measurement_t& fused = fused_[(fused_next_ + FUSED_HISTORY - fused_count_ + i) % FUSED_HISTORY];
+        if (fused.step > start)
+        {
+            replay[replay_count] = &fused;
+            replay_count++;
+        }
+    }
+    for (uint32_t i = 0; i < pending_count_; i++)
+    {
+        replay[replay_count] = &pending_[i];
+        replay_count++;
+    }
+
+    // Sort by step, measurements of the same step keep their order
+    for (uint32_t i = 1; i < replay_count; i++)
+    {
+        const measurement_t* measurement = replay[i];
+        uint32_t j = i;
+        while ((j > 0) && (replay[j - 1]->step > measurement->step))
+        {
+            replay[j] = replay[j - 1];
+            j--;
+        }
+        replay[j] = measurement;
+    }
+
+    // Fuse each measurement at its step, then predict up to the present
+    uint32_t next = 0;
+    for (uint32_t step = start; step <= step_; step++)
+    {
+        if (step > start)
+        {
+            predict_kf(inputs_[step % INPUT_HISTORY]);
+        }
+
+        while ((next < replay_count) && (replay[next]->step == step))
+        {
+            apply_measurement(*replay[next]);
+            next++;
+        }
+
+        if (step < step_)
+        {
+            save_snapshot(step);
+        }
+    }
+
+    // Keep the new measurements for the next replays
+    for (uint32_t i = 0; i < pending_count_; i++)
+    {
+        record_fused(pending_[i]);
+    }
+    pending_count_ = 0;
+}
+
+
+void INS_kf::record_fused(const measurement_t& measurement)
+{
+    fused_[fused_next_] = measurement;
+    fused_next_         = (fused_next_ + 1) % FUSED_HISTORY;
+    if (fused_count_ < FUSED_HISTORY)
+    {
+        fused_count_++;
+    }
+}
+
+
+uint32_t INS_kf::oldest_step(void) const
+{
+    // Oldest snapshot still in the buffer
+    uint32_t last_snapshot = step_ - (step_ % SNAPSHOT_PERIOD);
+    uint32_t span          = (SNAPSHOT_COUNT - 1) * SNAPSHOT_PERIOD;
+
+    if (last_snapshot < span)
+    {
+        return 0;
+    }
+    return last_snapshot - span;
+}
+
+
+void INS_kf::save_snapshot(uint32_t step)
+{
+    if ((step % SNAPSHOT_PERIOD) == 0)
+    {
+        snapshot_t& snapshot = snapshots_[(step / SNAPSHOT_PERIOD) % SNAPSHOT_COUNT];
+        snapshot.x = x_;
+        snapshot.P = P_;
+    }
 }
@@ -38,6 +38,15 @@
  *
  * \brief   Kalman filter for position estimation
  *
+ * \details Measurements are fused at the time they were taken: the inputs of
+ *          past prediction steps and periodic snapshots of the state and
+ *          covariance are kept in ring buffers. When a delayed measurement
+ *          arrives, the filter restarts from the snapshot preceding it, fuses
+ *          it at its timestamp and predicts again up to the present. The
+ *          measurements fused since the snapshot are kept with their step and
+ *          fused again during the replay. All measurements received during one
+ *          update share a single replay.
+ *
  ******************************************************************************/
 
 
@@ -150,6 +159,13 @@ public:
         float sigma_flow;
         float sigma_sonar;
 
+        // Measurement delays in seconds
+        float delay_gps_s;
+        float delay_gps_mocap_s;
+        float delay_baro_s;
+        float delay_sonar_s;
+        float delay_flow_s;
+
         // Position of the origin
         global_position_t origin;
     };
@@ -235,6 +251,57 @@ public:
 
 
 private:
+    static const uint32_t INPUT_HISTORY     = 64;                               ///< Number of past prediction steps kept
+    static const uint32_t SNAPSHOT_PERIOD   = 8;                                ///< Number of prediction steps between state snapshots
+    static const uint32_t SNAPSHOT_COUNT    = INPUT_HISTORY / SNAPSHOT_PERIOD;  ///< Number of state snapshots kept
+    static const uint32_t MAX_PENDING       = 8;                                ///< Maximum number of measurements fused per update
+    static const uint32_t MEASUREMENT_TYPES = 6;                                ///< Number of measurement types, each is fused at most once per step
+    static const uint32_t FUSED_HISTORY     = MEASUREMENT_TYPES * INPUT_HISTORY; ///< Number of past fused measurements kept for replays, covers the whole input history
+
+    /**
+     * \brief   Input of one prediction step
+     */
+    struct input_t
+    {
+        float               time_s;         ///< Time of the step in seconds
+        float               dt;             ///< Time interval since previous step in seconds
+        quat_t              attitude;       ///< Attitude during the step
+        std::array<float,3> acc;            ///< Linear acceleration in local frame
+    };
+
+    /**
+     * \brief   State and covariance after one prediction step and its measurements
+     */
+    struct snapshot_t
+    {
+        Mat<11,1>   x;                      ///< State
+        Mat<11,11>  P;                      ///< State covariance
+    };
+
+    /**
+     * \brief   Type of measurement, MEASUREMENT_TYPES values
+     */
+    enum measurement_type_t
+    {
+        MEASUREMENT_GPS_POS,
+        MEASUREMENT_GPS_VEL,
+        MEASUREMENT_GPS_MOCAP,
+        MEASUREMENT_BARO,
+        MEASUREMENT_SONAR,
+        MEASUREMENT_FLOW,
+    };
+
+    /**
+     * \brief   Measurement waiting to be fused
+     */
+    struct measurement_t
+    {
+        measurement_type_t  type;           ///< Type of measurement
+        uint32_t            step;           ///< Prediction step at which the measurement is fused
+        float               z[3];           ///< Measurement vector
+        float               sigma[3];       ///< Standard deviation of each component
+    };
+
     State&              state_;             ///< Reference to the state structure
     const Gps&          gps_;               ///< Gps (input)
     const Gps_mocap&    gps_mocap_;         ///< Gps from motion capture system (input)
@@ -270,47 +337,108 @@ private:
     float dt_;                              ///< Time interval since last update in seconds
     float last_update_;                     ///< Last update time in seconds
 
+    input_t         inputs_[INPUT_HISTORY];         ///< Inputs of past prediction steps
+    snapshot_t      snapshots_[SNAPSHOT_COUNT];     ///< Past states, every SNAPSHOT_PERIOD steps
+    uint32_t        step_;                          ///< Index of the last prediction step since init
+    measurement_t   pending_[MAX_PENDING];          ///< Measurements received during the current update
+    uint32_t        pending_count_;                 ///< Number of pending measurements
+    measurement_t   fused_[FUSED_HISTORY];          ///< Past fused measurements, ring buffer
+    uint32_t        fused_next_;                    ///< Index of the next fused measurement to write
+    uint32_t        fused_count_;                   ///< Number of fused measurements kept
+    const measurement_t* replay_[FUSED_HISTORY + MAX_PENDING];  ///< Measurements fused during a replay, sorted by step
+
 
     /**
      * \brief   Performs the prediction step of the Kalman filter, using linear formulation (KF, non-constant matrices)
+     *
+     * \param   input   Time interval, attitude and acceleration of the step
      */
-    void predict_kf(void);
+    void predict_kf(const input_t& input);
 
 
     /**
-     * \brief   Performs the update step of the Kalman filter, using gps position
+     * \brief   Queues the gps position for the update step of the Kalman filter
      */
     void update_gps_pos(void);
 
 
     /**
-     * \brief   Performs the update step of the Kalman filter, using gps velocity
+     * \brief   Queues the gps velocity for the update step of the Kalman filter
      */
     void update_gps_vel(void);
 
 
     /**
-     * \brief   Performs the update step of the Kalman filter, using motion capture system
+     * \brief   Queues the motion capture position for the update step of the Kalman filter
      */
     void update_gps_mocap(void);
 
 
     /**
-     * \brief   Performs the update step of the Kalman filter, using barometer
+     * \brief   Queues the barometer altitude for the update step of the Kalman filter
      */
     void update_barometer(void);
 
 
     /**
-     * \brief   Performs the update step of the Kalman filter, using sonar
+     * \brief   Queues the sonar distance for the update step of the Kalman filter
      */
     void update_sonar(void);
 
 
     /**
-     * \brief   Performs the update step of the Kalman filter, using optic flow
+     * \brief   Queues the optic flow velocity for the update step of the Kalman filter
      */
     void update_flow(void);
+
+
+    /**
+     * \brief   Adds a measurement to the list of measurements to fuse
+     *
+     * \param   type        Type of measurement
+     * \param   time_s      Time at which the measurement was taken, in seconds
+     * \param   z           Measurement vector (1 or 3 components)
+     * \param   sigma       Standard deviation of each component
+     */
+    void queue_measurement(measurement_type_t type, float time_s, const float z[3], const float sigma[3]);
+
+
+    /**
+     * \brief   Performs the update step of the Kalman filter for one measurement
+     *
+     * \param   measurement     Measurement
+     */
+    void apply_measurement(const measurement_t& measurement);
+
+
+    /**
+     * \brief   Fuses pending measurements at their step and predicts again up to the present
+     */
+    void fuse_pending(void);
+
+
+    /**
+     * \brief   Keeps a fused measurement for later replays
+     *
+     * \param   measurement     Measurement
+     */
+    void record_fused(const measurement_t& measurement);
+
+
+    /**
+     * \brief   Get the oldest prediction step from which the filter can be replayed
+     *
+     * \return  step index
+     */
+    uint32_t oldest_step(void) const;
+
+
+    /**
+     * \brief   Saves state and covariance if the step is a snapshot step
+     *
+     * \param   step    Index of the prediction step
+     */
+    void save_snapshot(uint32_t step);
 };
 
 
@@ -334,6 +462,13 @@ INS_kf::conf_t INS_kf::default_config(void)
     conf.sigma_flow         = 0.002f;
     conf.sigma_sonar        = 0.002f;       // Measured: 0.002f
 
+    // Measurement delays
+    conf.delay_gps_s        = 0.1f;
+    conf.delay_gps_mocap_s  = 0.0f;
+    conf.delay_baro_s       = 0.0f;
+    conf.delay_sonar_s      = 0.0f;
+    conf.delay_flow_s       = 0.02f;
+
     //default origin location (EFPL Esplanade)
     conf.origin = ORIGIN_EPFL;
 
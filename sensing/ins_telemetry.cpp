@@ -131,7 +131,7 @@ void ins_telemetry_send_global_position_int(const INS* ins, const Mavlink_stream
     std::array<float,3> vel_lf = ins->velocity_lf();
 
     global_position_t pos_gf;
-    coord_conventions_local_to_global_position(pos_lf, ins->origin(), pos_gf);
+    ins->projection().local_to_global(pos_lf, pos_gf);
 
 
     //mavlink_msg_global_position_int_send(mavlink_channel_t chan, uint32_t time_boot_ms, int32_t lat, int32_t lon, int32_t alt, int32_t relative_alt, int16_t vx, int16_t vy, int16_t vz, uint16_t hdg)
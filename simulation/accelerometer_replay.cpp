@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file accelerometer_replay.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Accelerometer returning samples read from a sensor log
+ *
+ ******************************************************************************/
+
+
+#include "simulation/accelerometer_replay.hpp"
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Accelerometer_replay::Accelerometer_replay(void):
+    acc_(std::array<float, 3>{{0.0f, 0.0f, 0.0f}}),
+    temperature_(0.0f),
+    last_update_us_(0.0f)
+{}
+
+
+bool Accelerometer_replay::init(void)
+{
+    return true;
+}
+
+
+bool Accelerometer_replay::update(void)
+{
+    return true;
+}
+
+
+void Accelerometer_replay::push(const std::array<float, 3>& acc, float temperature, uint64_t time_us)
+{
+    acc_            = acc;
+    temperature_    = temperature;
+    last_update_us_ = (float)time_us;
+}
+
+
+const float& Accelerometer_replay::last_update_us(void) const
+{
+    return last_update_us_;
+}
+
+
+const std::array<float, 3>& Accelerometer_replay::acc(void) const
+{
+    return acc_;
+}
+
+
+const float& Accelerometer_replay::acc_X(void) const
+{
+    return acc_[0];
+}
+
+
+const float& Accelerometer_replay::acc_Y(void) const
+{
+    return acc_[1];
+}
+
+
+const float& Accelerometer_replay::acc_Z(void) const
+{
+    return acc_[2];
+}
+
+
+const float& Accelerometer_replay::temperature(void) const
+{
+    return temperature_;
+}
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file barometer_replay.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Barometer returning samples read from a sensor log
+ *
+ ******************************************************************************/
+
+
+#include "simulation/barometer_replay.hpp"
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Barometer_replay::Barometer_replay(void):
+    pressure_(0.0f),
+    altitude_gf_(0.0f),
+    speed_lf_(0.0f),
+    temperature_(0.0f),
+    last_update_us_(0)
+{}
+
+
+bool Barometer_replay::init(void)
+{
+    return true;
+}
+
+
+bool Barometer_replay::update(void)
+{
+    return true;
+}
+
+
+void Barometer_replay::push(float pressure, float altitude_gf, float vertical_speed_lf, float temperature, uint64_t time_us)
+{
+    pressure_       = pressure;
+    altitude_gf_    = altitude_gf;
+    speed_lf_       = vertical_speed_lf;
+    temperature_    = temperature;
+    last_update_us_ = time_us;
+}
+
+
+uint64_t Barometer_replay::last_update_us(void) const
+{
+    return last_update_us_;
+}
+
+
+float Barometer_replay::pressure(void)  const
+{
+    return pressure_;
+}
+
+
+float Barometer_replay::altitude_gf(void) const
+{
+    return altitude_gf_;
+}
+
+
+float Barometer_replay::altitude_gf_raw(void) const
+{
+    return altitude_gf();
+}
+
+
+float Barometer_replay::vertical_speed_lf(void) const
+{
+    return speed_lf_;
+}
+
+
+float Barometer_replay::vertical_speed_lf_raw(void) const
+{
+    return vertical_speed_lf();
+}
+
+
+float Barometer_replay::temperature(void) const
+{
+    return temperature_;
+}
@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file barometer_replay.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Barometer returning samples read from a sensor log
+ *
+ ******************************************************************************/
+
+
+#ifndef BAROMETER_REPLAY_HPP_
+#define BAROMETER_REPLAY_HPP_
+
+
+#include <cstdint>
+
+#include "drivers/barometer.hpp"
+
+/**
+ * \brief   Replayed barometer
+ *
+ * \details Samples are pushed by Sensor_replay, update() does not read anything
+ */
+class Barometer_replay: public Barometer
+{
+public:
+    /**
+     * \brief   Constructor
+     */
+    Barometer_replay(void);
+
+
+    /**
+     * \brief   Initialise the sensor
+     *
+     * \return  Success
+     */
+    bool init(void);
+
+
+    /**
+     * \brief   Main update function
+     * \detail  Does nothing, samples are pushed from the log
+     *
+     * \return  Success
+     */
+    bool update(void);
+
+
+    /**
+     * \brief   Set the current sample
+     *
+     * \param   pressure            Pressure in Pa
+     * \param   altitude_gf         Altitude above sea level in m (>0 means upward)
+     * \param   vertical_speed_lf   Vertical speed in m/s (>0 means downward)
+     * \param   temperature         Sensor temperature
+     * \param   time_us             Time of the sample in microseconds
+     */
+    void push(float pressure, float altitude_gf, float vertical_speed_lf, float temperature, uint64_t time_us);
+
+
+    /**
+     * \brief   Get the last update time in microseconds
+     *
+     * \return  Value
+     */
+    uint64_t last_update_us(void) const;
+
+
+    /**
+     * \brief   Return the pressure (in Pa)
+     *
+     * \return  Value
+     */
+    float pressure(void)  const;
+
+
+    /**
+     * \brief   Get the altitude in meters above sea level
+     *
+     * \detail  Global frame: (>0 means upward)
+     *
+     * \return  Value
+     */
+    float altitude_gf(void) const;
+
+
+    /**
+     * \brief   Get the altitude in meters above sea level (not filtered)
+     *
+     * \detail  The log contains the output of the driver, so this is the same as altitude_gf
+     *
+     * \return  Value
+     */
+    float altitude_gf_raw(void) const;
+
+
+    /**
+     * \brief   Get the vertical speed in meters/second
+     *
+     * \detail  NED frame: (>0 means downward)
+     *
+     * \return  Value
+     */
+    float vertical_speed_lf(void) const;
+
+
+    /**
+     * \brief   Get the vertical speed in meters/second (not filtered)
+     *
+     * \detail  The log contains the output of the driver, so this is the same as vertical_speed_lf
+     *
+     * \return  Value
+     */
+    float vertical_speed_lf_raw(void) const;
+
+
+    /**
+     * \brief   Get sensor temperature
+     *
+     * \return  Value
+     */
+    float temperature(void) const;
+
+
+private:
+    float       pressure_;          ///< Pressure in Pa
+    float       altitude_gf_;       ///< Altitude above sea level in m
+    float       speed_lf_;          ///< Vertical speed in m/s
+    float       temperature_;       ///< Temperature
+    uint64_t    last_update_us_;    ///< Last update time in microseconds
+};
+
+#endif /* BAROMETER_REPLAY_HPP_ */
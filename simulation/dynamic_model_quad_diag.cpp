@@ -82,7 +82,7 @@ Dynamic_model_quad_diag::Dynamic_model_quad_diag(Servo& servo_rear_left,
     local_position_[2]  = 0.0f;
 
     // Init global position
-    coord_conventions_local_to_global_position(local_position_, INS::origin(), global_position_);
+    INS::projection().local_to_global(local_position_, global_position_);
 }
 
 
@@ -191,7 +191,7 @@ bool Dynamic_model_quad_diag::update(void)
         local_position_[i] = local_position_[i] + vel_[i] * dt_s_;
     }
 
-    coord_conventions_local_to_global_position(local_position_, INS::origin(), global_position_);
+    INS::projection().local_to_global(local_position_, global_position_);
 
     return true;
 }
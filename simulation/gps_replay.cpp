@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file gps_replay.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   GPS returning samples read from a sensor log
+ *
+ ******************************************************************************/
+
+
+#include "simulation/gps_replay.hpp"
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Gps_replay::Gps_replay(void):
+    sample_({{0.0, 0.0, 0.0f}, 0.0f, 0.0f, std::array<float, 3>{{0.0f, 0.0f, 0.0f}}, 0.0f, 0.0f, 0.0f, 0, FIX_ERR, false}),
+    last_update_us_(0.0f)
+{}
+
+
+bool Gps_replay::init(void)
+{
+    return true;
+}
+
+
+void Gps_replay::configure(void)
+{
+    ;
+}
+
+
+bool Gps_replay::update(void)
+{
+    return true;
+}
+
+
+void Gps_replay::push(const sample_t& sample, uint64_t time_us)
+{
+    sample_         = sample;
+    last_update_us_ = (float)time_us;
+}
+
+
+float Gps_replay::last_update_us(void) const
+{
+    return last_update_us_;
+}
+
+
+float Gps_replay::last_position_update_us(void) const
+{
+    return last_update_us_;
+}
+
+
+float Gps_replay::last_velocity_update_us(void) const
+{
+    return last_update_us_;
+}
+
+
+global_position_t Gps_replay::position_gf(void) const
+{
+    return sample_.position_gf;
+}
+
+
+float Gps_replay::horizontal_position_accuracy(void) const
+{
+    return sample_.horizontal_position_accuracy;
+}
+
+
+float Gps_replay::vertical_position_accuracy(void) const
+{
+    return sample_.vertical_position_accuracy;
+}
+
+
+std::array<float, 3> Gps_replay::velocity_lf(void) const
+{
+    return sample_.velocity_lf;
+}
+
+
+float Gps_replay::velocity_accuracy(void) const
+{
+    return sample_.velocity_accuracy;
+}
+
+
+float Gps_replay::heading(void) const
+{
+    return sample_.heading;
+}
+
+
+float Gps_replay::heading_accuracy(void) const
+{
+    return sample_.heading_accuracy;
+}
+
+
+uint8_t Gps_replay::num_sats(void) const
+{
+    return sample_.num_sats;
+}
+
+
+gps_fix_t Gps_replay::fix(void) const
+{
+    return sample_.fix;
+}
+
+
+bool Gps_replay::healthy(void) const
+{
+    return sample_.healthy;
+}
@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file gps_replay.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   GPS returning samples read from a sensor log
+ *
+ ******************************************************************************/
+
+
+#ifndef GPS_REPLAY_HPP_
+#define GPS_REPLAY_HPP_
+
+
+#include <array>
+#include <cstdint>
+
+#include "drivers/gps.hpp"
+
+/**
+ * \brief   Replayed GPS
+ *
+ * \details Samples are pushed by Sensor_replay, update() does not read anything.
+ *          Position and velocity are updated together
+ */
+class Gps_replay: public Gps
+{
+public:
+    /**
+     * \brief   GPS sample
+     */
+    struct sample_t
+    {
+        global_position_t       position_gf;                    ///< Global position
+        float                   horizontal_position_accuracy;   ///< Accuracy of position on horizontal plane in m
+        float                   vertical_position_accuracy;     ///< Accuracy of position on vertical axis in m
+        std::array<float, 3>    velocity_lf;                    ///< 3D Velocity in local frame in m/s
+        float                   velocity_accuracy;              ///< Accuracy of velocity in m/s
+        float                   heading;                        ///< Heading in degrees
+        float                   heading_accuracy;               ///< Accuracy of heading in degrees
+        uint8_t                 num_sats;                       ///< Number of satellites
+        gps_fix_t               fix;                            ///< Fix status
+        bool                    healthy;                        ///< Sensor status
+    };
+
+
+    /**
+     * \brief   Constructor
+     */
+    Gps_replay(void);
+
+
+    /**
+     * \brief   Initialise the sensor
+     *
+     * \return  Success
+     */
+    bool init(void);
+
+
+    /**
+     * \brief   Configure the sensor
+     */
+    void configure(void);
+
+
+    /**
+     * \brief   Main update function
+     * \detail  Does nothing, samples are pushed from the log
+     *
+     * \return  Success
+     */
+    bool update(void);
+
+
+    /**
+     * \brief   Set the current sample
+     *
+     * \param   sample      GPS sample
+     * \param   time_us     Time of the sample in microseconds
+     */
+    void push(const sample_t& sample, uint64_t time_us);
+
+
+    /**
+     * \brief   Get last update time in microseconds
+     *
+     * \return  Update time
+     */
+    float last_update_us(void) const;
+
+
+    /**
+     * \brief   Get last position update time in microseconds
+     *
+     * \return  Update time
+     */
+    float last_position_update_us(void) const;
+
+
+    /**
+     * \brief   Get last velocity update time in microseconds
+     *
+     * \return  Update time
+     */
+    float last_velocity_update_us(void) const;
+
+
+    /**
+     * \brief   Get position in global frame
+     *
+     * \return  position
+     */
+    global_position_t position_gf(void) const;
+
+
+    /**
+     * \brief   Get horizontal position accuracy in m
+     *
+     * \return  accuracy
+     */
+    float horizontal_position_accuracy(void) const;
+
+
+    /**
+     * \brief   Get vertical position accuracy in m
+     *
+     * \return  accuracy
+     */
+    float vertical_position_accuracy(void) const;
+
+
+    /**
+     * \brief   Get velocity in local frame in m/s
+     *
+     * \return  3D velocity
+     */
+    std::array<float, 3> velocity_lf(void) const;
+
+
+    /**
+     * \brief   Get velocity accuracy in m/s
+     *
+     * \return  velocity accuracy
+     */
+    float velocity_accuracy(void) const;
+
+
+    /**
+     * \brief   Get heading in degrees
+     *
+     * \return  heading
+     */
+    float heading(void) const;
+
+
+    /**
+     * \brief   Get heading accuracy in degrees
+     *
+     * \return  accuracy
+     */
+    float heading_accuracy(void) const;
+
+
+    /**
+     * \brief   Get the number of satellites
+     *
+     * \return  Value
+     */
+    uint8_t num_sats(void) const;
+
+
+    /**
+     * \brief   Indicates whether fix are received
+     *
+     * \return  Value
+     */
+    gps_fix_t fix(void) const;
+
+
+    /**
+     * \brief   Indicates whether the measurements can be trusted
+     *
+     * \return  Value
+     */
+    bool healthy(void) const;
+
+private:
+    sample_t    sample_;            ///< Last sample
+    float       last_update_us_;    ///< Last update time in microseconds
+};
+
+#endif /* GPS_REPLAY_HPP_ */
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file px4flow_replay.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   PX4Flow returning samples read from a sensor log
+ *
+ ******************************************************************************/
+
+
+#ifndef PX4FLOW_REPLAY_HPP_
+#define PX4FLOW_REPLAY_HPP_
+
+
+#include <cstdint>
+
+#include "drivers/px4flow.hpp"
+
+/**
+ * \brief   Replayed optic flow camera
+ *
+ * \details Samples are pushed by Sensor_replay, update() does not read anything.
+ *          The log contains values already rotated to the body frame
+ */
+class PX4Flow_replay: public PX4Flow
+{
+public:
+    /**
+     * \brief   Optic flow sample
+     */
+    struct sample_t
+    {
+        float   flow_x;             ///< Optic flow in x direction (rad/s)
+        float   flow_y;             ///< Optic flow in y direction (rad/s)
+        uint8_t flow_quality;       ///< Quality of optic flow measurement (between 0 and 255)
+        float   velocity_x;         ///< Velocity in x direction (m/s)
+        float   velocity_y;         ///< Velocity in y direction (m/s)
+        float   velocity_z;         ///< Velocity in z direction (m/s)
+        float   ground_distance;    ///< Ground distance (m)
+        bool    healthy;            ///< Indicates if sensor data can be trusted
+    };
+
+
+    /**
+     * \brief   Constructor
+     */
+    PX4Flow_replay(void);
+
+
+    /**
+     * \brief   Main update function
+     * \detail  Does nothing, samples are pushed from the log
+     *
+     * \return  Success
+     */
+    bool update(void);
+
+
+    /**
+     * \brief   Set the current sample
+     *
+     * \param   sample      Optic flow sample
+     * \param   time_us     Time of the sample in microseconds
+     */
+    void push(const sample_t& sample, uint64_t time_us);
+};
+
+#endif /* PX4FLOW_REPLAY_HPP_ */
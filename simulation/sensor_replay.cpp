@@ -0,0 +1,352 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file sensor_replay.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Replay of recorded sensor logs
+ *
+ ******************************************************************************/
+
+
+#include "simulation/sensor_replay.hpp"
+
+#include <cstring>
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS DECLARATION
+//------------------------------------------------------------------------------
+
+/**
+ * \brief   Decodes little endian integers and floats
+ *
+ * \param   data    Pointer to the first byte
+ *
+ * \return  Value
+ */
+static uint16_t get_u16(const uint8_t* data);
+static uint32_t get_u32(const uint8_t* data);
+static uint64_t get_u64(const uint8_t* data);
+static float get_float(const uint8_t* data);
+static double get_double(const uint8_t* data);
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+static uint16_t get_u16(const uint8_t* data)
+{
+    return (uint16_t)data[0] | ((uint16_t)data[1] << 8);
+}
+
+
+static uint32_t get_u32(const uint8_t* data)
+{
+    return (uint32_t)get_u16(data) | ((uint32_t)get_u16(data + 2) << 16);
+}
+
+
+static uint64_t get_u64(const uint8_t* data)
+{
+    return (uint64_t)get_u32(data) | ((uint64_t)get_u32(data + 4) << 32);
+}
+
+
+static float get_float(const uint8_t* data)
+{
+    uint32_t bits = get_u32(data);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+static double get_double(const uint8_t* data)
+{
+    uint64_t bits = get_u64(data);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+bool Sensor_replay::read(uint8_t* data, uint32_t size)
+{
+    if (offset_ + size > length_)
+    {
+        offset_ = length_;
+        return false;
+    }
+
+    file_.read(data, size);
+    offset_ += size;
+
+    return true;
+}
+
+
+bool Sensor_replay::dispatch(uint8_t type, const uint8_t* payload, uint8_t size, uint64_t time_us)
+{
+    switch (type)
+    {
+        case RECORD_ACCELEROMETER:
+        case RECORD_GYROSCOPE:
+        case RECORD_MAGNETOMETER:
+        {
+            if (size != 16)
+            {
+                return false;
+            }
+            std::array<float, 3> xyz = {{get_float(&payload[0]), get_float(&payload[4]), get_float(&payload[8])}};
+            float temperature        = get_float(&payload[12]);
+            if (type == RECORD_ACCELEROMETER)
+            {
+                accelerometer_.push(xyz, temperature, time_us);
+            }
+            else if (type == RECORD_GYROSCOPE)
+            {
+                gyroscope_.push(xyz, temperature, time_us);
+            }
+            else
+            {
+                magnetometer_.push(xyz, temperature, time_us);
+            }
+        }
+        break;
+
+        case RECORD_BAROMETER:
+            if (size != 16)
+            {
+                return false;
+            }
+            barometer_.push(get_float(&payload[0]),
+                            get_float(&payload[4]),
+                            get_float(&payload[8]),
+                            get_float(&payload[12]),
+                            time_us);
+        break;
+
+        case RECORD_GPS:
+        {
+            if (size != 54)
+            {
+                return false;
+            }
+            Gps_replay::sample_t sample;
+            sample.position_gf.latitude           = get_double(&payload[0]);
+            sample.position_gf.longitude          = get_double(&payload[8]);
+            sample.position_gf.altitude           = get_float(&payload[16]);
+            sample.horizontal_position_accuracy   = get_float(&payload[20]);
+            sample.vertical_position_accuracy     = get_float(&payload[24]);
+            sample.velocity_lf[0]                 = get_float(&payload[28]);
+            sample.velocity_lf[1]                 = get_float(&payload[32]);
+            sample.velocity_lf[2]                 = get_float(&payload[36]);
+            sample.velocity_accuracy              = get_float(&payload[40]);
+            sample.heading                        = get_float(&payload[44]);
+            sample.heading_accuracy               = get_float(&payload[48]);
+            sample.num_sats                       = payload[52];
+            sample.fix                            = (gps_fix_t)(payload[53] & 0x7F);
+            sample.healthy                        = (payload[53] & 0x80) != 0;
+            gps_.push(sample, time_us);
+        }
+        break;
+
+        case RECORD_SONAR:
+            if (size != 9)
+            {
+                return false;
+            }
+            sonar_.push(get_float(&payload[0]), get_float(&payload[4]), payload[8] != 0, time_us);
+        break;
+
+        case RECORD_FLOW:
+        {
+            if (size != 26)
+            {
+                return false;
+            }
+            PX4Flow_replay::sample_t sample;
+            sample.flow_x          = get_float(&payload[0]);
+            sample.flow_y          = get_float(&payload[4]);
+            sample.velocity_x      = get_float(&payload[8]);
+            sample.velocity_y      = get_float(&payload[12]);
+            sample.velocity_z      = get_float(&payload[16]);
+            sample.ground_distance = get_float(&payload[20]);
+            sample.flow_quality    = payload[24];
+            sample.healthy         = payload[25] != 0;
+            flow_.push(sample, time_us);
+        }
+        break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Sensor_replay::Sensor_replay(File& file):
+    file_(file),
+    length_(0),
+    offset_(0),
+    type_(RECORD_NONE),
+    time_us_(0),
+    stats_({0, 0, 0})
+{}
+
+
+bool Sensor_replay::init(void)
+{
+    uint8_t header[8];
+
+    length_  = file_.length();
+    offset_  = 0;
+    type_    = RECORD_NONE;
+    time_us_ = 0;
+    stats_   = {0, 0, 0};
+
+    if (file_.seek(0, FILE_SEEK_START) == false)
+    {
+        return false;
+    }
+
+    if (read(header, sizeof(header)) == false)
+    {
+        return false;
+    }
+
+    return (get_u32(&header[0]) == MAGIC) && (get_u16(&header[4]) == VERSION);
+}
+
+
+bool Sensor_replay::next(void)
+{
+    uint8_t header[10];
+
+    while (read(header, sizeof(header)))
+    {
+        uint8_t  type    = header[0];
+        uint8_t  size    = header[1];
+        uint64_t time_us = get_u64(&header[2]);
+
+        if (read(payload_, size) == false)
+        {
+            return false;
+        }
+
+        if (dispatch(type, payload_, size, time_us))
+        {
+            type_    = (record_t)type;
+            time_us_ = time_us;
+            stats_.records++;
+            return true;
+        }
+        else if (type > RECORD_FLOW)
+        {
+            stats_.skipped++;
+        }
+        else
+        {
+            stats_.errors++;
+        }
+    }
+
+    return false;
+}
+
+
+Sensor_replay::record_t Sensor_replay::type(void) const
+{
+    return type_;
+}
+
+
+uint64_t Sensor_replay::time_us(void) const
+{
+    return time_us_;
+}
+
+
+const Sensor_replay::stats_t& Sensor_replay::stats(void) const
+{
+    return stats_;
+}
+
+
+Accelerometer& Sensor_replay::accelerometer(void)
+{
+    return accelerometer_;
+}
+
+
+Gyroscope& Sensor_replay::gyroscope(void)
+{
+    return gyroscope_;
+}
+
+
+Magnetometer& Sensor_replay::magnetometer(void)
+{
+    return magnetometer_;
+}
+
+
+Barometer& Sensor_replay::barometer(void)
+{
+    return barometer_;
+}
+
+
+Gps& Sensor_replay::gps(void)
+{
+    return gps_;
+}
+
+
+Sonar& Sensor_replay::sonar(void)
+{
+    return sonar_;
+}
+
+
+PX4Flow& Sensor_replay::flow(void)
+{
+    return flow_;
+}
@@ -0,0 +1,272 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file sensor_replay.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Replay of recorded sensor logs
+ *
+ * \details The log is a binary file, all values are little endian and floats
+ *          are IEEE 754 single precision. It starts with an 8 bytes header:
+ *              uint32 magic ("MSLG"), uint16 version, uint16 reserved
+ *          followed by records:
+ *              uint8 type, uint8 payload size, uint64 time_us, payload
+ *          Payloads are:
+ *          - ACCELEROMETER, GYROSCOPE, MAGNETOMETER (16 bytes):
+ *              float x, y, z (raw, sensor frame), float temperature
+ *          - BAROMETER (16 bytes):
+ *              float pressure, altitude_gf, vertical_speed_lf, temperature
+ *          - GPS (54 bytes):
+ *              double latitude, longitude, float altitude,
+ *              float horizontal_accuracy, vertical_accuracy,
+ *              float velocity_lf x, y, z, float velocity_accuracy,
+ *              float heading, heading_accuracy, uint8 num_sats,
+ *              uint8 fix (bits 0-6) and healthy (bit 7)
+ *          - SONAR (9 bytes):
+ *              float distance, velocity, uint8 healthy
+ *          - FLOW (26 bytes):
+ *              float flow_x, flow_y, velocity_x, velocity_y, velocity_z,
+ *              float ground_distance, uint8 quality, uint8 healthy
+ *          Records of unknown type are skipped, so that new sensors can be
+ *          added to the format without breaking older readers
+ *
+ ******************************************************************************/
+
+
+#ifndef SENSOR_REPLAY_HPP_
+#define SENSOR_REPLAY_HPP_
+
+
+#include <cstdint>
+
+#include "hal/common/file.hpp"
+#include "simulation/accelerometer_replay.hpp"
+#include "simulation/gyroscope_replay.hpp"
+#include "simulation/magnetometer_replay.hpp"
+#include "simulation/barometer_replay.hpp"
+#include "simulation/gps_replay.hpp"
+#include "simulation/sonar_replay.hpp"
+#include "simulation/px4flow_replay.hpp"
+
+
+/**
+ * \brief   Reads a sensor log and pushes each record to the corresponding replayed sensor
+ *
+ * \details The replayed sensors are used in place of the hardware drivers to
+ *          run the estimators on recorded data. The log sets the time: the
+ *          caller should start a Cycle_clock cycle at time_us() after each
+ *          call to next()
+ */
+class Sensor_replay
+{
+public:
+    /**
+     * \brief   Type of records
+     */
+    enum record_t
+    {
+        RECORD_NONE          = 0,
+        RECORD_ACCELEROMETER = 1,
+        RECORD_GYROSCOPE     = 2,
+        RECORD_MAGNETOMETER  = 3,
+        RECORD_BAROMETER     = 4,
+        RECORD_GPS           = 5,
+        RECORD_SONAR         = 6,
+        RECORD_FLOW          = 7,
+    };
+
+
+    static const uint32_t MAGIC       = 0x474C534D;   ///< "MSLG" in little endian
+    static const uint16_t VERSION     = 1;            ///< Version of the log format
+    static const uint32_t MAX_PAYLOAD = 255;          ///< Maximum size of a payload
+
+
+    /**
+     * \brief   Statistics
+     */
+    struct stats_t
+    {
+        uint32_t records;           ///< Number of records pushed to sensors
+        uint32_t skipped;           ///< Number of records of unknown type
+        uint32_t errors;            ///< Number of records with invalid size
+    };
+
+
+    /**
+     * \brief   Constructor
+     *
+     * \param   file    Log file, already open
+     */
+    Sensor_replay(File& file);
+
+
+    /**
+     * \brief   Reads the header of the log
+     *
+     * \return  Success, false if the file is not a sensor log of a supported version
+     */
+    bool init(void);
+
+
+    /**
+     * \brief   Reads the next record and pushes it to the corresponding sensor
+     *
+     * \details Records of unknown type are skipped
+     *
+     * \return  False at the end of the log, or if the end of the log is truncated
+     */
+    bool next(void);
+
+
+    /**
+     * \brief   Get the type of the last record
+     *
+     * \return  Type
+     */
+    record_t type(void) const;
+
+
+    /**
+     * \brief   Get the time of the last record
+     *
+     * \return  Time in microseconds
+     */
+    uint64_t time_us(void) const;
+
+
+    /**
+     * \brief   Get statistics
+     *
+     * \return  Statistics
+     */
+    const stats_t& stats(void) const;
+
+
+    /**
+     * \brief   Get replayed accelerometer
+     *
+     * \return  Reference to accelerometer
+     */
+    Accelerometer& accelerometer(void);
+
+
+    /**
+     * \brief   Get replayed gyroscope
+     *
+     * \return  Reference to gyroscope
+     */
+    Gyroscope& gyroscope(void);
+
+
+    /**
+     * \brief   Get replayed magnetometer
+     *
+     * \return  Reference to magnetometer
+     */
+    Magnetometer& magnetometer(void);
+
+
+    /**
+     * \brief   Get replayed barometer
+     *
+     * \return  Reference to barometer
+     */
+    Barometer& barometer(void);
+
+
+    /**
+     * \brief   Get replayed gps
+     *
+     * \return  Reference to gps
+     */
+    Gps& gps(void);
+
+
+    /**
+     * \brief   Get replayed sonar
+     *
+     * \return  Reference to sonar
+     */
+    Sonar& sonar(void);
+
+
+    /**
+     * \brief   Get replayed optic flow camera
+     *
+     * \return  Reference to optic flow camera
+     */
+    PX4Flow& flow(void);
+
+
+private:
+    /**
+     * \brief   Reads bytes from the log
+     *
+     * \param   data    Output buffer
+     * \param   size    Number of bytes
+     *
+     * \return  False if the log does not contain enough bytes
+     */
+    bool read(uint8_t* data, uint32_t size);
+
+
+    /**
+     * \brief   Pushes a record to the corresponding sensor
+     *
+     * \param   type        Type of record
+     * \param   payload     Payload
+     * \param   size        Size of payload
+     * \param   time_us     Time of the record
+     *
+     * \return  False if the type is unknown or the size does not match the type
+     */
+    bool dispatch(uint8_t type, const uint8_t* payload, uint8_t size, uint64_t time_us);
+
+    File&                   file_;                  ///< Log file
+    uint32_t                length_;                ///< Length of the log in bytes
+    uint32_t                offset_;                ///< Current offset in the log
+    record_t                type_;                  ///< Type of the last record
+    uint64_t                time_us_;               ///< Time of the last record
+    stats_t                 stats_;                 ///< Statistics
+    uint8_t                 payload_[MAX_PAYLOAD];  ///< Payload of the current record
+
+    Accelerometer_replay    accelerometer_;         ///< Replayed accelerometer
+    Gyroscope_replay        gyroscope_;             ///< Replayed gyroscope
+    Magnetometer_replay     magnetometer_;          ///< Replayed magnetometer
+    Barometer_replay        barometer_;             ///< Replayed barometer
+    Gps_replay              gps_;                   ///< Replayed gps
+    Sonar_replay            sonar_;                 ///< Replayed sonar
+    PX4Flow_replay          flow_;                  ///< Replayed optic flow camera
+};
+
+#endif /* SENSOR_REPLAY_HPP_ */
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file sonar_replay.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Sonar returning samples read from a sensor log
+ *
+ ******************************************************************************/
+
+
+#include "simulation/sonar_replay.hpp"
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Sonar_replay::Sonar_replay(std::array<float, 3> orientation_bf):
+    orientation_bf_(orientation_bf),
+    distance_(0.0f),
+    velocity_(0.0f),
+    last_update_us_(0.0f),
+    healthy_(false)
+{}
+
+
+bool Sonar_replay::init(void)
+{
+    return true;
+}
+
+
+bool Sonar_replay::update(void)
+{
+    return true;
+}
+
+
+void Sonar_replay::push(float distance, float velocity, bool healthy, uint64_t time_us)
+{
+    distance_       = distance;
+    velocity_       = velocity;
+    healthy_        = healthy;
+    last_update_us_ = (float)time_us;
+}
+
+
+const float& Sonar_replay::last_update_us(void) const
+{
+    return last_update_us_;
+}
+
+
+const std::array<float, 3>& Sonar_replay::orientation_bf(void) const
+{
+    return orientation_bf_;
+}
+
+
+const float& Sonar_replay::distance(void) const
+{
+    return distance_;
+}
+
+
+const float& Sonar_replay::velocity(void) const
+{
+    return velocity_;
+}
+
+
+const bool& Sonar_replay::healthy(void) const
+{
+    return healthy_;
+}
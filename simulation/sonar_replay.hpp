@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file sonar_replay.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief   Sonar returning samples read from a sensor log
+ *
+ ******************************************************************************/
+
+
+#ifndef SONAR_REPLAY_HPP_
+#define SONAR_REPLAY_HPP_
+
+
+#include <array>
+#include <cstdint>
+
+#include "drivers/sonar.hpp"
+
+/**
+ * \brief   Replayed sonar
+ *
+ * \details Samples are pushed by Sensor_replay, update() does not read anything
+ */
+class Sonar_replay: public Sonar
+{
+public:
+    /**
+     * \brief   Constructor
+     *
+     * \param   orientation_bf  Sensor orientation relative to the body frame
+     */
+    Sonar_replay(std::array<float, 3> orientation_bf = std::array<float, 3> {{0.0f, 0.0f, 1.0f}});
+
+
+    /**
+     * \brief   Initialise the sensor
+     *
+     * \return  Success
+     */
+    bool init(void);
+
+
+    /**
+     * \brief   Main update function
+     * \detail  Does nothing, samples are pushed from the log
+     *
+     * \return  Success
+     */
+    bool update(void);
+
+
+    /**
+     * \brief   Set the current sample
+     *
+     * \param   distance    Distance in m
+     * \param   velocity    Velocity in m/s
+     * \param   healthy     Sensor status
+     * \param   time_us     Time of the sample in microseconds
+     */
+    void push(float distance, float velocity, bool healthy, uint64_t time_us);
+
+
+    /**
+     * \brief   Get last update time in microseconds
+     *
+     * \return  Update time
+     */
+    const float& last_update_us(void) const;
+
+
+    /**
+     * \brief   Get sensor orientation relative to the body frame
+     *
+     * \return  Unit vector
+     */
+    const std::array<float, 3>& orientation_bf(void) const;
+
+
+    /**
+     * \brief   Get latest distance measure
+     *
+     * \return  Value
+     */
+    const float& distance(void) const;
+
+
+    /**
+     * \brief   Get latest velocity estimate
+     *
+     * \return  Value
+     */
+    const float& velocity(void) const;
+
+
+    /**
+     * \brief   Indicates whether the measurements can be trusted
+     *
+     * \return  Value
+     */
+    const bool& healthy(void) const;
+
+
+private:
+    std::array<float, 3>    orientation_bf_;    ///< Sensor orientation relative to the body frame
+    float                   distance_;          ///< Current distance
+    float                   velocity_;          ///< Current velocity
+    float                   last_update_us_;    ///< Last update time in microseconds
+    bool                    healthy_;           ///< Sensor status
+};
+
+#endif /* SONAR_REPLAY_HPP_ */
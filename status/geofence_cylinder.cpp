@@ -59,8 +59,8 @@ bool Geofence_cylinder::is_allowed(const global_position_t& position) const
     // Get position in local frame
     local_position_t position_lf;
     local_position_t center_lf;
-    coord_conventions_global_to_local_position(position,        INS::origin(), position_lf);
-    coord_conventions_global_to_local_position(config_.center,  INS::origin(), center_lf);
+    INS::projection().global_to_local(position,       position_lf);
+    INS::projection().global_to_local(config_.center, center_lf);
 
     // Get distance to fence center
     float dist_xy_sqr = SQR(position_lf[X] - center_lf[X]) + SQR(position_lf[Y] - center_lf[Y]);
@@ -83,8 +83,8 @@ bool Geofence_cylinder::closest_border(const global_position_t& current_position
     // Get position in local frame
     local_position_t position_lf;
     local_position_t center_lf;
-    coord_conventions_global_to_local_position(current_position, INS::origin(), position_lf);
-    coord_conventions_global_to_local_position(config_.center,   INS::origin(), center_lf);
+    INS::projection().global_to_local(current_position, position_lf);
+    INS::projection().global_to_local(config_.center,   center_lf);
 
     // Unit vector from cylinder center to current position
     float u[3];
@@ -115,7 +115,7 @@ bool Geofence_cylinder::closest_border(const global_position_t& current_position
     if (border_cyl_dist_sqr < border_top_dist_sqr)
     {
         // Convert to global frame
-        coord_conventions_local_to_global_position(border_cyl, INS::origin(), border_position);
+        INS::projection().local_to_global(border_cyl, border_position);
 
         // Return shortest distance
         distance = maths_fast_sqrt(border_cyl_dist_sqr);
@@ -123,7 +123,7 @@ bool Geofence_cylinder::closest_border(const global_position_t& current_position
     else
     {
         // Convert to global frame
-        coord_conventions_local_to_global_position(border_top, INS::origin(), border_position);
+        INS::projection().local_to_global(border_top, border_position);
 
         // Return shortest distance
         distance = maths_fast_sqrt(border_top_dist_sqr);
@@ -0,0 +1,545 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+* \file geofence_polygon.cpp
+*
+* \author MAV'RIC Team
+*
+* \brief  Geofence made of polygonal zones with altitude bands
+*
+******************************************************************************/
+
+
+#include "status/geofence_polygon.hpp"
+#include "sensing/ins.hpp"
+
+extern "C"
+{
+#include "util/maths.h"
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS DECLARATION
+//------------------------------------------------------------------------------
+
+/**
+ * \brief   Indicates on which side of the line (a, b) the point p is
+ *
+ * \return  True if p is strictly on the left of (a, b)
+ */
+static inline bool is_left(const float a[2], const float b[2], const float p[2]);
+
+
+/**
+ * \brief   Indicates if the segments (p, q) and (a, b) cross
+ *
+ * \details Points on the line are counted on the right side, so that a
+ *          segment going through a vertex crosses exactly one of the two
+ *          edges sharing this vertex
+ */
+static bool segments_cross(const float p[2], const float q[2], const float a[2], const float b[2]);
+
+
+/**
+ * \brief   Indicates if a segment crosses a rectangle
+ */
+static bool segment_crosses_box(const float a[2], const float b[2], const float box_min[2], const float box_max[2]);
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+static inline bool is_left(const float a[2], const float b[2], const float p[2])
+{
+    return ((b[X] - a[X]) * (p[Y] - a[Y]) - (b[Y] - a[Y]) * (p[X] - a[X])) > 0.0f;
+}
+
+
+static bool segments_cross(const float p[2], const float q[2], const float a[2], const float b[2])
+{
+    return (is_left(a, b, p) != is_left(a, b, q)) && (is_left(p, q, a) != is_left(p, q, b));
+}
+
+
+static bool segment_crosses_box(const float a[2], const float b[2], const float box_min[2], const float box_max[2])
+{
+    // Clip the segment a + t * (b - a), t in [0, 1], against each slab of the box
+    float t_min = 0.0f;
+    float t_max = 1.0f;
+    for (uint8_t i = 0; i < 2; ++i)
+    {
+        float d = b[i] - a[i];
+        if (maths_f_abs(d) < 1e-9f)
+        {
+            if ((a[i] < box_min[i]) || (a[i] > box_max[i]))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            float t0 = (box_min[i] - a[i]) / d;
+            float t1 = (box_max[i] - a[i]) / d;
+            t_min = maths_f_max(t_min, maths_f_min(t0, t1));
+            t_max = maths_f_min(t_max, maths_f_max(t0, t1));
+            if (t_min > t_max)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+void Geofence_polygon::project(void) const
+{
+    if (projected_ && (origin_version_ == INS::origin_version()))
+    {
+        return;
+    }
+
+    zone_t* zone_list               = zones();
+    const global_position_t* vertex = vertices();
+    edge_t* edge_list               = edges();
+
+    uint16_t first_ref = 0;
+    for (uint16_t z = 0; z < zone_count_; ++z)
+    {
+        zone_t& zone = zone_list[z];
+
+        // Altitude band
+        zone.z_top    = -(zone.max_altitude - INS::origin().altitude);
+        zone.z_bottom = -(zone.min_altitude - INS::origin().altitude);
+
+        // Edges and bounding box
+        for (uint16_t i = 0; i < zone.vertex_count; ++i)
+        {
+            uint16_t ia = zone.first_vertex + i;
+            uint16_t ib = zone.first_vertex + ((i + 1) % zone.vertex_count);
+            local_position_t a;
+            local_position_t b;
+            INS::projection().global_to_local(vertex[ia], a);
+            INS::projection().global_to_local(vertex[ib], b);
+
+            edge_t& edge = edge_list[ia];
+            edge.a[X]    = a[X];
+            edge.a[Y]    = a[Y];
+            edge.b[X]    = b[X];
+            edge.b[Y]    = b[Y];
+            edge.length  = maths_fast_sqrt(SQR(b[X] - a[X]) + SQR(b[Y] - a[Y]));
+            if (edge.length > 0.0f)
+            {
+                edge.u[X] = (b[X] - a[X]) / edge.length;
+                edge.u[Y] = (b[Y] - a[Y]) / edge.length;
+            }
+            else
+            {
+                edge.u[X] = 0.0f;
+                edge.u[Y] = 0.0f;
+            }
+
+            if (i == 0)
+            {
+                zone.min[X] = zone.max[X] = a[X];
+                zone.min[Y] = zone.max[Y] = a[Y];
+            }
+            zone.min[X] = maths_f_min(zone.min[X], a[X]);
+            zone.min[Y] = maths_f_min(zone.min[Y], a[Y]);
+            zone.max[X] = maths_f_max(zone.max[X], a[X]);
+            zone.max[Y] = maths_f_max(zone.max[Y], a[Y]);
+        }
+
+        first_ref = build_grid(zone, first_ref);
+    }
+
+    origin_version_ = INS::origin_version();
+    projected_      = true;
+}
+
+
+uint16_t Geofence_polygon::build_grid(zone_t& zone, uint16_t first_ref) const
+{
+    const edge_t* edge_list = edges();
+    uint16_t* ref_list      = refs();
+
+    zone.cell_size[X] = maths_f_max((zone.max[X] - zone.min[X]) / GRID, 1e-3f);
+    zone.cell_size[Y] = maths_f_max((zone.max[Y] - zone.min[Y]) / GRID, 1e-3f);
+    zone.first_ref    = first_ref;
+    zone.indexed      = true;
+
+    uint16_t ref = first_ref;
+    for (uint16_t c = 0; c < CELL_COUNT; ++c)
+    {
+        uint16_t cx = c % GRID;
+        uint16_t cy = c / GRID;
+
+        // Cell, slightly enlarged to include the edges on its border
+        float margin = 1e-3f * (zone.cell_size[X] + zone.cell_size[Y]);
+        float box_min[2] = {zone.min[X] + cx * zone.cell_size[X] - margin,
+                            zone.min[Y] + cy * zone.cell_size[Y] - margin};
+        float box_max[2] = {box_min[X] + zone.cell_size[X] + 2.0f * margin,
+                            box_min[Y] + zone.cell_size[Y] + 2.0f * margin};
+        float center[2]  = {zone.min[X] + (cx + 0.5f) * zone.cell_size[X],
+                            zone.min[Y] + (cy + 0.5f) * zone.cell_size[Y]};
+
+        // Edges crossing the cell, and inside test of the center by ray casting
+        zone.cell_start[c] = ref - first_ref;
+        bool inside = false;
+        for (uint16_t i = 0; i < zone.vertex_count; ++i)
+        {
+            const edge_t& edge = edge_list[zone.first_vertex + i];
+
+            if (((edge.a[Y] > center[Y]) != (edge.b[Y] > center[Y]))
+                && (center[X] < edge.a[X] + (center[Y] - edge.a[Y]) * (edge.b[X] - edge.a[X]) / (edge.b[Y] - edge.a[Y])))
+            {
+                inside = !inside;
+            }
+
+            if (zone.indexed && segment_crosses_box(edge.a, edge.b, box_min, box_max))
+            {
+                if (ref < ref_max_count())
+                {
+                    ref_list[ref++] = zone.first_vertex + i;
+                }
+                else
+                {
+                    // Not enough memory, all edges will be tested
+                    zone.indexed = false;
+                }
+            }
+        }
+
+        if (inside)
+        {
+            zone.inside[c / 8] |= (1 << (c % 8));
+        }
+        else
+        {
+            zone.inside[c / 8] &= ~(1 << (c % 8));
+        }
+    }
+    zone.cell_start[CELL_COUNT] = ref - first_ref;
+
+    if (!zone.indexed)
+    {
+        return first_ref;
+    }
+
+    return ref;
+}
+
+
+bool Geofence_polygon::is_inside_polygon(const zone_t& zone, const float pos[2]) const
+{
+    // Bounding box
+    if ((pos[X] < zone.min[X]) || (pos[X] > zone.max[X]) || (pos[Y] < zone.min[Y]) || (pos[Y] > zone.max[Y]))
+    {
+        return false;
+    }
+
+    const edge_t* edge_list = edges();
+
+    if (!zone.indexed)
+    {
+        // Ray casting over all edges
+        bool inside = false;
+        for (uint16_t i = 0; i < zone.vertex_count; ++i)
+        {
+            const edge_t& edge = edge_list[zone.first_vertex + i];
+            if (((edge.a[Y] > pos[Y]) != (edge.b[Y] > pos[Y]))
+                && (pos[X] < edge.a[X] + (pos[Y] - edge.a[Y]) * (edge.b[X] - edge.a[X]) / (edge.b[Y] - edge.a[Y])))
+            {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    // Start from the status of the center of the cell, and count the edges
+    // crossed between the center and the position: they all cross the cell
+    uint16_t cx = maths_f_min((pos[X] - zone.min[X]) / zone.cell_size[X], GRID - 1);
+    uint16_t cy = maths_f_min((pos[Y] - zone.min[Y]) / zone.cell_size[Y], GRID - 1);
+    uint16_t c  = cy * GRID + cx;
+    float center[2] = {zone.min[X] + (cx + 0.5f) * zone.cell_size[X],
+                       zone.min[Y] + (cy + 0.5f) * zone.cell_size[Y]};
+
+    bool inside = (zone.inside[c / 8] & (1 << (c % 8))) != 0;
+    const uint16_t* ref_list = refs() + zone.first_ref;
+    for (uint16_t r = zone.cell_start[c]; r < zone.cell_start[c + 1]; ++r)
+    {
+        const edge_t& edge = edge_list[ref_list[r]];
+        if (segments_cross(center, pos, edge.a, edge.b))
+        {
+            inside = !inside;
+        }
+    }
+
+    return inside;
+}
+
+
+float Geofence_polygon::closest_edge_point(const zone_t& zone, const float pos[2], float closest[2]) const
+{
+    const edge_t* edge_list = edges();
+    float best_dist_sqr = -1.0f;
+
+    // Closest point of one edge
+    #define TEST_EDGE(edge_index)                                                       \
+    {                                                                                   \
+        const edge_t& edge = edge_list[edge_index];                                     \
+        float t = (pos[X] - edge.a[X]) * edge.u[X] + (pos[Y] - edge.a[Y]) * edge.u[Y];  \
+        t = maths_f_min(maths_f_max(t, 0.0f), edge.length);                             \
+        float p[2] = {edge.a[X] + t * edge.u[X], edge.a[Y] + t * edge.u[Y]};            \
+        float dist_sqr = SQR(p[X] - pos[X]) + SQR(p[Y] - pos[Y]);                      \
+        if ((best_dist_sqr < 0.0f) || (dist_sqr < best_dist_sqr))                       \
+        {                                                                               \
+            best_dist_sqr = dist_sqr;                                                   \
+            closest[X]    = p[X];                                                       \
+            closest[Y]    = p[Y];                                                       \
+        }                                                                               \
+    }
+
+    bool in_box = (pos[X] >= zone.min[X]) && (pos[X] <= zone.max[X]) && (pos[Y] >= zone.min[Y]) && (pos[Y] <= zone.max[Y]);
+
+    if (!zone.indexed || !in_box)
+    {
+        // Test all edges
+        for (uint16_t i = 0; i < zone.vertex_count; ++i)
+        {
+            TEST_EDGE(zone.first_vertex + i);
+        }
+        return best_dist_sqr;
+    }
+
+    // Search rings of cells around the position, until the next ring is
+    // further than the closest point found
+    int32_t cx = maths_f_min((pos[X] - zone.min[X]) / zone.cell_size[X], GRID - 1);
+    int32_t cy = maths_f_min((pos[Y] - zone.min[Y]) / zone.cell_size[Y], GRID - 1);
+    float ring_size = maths_f_min(zone.cell_size[X], zone.cell_size[Y]);
+    const uint16_t* ref_list = refs() + zone.first_ref;
+
+    for (int32_t ring = 0; ring < GRID; ++ring)
+    {
+        for (int32_t y = cy - ring; y <= cy + ring; ++y)
+        {
+            if ((y < 0) || (y >= GRID))
+            {
+                continue;
+            }
+
+            // Only the first and last columns, except on the first and last rows of the ring
+            int32_t step = ((y == cy - ring) || (y == cy + ring)) ? 1 : 2 * ring;
+            if (step == 0)
+            {
+                step = 1;
+            }
+
+            for (int32_t x = cx - ring; x <= cx + ring; x += step)
+            {
+                if ((x < 0) || (x >= GRID))
+                {
+                    continue;
+                }
+
+                uint16_t c = y * GRID + x;
+                for (uint16_t r = zone.cell_start[c]; r < zone.cell_start[c + 1]; ++r)
+                {
+                    TEST_EDGE(ref_list[r]);
+                }
+            }
+        }
+
+        // Cells of the next rings are at least ring * ring_size away from the position
+        if ((best_dist_sqr >= 0.0f) && (best_dist_sqr <= SQR(ring * ring_size)))
+        {
+            break;
+        }
+    }
+
+    #undef TEST_EDGE
+
+    return best_dist_sqr;
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Geofence_polygon::Geofence_polygon(void):
+    zone_count_(0),
+    vertex_count_(0),
+    origin_version_(0),
+    projected_(false)
+{}
+
+
+bool Geofence_polygon::add_zone(zone_type_t type, const global_position_t vertices_in[], uint16_t count, float min_altitude, float max_altitude)
+{
+    if ((count < 3)
+        || (zone_count_ >= zone_max_count())
+        || ((vertex_count_ + count) > vertex_max_count()))
+    {
+        return false;
+    }
+
+    zone_t& zone        = zones()[zone_count_];
+    zone.type           = type;
+    zone.first_vertex   = vertex_count_;
+    zone.vertex_count   = count;
+    zone.min_altitude   = min_altitude;
+    zone.max_altitude   = max_altitude;
+
+    global_position_t* vertex = vertices();
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        vertex[vertex_count_ + i] = vertices_in[i];
+    }
+
+    vertex_count_ += count;
+    zone_count_++;
+    projected_ = false;
+
+    return true;
+}
+
+
+void Geofence_polygon::clear(void)
+{
+    zone_count_   = 0;
+    vertex_count_ = 0;
+    projected_    = false;
+}
+
+
+uint16_t Geofence_polygon::zone_count(void) const
+{
+    return zone_count_;
+}
+
+
+bool Geofence_polygon::is_allowed(const global_position_t& position) const
+{
+    project();
+
+    local_position_t position_lf;
+    INS::projection().global_to_local(position, position_lf);
+
+    bool has_inclusion = false;
+    bool is_included   = false;
+
+    const zone_t* zone_list = zones();
+    for (uint16_t z = 0; z < zone_count_; ++z)
+    {
+        const zone_t& zone = zone_list[z];
+
+        bool is_inside = (position_lf[Z] >= zone.z_top)
+                         && (position_lf[Z] <= zone.z_bottom)
+                         && is_inside_polygon(zone, position_lf.data());
+
+        if (zone.type == EXCLUSION)
+        {
+            if (is_inside)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            has_inclusion = true;
+            is_included  |= is_inside;
+        }
+    }
+
+    return (!has_inclusion) || is_included;
+}
+
+
+bool Geofence_polygon::closest_border(const global_position_t& current_position, global_position_t& border_position, float& distance) const
+{
+    if (zone_count_ == 0)
+    {
+        return false;
+    }
+
+    project();
+
+    local_position_t position_lf;
+    INS::projection().global_to_local(current_position, position_lf);
+
+    local_position_t best;
+    float best_dist_sqr = -1.0f;
+
+    const zone_t* zone_list = zones();
+    for (uint16_t z = 0; z < zone_count_; ++z)
+    {
+        const zone_t& zone = zone_list[z];
+
+        // Closest point on the vertical walls
+        float edge_point[2];
+        float dist_sqr = closest_edge_point(zone, position_lf.data(), edge_point);
+        float wall_z   = maths_f_min(maths_f_max(position_lf[Z], zone.z_top), zone.z_bottom);
+        dist_sqr      += SQR(wall_z - position_lf[Z]);
+        if ((best_dist_sqr < 0.0f) || (dist_sqr < best_dist_sqr))
+        {
+            best_dist_sqr = dist_sqr;
+            best[X]       = edge_point[X];
+            best[Y]       = edge_point[Y];
+            best[Z]       = wall_z;
+        }
+
+        // Closest point on the top and bottom of the zone
+        if (is_inside_polygon(zone, position_lf.data()))
+        {
+            float top_dist_sqr    = SQR(zone.z_top - position_lf[Z]);
+            float bottom_dist_sqr = SQR(zone.z_bottom - position_lf[Z]);
+            float plane_z         = (top_dist_sqr < bottom_dist_sqr) ? zone.z_top : zone.z_bottom;
+            float plane_dist_sqr  = maths_f_min(top_dist_sqr, bottom_dist_sqr);
+            if (plane_dist_sqr < best_dist_sqr)
+            {
+                best_dist_sqr = plane_dist_sqr;
+                best[X]       = position_lf[X];
+                best[Y]       = position_lf[Y];
+                best[Z]       = plane_z;
+            }
+        }
+    }
+
+    // Convert to global frame
+    INS::projection().local_to_global(best, border_position);
+    distance = maths_fast_sqrt(best_dist_sqr);
+
+    return true;
+}
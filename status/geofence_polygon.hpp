@@ -0,0 +1,317 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+* \file geofence_polygon.hpp
+*
+* \author MAV'RIC Team
+*
+* \brief  Geofence made of polygonal zones with altitude bands
+*
+* \details The allowed space is the union of the inclusion zones (everywhere
+*          if there is no inclusion zone), minus the exclusion zones.
+*          The vertices are given in global coordinates and the edges are
+*          projected to the local frame each time the origin changes, with
+*          their direction and length. Each zone is covered by a grid of
+*          GRID x GRID cells listing the edges that cross them, and whether
+*          the center of each cell is inside the polygon. A position is then
+*          tested against the edges of its cell only, and the closest border
+*          is searched in rings of cells around the position
+*
+******************************************************************************/
+
+
+#ifndef GEOFENCE_POLYGON_HPP_
+#define GEOFENCE_POLYGON_HPP_
+
+#include <cstdint>
+
+#include "status/geofence.hpp"
+
+
+/**
+ * \brief   Geofence made of polygonal zones with altitude bands
+ */
+class Geofence_polygon: public Geofence
+{
+public:
+    static const uint16_t GRID = 16;                    ///< Number of cells of the grid of a zone along each axis
+    static const uint16_t CELL_COUNT = GRID * GRID;     ///< Number of cells of the grid of a zone
+
+    /**
+     * \brief   Type of zone
+     */
+    enum zone_type_t
+    {
+        INCLUSION = 0,      ///< The allowed space is inside the zone
+        EXCLUSION = 1,      ///< The space inside the zone is not allowed
+    };
+
+
+    /**
+     * \brief   Edge projected in the local frame
+     */
+    struct edge_t
+    {
+        float a[2];         ///< First vertex
+        float b[2];         ///< Second vertex
+        float u[2];         ///< Unit vector from a to b
+        float length;       ///< Length of the edge
+    };
+
+
+    /**
+     * \brief   Zone
+     */
+    struct zone_t
+    {
+        zone_type_t type;                       ///< Type of zone
+        uint16_t first_vertex;                  ///< Index of the first vertex
+        uint16_t vertex_count;                  ///< Number of vertices
+        float min_altitude;                     ///< Altitude of the bottom of the zone above sea level (m)
+        float max_altitude;                     ///< Altitude of the top of the zone above sea level (m)
+
+        // Local frame data, computed by project()
+        float z_top;                            ///< Top of the zone in the local frame
+        float z_bottom;                         ///< Bottom of the zone in the local frame
+        float min[2];                           ///< Corner of the bounding box
+        float max[2];                           ///< Opposite corner of the bounding box
+        float cell_size[2];                     ///< Size of the cells
+        bool indexed;                           ///< False if the grid did not fit in memory (edges are then all tested)
+        uint16_t first_ref;                     ///< Index of the first edge reference of the zone
+        uint16_t cell_start[CELL_COUNT + 1];    ///< Start of each cell in the edge references, relative to first_ref
+        uint8_t inside[CELL_COUNT / 8];         ///< Bit set if the center of the cell is inside the polygon
+    };
+
+
+    /**
+     * \brief   Constructor
+     */
+    Geofence_polygon(void);
+
+
+    /**
+     * \brief   Adds a zone
+     *
+     * \param   type            Inclusion or exclusion zone
+     * \param   vertices        Vertices of the polygon (the last vertex is connected to the first one)
+     * \param   count           Number of vertices (at least 3)
+     * \param   min_altitude    Altitude of the bottom of the zone above sea level (m)
+     * \param   max_altitude    Altitude of the top of the zone above sea level (m)
+     *
+     * \return  False if there is no space left for the zone
+     */
+    bool add_zone(zone_type_t type, const global_position_t vertices[], uint16_t count, float min_altitude, float max_altitude);
+
+
+    /**
+     * \brief   Removes all zones
+     */
+    void clear(void);
+
+
+    /**
+     * \brief   Number of zones
+     *
+     * \return  count
+     */
+    uint16_t zone_count(void) const;
+
+
+    /**
+     * \brief     Indicates if the position is allowed by the geofence
+     *
+     * \return    boolean (true if allowed, false if not)
+     */
+    bool is_allowed(const global_position_t& position) const;
+
+
+    /**
+     * \brief     Computes the closest border between allowed and disallowed space
+     *
+     * \details   Returns the closest point on the border of any zone
+     *
+     * \param     current_position      Current position of the MAV (input)
+     * \param     border_position       Closest position at the border (output)
+     * \param     distance              Distance to closest border (output)
+     *
+     * \return    success               False if there is no zone
+     */
+    bool closest_border(const global_position_t& current_position, global_position_t& border_position, float& distance) const;
+
+
+protected:
+    /**
+     * \brief   Get maximum number of zones
+     *
+     * \return  Maximum number of zones
+     */
+    virtual uint16_t zone_max_count(void) const = 0;
+
+
+    /**
+     * \brief   Get maximum number of vertices of all zones
+     *
+     * \return  Maximum number of vertices
+     */
+    virtual uint16_t vertex_max_count(void) const = 0;
+
+
+    /**
+     * \brief   Get maximum number of edge references in the grids of all zones
+     *
+     * \return  Maximum number of edge references
+     */
+    virtual uint16_t ref_max_count(void) const = 0;
+
+
+    /**
+     * \brief   Get the arrays of zones, vertices, edges and edge references
+     *
+     * \details The local frame data is updated from const functions when the origin changes
+     *
+     * \return  array
+     */
+    virtual zone_t* zones(void) const = 0;
+    virtual global_position_t* vertices(void) const = 0;
+    virtual edge_t* edges(void) const = 0;
+    virtual uint16_t* refs(void) const = 0;
+
+
+private:
+    /**
+     * \brief   Projects the zones in the local frame if the origin has changed
+     */
+    void project(void) const;
+
+
+    /**
+     * \brief   Builds the grid of a zone
+     *
+     * \param   zone        Zone, with projected edges and bounding box
+     * \param   first_ref   Index of the first free edge reference
+     *
+     * \return  Index of the first free edge reference after the zone
+     */
+    uint16_t build_grid(zone_t& zone, uint16_t first_ref) const;
+
+
+    /**
+     * \brief   Indicates if a horizontal position is inside the polygon of a zone
+     *
+     * \param   zone        Zone
+     * \param   pos         Horizontal position in the local frame
+     *
+     * \return  True if inside
+     */
+    bool is_inside_polygon(const zone_t& zone, const float pos[2]) const;
+
+
+    /**
+     * \brief   Computes the closest point on the edges of a zone
+     *
+     * \param   zone        Zone
+     * \param   pos         Horizontal position in the local frame
+     * \param   closest     Closest point (output)
+     *
+     * \return  Squared distance to the closest point
+     */
+    float closest_edge_point(const zone_t& zone, const float pos[2], float closest[2]) const;
+
+
+    uint16_t zone_count_;                   ///< Number of zones
+    uint16_t vertex_count_;                 ///< Number of vertices of all zones
+    mutable uint32_t origin_version_;       ///< Version of the origin used for the local frame data
+    mutable bool projected_;                ///< False if zones were added since the last projection
+};
+
+
+/**
+ * \brief   Geofence made of polygonal zones
+ *
+ * \tparam  ZONES       Maximum number of zones
+ * \tparam  VERTICES    Maximum number of vertices of all zones
+ * \tparam  REFS        Maximum number of edge references in the grids of all zones
+ */
+template<uint16_t ZONES, uint16_t VERTICES, uint16_t REFS = 8 * VERTICES>
+class Geofence_polygon_T: public Geofence_polygon
+{
+public:
+    Geofence_polygon_T(void):
+        Geofence_polygon()
+    {}
+
+
+protected:
+    uint16_t zone_max_count(void) const
+    {
+        return ZONES;
+    }
+
+    uint16_t vertex_max_count(void) const
+    {
+        return VERTICES;
+    }
+
+    uint16_t ref_max_count(void) const
+    {
+        return REFS;
+    }
+
+    zone_t* zones(void) const
+    {
+        return zones_;
+    }
+
+    global_position_t* vertices(void) const
+    {
+        return vertices_;
+    }
+
+    edge_t* edges(void) const
+    {
+        return edges_;
+    }
+
+    uint16_t* refs(void) const
+    {
+        return refs_;
+    }
+
+
+private:
+    mutable zone_t zones_[ZONES];                   ///< Zones
+    mutable global_position_t vertices_[VERTICES];  ///< Vertices of all zones in global frame
+    mutable edge_t edges_[VERTICES];                ///< Edges of all zones in local frame (edge i goes from vertex i to the next vertex of the zone)
+    mutable uint16_t refs_[REFS];                   ///< Edges crossing each cell of the grids
+};
+
+#endif /* GEOFENCE_POLYGON_HPP_ */
@@ -148,6 +148,30 @@ public:
     bool get_element(uint32_t index, T& elem) const;
 
 
+    /**
+     * \brief     Get the oldest contiguous span of elements, without removing them
+     *
+     * \details   When the data wraps around the end of the storage, only the
+     *            part before the end is returned, the rest is returned by the
+     *            next call once the span is consumed
+     *
+     * \param     data      Pointer to the oldest element (output)
+     *
+     * \return    Number of contiguous elements available at data
+     */
+    uint32_t peek(const T*& data) const;
+
+
+    /**
+     * \brief     Remove the oldest elements from the buffer
+     *
+     * \param     count     Number of elements to remove
+     *
+     * \return    success (false if less than count elements are available)
+     */
+    bool consume(uint32_t count);
+
+
 private:
     T           buffer_[S + 1]; ///<    Array of bytes containing the data
     uint32_t    head_;          ///<    Head of the buffer (newest byte)
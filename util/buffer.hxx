@@ -165,4 +165,37 @@ bool Buffer_T<S, T>::get_element(uint32_t index, T& elem) const
 }
 
 
+template<uint32_t S, typename T>
+uint32_t Buffer_T<S, T>::peek(const T*& data) const
+{
+    uint32_t head = head_;
+    uint32_t tail = tail_;
+
+    data = &buffer_[tail];
+
+    if (head >= tail)
+    {
+        return head - tail;
+    }
+    else
+    {
+        return S + 1 - tail;
+    }
+}
+
+
+template<uint32_t S, typename T>
+bool Buffer_T<S, T>::consume(uint32_t count)
+{
+    if (readable() < count)
+    {
+        return false;
+    }
+
+    tail_ = (tail_ + count) % (S + 1);
+
+    return true;
+}
+
+
 #endif /* BUFFER_HXX_ */
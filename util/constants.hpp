@@ -46,6 +46,10 @@
 
 #define GRAVITY 9.81f           ///< The gravity constant
 
+#define PI_DOUBLE               3.141592653589793       ///< Pi in double precision, for precise conversion of coordinates
+#define MATH_DEG_TO_RAD_DOUBLE  (PI_DOUBLE/180.0)       ///< Degrees to radians in double precision
+#define MATH_RAD_TO_DEG_DOUBLE  (180.0/PI_DOUBLE)       ///< Radians to degrees in double precision
+
 
 /**
  * \brief Enumerates the X, Y and Z orientations
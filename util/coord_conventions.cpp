@@ -44,6 +44,7 @@
 #include "util/constants.hpp"
 #include "util/print_util.hpp"
 #include "util/quick_trig.hpp"
+#include "util/fast_math.hpp"
 
 #include <cmath>
 
@@ -52,11 +53,8 @@ extern "C"
 #include "util/maths.h"
 }
 
-// Definitions constants as double for precise conversion
+// Earth radius as double for precise conversion
 #define EARTH_RADIUS_DOUBLE     6378137.0
-#define PI_DOUBLE               3.141592653589793
-#define MATH_DEG_TO_RAD_DOUBLE  (PI_DOUBLE/180.0)
-#define MATH_RAD_TO_DEG_DOUBLE  (180.0/PI_DOUBLE)
 
 
 void coord_conventions_local_to_global_position(const local_position_t& input, const global_position_t& origin, global_position_t& output)
@@ -82,9 +80,9 @@ aero_attitude_t coord_conventions_quat_to_aero(quat_t qe)
 {
     aero_attitude_t aero;
 
-    aero.rpy[0] = atan2(2 * (qe.s * qe.v[0] + qe.v[1] * qe.v[2]) , (qe.s * qe.s - qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] + qe.v[2] * qe.v[2]));
-    aero.rpy[1] = -asin(2 * (qe.v[0] * qe.v[2] - qe.s * qe.v[1]));
-    aero.rpy[2] = atan2(2 * (qe.s * qe.v[2] + qe.v[0] * qe.v[1]) , (qe.s * qe.s + qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] - qe.v[2] * qe.v[2]));
+    aero.rpy[0] = fast_math_atan2(2 * (qe.s * qe.v[0] + qe.v[1] * qe.v[2]) , (qe.s * qe.s - qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] + qe.v[2] * qe.v[2]), FAST_MATH_TIER_HIGH);
+    aero.rpy[1] = -fast_math_asin(2 * (qe.v[0] * qe.v[2] - qe.s * qe.v[1]), FAST_MATH_TIER_HIGH);
+    aero.rpy[2] = fast_math_atan2(2 * (qe.s * qe.v[2] + qe.v[0] * qe.v[1]) , (qe.s * qe.s + qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] - qe.v[2] * qe.v[2]), FAST_MATH_TIER_HIGH);
 
     return aero;
 }
@@ -145,15 +143,15 @@ quat_t coord_conventions_quaternion_from_rpy(float roll, float pitch, float yaw)
 
 void coord_conventions_rpy_from_quaternion(const quat_t& qe, float rpy[3])
 {
-    rpy[0] = atan2(2 * (qe.s * qe.v[0] + qe.v[1] * qe.v[2]) , (qe.s * qe.s - qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] + qe.v[2] * qe.v[2]));
-    rpy[1] = -asin(2 * (qe.v[0] * qe.v[2] - qe.s * qe.v[1]));
-    rpy[2] = atan2(2 * (qe.s * qe.v[2] + qe.v[0] * qe.v[1]) , (qe.s * qe.s + qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] - qe.v[2] * qe.v[2]));
+    rpy[0] = fast_math_atan2(2 * (qe.s * qe.v[0] + qe.v[1] * qe.v[2]) , (qe.s * qe.s - qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] + qe.v[2] * qe.v[2]), FAST_MATH_TIER_HIGH);
+    rpy[1] = -fast_math_asin(2 * (qe.v[0] * qe.v[2] - qe.s * qe.v[1]), FAST_MATH_TIER_HIGH);
+    rpy[2] = fast_math_atan2(2 * (qe.s * qe.v[2] + qe.v[0] * qe.v[1]) , (qe.s * qe.s + qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] - qe.v[2] * qe.v[2]), FAST_MATH_TIER_HIGH);
 }
 
 
 float coord_conventions_get_yaw(quat_t qe)
 {
-    return  atan2(2 * (qe.s * qe.v[2] + qe.v[0] * qe.v[1]) , (qe.s * qe.s + qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] - qe.v[2] * qe.v[2]));
+    return  fast_math_atan2(2 * (qe.s * qe.v[2] + qe.v[0] * qe.v[1]) , (qe.s * qe.s + qe.v[0] * qe.v[0] - qe.v[1] * qe.v[1] - qe.v[2] * qe.v[2]), FAST_MATH_TIER_HIGH);
 }
 
 
@@ -0,0 +1,421 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file fast_math.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Fast polynomial approximations of trigonometric functions and square root
+ *
+ * \details All functions take an accuracy tier as last argument. Lower tiers
+ *          use shorter polynomials (or fewer Newton iterations) and are faster.
+ *          The polynomials are minimax approximations of the absolute error,
+ *          range reduction is done without branches (only selects).
+ *
+ *          Maximum absolute error for each tier:
+ *          function        LOW         MEDIUM      HIGH
+ *          sin, cos        6.8e-5      8.3e-7      2.5e-7
+ *          atan, atan2     8.2e-5      2.0e-6      3.1e-7
+ *          asin, acos      4.5e-5      1.1e-6      4.8e-7
+ *          sqrt (relative) 1.8e-3      4.8e-6      2.2e-7
+ *
+ *          (maximum over dense sweeps of the input range against double
+ *          precision; the Benchmark sample project reports the error on its
+ *          own, smaller, set of samples)
+ *
+ *          sin and cos are accurate for |x| < 1000 rad, larger angles are
+ *          first reduced with fmod (slower)
+ *
+ ******************************************************************************/
+
+
+#ifndef FAST_MATH_HPP_
+#define FAST_MATH_HPP_
+
+#include <cstdint>
+
+extern "C"
+{
+#include "util/maths.h"
+}
+
+
+/**
+ * \brief   Accuracy tiers
+ */
+typedef enum
+{
+    FAST_MATH_TIER_LOW      = 0,    ///< Fastest, error around 1e-4 (1.8e-3 relative for sqrt)
+    FAST_MATH_TIER_MEDIUM   = 1,    ///< Error around 1e-6
+    FAST_MATH_TIER_HIGH     = 2,    ///< Error close to float precision
+} fast_math_tier_t;
+
+
+/**
+ * \brief   Tier used when none is given
+ *
+ * \details Can be overridden at compile time (ie. -DFAST_MATH_DEFAULT_TIER=FAST_MATH_TIER_LOW)
+ */
+#ifndef FAST_MATH_DEFAULT_TIER
+#define FAST_MATH_DEFAULT_TIER FAST_MATH_TIER_MEDIUM
+#endif
+
+
+#define FAST_MATH_INV_PI    0.318309886f        ///< 1 / pi
+#define FAST_MATH_PI_A      3.140625f           ///< pi = PI_A + PI_B, with PI_A exact on 8 bits (Cody-Waite reduction)
+#define FAST_MATH_PI_B      9.67653589793e-4f   ///< pi - PI_A
+#define FAST_MATH_PI_2      1.570796327f        ///< pi / 2
+#define FAST_MATH_2PI_D     6.283185307179586   ///< 2 * pi in double precision
+#define FAST_MATH_TRIG_MAX  1000.0f             ///< Largest angle reduced without fmod
+
+
+/**
+ * \brief       Rounds to the nearest integer without branch nor conversion to int
+ *
+ * \details     Adding and removing 1.5 * 2^23 pushes the fractional part out of the mantissa
+ *              Valid for |x| < 2^22
+ *
+ * \param   x   Input value
+ *
+ * \return      Rounded value
+ */
+static inline float fast_math_round(float x)
+{
+    const float magic = 12582912.0f;
+    return (x + magic) - magic;
+}
+
+
+/**
+ * \brief       Brings large angles back to the range handled by the fast reduction
+ *
+ * \details     Angles above FAST_MATH_TRIG_MAX are reduced with fmod in double
+ *              precision, so that the rounding of x / pi stays exact and its
+ *              parity well defined
+ *
+ * \param   x   Input angle in radians
+ *
+ * \return      Angle in [-FAST_MATH_TRIG_MAX, FAST_MATH_TRIG_MAX], equal to x modulo 2 pi
+ */
+static inline float fast_math_trig_range(float x)
+{
+    return (maths_f_abs(x) <= FAST_MATH_TRIG_MAX) ? x : (float)fmod((double)x, FAST_MATH_2PI_D);
+}
+
+
+/**
+ * \brief       Sign (-1)^k of an integer valued float, without conversion to int
+ *
+ * \param   k   Integer value, |k| < 2^22
+ *
+ * \return      1 for even k, -1 for odd k (NaN if k is NaN)
+ */
+static inline float fast_math_parity_sign(float k)
+{
+    return 1.0f - 2.0f * maths_f_abs(k - 2.0f * fast_math_round(0.5f * k));
+}
+
+
+/**
+ * \brief           Polynomial approximation of sin on [-pi/2, pi/2]
+ *
+ * \param   x       Input angle in radians
+ * \param   tier    Accuracy tier
+ *
+ * \return          sin(x)
+ */
+static inline float fast_math_sin_poly(float x, fast_math_tier_t tier)
+{
+    float x2 = x * x;
+    float p;
+
+    switch (tier)
+    {
+        case FAST_MATH_TIER_LOW:
+            p = 9.996967731e-01f + x2 * (-1.656730793e-01f + x2 * 7.514377178e-03f);
+        break;
+
+        case FAST_MATH_TIER_MEDIUM:
+            p = 9.999966159e-01f + x2 * (-1.666482838e-01f + x2 * (8.306325227e-03f + x2 * -1.836365398e-04f));
+        break;
+
+        case FAST_MATH_TIER_HIGH:
+        default:
+            p = 9.999999766e-01f + x2 * (-1.666664763e-01f + x2 * (8.332899823e-03f + x2 * (-1.980089776e-04f + x2 * 2.590488501e-06f)));
+        break;
+    }
+
+    return x * p;
+}
+
+
+/**
+ * \brief           Polynomial approximation of atan on [0, 1]
+ *
+ * \param   x       Input value
+ * \param   tier    Accuracy tier
+ *
+ * \return          atan(x)
+ */
+static inline float fast_math_atan_poly(float x, fast_math_tier_t tier)
+{
+    float x2 = x * x;
+    float p;
+
+    switch (tier)
+    {
+        case FAST_MATH_TIER_LOW:
+            p = 9.992138126e-01f + x2 * (-3.211749693e-01f + x2 * (1.462644636e-01f + x2 * -3.898651420e-02f));
+        break;
+
+        case FAST_MATH_TIER_MEDIUM:
+            p = 9.999772191e-01f + x2 * (-3.326228278e-01f + x2 * (1.935403758e-01f + x2 * (-1.164264812e-01f
+                + x2 * (5.264735062e-02f + x2 * -1.171913541e-02f))));
+        break;
+
+        case FAST_MATH_TIER_HIGH:
+        default:
+            p = 9.999993356e-01f + x2 * (-3.332986078e-01f + x2 * (1.994656565e-01f + x2 * (-1.390862955e-01f
+                + x2 * (9.642197328e-02f + x2 * (-5.591232677e-02f + x2 * (2.186295787e-02f + x2 * -4.054567213e-03f))))));
+        break;
+    }
+
+    return x * p;
+}
+
+
+/**
+ * \brief           Polynomial approximation of acos(x) / sqrt(1 - x) on [0, 1]
+ *
+ * \param   x       Input value
+ * \param   tier    Accuracy tier
+ *
+ * \return          acos(x) / sqrt(1 - x)
+ */
+static inline float fast_math_acos_poly(float x, fast_math_tier_t tier)
+{
+    float p;
+
+    switch (tier)
+    {
+        case FAST_MATH_TIER_LOW:
+            p = 1.570758340e+00f + x * (-2.128751842e-01f + x * (7.689738736e-02f + x * -2.089203711e-02f));
+        break;
+
+        case FAST_MATH_TIER_MEDIUM:
+            p = 1.570795690e+00f + x * (-2.145428168e-01f + x * (8.817105357e-02f + x * (-4.592722877e-02f
+                + x * (2.062006171e-02f + x * -4.911174470e-03f))));
+        break;
+
+        case FAST_MATH_TIER_HIGH:
+        default:
+            p = 1.570796314e+00f + x * (-2.145998924e-01f + x * (8.899926492e-02f + x * (-5.031278493e-02f
+                + x * (3.133547207e-02f + x * (-1.780898721e-02f + x * (7.245450519e-03f + x * -1.441480668e-03f))))));
+        break;
+    }
+
+    return p;
+}
+
+
+/**
+ * \brief           Fast square root
+ *
+ * \details         Newton iterations on the inverse square root (see maths_fast_sqrt)
+ *                  One iteration per tier. Negative inputs return 0
+ *
+ * \param   x       Input value
+ * \param   tier    Accuracy tier
+ *
+ * \return          sqrt(x)
+ */
+static inline float fast_math_sqrt(float x, fast_math_tier_t tier = FAST_MATH_DEFAULT_TIER)
+{
+    union
+    {
+        float   f;
+        int32_t l;
+    } i;
+
+    x = (x > 0.0f) ? x : 0.0f;
+
+    float half_x = 0.5f * x;
+    i.f = x;
+    i.l = 0x5f3759df - (i.l >> 1);
+    float y = i.f;
+
+    y = y * (1.5f - half_x * y * y);
+    if (tier >= FAST_MATH_TIER_MEDIUM)
+    {
+        y = y * (1.5f - half_x * y * y);
+    }
+    if (tier >= FAST_MATH_TIER_HIGH)
+    {
+        y = y * (1.5f - half_x * y * y);
+    }
+
+    return x * y;
+}
+
+
+/**
+ * \brief           Fast sine
+ *
+ * \param   x       Input angle in radians
+ * \param   tier    Accuracy tier
+ *
+ * \return          sin(x)
+ */
+static inline float fast_math_sin(float x, fast_math_tier_t tier = FAST_MATH_DEFAULT_TIER)
+{
+    // sin(x) = (-1)^k * sin(x - k * pi), with x - k * pi in [-pi/2, pi/2]
+    x = fast_math_trig_range(x);
+    float k = fast_math_round(x * FAST_MATH_INV_PI);
+    float r = (x - k * FAST_MATH_PI_A) - k * FAST_MATH_PI_B;
+
+    // Flip sign for odd k
+    float sign = fast_math_parity_sign(k);
+
+    return sign * fast_math_sin_poly(r, tier);
+}
+
+
+/**
+ * \brief           Fast cosine
+ *
+ * \param   x       Input angle in radians
+ * \param   tier    Accuracy tier
+ *
+ * \return          cos(x)
+ */
+static inline float fast_math_cos(float x, fast_math_tier_t tier = FAST_MATH_DEFAULT_TIER)
+{
+    // cos(x) = (-1)^k * sin(x - (k - 1/2) * pi), with x - (k - 1/2) * pi in [-pi/2, pi/2]
+    x = fast_math_trig_range(x);
+    float k = fast_math_round(x * FAST_MATH_INV_PI + 0.5f);
+    float h = k - 0.5f;
+    float r = (x - h * FAST_MATH_PI_A) - h * FAST_MATH_PI_B;
+
+    // Flip sign for odd k
+    float sign = fast_math_parity_sign(k);
+
+    return sign * fast_math_sin_poly(r, tier);
+}
+
+
+/**
+ * \brief           Fast arc tangent
+ *
+ * \param   x       Input value
+ * \param   tier    Accuracy tier
+ *
+ * \return          atan(x) in [-pi/2, pi/2]
+ */
+static inline float fast_math_atan(float x, fast_math_tier_t tier = FAST_MATH_DEFAULT_TIER)
+{
+    // atan(x) = pi/2 - atan(1/x) for x > 1
+    float a   = (x < 0.0f) ? -x : x;
+    bool  inv = a > 1.0f;
+    float z   = inv ? (1.0f / a) : a;
+
+    float r = fast_math_atan_poly(z, tier);
+    r = inv ? (FAST_MATH_PI_2 - r) : r;
+
+    return (x < 0.0f) ? -r : r;
+}
+
+
+/**
+ * \brief           Fast arc tangent of y/x, using the signs of x and y to find the quadrant
+ *
+ * \param   y       Y coordinate
+ * \param   x       X coordinate
+ * \param   tier    Accuracy tier
+ *
+ * \return          atan2(y, x) in [-pi, pi], with the same results as atan2 for signed zeros
+ */
+static inline float fast_math_atan2(float y, float x, fast_math_tier_t tier = FAST_MATH_DEFAULT_TIER)
+{
+    float ax = (x < 0.0f) ? -x : x;
+    float ay = (y < 0.0f) ? -y : y;
+    float mx = (ax > ay) ? ax : ay;
+    float mn = (ax > ay) ? ay : ax;
+
+    // Adding the smallest float avoids the division by zero when x = y = 0
+    float r = fast_math_atan_poly(mn / (mx + 1.17549435e-38f), tier);
+
+    r = (ay > ax)  ? (FAST_MATH_PI_2 - r) : r;
+    // Signs taken with copysignf so that zeros behave as in atan2 (ie. atan2(-0, -1) = -pi)
+    r = (copysignf(1.0f, x) < 0.0f) ? (PI - r) : r;
+
+    return copysignf(r, y);
+}
+
+
+/**
+ * \brief           Fast arc cosine
+ *
+ * \param   x       Input value, clipped to [-1, 1]
+ * \param   tier    Accuracy tier
+ *
+ * \return          acos(x) in [0, pi]
+ */
+static inline float fast_math_acos(float x, fast_math_tier_t tier = FAST_MATH_DEFAULT_TIER)
+{
+    // acos(x) = sqrt(1 - x) * P(x) for x in [0, 1] and acos(-x) = pi - acos(x)
+    float a = (x < 0.0f) ? -x : x;
+    a = (a > 1.0f) ? 1.0f : a;
+
+    // The square root is computed one tier higher, otherwise its error dominates
+    fast_math_tier_t sqrt_tier = (tier == FAST_MATH_TIER_LOW) ? FAST_MATH_TIER_MEDIUM : FAST_MATH_TIER_HIGH;
+
+    float r = fast_math_sqrt(1.0f - a, sqrt_tier) * fast_math_acos_poly(a, tier);
+
+    return (x < 0.0f) ? (PI - r) : r;
+}
+
+
+/**
+ * \brief           Fast arc sine
+ *
+ * \param   x       Input value, clipped to [-1, 1]
+ * \param   tier    Accuracy tier
+ *
+ * \return          asin(x) in [-pi/2, pi/2]
+ */
+static inline float fast_math_asin(float x, fast_math_tier_t tier = FAST_MATH_DEFAULT_TIER)
+{
+    return FAST_MATH_PI_2 - fast_math_acos(x, tier);
+}
+
+
+#endif /* FAST_MATH_HPP_ */
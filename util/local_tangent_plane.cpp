@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file local_tangent_plane.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Cached projection between global and local (NED) coordinates
+ *
+ ******************************************************************************/
+
+
+#include "util/local_tangent_plane.hpp"
+#include "util/constants.hpp"
+
+#include <cmath>
+
+extern "C"
+{
+#include "util/maths.h"
+}
+
+
+const float Local_tangent_plane::MAX_OFFSET_RAD = 0.01f;
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+Local_tangent_plane::Local_tangent_plane(const global_position_t& origin):
+    version_(0)
+{
+    set_origin(origin);
+}
+
+
+void Local_tangent_plane::set_origin(const global_position_t& origin)
+{
+    origin_  = origin;
+    cos_lat_ = (float)cos(MATH_DEG_TO_RAD_DOUBLE * origin.latitude);
+    sin_lat_ = (float)sin(MATH_DEG_TO_RAD_DOUBLE * origin.latitude);
+    version_++;
+}
+
+
+const global_position_t& Local_tangent_plane::origin(void) const
+{
+    return origin_;
+}
+
+
+uint32_t Local_tangent_plane::version(void) const
+{
+    return version_;
+}
+
+
+void Local_tangent_plane::global_to_local(const global_position_t& input, local_position_t& output) const
+{
+    // Offsets to origin, the subtraction has to be done in double
+    float dlat = MATH_DEG_TO_RAD * (float)(input.latitude  - origin_.latitude);
+    float dlon = MATH_DEG_TO_RAD * (float)(input.longitude - origin_.longitude);
+
+    if ((maths_f_abs(dlat) > MAX_OFFSET_RAD) || (maths_f_abs(dlon) > MAX_OFFSET_RAD))
+    {
+        coord_conventions_global_to_local_position(input, origin_, output);
+        return;
+    }
+
+    // sin(x) = x - x^3/6 + O(x^5)
+    float sin_dlat = dlat * (1.0f - dlat * dlat * (1.0f / 6.0f));
+    float sin_dlon = dlon * (1.0f - dlon * dlon * (1.0f / 6.0f));
+
+    output[X] = EARTH_RADIUS * sin_dlat;
+    output[Y] = EARTH_RADIUS * sin_dlon * cos_latitude(dlat);
+    output[Z] = -(input.altitude - origin_.altitude);
+}
+
+
+void Local_tangent_plane::global_to_local(const global_position_t input[], local_position_t output[], uint32_t count) const
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        global_to_local(input[i], output[i]);
+    }
+}
+
+
+void Local_tangent_plane::local_to_global(const local_position_t& input, global_position_t& output) const
+{
+    float dlat = input[X] / EARTH_RADIUS;
+
+    if (maths_f_abs(dlat) > MAX_OFFSET_RAD)
+    {
+        coord_conventions_local_to_global_position(input, origin_, output);
+        return;
+    }
+
+    float dlon = input[Y] / (EARTH_RADIUS * cos_latitude(dlat));
+
+    output.latitude  = origin_.latitude  + MATH_RAD_TO_DEG_DOUBLE * (double)dlat;
+    output.longitude = origin_.longitude + MATH_RAD_TO_DEG_DOUBLE * (double)dlon;
+    output.altitude  = -input[Z] + origin_.altitude;
+}
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+float Local_tangent_plane::cos_latitude(float dlat) const
+{
+    // cos(x) = 1 - x^2/2 + x^4/24 + O(x^6), sin(x) = x - x^3/6 + O(x^5)
+    float dlat2    = dlat * dlat;
+    float cos_dlat = 1.0f - 0.5f * dlat2 * (1.0f - dlat2 * (1.0f / 12.0f));
+    float sin_dlat = dlat * (1.0f - dlat2 * (1.0f / 6.0f));
+
+    // cos(a + b) = cos(a) cos(b) - sin(a) sin(b)
+    return cos_lat_ * cos_dlat - sin_lat_ * sin_dlat;
+}
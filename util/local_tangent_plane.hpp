@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file local_tangent_plane.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Cached projection between global and local (NED) coordinates
+ *
+ ******************************************************************************/
+
+
+#ifndef LOCAL_TANGENT_PLANE_HPP_
+#define LOCAL_TANGENT_PLANE_HPP_
+
+#include <cstdint>
+
+#include "util/coord_conventions.hpp"
+
+
+/**
+ * \brief   Projection between global coordinates and the local NED frame of a fixed origin
+ *
+ * \details Gives the same results as coord_conventions_global_to_local_position and
+ *          coord_conventions_local_to_global_position, but the trigonometric terms of
+ *          the origin are computed once (in set_origin), and conversions are done in
+ *          float using the angle sum identities and truncated Taylor series of the
+ *          latitude and longitude offsets.
+ *
+ *          Error bound: for offsets smaller than MAX_OFFSET_RAD (0.01 rad, ~60km)
+ *          the truncation error of the series is below 1e-12 rad, so the error is
+ *          dominated by float rounding: less than 1cm at 60km from the origin.
+ *          For larger offsets the exact double precision functions are used.
+ *
+ *          Only the subtraction of latitude and longitude to the origin is done in
+ *          double, since float does not have enough bits to represent absolute
+ *          coordinates with centimeter resolution.
+ */
+class Local_tangent_plane
+{
+public:
+    /**
+     * \brief   Maximum latitude and longitude offset to the origin for the float path, in radians
+     */
+    static const float MAX_OFFSET_RAD;
+
+
+    /**
+     * \brief   Default constructor, origin at latitude, longitude and altitude 0
+     *
+     * \details constexpr so that static instances are initialized before any
+     *          dynamic initialization (which may call set_origin)
+     */
+    constexpr Local_tangent_plane(void):
+        origin_{0.0, 0.0, 0.0f},
+        cos_lat_(1.0f),
+        sin_lat_(0.0f),
+        version_(0)
+    {}
+
+
+    /**
+     * \brief   Constructor
+     *
+     * \param   origin      Origin of the local frame
+     */
+    Local_tangent_plane(const global_position_t& origin);
+
+
+    /**
+     * \brief   Sets the origin of the local frame and precomputes its trigonometric terms
+     *
+     * \param   origin      Origin of the local frame
+     */
+    void set_origin(const global_position_t& origin);
+
+
+    /**
+     * \brief   Origin of the local frame
+     *
+     * \return  origin
+     */
+    const global_position_t& origin(void) const;
+
+
+    /**
+     * \brief   Version of the origin
+     * \details Incremented each time the origin is set, so that positions
+     *          converted to the local frame can be cached and recomputed
+     *          only when the origin changes
+     * \return  version
+     */
+    uint32_t version(void) const;
+
+
+    /**
+     * \brief   Converts global coordinates to local NED coordinates
+     *
+     * \param   input       Global position
+     * \param   output      Local position
+     */
+    void global_to_local(const global_position_t& input, local_position_t& output) const;
+
+
+    /**
+     * \brief   Converts an array of global coordinates to local NED coordinates
+     *
+     * \param   input       Global positions (array of size count)
+     * \param   output      Local positions (array of size count)
+     * \param   count       Number of positions
+     */
+    void global_to_local(const global_position_t input[], local_position_t output[], uint32_t count) const;
+
+
+    /**
+     * \brief   Converts local NED coordinates to global coordinates
+     *
+     * \param   input       Local position
+     * \param   output      Global position
+     */
+    void local_to_global(const local_position_t& input, global_position_t& output) const;
+
+
+private:
+    /**
+     * \brief   Cosine of the latitude origin_.latitude + dlat
+     *
+     * \param   dlat        Latitude offset to the origin in radians (|dlat| < MAX_OFFSET_RAD)
+     *
+     * \return  Cosine of the latitude
+     */
+    float cos_latitude(float dlat) const;
+
+
+    global_position_t origin_;      ///< Origin of the local frame
+    float cos_lat_;                 ///< Cosine of the origin latitude
+    float sin_lat_;                 ///< Sine of the origin latitude
+    uint32_t version_;              ///< Number of calls to set_origin
+};
+
+
+#endif /* LOCAL_TANGENT_PLANE_HPP_ */
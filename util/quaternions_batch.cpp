@@ -0,0 +1,247 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file quaternions_batch.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Batch operations on arrays of quaternions
+ *
+ ******************************************************************************/
+
+
+#include "util/quaternions_batch.hpp"
+
+#if defined(VECTORS_BATCH_USE_NEON)
+    #include <arm_neon.h>
+#elif defined(VECTORS_BATCH_USE_SSE)
+    #include <xmmintrin.h>
+#endif
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS DECLARATION
+//------------------------------------------------------------------------------
+
+/**
+ * \brief   Scalar rotation of the vectors i to n-1
+ *
+ * \param   q       Unit quaternion
+ * \param   u       Input vectors
+ * \param   v       Rotated vectors (output)
+ * \param   i       Index of first vector
+ * \param   n       Number of vectors
+ */
+static void quaternions_batch_rotate_vectors_scalar(const quat_t& q, const vectors_soa_t& u, vectors_soa_t& v, uint32_t i, uint32_t n);
+
+
+/**
+ * \brief   Scalar multiplication of the quaternions i to n-1
+ *
+ * \param   q1      First input quaternions
+ * \param   q2      Second input quaternions
+ * \param   out     Output quaternions
+ * \param   i       Index of first quaternion
+ * \param   n       Number of quaternions
+ */
+static void quaternions_batch_multiply_scalar(const quaternions_soa_t& q1, const quaternions_soa_t& q2, quaternions_soa_t& out, uint32_t i, uint32_t n);
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+static void quaternions_batch_rotate_vectors_scalar(const quat_t& q, const vectors_soa_t& u, vectors_soa_t& v, uint32_t i, uint32_t n)
+{
+    for (; i < n; ++i)
+    {
+        float in[3] = {u.x[i], u.y[i], u.z[i]};
+        float out[3];
+
+        quaternions_rotate_vector(q, in, out);
+
+        v.x[i] = out[0];
+        v.y[i] = out[1];
+        v.z[i] = out[2];
+    }
+}
+
+
+static void quaternions_batch_multiply_scalar(const quaternions_soa_t& q1, const quaternions_soa_t& q2, quaternions_soa_t& out, uint32_t i, uint32_t n)
+{
+    for (; i < n; ++i)
+    {
+        quat_t a = quaternions_create(q1.s[i], q1.v1[i], q1.v2[i], q1.v3[i]);
+        quat_t b = quaternions_create(q2.s[i], q2.v1[i], q2.v2[i], q2.v3[i]);
+        quat_t c = quaternions_multiply(a, b);
+
+        out.s[i]  = c.s;
+        out.v1[i] = c.v[0];
+        out.v2[i] = c.v[1];
+        out.v3[i] = c.v[2];
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+void quaternions_batch_rotate_vectors(const quat_t& q, const vectors_soa_t& u, vectors_soa_t& v, uint32_t n)
+{
+    uint32_t i = 0;
+
+    // Same algorithm as quaternions_rotate_vector:
+    // t = 2 * (q.v x u)
+    // v = u + q.s * t + q.v x t
+#if defined(VECTORS_BATCH_USE_NEON)
+    const float32x4_t qs = vdupq_n_f32(q.s);
+    const float32x4_t qx = vdupq_n_f32(q.v[0]);
+    const float32x4_t qy = vdupq_n_f32(q.v[1]);
+    const float32x4_t qz = vdupq_n_f32(q.v[2]);
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4_t ux = vld1q_f32(&u.x[i]);
+        float32x4_t uy = vld1q_f32(&u.y[i]);
+        float32x4_t uz = vld1q_f32(&u.z[i]);
+
+        float32x4_t tx = vmlsq_f32(vmulq_f32(qy, uz), qz, uy);
+        float32x4_t ty = vmlsq_f32(vmulq_f32(qz, ux), qx, uz);
+        float32x4_t tz = vmlsq_f32(vmulq_f32(qx, uy), qy, ux);
+        tx = vaddq_f32(tx, tx);
+        ty = vaddq_f32(ty, ty);
+        tz = vaddq_f32(tz, tz);
+
+        vst1q_f32(&v.x[i], vaddq_f32(vmlaq_f32(ux, qs, tx), vmlsq_f32(vmulq_f32(qy, tz), qz, ty)));
+        vst1q_f32(&v.y[i], vaddq_f32(vmlaq_f32(uy, qs, ty), vmlsq_f32(vmulq_f32(qz, tx), qx, tz)));
+        vst1q_f32(&v.z[i], vaddq_f32(vmlaq_f32(uz, qs, tz), vmlsq_f32(vmulq_f32(qx, ty), qy, tx)));
+    }
+#elif defined(VECTORS_BATCH_USE_SSE)
+    const __m128 qs = _mm_set1_ps(q.s);
+    const __m128 qx = _mm_set1_ps(q.v[0]);
+    const __m128 qy = _mm_set1_ps(q.v[1]);
+    const __m128 qz = _mm_set1_ps(q.v[2]);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 ux = _mm_loadu_ps(&u.x[i]);
+        __m128 uy = _mm_loadu_ps(&u.y[i]);
+        __m128 uz = _mm_loadu_ps(&u.z[i]);
+
+        __m128 tx = _mm_sub_ps(_mm_mul_ps(qy, uz), _mm_mul_ps(qz, uy));
+        __m128 ty = _mm_sub_ps(_mm_mul_ps(qz, ux), _mm_mul_ps(qx, uz));
+        __m128 tz = _mm_sub_ps(_mm_mul_ps(qx, uy), _mm_mul_ps(qy, ux));
+        tx = _mm_add_ps(tx, tx);
+        ty = _mm_add_ps(ty, ty);
+        tz = _mm_add_ps(tz, tz);
+
+        __m128 vx = _mm_add_ps(_mm_add_ps(ux, _mm_mul_ps(qs, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+        __m128 vy = _mm_add_ps(_mm_add_ps(uy, _mm_mul_ps(qs, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+        __m128 vz = _mm_add_ps(_mm_add_ps(uz, _mm_mul_ps(qs, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+
+        _mm_storeu_ps(&v.x[i], vx);
+        _mm_storeu_ps(&v.y[i], vy);
+        _mm_storeu_ps(&v.z[i], vz);
+    }
+#endif
+
+    // Remaining elements
+    quaternions_batch_rotate_vectors_scalar(q, u, v, i, n);
+}
+
+
+void quaternions_batch_multiply(const quaternions_soa_t& q1, const quaternions_soa_t& q2, quaternions_soa_t& out, uint32_t n)
+{
+    uint32_t i = 0;
+
+    // Same algorithm as quaternions_multiply:
+    // out.v = q2.s * q1.v + q1.s * q2.v + q1.v x q2.v
+    // out.s = q1.s * q2.s - q1.v . q2.v
+#if defined(VECTORS_BATCH_USE_NEON)
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4_t as = vld1q_f32(&q1.s[i]);
+        float32x4_t ax = vld1q_f32(&q1.v1[i]);
+        float32x4_t ay = vld1q_f32(&q1.v2[i]);
+        float32x4_t az = vld1q_f32(&q1.v3[i]);
+        float32x4_t bs = vld1q_f32(&q2.s[i]);
+        float32x4_t bx = vld1q_f32(&q2.v1[i]);
+        float32x4_t by = vld1q_f32(&q2.v2[i]);
+        float32x4_t bz = vld1q_f32(&q2.v3[i]);
+
+        float32x4_t s = vmulq_f32(as, bs);
+        s = vmlsq_f32(s, ax, bx);
+        s = vmlsq_f32(s, ay, by);
+        s = vmlsq_f32(s, az, bz);
+
+        float32x4_t x = vmlaq_f32(vmlsq_f32(vmulq_f32(ay, bz), az, by), bs, ax);
+        float32x4_t y = vmlaq_f32(vmlsq_f32(vmulq_f32(az, bx), ax, bz), bs, ay);
+        float32x4_t z = vmlaq_f32(vmlsq_f32(vmulq_f32(ax, by), ay, bx), bs, az);
+        x = vmlaq_f32(x, as, bx);
+        y = vmlaq_f32(y, as, by);
+        z = vmlaq_f32(z, as, bz);
+
+        vst1q_f32(&out.s[i],  s);
+        vst1q_f32(&out.v1[i], x);
+        vst1q_f32(&out.v2[i], y);
+        vst1q_f32(&out.v3[i], z);
+    }
+#elif defined(VECTORS_BATCH_USE_SSE)
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 as = _mm_loadu_ps(&q1.s[i]);
+        __m128 ax = _mm_loadu_ps(&q1.v1[i]);
+        __m128 ay = _mm_loadu_ps(&q1.v2[i]);
+        __m128 az = _mm_loadu_ps(&q1.v3[i]);
+        __m128 bs = _mm_loadu_ps(&q2.s[i]);
+        __m128 bx = _mm_loadu_ps(&q2.v1[i]);
+        __m128 by = _mm_loadu_ps(&q2.v2[i]);
+        __m128 bz = _mm_loadu_ps(&q2.v3[i]);
+
+        __m128 scp = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+        __m128 s   = _mm_sub_ps(_mm_mul_ps(as, bs), scp);
+
+        __m128 x = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+        x = _mm_add_ps(x, _mm_add_ps(_mm_mul_ps(bs, ax), _mm_mul_ps(as, bx)));
+        y = _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(bs, ay), _mm_mul_ps(as, by)));
+        z = _mm_add_ps(z, _mm_add_ps(_mm_mul_ps(bs, az), _mm_mul_ps(as, bz)));
+
+        _mm_storeu_ps(&out.s[i],  s);
+        _mm_storeu_ps(&out.v1[i], x);
+        _mm_storeu_ps(&out.v2[i], y);
+        _mm_storeu_ps(&out.v3[i], z);
+    }
+#endif
+
+    // Remaining elements
+    quaternions_batch_multiply_scalar(q1, q2, out, i, n);
+}
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file quaternions_batch.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Batch operations on arrays of quaternions
+ *
+ * \details Quaternions are stored in structure-of-arrays form (one array per
+ *          component). See vectors_batch.hpp for the selection of the SIMD
+ *          implementation.
+ *
+ ******************************************************************************/
+
+
+#ifndef QUATERNIONS_BATCH_HPP_
+#define QUATERNIONS_BATCH_HPP_
+
+#include <cstdint>
+
+#include "util/vectors_batch.hpp"
+
+extern "C"
+{
+#include "util/quaternions.h"
+}
+
+
+/**
+ * \brief   Array of quaternions in structure-of-arrays form
+ *
+ * \details The quaternions are in the form q = [s, v_1, v_2, v_3]
+ *          Each pointer references an array of at least n elements, n being
+ *          the batch size given to the batch functions.
+ *          Input and output arrays may be identical (in place operation),
+ *          but must not partially overlap.
+ */
+typedef struct
+{
+    float* s;           ///< Scalar components
+    float* v1;          ///< First components of the vector part
+    float* v2;          ///< Second components of the vector part
+    float* v3;          ///< Third components of the vector part
+} quaternions_soa_t;
+
+
+/**
+ * \brief   Rotates n vectors according to the same unit quaternion
+ *
+ * \details Batch version of quaternions_rotate_vector
+ *
+ * \param   q       Unit quaternion
+ * \param   u       Input vectors
+ * \param   v       Rotated vectors (output)
+ * \param   n       Number of vectors
+ */
+void quaternions_batch_rotate_vectors(const quat_t& q, const vectors_soa_t& u, vectors_soa_t& v, uint32_t n);
+
+
+/**
+ * \brief   Multiplies n pairs of quaternions
+ *
+ * \details Batch version of quaternions_multiply: out[i] = q1[i] * q2[i]
+ *
+ * \param   q1      First input quaternions
+ * \param   q2      Second input quaternions
+ * \param   out     Output quaternions
+ * \param   n       Number of quaternions
+ */
+void quaternions_batch_multiply(const quaternions_soa_t& q1, const quaternions_soa_t& q2, quaternions_soa_t& out, uint32_t n);
+
+
+#endif /* QUATERNIONS_BATCH_HPP_ */
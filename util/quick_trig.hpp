@@ -37,6 +37,9 @@
  *
  * \brief Quick implementation of trigonometric functions
  *
+ * \details Uses the polynomial approximations of fast_math.hpp with the default
+ *          accuracy tier (FAST_MATH_DEFAULT_TIER)
+ *
  ******************************************************************************/
 
 
@@ -51,9 +54,6 @@ extern "C"
 #include "util/maths.h"
 
 
-#define INTERP_POINTS 50
-
-
 /**
  * \brief             Quick implementation of the sinus function
  *
@@ -114,42 +114,6 @@ float quick_trig_tan(float x);
 float quick_trig_atan(float x);
 
 
-/**
- * \brief             Generic function used to approximate any function by interpolation
- *
- * \param x           Input value
- * \param func_x_min  Minimum of input range
- * \param func_x_max  Maximum of input range
- * \param func_x_step Discretisation step used for interpolation
- * \param func_y      Exact value of the fonction for each sampled input value
- *
- * \return            Estimated return value of the function
- */
-static inline float quick_trig_func(float x, const float func_x_min, const float func_x_max, float func_x_step, const float func_y[])
-{
-    float y;
-    int32_t i;
-
-    if (x <= func_x_min)
-    {
-        y = func_y[0];
-    }
-    else if (x >= func_x_max)
-    {
-        y = func_y[INTERP_POINTS - 1];
-    }
-    else
-    {
-        i = (int32_t)((x - func_x_min) / func_x_step);
-        y = maths_interpolate(x,
-                              func_x_min + i * func_x_step,
-                              func_x_min + (i + 1) * func_x_step,
-                              func_y[i],
-                              func_y[i + 1]);
-    }
-    return y;
-}
-
 #ifdef __cplusplus
 }
 #endif
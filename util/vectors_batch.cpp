@@ -0,0 +1,279 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file vectors_batch.cpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Batch operations on arrays of 3D vectors
+ *
+ ******************************************************************************/
+
+
+#include "util/vectors_batch.hpp"
+
+#if defined(VECTORS_BATCH_USE_NEON)
+    #include <arm_neon.h>
+#elif defined(VECTORS_BATCH_USE_SSE)
+    #include <xmmintrin.h>
+#endif
+
+extern "C"
+{
+#include "util/maths.h"
+}
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS DECLARATION
+//------------------------------------------------------------------------------
+
+/**
+ * \brief   Squared norm below which a vector is considered null
+ */
+static const float VECTORS_BATCH_NORM_SQR_MIN = 0.0000001f;
+
+
+/**
+ * \brief   Scalar normalization of the vectors i to n-1
+ *
+ * \param   in      Input vectors
+ * \param   out     Output vectors
+ * \param   i       Index of first vector
+ * \param   n       Number of vectors
+ */
+static void vectors_batch_normalize_scalar(const vectors_soa_t& in, vectors_soa_t& out, uint32_t i, uint32_t n);
+
+
+/**
+ * \brief   Scalar cross product of the vectors i to n-1
+ *
+ * \param   u       First input vectors
+ * \param   v       Second input vectors
+ * \param   out     Output vectors
+ * \param   i       Index of first vector
+ * \param   n       Number of vectors
+ */
+static void vectors_batch_cross_product_scalar(const vectors_soa_t& u, const vectors_soa_t& v, vectors_soa_t& out, uint32_t i, uint32_t n);
+
+
+/**
+ * \brief   Scalar product of the vectors i to n-1
+ *
+ * \param   u       First input vectors
+ * \param   v       Second input vectors
+ * \param   out     Output scalar products
+ * \param   i       Index of first vector
+ * \param   n       Number of vectors
+ */
+static void vectors_batch_scalar_product_scalar(const vectors_soa_t& u, const vectors_soa_t& v, float* out, uint32_t i, uint32_t n);
+
+
+//------------------------------------------------------------------------------
+// PRIVATE FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+static void vectors_batch_normalize_scalar(const vectors_soa_t& in, vectors_soa_t& out, uint32_t i, uint32_t n)
+{
+    for (; i < n; ++i)
+    {
+        float x = in.x[i];
+        float y = in.y[i];
+        float z = in.z[i];
+        float norm_sqr = x * x + y * y + z * z;
+
+        if (norm_sqr > VECTORS_BATCH_NORM_SQR_MIN)
+        {
+            float inv_norm = 1.0f / maths_fast_sqrt(norm_sqr);
+            out.x[i] = x * inv_norm;
+            out.y[i] = y * inv_norm;
+            out.z[i] = z * inv_norm;
+        }
+        else
+        {
+            out.x[i] = 0.0f;
+            out.y[i] = 0.0f;
+            out.z[i] = 0.0f;
+        }
+    }
+}
+
+
+static void vectors_batch_cross_product_scalar(const vectors_soa_t& u, const vectors_soa_t& v, vectors_soa_t& out, uint32_t i, uint32_t n)
+{
+    for (; i < n; ++i)
+    {
+        // Use temporaries so that out can be the same array as u or v
+        float x = u.y[i] * v.z[i] - u.z[i] * v.y[i];
+        float y = u.z[i] * v.x[i] - u.x[i] * v.z[i];
+        float z = u.x[i] * v.y[i] - u.y[i] * v.x[i];
+        out.x[i] = x;
+        out.y[i] = y;
+        out.z[i] = z;
+    }
+}
+
+
+static void vectors_batch_scalar_product_scalar(const vectors_soa_t& u, const vectors_soa_t& v, float* out, uint32_t i, uint32_t n)
+{
+    for (; i < n; ++i)
+    {
+        out[i] = u.x[i] * v.x[i] + u.y[i] * v.y[i] + u.z[i] * v.z[i];
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// PUBLIC FUNCTIONS IMPLEMENTATION
+//------------------------------------------------------------------------------
+
+void vectors_batch_normalize(const vectors_soa_t& in, vectors_soa_t& out, uint32_t n)
+{
+    uint32_t i = 0;
+
+#if defined(VECTORS_BATCH_USE_NEON)
+    const float32x4_t norm_min = vdupq_n_f32(VECTORS_BATCH_NORM_SQR_MIN);
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4_t x = vld1q_f32(&in.x[i]);
+        float32x4_t y = vld1q_f32(&in.y[i]);
+        float32x4_t z = vld1q_f32(&in.z[i]);
+
+        float32x4_t norm_sqr = vmlaq_f32(vmlaq_f32(vmulq_f32(x, x), y, y), z, z);
+
+        // Estimate of 1/sqrt refined with two Newton iterations
+        float32x4_t inv_norm = vrsqrteq_f32(norm_sqr);
+        inv_norm = vmulq_f32(inv_norm, vrsqrtsq_f32(vmulq_f32(norm_sqr, inv_norm), inv_norm));
+        inv_norm = vmulq_f32(inv_norm, vrsqrtsq_f32(vmulq_f32(norm_sqr, inv_norm), inv_norm));
+
+        // Null vectors give null output
+        uint32x4_t valid = vcgtq_f32(norm_sqr, norm_min);
+        inv_norm = vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(inv_norm)));
+
+        vst1q_f32(&out.x[i], vmulq_f32(x, inv_norm));
+        vst1q_f32(&out.y[i], vmulq_f32(y, inv_norm));
+        vst1q_f32(&out.z[i], vmulq_f32(z, inv_norm));
+    }
+#elif defined(VECTORS_BATCH_USE_SSE)
+    const __m128 norm_min = _mm_set1_ps(VECTORS_BATCH_NORM_SQR_MIN);
+    const __m128 half     = _mm_set1_ps(0.5f);
+    const __m128 three    = _mm_set1_ps(3.0f);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(&in.x[i]);
+        __m128 y = _mm_loadu_ps(&in.y[i]);
+        __m128 z = _mm_loadu_ps(&in.z[i]);
+
+        __m128 norm_sqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+
+        // Estimate of 1/sqrt refined with one Newton iteration: r = 0.5 * r * (3 - n * r * r)
+        __m128 inv_norm = _mm_rsqrt_ps(norm_sqr);
+        inv_norm = _mm_mul_ps(_mm_mul_ps(half, inv_norm),
+                              _mm_sub_ps(three, _mm_mul_ps(_mm_mul_ps(norm_sqr, inv_norm), inv_norm)));
+
+        // Null vectors give null output
+        inv_norm = _mm_and_ps(_mm_cmpgt_ps(norm_sqr, norm_min), inv_norm);
+
+        _mm_storeu_ps(&out.x[i], _mm_mul_ps(x, inv_norm));
+        _mm_storeu_ps(&out.y[i], _mm_mul_ps(y, inv_norm));
+        _mm_storeu_ps(&out.z[i], _mm_mul_ps(z, inv_norm));
+    }
+#endif
+
+    // Remaining elements
+    vectors_batch_normalize_scalar(in, out, i, n);
+}
+
+
+void vectors_batch_cross_product(const vectors_soa_t& u, const vectors_soa_t& v, vectors_soa_t& out, uint32_t n)
+{
+    uint32_t i = 0;
+
+#if defined(VECTORS_BATCH_USE_NEON)
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4_t ux = vld1q_f32(&u.x[i]);
+        float32x4_t uy = vld1q_f32(&u.y[i]);
+        float32x4_t uz = vld1q_f32(&u.z[i]);
+        float32x4_t vx = vld1q_f32(&v.x[i]);
+        float32x4_t vy = vld1q_f32(&v.y[i]);
+        float32x4_t vz = vld1q_f32(&v.z[i]);
+
+        vst1q_f32(&out.x[i], vmlsq_f32(vmulq_f32(uy, vz), uz, vy));
+        vst1q_f32(&out.y[i], vmlsq_f32(vmulq_f32(uz, vx), ux, vz));
+        vst1q_f32(&out.z[i], vmlsq_f32(vmulq_f32(ux, vy), uy, vx));
+    }
+#elif defined(VECTORS_BATCH_USE_SSE)
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 ux = _mm_loadu_ps(&u.x[i]);
+        __m128 uy = _mm_loadu_ps(&u.y[i]);
+        __m128 uz = _mm_loadu_ps(&u.z[i]);
+        __m128 vx = _mm_loadu_ps(&v.x[i]);
+        __m128 vy = _mm_loadu_ps(&v.y[i]);
+        __m128 vz = _mm_loadu_ps(&v.z[i]);
+
+        _mm_storeu_ps(&out.x[i], _mm_sub_ps(_mm_mul_ps(uy, vz), _mm_mul_ps(uz, vy)));
+        _mm_storeu_ps(&out.y[i], _mm_sub_ps(_mm_mul_ps(uz, vx), _mm_mul_ps(ux, vz)));
+        _mm_storeu_ps(&out.z[i], _mm_sub_ps(_mm_mul_ps(ux, vy), _mm_mul_ps(uy, vx)));
+    }
+#endif
+
+    // Remaining elements
+    vectors_batch_cross_product_scalar(u, v, out, i, n);
+}
+
+
+void vectors_batch_scalar_product(const vectors_soa_t& u, const vectors_soa_t& v, float* out, uint32_t n)
+{
+    uint32_t i = 0;
+
+#if defined(VECTORS_BATCH_USE_NEON)
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4_t scp = vmulq_f32(vld1q_f32(&u.x[i]), vld1q_f32(&v.x[i]));
+        scp = vmlaq_f32(scp, vld1q_f32(&u.y[i]), vld1q_f32(&v.y[i]));
+        scp = vmlaq_f32(scp, vld1q_f32(&u.z[i]), vld1q_f32(&v.z[i]));
+        vst1q_f32(&out[i], scp);
+    }
+#elif defined(VECTORS_BATCH_USE_SSE)
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 scp = _mm_mul_ps(_mm_loadu_ps(&u.x[i]), _mm_loadu_ps(&v.x[i]));
+        scp = _mm_add_ps(scp, _mm_mul_ps(_mm_loadu_ps(&u.y[i]), _mm_loadu_ps(&v.y[i])));
+        scp = _mm_add_ps(scp, _mm_mul_ps(_mm_loadu_ps(&u.z[i]), _mm_loadu_ps(&v.z[i])));
+        _mm_storeu_ps(&out[i], scp);
+    }
+#endif
+
+    // Remaining elements
+    vectors_batch_scalar_product_scalar(u, v, out, i, n);
+}
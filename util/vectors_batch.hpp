@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Copyright (c) 2009-2016, MAV'RIC Development Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * \file vectors_batch.hpp
+ *
+ * \author MAV'RIC Team
+ *
+ * \brief Batch operations on arrays of 3D vectors
+ *
+ * \details Vectors are stored in structure-of-arrays form (one array per
+ *          component), so that SIMD units can process several vectors at once.
+ *          NEON and SSE implementations are selected at compile time,
+ *          all other targets use the scalar implementation.
+ *
+ ******************************************************************************/
+
+
+#ifndef VECTORS_BATCH_HPP_
+#define VECTORS_BATCH_HPP_
+
+#include <cstdint>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define VECTORS_BATCH_USE_NEON
+#elif defined(__SSE__)
+    #define VECTORS_BATCH_USE_SSE
+#endif
+
+
+/**
+ * \brief   Array of 3D vectors in structure-of-arrays form
+ *
+ * \details Each pointer references an array of at least n elements, n being
+ *          the batch size given to the batch functions.
+ *          Input and output arrays may be identical (in place operation),
+ *          but must not partially overlap.
+ */
+typedef struct
+{
+    float* x;           ///< X components
+    float* y;           ///< Y components
+    float* z;           ///< Z components
+} vectors_soa_t;
+
+
+/**
+ * \brief   Normalizes n vectors of dimension 3
+ *
+ * \details Vectors with a norm close to zero are set to zero
+ *
+ * \param   in      Input vectors
+ * \param   out     Output vectors (unit norm)
+ * \param   n       Number of vectors
+ */
+void vectors_batch_normalize(const vectors_soa_t& in, vectors_soa_t& out, uint32_t n);
+
+
+/**
+ * \brief   Computes the cross products of n pairs of vectors (dim 3)
+ *
+ * \param   u       First input vectors
+ * \param   v       Second input vectors
+ * \param   out     Output vectors (u x v)
+ * \param   n       Number of vectors
+ */
+void vectors_batch_cross_product(const vectors_soa_t& u, const vectors_soa_t& v, vectors_soa_t& out, uint32_t n);
+
+
+/**
+ * \brief   Computes the scalar products of n pairs of vectors (dim 3)
+ *
+ * \param   u       First input vectors
+ * \param   v       Second input vectors
+ * \param   out     Output scalar products (array of n floats)
+ * \param   n       Number of vectors
+ */
+void vectors_batch_scalar_product(const vectors_soa_t& u, const vectors_soa_t& v, float* out, uint32_t n);
+
+
+#endif /* VECTORS_BATCH_HPP_ */